@@ -443,6 +443,42 @@ class V8_EXPORT AllocationProfile {
     unsigned int count;
   };
 
+  /**
+   * Lifetimes of the objects sampled at a node in the call-graph. Only
+   * collected if the profile was started with kSamplingTrackLifetimes.
+   */
+  struct LifetimeHistogram {
+    /**
+     * Total size of the objects sampled at this node, including objects that
+     * have died since.
+     */
+    size_t allocated_bytes;
+
+    /**
+     * The number of sampled objects that died before surviving a scavenge.
+     */
+    unsigned int died_young;
+
+    /**
+     * died_after_scavenges[n] is the number of sampled objects that died in
+     * the young generation after surviving n + 1 scavenges. The last entry
+     * also counts objects that survived more scavenges than that.
+     */
+    std::vector<unsigned int> died_after_scavenges;
+
+    /**
+     * The number of sampled objects that were promoted to the old generation
+     * or allocated there directly, whether they are still live or not.
+     */
+    unsigned int promoted;
+
+    /**
+     * The number of sampled objects that are still live in the young
+     * generation.
+     */
+    unsigned int young;
+  };
+
   /**
    * Represents a node in the call-graph.
    */
@@ -493,6 +529,11 @@ class V8_EXPORT AllocationProfile {
      * List of self allocations done by this node in the call-graph.
      */
     std::vector<Allocation> allocations;
+
+    /**
+     * Lifetimes of the objects allocated by this node in the call-graph.
+     */
+    LifetimeHistogram lifetimes;
   };
 
   /**
@@ -515,6 +556,11 @@ class V8_EXPORT AllocationProfile {
  */
 class V8_EXPORT HeapProfiler {
  public:
+  enum SamplingFlags {
+    kSamplingNoFlags = 0,
+    kSamplingTrackLifetimes = 1 << 0,
+  };
+
   /**
    * Callback function invoked for obtaining RetainedObjectInfo for
    * the given JavaScript wrapper object. It is prohibited to enter V8
@@ -637,10 +683,18 @@ class V8_EXPORT HeapProfiler {
    * Objects allocated before the sampling is started will not be included in
    * the profile.
    *
+   * If |flags| contains kSamplingTrackLifetimes, the profiler also records
+   * how many scavenges each sampled object survives, whether it gets
+   * promoted, and when it dies. The resulting per node lifetime histograms
+   * help finding allocation sites that would benefit from pretenuring or
+   * object pooling. Sampled objects are then no longer kept alive by
+   * scavenges.
+   *
    * Returns false if a sampling heap profiler is already running.
    */
   bool StartSamplingHeapProfiler(uint64_t sample_interval = 512 * 1024,
-                                 int stack_depth = 16);
+                                 int stack_depth = 16,
+                                 SamplingFlags flags = kSamplingNoFlags);
 
   /**
    * Stops the sampling heap profile and discards the current profile.
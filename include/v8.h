@@ -4925,6 +4925,15 @@ class V8_EXPORT ResourceConstraints {
   void set_code_range_size(size_t value) {
     code_range_size_ = value;
   }
+  int memory_budget() const { return memory_budget_; }
+  /**
+   * Sets the total amount of memory, in MB, the embedder process should stay
+   * under, e.g. the memory limit of its container. The maximum heap size is
+   * capped to fit into the budget and the heap grows, uses new space and
+   * reduces memory such that the heap and external memory stay under it.
+   * Zero means that there is no budget.
+   */
+  void set_memory_budget(int value) { memory_budget_ = value; }
 
  private:
   int max_semi_space_size_;
@@ -4932,6 +4941,7 @@ class V8_EXPORT ResourceConstraints {
   int max_executable_size_;
   uint32_t* stack_limit_;
   size_t code_range_size_;
+  int memory_budget_;
 };
 
 
@@ -5162,6 +5172,69 @@ class V8_EXPORT HeapObjectStatistics {
 };
 
 
+/**
+ * Statistics about the objects that were live at the last mark-compact
+ * garbage collection, filled in by Isolate::GetHeapObjectStatisticsSnapshot.
+ * Contains an entry for every tracked object type with live objects.
+ */
+class V8_EXPORT HeapObjectStatisticsSnapshot {
+ public:
+  HeapObjectStatisticsSnapshot();
+  ~HeapObjectStatisticsSnapshot();
+
+  /**
+   * The number of the mark-compact garbage collection the statistics were
+   * collected at.
+   */
+  int gc_count() { return gc_count_; }
+
+  /**
+   * The statistics were collected on one in sampling_rate() pages of the heap
+   * and are extrapolated to the whole heap. A sampling rate of 1 means that
+   * the statistics are exact.
+   */
+  int sampling_rate() { return sampling_rate_; }
+
+  size_t length() { return length_; }
+  HeapObjectStatistics* Get(size_t index) { return &statistics_[index]; }
+
+ private:
+  HeapObjectStatisticsSnapshot(const HeapObjectStatisticsSnapshot&);
+  void operator=(const HeapObjectStatisticsSnapshot&);
+
+  int gc_count_;
+  int sampling_rate_;
+  HeapObjectStatistics* statistics_;
+  size_t length_;
+
+  friend class Isolate;
+};
+
+
+/**
+ * Statistics about the idle gaps between requests of a server embedder, see
+ * Isolate::IdleNotificationRequestFinished. A hit is a gap in which garbage
+ * collection work finished before the next request arrived, a miss is a gap
+ * in which it delayed the next request.
+ */
+class V8_EXPORT IdleGapStatistics {
+ public:
+  IdleGapStatistics();
+  double predicted_idle_gap_in_ms() { return predicted_idle_gap_in_ms_; }
+  size_t hits() { return hits_; }
+  size_t misses() { return misses_; }
+  double total_delay_in_ms() { return total_delay_in_ms_; }
+
+ private:
+  double predicted_idle_gap_in_ms_;
+  size_t hits_;
+  size_t misses_;
+  double total_delay_in_ms_;
+
+  friend class Isolate;
+};
+
+
 class RetainedObjectInfo;
 
 
@@ -5606,6 +5679,17 @@ class V8_EXPORT Isolate {
   bool GetHeapObjectStatisticsAtLastGC(HeapObjectStatistics* object_statistics,
                                        size_t type_index);
 
+  /**
+   * Get statistics about all types of objects in the heap that were live at
+   * the last mark-compact garbage collection. Statistics are collected with
+   * --track-gc-object-stats, or cheaply enough to be left on with
+   * --gc-object-stats-sampling-rate.
+   *
+   * \param snapshot The HeapObjectStatisticsSnapshot object to fill in.
+   * \returns true on success, false if no statistics were collected yet.
+   */
+  bool GetHeapObjectStatisticsSnapshot(HeapObjectStatisticsSnapshot* snapshot);
+
   /**
    * Get a call stack sample from the isolate.
    * \param state Execution state.
@@ -5921,6 +6005,28 @@ class V8_EXPORT Isolate {
   V8_DEPRECATED("use IdleNotificationDeadline()",
                 bool IdleNotification(int idle_time_in_ms));
 
+  /**
+   * Optional notifications for server embedders that are idle in short bursts
+   * between requests, instead of IdleNotificationDeadline.
+   *
+   * IdleNotificationRequestFinished tells V8 that the embedder finished
+   * handling a request and is idle until the next one arrives. V8 performs the
+   * garbage collection work that is predicted to fit in the idle gap, based on
+   * the lengths of the recent gaps. Returns true if V8 has no more work to do.
+   *
+   * IdleNotificationRequestArrived ends the idle gap. The
+   * arrival_time_in_seconds argument is the time the next request arrived,
+   * based on the same timebase as MonotonicallyIncreasingTime().
+   */
+  bool IdleNotificationRequestFinished();
+  void IdleNotificationRequestArrived(double arrival_time_in_seconds);
+
+  /**
+   * Get statistics about the idle gaps reported with
+   * IdleNotificationRequestFinished and IdleNotificationRequestArrived.
+   */
+  void GetIdleGapStatistics(IdleGapStatistics* idle_gap_statistics);
+
   /**
    * Optional notification that the system is running low on memory.
    * V8 uses these notifications to attempt to free memory.
@@ -37,6 +37,7 @@
 #include "src/execution.h"
 #include "src/gdb-jit.h"
 #include "src/global-handles.h"
+#include "src/heap/gc-idle-time-handler.h"
 #include "src/icu_util.h"
 #include "src/isolate-inl.h"
 #include "src/json-parser.h"
@@ -507,7 +508,8 @@ ResourceConstraints::ResourceConstraints()
       max_old_space_size_(0),
       max_executable_size_(0),
       stack_limit_(NULL),
-      code_range_size_(0) { }
+      code_range_size_(0),
+      memory_budget_(0) { }
 
 void ResourceConstraints::ConfigureDefaults(uint64_t physical_memory,
                                             uint64_t virtual_memory_limit) {
@@ -557,10 +559,12 @@ void SetResourceConstraints(i::Isolate* isolate,
   int old_space_size = constraints.max_old_space_size();
   int max_executable_size = constraints.max_executable_size();
   size_t code_range_size = constraints.code_range_size();
+  int memory_budget = constraints.memory_budget();
   if (semi_space_size != 0 || old_space_size != 0 ||
-      max_executable_size != 0 || code_range_size != 0) {
+      max_executable_size != 0 || code_range_size != 0 || memory_budget != 0) {
     isolate->heap()->ConfigureHeap(semi_space_size, old_space_size,
-                                   max_executable_size, code_range_size);
+                                   max_executable_size, code_range_size,
+                                   memory_budget);
   }
   if (constraints.stack_limit() != NULL) {
     uintptr_t limit = reinterpret_cast<uintptr_t>(constraints.stack_limit());
@@ -5422,6 +5426,20 @@ HeapObjectStatistics::HeapObjectStatistics()
       object_size_(0) {}
 
 
+IdleGapStatistics::IdleGapStatistics()
+    : predicted_idle_gap_in_ms_(0), hits_(0), misses_(0),
+      total_delay_in_ms_(0) {}
+
+
+HeapObjectStatisticsSnapshot::HeapObjectStatisticsSnapshot()
+    : gc_count_(0), sampling_rate_(0), statistics_(nullptr), length_(0) {}
+
+
+HeapObjectStatisticsSnapshot::~HeapObjectStatisticsSnapshot() {
+  delete[] statistics_;
+}
+
+
 bool v8::V8::InitializeICU(const char* icu_data_file) {
   return i::InitializeICU(icu_data_file);
 }
@@ -7339,7 +7357,10 @@ size_t Isolate::NumberOfTrackedHeapObjectTypes() {
 bool Isolate::GetHeapObjectStatisticsAtLastGC(
     HeapObjectStatistics* object_statistics, size_t type_index) {
   if (!object_statistics) return false;
-  if (!i::FLAG_track_gc_object_stats) return false;
+  if (!i::FLAG_track_gc_object_stats &&
+      i::FLAG_gc_object_stats_sampling_rate == 0) {
+    return false;
+  }
 
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
   i::Heap* heap = isolate->heap();
@@ -7364,6 +7385,38 @@ bool Isolate::GetHeapObjectStatisticsAtLastGC(
 }
 
 
+bool Isolate::GetHeapObjectStatisticsSnapshot(
+    HeapObjectStatisticsSnapshot* snapshot) {
+  if (!snapshot) return false;
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::Heap* heap = isolate->heap();
+  if (heap->ObjectStatsGCCount() == 0) return false;
+
+  size_t types = heap->NumberOfTrackedHeapObjectTypes();
+  delete[] snapshot->statistics_;
+  snapshot->statistics_ = new HeapObjectStatistics[types];
+  snapshot->length_ = 0;
+  snapshot->gc_count_ = heap->ObjectStatsGCCount();
+  snapshot->sampling_rate_ = heap->ObjectStatsSamplingRate();
+  for (size_t type_index = 0; type_index < types; type_index++) {
+    size_t object_count = heap->ObjectCountAtLastGC(type_index);
+    if (object_count == 0) continue;
+    const char* object_type;
+    const char* object_sub_type;
+    if (!heap->GetObjectTypeName(type_index, &object_type, &object_sub_type)) {
+      continue;
+    }
+    HeapObjectStatistics* statistics =
+        &snapshot->statistics_[snapshot->length_++];
+    statistics->object_type_ = object_type;
+    statistics->object_sub_type_ = object_sub_type;
+    statistics->object_count_ = object_count;
+    statistics->object_size_ = heap->ObjectSizeAtLastGC(type_index);
+  }
+  return true;
+}
+
+
 void Isolate::GetStackSample(const RegisterState& state, void** frames,
                              size_t frames_limit, SampleInfo* sample_info) {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
@@ -7507,6 +7560,30 @@ bool Isolate::IdleNotificationDeadline(double deadline_in_seconds) {
 }
 
 
+bool Isolate::IdleNotificationRequestFinished() {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  if (!i::FLAG_use_idle_notification) return true;
+  return isolate->heap()->IdleNotificationRequestFinished();
+}
+
+
+void Isolate::IdleNotificationRequestArrived(double arrival_time_in_seconds) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  if (!i::FLAG_use_idle_notification) return;
+  isolate->heap()->IdleNotificationRequestArrived(arrival_time_in_seconds);
+}
+
+
+void Isolate::GetIdleGapStatistics(IdleGapStatistics* idle_gap_statistics) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::GCIdleGapHistory* idle_gaps = isolate->heap()->idle_gaps();
+  idle_gap_statistics->predicted_idle_gap_in_ms_ = idle_gaps->PredictGap();
+  idle_gap_statistics->hits_ = idle_gaps->hits();
+  idle_gap_statistics->misses_ = idle_gaps->misses();
+  idle_gap_statistics->total_delay_in_ms_ = idle_gaps->total_delay_in_ms();
+}
+
+
 void Isolate::LowMemoryNotification() {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
   {
@@ -8319,9 +8396,10 @@ SnapshotObjectId HeapProfiler::GetHeapStats(OutputStream* stream,
 
 
 bool HeapProfiler::StartSamplingHeapProfiler(uint64_t sample_interval,
-                                             int stack_depth) {
+                                             int stack_depth,
+                                             SamplingFlags flags) {
   return reinterpret_cast<i::HeapProfiler*>(this)
-      ->StartSamplingHeapProfiler(sample_interval, stack_depth);
+      ->StartSamplingHeapProfiler(sample_interval, stack_depth, flags);
 }
 
 
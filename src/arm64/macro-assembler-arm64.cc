@@ -1328,10 +1328,10 @@ void MacroAssembler::AssertStackConsistency() {
   // much code to be generated.
   if (emit_debug_code() && use_real_aborts()) {
     if (csp.Is(StackPointer())) {
-      // Always check the alignment of csp if ALWAYS_ALIGN_CSP is true.  We
-      // can't check the alignment of csp without using a scratch register (or
-      // clobbering the flags), but the processor (or simulator) will abort if
-      // it is not properly aligned during a load.
+      // Always check the alignment of csp.  We can't check the alignment of
+      // csp without using a scratch register (or clobbering the flags), but
+      // the processor (or simulator) will abort if it is not properly aligned
+      // during a load.
       ldr(xzr, MemOperand(csp, 0));
     }
     if (FLAG_enable_slow_asserts && !csp.Is(StackPointer())) {
@@ -3917,12 +3917,12 @@ void MacroAssembler::RememberedSetHelper(Register object,  // For debug tests.
   // Call stub on end of buffer.
   // Check for end of buffer.
   DCHECK(StoreBuffer::kStoreBufferOverflowBit ==
-         (1 << (14 + kPointerSizeLog2)));
+         (1 << StoreBuffer::kStoreBufferSizeLog2));
   if (and_then == kFallThroughAtEnd) {
-    Tbz(scratch1, (14 + kPointerSizeLog2), &done);
+    Tbz(scratch1, StoreBuffer::kStoreBufferSizeLog2, &done);
   } else {
     DCHECK(and_then == kReturnAtEnd);
-    Tbnz(scratch1, (14 + kPointerSizeLog2), &store_buffer_overflow);
+    Tbnz(scratch1, StoreBuffer::kStoreBufferSizeLog2, &store_buffer_overflow);
     Ret();
   }
 
@@ -142,6 +142,20 @@ inline unsigned CountTrailingZeros64(uint64_t value) {
 }
 
 
+// ClearLowestSetBit32(value) returns |value| with its least significant 1 bit
+// cleared. Returns 0 if |value| is 0.
+inline uint32_t ClearLowestSetBit32(uint32_t value) {
+  return value & (value - 1);
+}
+
+
+// ClearLowestSetBit64(value) returns |value| with its least significant 1 bit
+// cleared. Returns 0 if |value| is 0.
+inline uint64_t ClearLowestSetBit64(uint64_t value) {
+  return value & (value - 1);
+}
+
+
 // Returns true iff |value| is a power of 2.
 inline bool IsPowerOfTwo32(uint32_t value) {
   return value && !(value & (value - 1));
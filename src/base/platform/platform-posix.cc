@@ -134,6 +134,15 @@ void OS::Guard(void* address, const size_t size) {
 }
 
 
+bool OS::AdviseHugePages(void* address, const size_t size) {
+#if defined(MADV_HUGEPAGE)
+  return madvise(address, size, MADV_HUGEPAGE) == 0;
+#else
+  return false;
+#endif
+}
+
+
 static LazyInstance<RandomNumberGenerator>::type
     platform_random_number_generator = LAZY_INSTANCE_INITIALIZER;
 
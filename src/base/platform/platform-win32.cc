@@ -822,6 +822,13 @@ void OS::Guard(void* address, const size_t size) {
 }
 
 
+bool OS::AdviseHugePages(void* address, const size_t size) {
+  // Large pages on Windows need SeLockMemoryPrivilege and have to be
+  // requested at allocation time.
+  return false;
+}
+
+
 void OS::Sleep(TimeDelta interval) {
   ::Sleep(static_cast<DWORD>(interval.InMilliseconds()));
 }
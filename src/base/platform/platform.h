@@ -184,6 +184,11 @@ class OS {
   // Assign memory as a guard page so that access will cause an exception.
   static void Guard(void* address, const size_t size);
 
+  // Ask the OS to back a committed region with huge pages where supported
+  // (transparent huge pages on Linux). Returns false if the hint is not
+  // available. The hint does not survive re-committing the region.
+  static bool AdviseHugePages(void* address, const size_t size);
+
   // Generate a random address to be used for hinting mmap().
   static void* GetRandomMmapAddr();
 
@@ -16,6 +16,8 @@
 #include <sys/sysctl.h>
 #endif
 
+#include <stdio.h>
+
 #include <limits>
 
 #include "src/base/logging.h"
@@ -116,5 +118,28 @@ int64_t SysInfo::AmountOfVirtualMemory() {
 #endif
 }
 
+
+// static
+int64_t SysInfo::AmountOfContainerMemory() {
+#if V8_OS_LINUX
+  // cgroup v2 reports "max" if there is no limit, cgroup v1 a huge number.
+  static const char* const kLimitFiles[] = {
+      "/sys/fs/cgroup/memory.max",
+      "/sys/fs/cgroup/memory/memory.limit_in_bytes"};
+  for (size_t i = 0; i < arraysize(kLimitFiles); i++) {
+    FILE* file = fopen(kLimitFiles[i], "r");
+    if (file == NULL) continue;
+    long long limit = 0;  // NOLINT(runtime/int)
+    int matched = fscanf(file, "%lld", &limit);
+    fclose(file);
+    if (matched != 1 || limit <= 0) return 0;
+    int64_t physical_memory = AmountOfPhysicalMemory();
+    if (physical_memory > 0 && limit >= physical_memory) return 0;
+    return static_cast<int64_t>(limit);
+  }
+#endif
+  return 0;
+}
+
 }  // namespace base
 }  // namespace v8
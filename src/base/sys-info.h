@@ -22,6 +22,10 @@ class SysInfo final {
   // Returns the number of bytes of virtual memory of this process. A return
   // value of zero means that there is no limit on the available virtual memory.
   static int64_t AmountOfVirtualMemory();
+
+  // Returns the memory limit in bytes of the cgroup of this process. A return
+  // value of zero means that there is no limit or that it is not known.
+  static int64_t AmountOfContainerMemory();
 };
 
 }  // namespace base
@@ -78,6 +78,10 @@ class S390OperandConverter final : public InstructionOperandConverter {
       case kMode_MRR:
         *first_index += 2;
         return MemOperand(InputRegister(index + 0), InputRegister(index + 1));
+      case kMode_MRRI:
+        *first_index += 3;
+        return MemOperand(InputRegister(index + 0), InputRegister(index + 1),
+                          InputInt32(index + 2));
     }
     UNREACHABLE();
     return MemOperand(r0);
@@ -103,6 +107,12 @@ static inline bool HasRegisterInput(Instruction* instr, int index) {
 }
 
 
+// Instructions that folded a load take their second operand from memory.
+static inline bool HasMemoryOperand(Instruction* instr) {
+  return AddressingModeField::decode(instr->opcode()) != kMode_None;
+}
+
+
 namespace {
 
 class OutOfLineLoadNAN32 final : public OutOfLineCode {
@@ -304,6 +314,20 @@ Condition FlagsConditionToCondition(FlagsCondition condition, ArchOpcode op) {
   } while (0)
 
 
+// The output is the same register as the first input.
+#define ASSEMBLE_BINOP_MEMORY(asm_instr_32, asm_instr_ptr)               \
+  do {                                                                   \
+    DCHECK(i.OutputRegister().is(i.InputRegister(0)));                   \
+    AddressingMode mode = kMode_None;                                    \
+    MemOperand operand = i.MemoryOperand(&mode, 1);                      \
+    if (MiscField::decode(instr->opcode()) == kS390_MemoryOperand64) {   \
+      __ asm_instr_ptr(i.OutputRegister(), operand);                     \
+    } else {                                                             \
+      __ asm_instr_32(i.OutputRegister(), operand);                      \
+    }                                                                    \
+  } while (0)
+
+
 #define ASSEMBLE_BINOP_INT(asm_instr_reg, asm_instr_imm)    \
   do {                                                         \
     if (HasRegisterInput(instr, 1)) {                          \
@@ -361,7 +385,15 @@ Condition FlagsConditionToCondition(FlagsCondition condition, ArchOpcode op) {
 
 #define ASSEMBLE_COMPARE(cmp_instr, cmpl_instr)                        \
   do {                                                                 \
-    if (HasRegisterInput(instr, 1)) {                                  \
+    if (HasMemoryOperand(instr)) {                                     \
+      AddressingMode mode = kMode_None;                                \
+      MemOperand operand = i.MemoryOperand(&mode, 1);                  \
+      if (i.CompareLogical()) {                                        \
+        __ cmpl_instr(i.InputRegister(0), operand);                    \
+      } else {                                                         \
+        __ cmp_instr(i.InputRegister(0), operand);                     \
+      }                                                                \
+    } else if (HasRegisterInput(instr, 1)) {                           \
       if (i.CompareLogical()) {                                        \
         __ cmpl_instr(i.InputRegister(0), i.InputRegister(1));         \
       } else {                                                         \
@@ -784,21 +816,33 @@ void CodeGenerator::AssembleArchInstruction(Instruction* instr) {
       break;
     }
     case kS390_And:
-      ASSEMBLE_BINOP(AndP, AndP);
+      if (HasMemoryOperand(instr)) {
+        ASSEMBLE_BINOP_MEMORY(And, AndP);
+      } else {
+        ASSEMBLE_BINOP(AndP, AndP);
+      }
       break;
     case kS390_AndComplement:
       __ NotP(i.InputRegister(1));
       __ AndP(i.OutputRegister(), i.InputRegister(0), i.InputRegister(1));
       break;
     case kS390_Or:
-      ASSEMBLE_BINOP(OrP, OrP);
+      if (HasMemoryOperand(instr)) {
+        ASSEMBLE_BINOP_MEMORY(Or, OrP);
+      } else {
+        ASSEMBLE_BINOP(OrP, OrP);
+      }
       break;
     case kS390_OrComplement:
       __ NotP(i.InputRegister(1));
       __ OrP(i.OutputRegister(), i.InputRegister(0), i.InputRegister(1));
       break;
     case kS390_Xor:
-      ASSEMBLE_BINOP(XorP, XorP);
+      if (HasMemoryOperand(instr)) {
+        ASSEMBLE_BINOP_MEMORY(Xor, XorP);
+      } else {
+        ASSEMBLE_BINOP(XorP, XorP);
+      }
       break;
     case kS390_ShiftLeft32:
       if (HasRegisterInput(instr, 1)) {
@@ -926,6 +970,10 @@ void CodeGenerator::AssembleArchInstruction(Instruction* instr) {
       break;
 #endif
     case kS390_Add:
+      if (HasMemoryOperand(instr)) {
+        ASSEMBLE_BINOP_MEMORY(Add32, AddP);
+        break;
+      }
 #if V8_TARGET_ARCH_S390X
       if (FlagsModeField::decode(instr->opcode()) != kFlags_none) {
         ASSEMBLE_ADD_WITH_OVERFLOW();
@@ -960,6 +1008,10 @@ void CodeGenerator::AssembleArchInstruction(Instruction* instr) {
     }
       break;
     case kS390_Sub:
+      if (HasMemoryOperand(instr)) {
+        ASSEMBLE_BINOP_MEMORY(Sub32, SubP);
+        break;
+      }
 #if V8_TARGET_ARCH_S390X
       if (FlagsModeField::decode(instr->opcode()) != kFlags_none) {
         ASSEMBLE_SUB_WITH_OVERFLOW();
@@ -1117,6 +1169,10 @@ void CodeGenerator::AssembleArchInstruction(Instruction* instr) {
       __ fiebra(i.OutputDoubleRegister(), i.InputDoubleRegister(0),
           v8::internal::Assembler::FIDBRA_ROUND_TOWARD_0);
       break;
+    case kS390_RoundTiesEvenFloat:
+      __ fiebra(i.OutputDoubleRegister(), i.InputDoubleRegister(0),
+          v8::internal::Assembler::FIDBRA_ROUND_TO_NEAREST_TO_EVEN);
+      break;
 //  Double operations
     case kS390_ModDouble:
       ASSEMBLE_FLOAT_MODULO();
@@ -1154,6 +1210,10 @@ void CodeGenerator::AssembleArchInstruction(Instruction* instr) {
       __ fidbra(i.OutputDoubleRegister(), i.InputDoubleRegister(0),
           v8::internal::Assembler::FIDBRA_ROUND_TO_NEAREST_AWAY_FROM_0);
       break;
+    case kS390_RoundTiesEvenDouble:
+      __ fidbra(i.OutputDoubleRegister(), i.InputDoubleRegister(0),
+          v8::internal::Assembler::FIDBRA_ROUND_TO_NEAREST_TO_EVEN);
+      break;
     case kS390_NegDouble:
       ASSEMBLE_FLOAT_UNOP(lcdbr);
       break;
@@ -1181,6 +1241,20 @@ void CodeGenerator::AssembleArchInstruction(Instruction* instr) {
       // __ popcntd(i.OutputRegister(), i.InputRegister(0));
       // DCHECK_EQ(LeaveRC, i.OutputRCBit());
       break;
+#endif
+    case kS390_Ctz32:
+      __ CountTrailingZeros32(i.OutputRegister(), i.InputRegister(0));
+      break;
+    case kS390_ReverseBits32:
+      __ ReverseBits32(i.OutputRegister(), i.InputRegister(0));
+      break;
+#if V8_TARGET_ARCH_S390X
+    case kS390_Ctz64:
+      __ CountTrailingZeros64(i.OutputRegister(), i.InputRegister(0));
+      break;
+    case kS390_ReverseBits64:
+      __ ReverseBits64(i.OutputRegister(), i.InputRegister(0));
+      break;
 #endif
     case kS390_Cmp32:
       ASSEMBLE_COMPARE(Cmp32, CmpLogical32);
@@ -1197,7 +1271,11 @@ void CodeGenerator::AssembleArchInstruction(Instruction* instr) {
       __ cdbr(i.InputDoubleRegister(0), i.InputDoubleRegister(1));
       break;
     case kS390_Tst32:
-      if (HasRegisterInput(instr, 1)) {
+      if (HasMemoryOperand(instr)) {
+        AddressingMode mode = kMode_None;
+        __ LoadRR(r0, i.InputRegister(0));
+        __ And(r0, i.MemoryOperand(&mode, 1));
+      } else if (HasRegisterInput(instr, 1)) {
         __ AndP(r0, i.InputRegister(0), i.InputRegister(1));
       } else {
         __ AndP(r0, i.InputRegister(0), i.InputImmediate(1));
@@ -1209,7 +1287,11 @@ void CodeGenerator::AssembleArchInstruction(Instruction* instr) {
       break;
 #if V8_TARGET_ARCH_S390X
     case kS390_Tst64:
-      if (HasRegisterInput(instr, 1)) {
+      if (HasMemoryOperand(instr)) {
+        AddressingMode mode = kMode_None;
+        __ LoadRR(r0, i.InputRegister(0));
+        __ AndP(r0, i.MemoryOperand(&mode, 1));
+      } else if (HasRegisterInput(instr, 1)) {
         __ AndP(r0, i.InputRegister(0), i.InputRegister(1));
       } else {
         __ AndP(r0, i.InputRegister(0), i.InputImmediate(1));
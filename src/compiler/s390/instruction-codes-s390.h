@@ -61,12 +61,14 @@ namespace compiler {
   V(S390_FloorFloat)                \
   V(S390_CeilFloat)                 \
   V(S390_TruncateFloat)             \
+  V(S390_RoundTiesEvenFloat)        \
   V(S390_AbsFloat)                  \
   V(S390_SqrtDouble)                \
   V(S390_FloorDouble)               \
   V(S390_CeilDouble)                \
   V(S390_TruncateDouble)            \
   V(S390_RoundDouble)               \
+  V(S390_RoundTiesEvenDouble)       \
   V(S390_MaxDouble)                 \
   V(S390_MinDouble)                 \
   V(S390_AbsDouble)                 \
@@ -74,6 +76,10 @@ namespace compiler {
   V(S390_Cntlz64)                   \
   V(S390_Popcnt32)                  \
   V(S390_Popcnt64)                  \
+  V(S390_Ctz32)                     \
+  V(S390_Ctz64)                     \
+  V(S390_ReverseBits32)             \
+  V(S390_ReverseBits64)             \
   V(S390_Cmp32)                     \
   V(S390_Cmp64)                     \
   V(S390_CmpFloat)                  \
@@ -143,9 +149,18 @@ namespace compiler {
 // I = immediate (handle, external, int32)
 // MRI = [register + immediate]
 // MRR = [register + register]
+// MRRI = [register + register + immediate]
 #define TARGET_ADDRESSING_MODE_LIST(V) \
-  V(MRI) /* [%r0 + K] */               \
-  V(MRR) /* [%r0 + %r1] */
+  V(MRI)  /* [%r0 + K] */              \
+  V(MRR)  /* [%r0 + %r1] */            \
+  V(MRRI) /* [%r0 + %r1 + K] */
+
+// The width of the memory operand of an S390_Add, S390_Sub, S390_And,
+// S390_Or or S390_Xor that has an addressing mode, encoded in the MiscField.
+enum S390MemoryOperandWidth {
+  kS390_MemoryOperand32 = 0,
+  kS390_MemoryOperand64 = 1
+};
 
 }  // namespace compiler
 }  // namespace internal
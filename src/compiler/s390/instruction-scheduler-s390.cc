@@ -15,10 +15,20 @@ int InstructionScheduler::GetTargetInstructionFlags(
     const Instruction* instr) const {
   switch (instr->arch_opcode()) {
     case kS390_And:
-    case kS390_AndComplement:
     case kS390_Or:
-    case kS390_OrComplement:
     case kS390_Xor:
+    case kS390_Add:
+    case kS390_Sub:
+    case kS390_Cmp32:
+    case kS390_Cmp64:
+    case kS390_Tst32:
+    case kS390_Tst64:
+      // These read their second operand from memory if they folded a load.
+      return instr->addressing_mode() == kMode_None ? kNoOpcodeFlags
+                                                    : kIsLoadOperation;
+
+    case kS390_AndComplement:
+    case kS390_OrComplement:
     case kS390_ShiftLeft32:
     case kS390_ShiftLeft64:
     case kS390_ShiftRight32:
@@ -32,11 +42,9 @@ int InstructionScheduler::GetTargetInstructionFlags(
     case kS390_RotLeftAndClear64:
     case kS390_RotLeftAndClearLeft64:
     case kS390_RotLeftAndClearRight64:
-    case kS390_Add:
     case kS390_AddWithOverflow32:
     case kS390_AddFloat:
     case kS390_AddDouble:
-    case kS390_Sub:
     case kS390_SubWithOverflow32:
     case kS390_SubFloat:
     case kS390_SubDouble:
@@ -63,12 +71,14 @@ int InstructionScheduler::GetTargetInstructionFlags(
     case kS390_FloorFloat:
     case kS390_CeilFloat:
     case kS390_TruncateFloat:
+    case kS390_RoundTiesEvenFloat:
     case kS390_AbsFloat:
     case kS390_SqrtDouble:
     case kS390_FloorDouble:
     case kS390_CeilDouble:
     case kS390_TruncateDouble:
     case kS390_RoundDouble:
+    case kS390_RoundTiesEvenDouble:
     case kS390_MaxDouble:
     case kS390_MinDouble:
     case kS390_AbsDouble:
@@ -76,12 +86,12 @@ int InstructionScheduler::GetTargetInstructionFlags(
     case kS390_Cntlz64:
     case kS390_Popcnt32:
     case kS390_Popcnt64:
-    case kS390_Cmp32:
-    case kS390_Cmp64:
+    case kS390_Ctz32:
+    case kS390_Ctz64:
+    case kS390_ReverseBits32:
+    case kS390_ReverseBits64:
     case kS390_CmpFloat:
     case kS390_CmpDouble:
-    case kS390_Tst32:
-    case kS390_Tst64:
     case kS390_ExtendSignWord8:
     case kS390_ExtendSignWord16:
     case kS390_ExtendSignWord32:
@@ -149,9 +159,254 @@ int InstructionScheduler::GetTargetInstructionFlags(
 }
 
 
+namespace {
+
+// Approximate latencies, in cycles, of the instruction classes emitted for
+// the kS390_* opcodes, based on the published pipeline characteristics of
+// the z/Architecture cores. Non-pipelined operations like divide and square
+// root are modeled by their full latency.
+struct S390LatencyModel {
+  int load;
+  int float_load;
+  int multiply32;
+  int multiply64;
+  int divide32;
+  int divide64;
+  int count_bits;
+  int float_move;
+  int float_compare;
+  int float_add;
+  int float_multiply;
+  int float32_divide;
+  int float64_divide;
+  int float32_sqrt;
+  int float64_sqrt;
+  int float_round;
+  int conversion;
+};
+
+// z13 and later: shorter fixed-point divide and binary floating point
+// latencies than the previous generations.
+const S390LatencyModel kZ13Model = {
+    4,   // load
+    5,   // float_load
+    5,   // multiply32
+    7,   // multiply64
+    20,  // divide32
+    32,  // divide64
+    3,   // count_bits
+    2,   // float_move
+    3,   // float_compare
+    7,   // float_add
+    7,   // float_multiply
+    17,  // float32_divide
+    27,  // float64_divide
+    21,  // float32_sqrt
+    33,  // float64_sqrt
+    7,   // float_round
+    8    // conversion
+};
+
+// z196 and zEC12: pipelined binary floating point unit, 4 cycle L1 data
+// cache hits.
+const S390LatencyModel kZ196Model = {
+    4,   // load
+    5,   // float_load
+    6,   // multiply32
+    9,   // multiply64
+    26,  // divide32
+    42,  // divide64
+    5,   // count_bits
+    3,   // float_move
+    3,   // float_compare
+    8,   // float_add
+    8,   // float_multiply
+    21,  // float32_divide
+    31,  // float64_divide
+    25,  // float32_sqrt
+    37,  // float64_sqrt
+    8,   // float_round
+    9    // conversion
+};
+
+// z10 and earlier: in-order cores with slower multiply, divide and floating
+// point pipelines.
+const S390LatencyModel kZ10Model = {
+    4,   // load
+    6,   // float_load
+    8,   // multiply32
+    12,  // multiply64
+    32,  // divide32
+    56,  // divide64
+    7,   // count_bits
+    4,   // float_move
+    4,   // float_compare
+    10,  // float_add
+    10,  // float_multiply
+    27,  // float32_divide
+    40,  // float64_divide
+    32,  // float32_sqrt
+    48,  // float64_sqrt
+    10,  // float_round
+    12   // conversion
+};
+
+// The vector facility was introduced with the z13 and the distinct operands
+// facility with the z196, so they tell the machine generations apart.
+const S390LatencyModel& GetLatencyModel() {
+  if (CpuFeatures::IsSupported(VECTOR_FACILITY)) return kZ13Model;
+  return CpuFeatures::IsSupported(DISTINCT_OPS) ? kZ196Model : kZ10Model;
+}
+
+}  // namespace
+
+
 int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
-  // TODO(all): Add instruction cost modeling.
-  return 1;
+  const S390LatencyModel& model = GetLatencyModel();
+  switch (instr->arch_opcode()) {
+    case kCheckedLoadInt8:
+    case kCheckedLoadUint8:
+    case kCheckedLoadInt16:
+    case kCheckedLoadUint16:
+    case kCheckedLoadWord32:
+    case kCheckedLoadWord64:
+    case kS390_LoadWordS8:
+    case kS390_LoadWordU8:
+    case kS390_LoadWordS16:
+    case kS390_LoadWordU16:
+    case kS390_LoadWordS32:
+    case kS390_LoadWord64:
+      return model.load;
+
+    case kS390_And:
+    case kS390_Or:
+    case kS390_Xor:
+    case kS390_Add:
+    case kS390_Sub:
+    case kS390_Cmp32:
+    case kS390_Cmp64:
+    case kS390_Tst32:
+    case kS390_Tst64:
+      // The RX/RXY forms wait for their memory operand.
+      return instr->addressing_mode() == kMode_None ? 1 : model.load;
+
+    case kCheckedLoadFloat32:
+    case kCheckedLoadFloat64:
+    case kS390_LoadFloat32:
+    case kS390_LoadDouble:
+      return model.float_load;
+
+    case kS390_Mul32:
+    case kS390_MulHigh32:
+    case kS390_MulHighU32:
+      return model.multiply32;
+
+    case kS390_Mul64:
+      return model.multiply64;
+
+    case kS390_Div32:
+    case kS390_DivU32:
+    case kS390_Mod32:
+    case kS390_ModU32:
+      return model.divide32;
+
+    case kS390_Div64:
+    case kS390_DivU64:
+    case kS390_Mod64:
+    case kS390_ModU64:
+      return model.divide64;
+
+    case kS390_Cntlz32:
+    case kS390_Cntlz64:
+    case kS390_Popcnt32:
+    case kS390_Popcnt64:
+    case kS390_Ctz32:
+    case kS390_Ctz64:
+      return model.count_bits;
+
+    case kS390_ReverseBits32:
+    case kS390_ReverseBits64:
+      // A byte reversal followed by three dependent shift/mask/or rounds.
+      return 1 + 3 * 4;
+
+    case kS390_DoubleExtractLowWord32:
+    case kS390_DoubleExtractHighWord32:
+    case kS390_DoubleInsertLowWord32:
+    case kS390_DoubleInsertHighWord32:
+    case kS390_DoubleConstruct:
+    case kS390_BitcastInt32ToFloat32:
+    case kS390_BitcastFloat32ToInt32:
+    case kS390_BitcastInt64ToDouble:
+    case kS390_BitcastDoubleToInt64:
+    case kS390_AbsFloat:
+    case kS390_AbsDouble:
+    case kS390_NegDouble:
+      return model.float_move;
+
+    case kS390_CmpFloat:
+    case kS390_CmpDouble:
+      return model.float_compare;
+
+    case kS390_AddFloat:
+    case kS390_AddDouble:
+    case kS390_SubFloat:
+    case kS390_SubDouble:
+    case kS390_MaxDouble:
+    case kS390_MinDouble:
+      return model.float_add;
+
+    case kS390_MulFloat:
+    case kS390_MulDouble:
+      return model.float_multiply;
+
+    case kS390_DivFloat:
+      return model.float32_divide;
+
+    case kS390_DivDouble:
+    case kS390_ModDouble:
+      return model.float64_divide;
+
+    case kS390_SqrtFloat:
+      return model.float32_sqrt;
+
+    case kS390_SqrtDouble:
+      return model.float64_sqrt;
+
+    case kS390_FloorFloat:
+    case kS390_CeilFloat:
+    case kS390_TruncateFloat:
+    case kS390_RoundTiesEvenFloat:
+    case kS390_FloorDouble:
+    case kS390_CeilDouble:
+    case kS390_TruncateDouble:
+    case kS390_RoundDouble:
+    case kS390_RoundTiesEvenDouble:
+      return model.float_round;
+
+    case kArchTruncateDoubleToI:
+    case kS390_Int64ToFloat32:
+    case kS390_Int64ToDouble:
+    case kS390_Uint64ToFloat32:
+    case kS390_Uint64ToDouble:
+    case kS390_Int32ToFloat32:
+    case kS390_Int32ToDouble:
+    case kS390_Uint32ToFloat32:
+    case kS390_Uint32ToDouble:
+    case kS390_Float32ToInt32:
+    case kS390_Float32ToUint32:
+    case kS390_Float32ToUint64:
+    case kS390_Float32ToDouble:
+    case kS390_DoubleToInt32:
+    case kS390_DoubleToUint32:
+    case kS390_Float32ToInt64:
+    case kS390_DoubleToInt64:
+    case kS390_DoubleToUint64:
+    case kS390_DoubleToFloat32:
+      return model.conversion;
+
+    default:
+      return 1;
+  }
 }
 
 }  // namespace compiler
@@ -17,6 +17,7 @@ enum ImmediateMode {
   kInt16Imm_Unsigned,
   kInt16Imm_Negate,
   kInt16Imm_4ByteAligned,
+  kInt20Imm,
   kShift32Imm,
   kShift64Imm,
   kNoImmediate
@@ -57,6 +58,8 @@ class S390OperandGenerator final : public OperandGenerator {
         return is_int16(-value);
       case kInt16Imm_4ByteAligned:
         return is_int16(value) && !(value & 3);
+      case kInt20Imm:
+        return is_int20(value);
       case kShift32Imm:
         return 0 <= value && value < 32;
       case kShift64Imm:
@@ -66,6 +69,56 @@ class S390OperandGenerator final : public OperandGenerator {
     }
     return false;
   }
+
+  // Adds the inputs addressing [base + offset] for the memory access {node}
+  // and returns the addressing mode. A covered pointer-sized addition of a
+  // 20-bit displacement to either component is folded into an MRRI operand.
+  AddressingMode GenerateMemoryOperandInputs(Node* node, Node* base,
+                                             Node* offset,
+                                             InstructionOperand inputs[],
+                                             size_t* input_count) {
+    if (CanBeImmediate(offset, kInt20Imm)) {
+      inputs[(*input_count)++] = UseRegister(base);
+      inputs[(*input_count)++] = UseImmediate(offset);
+      return kMode_MRI;
+    }
+    if (CanBeImmediate(base, kInt20Imm)) {
+      inputs[(*input_count)++] = UseRegister(offset);
+      inputs[(*input_count)++] = UseImmediate(base);
+      return kMode_MRI;
+    }
+    if (MatchDisplacement(node, offset)) {
+      IntPtrBinopMatcher m(offset);
+      inputs[(*input_count)++] = UseRegister(base);
+      inputs[(*input_count)++] = UseRegister(m.left().node());
+      inputs[(*input_count)++] = UseImmediate(m.right().node());
+      return kMode_MRRI;
+    }
+    if (MatchDisplacement(node, base)) {
+      IntPtrBinopMatcher m(base);
+      inputs[(*input_count)++] = UseRegister(offset);
+      inputs[(*input_count)++] = UseRegister(m.left().node());
+      inputs[(*input_count)++] = UseImmediate(m.right().node());
+      return kMode_MRRI;
+    }
+    inputs[(*input_count)++] = UseRegister(base);
+    inputs[(*input_count)++] = UseRegister(offset);
+    return kMode_MRR;
+  }
+
+ private:
+  // Returns true if {input} is an addition of a register and a 20-bit
+  // displacement that the memory access {node} can absorb.
+  bool MatchDisplacement(Node* node, Node* input) {
+#if V8_TARGET_ARCH_S390X
+    if (input->opcode() != IrOpcode::kInt64Add) return false;
+#else
+    if (input->opcode() != IrOpcode::kInt32Add) return false;
+#endif
+    if (!selector()->CanCover(node, input)) return false;
+    IntPtrBinopMatcher m(input);
+    return m.right().HasValue() && is_int20(m.right().Value());
+  }
 };
 
 
@@ -157,6 +210,63 @@ void VisitBinop(InstructionSelector* selector, Node* node, ArchOpcode opcode,
   VisitBinop<Matcher>(selector, node, opcode, operand_mode, &cont);
 }
 
+
+// Returns true if {input} is a load that {node} can cover and whose value has
+// the width of the operation, so that it can be used as an RX/RXY operand.
+bool CanBeMemoryOperand(InstructionSelector* selector, Node* node, Node* input,
+                        bool is_64bit) {
+  if (input->opcode() != IrOpcode::kLoad || !selector->CanCover(node, input)) {
+    return false;
+  }
+  switch (LoadRepresentationOf(input->op()).representation()) {
+#if !V8_TARGET_ARCH_S390X
+    case MachineRepresentation::kTagged:  // Fall through.
+#endif
+    case MachineRepresentation::kWord32:
+      return !is_64bit;
+#if V8_TARGET_ARCH_S390X
+    case MachineRepresentation::kTagged:  // Fall through.
+    case MachineRepresentation::kWord64:
+      return is_64bit;
+#endif
+    default:
+      return false;
+  }
+}
+
+
+// Shared routine for binary operations with a register and a memory operand.
+// Returns false if neither input is a load that can be folded.
+bool TryVisitBinopWithMemoryOperand(InstructionSelector* selector, Node* node,
+                                    ArchOpcode opcode, bool is_64bit,
+                                    bool commutative) {
+  Node* left = node->InputAt(0);
+  Node* right = node->InputAt(1);
+  if (!CanBeMemoryOperand(selector, node, right, is_64bit)) {
+    if (!commutative || !CanBeMemoryOperand(selector, node, left, is_64bit)) {
+      return false;
+    }
+    std::swap(left, right);
+  }
+  // Constants are better matched as immediates of the register form.
+  if (left->opcode() == IrOpcode::kInt32Constant ||
+      left->opcode() == IrOpcode::kInt64Constant) {
+    return false;
+  }
+  S390OperandGenerator g(selector);
+  InstructionOperand inputs[4];
+  size_t input_count = 0;
+  inputs[input_count++] = g.UseRegister(left);
+  AddressingMode mode = g.GenerateMemoryOperandInputs(
+      right, right->InputAt(0), right->InputAt(1), inputs, &input_count);
+  InstructionCode code = opcode | AddressingModeField::encode(mode) |
+                         MiscField::encode(is_64bit ? kS390_MemoryOperand64
+                                                    : kS390_MemoryOperand32);
+  InstructionOperand outputs[] = {g.DefineSameAsFirst(node)};
+  selector->Emit(code, arraysize(outputs), outputs, input_count, inputs);
+  return true;
+}
+
 }  // namespace
 
 
@@ -166,7 +276,6 @@ void InstructionSelector::VisitLoad(Node* node) {
   Node* base = node->InputAt(0);
   Node* offset = node->InputAt(1);
   ArchOpcode opcode = kArchNop;
-  ImmediateMode mode = kInt16Imm;
   switch (load_rep.representation()) {
     case MachineRepresentation::kFloat32:
       opcode = kS390_LoadFloat32;
@@ -186,16 +295,11 @@ void InstructionSelector::VisitLoad(Node* node) {
 #endif
     case MachineRepresentation::kWord32:
       opcode = kS390_LoadWordS32;
-#if V8_TARGET_ARCH_S390X
-      // TODO(mbrandy): this applies to signed loads only (lwa)
-      mode = kInt16Imm_4ByteAligned;
-#endif
       break;
 #if V8_TARGET_ARCH_S390X
     case MachineRepresentation::kTagged:  // Fall through.
     case MachineRepresentation::kWord64:
       opcode = kS390_LoadWord64;
-      mode = kInt16Imm_4ByteAligned;
       break;
 #else
     case MachineRepresentation::kWord64:  // Fall through.
@@ -205,16 +309,13 @@ void InstructionSelector::VisitLoad(Node* node) {
       UNREACHABLE();
       return;
   }
-  if (g.CanBeImmediate(offset, mode)) {
-    Emit(opcode | AddressingModeField::encode(kMode_MRI),
-         g.DefineAsRegister(node), g.UseRegister(base), g.UseImmediate(offset));
-  } else if (g.CanBeImmediate(base, mode)) {
-    Emit(opcode | AddressingModeField::encode(kMode_MRI),
-         g.DefineAsRegister(node), g.UseRegister(offset), g.UseImmediate(base));
-  } else {
-    Emit(opcode | AddressingModeField::encode(kMode_MRR),
-         g.DefineAsRegister(node), g.UseRegister(base), g.UseRegister(offset));
-  }
+  InstructionOperand inputs[3];
+  size_t input_count = 0;
+  AddressingMode mode =
+      g.GenerateMemoryOperandInputs(node, base, offset, inputs, &input_count);
+  InstructionOperand outputs[] = {g.DefineAsRegister(node)};
+  Emit(opcode | AddressingModeField::encode(mode), arraysize(outputs), outputs,
+       input_count, inputs);
 }
 
 
@@ -273,7 +374,6 @@ void InstructionSelector::VisitStore(Node* node) {
     Emit(code, 0, nullptr, input_count, inputs, temp_count, temps);
   } else {
     ArchOpcode opcode = kArchNop;
-    ImmediateMode mode = kInt16Imm;
     switch (rep) {
       case MachineRepresentation::kFloat32:
         opcode = kS390_StoreFloat32;
@@ -298,7 +398,6 @@ void InstructionSelector::VisitStore(Node* node) {
       case MachineRepresentation::kTagged:  // Fall through.
       case MachineRepresentation::kWord64:
         opcode = kS390_StoreWord64;
-        mode = kInt16Imm_4ByteAligned;
         break;
 #else
       case MachineRepresentation::kWord64:  // Fall through.
@@ -308,16 +407,13 @@ void InstructionSelector::VisitStore(Node* node) {
         UNREACHABLE();
         return;
     }
-    if (g.CanBeImmediate(offset, mode)) {
-      Emit(opcode | AddressingModeField::encode(kMode_MRI), g.NoOutput(),
-           g.UseRegister(base), g.UseImmediate(offset), g.UseRegister(value));
-    } else if (g.CanBeImmediate(base, mode)) {
-      Emit(opcode | AddressingModeField::encode(kMode_MRI), g.NoOutput(),
-           g.UseRegister(offset), g.UseImmediate(base), g.UseRegister(value));
-    } else {
-      Emit(opcode | AddressingModeField::encode(kMode_MRR), g.NoOutput(),
-           g.UseRegister(base), g.UseRegister(offset), g.UseRegister(value));
-    }
+    InstructionOperand inputs[4];
+    size_t input_count = 0;
+    AddressingMode mode =
+        g.GenerateMemoryOperandInputs(node, base, offset, inputs, &input_count);
+    inputs[input_count++] = g.UseRegister(value);
+    Emit(opcode | AddressingModeField::encode(mode), 0, nullptr, input_count,
+         inputs);
   }
 }
 
@@ -519,6 +615,9 @@ void InstructionSelector::VisitWord32And(Node* node) {
       return;
     }
   }
+  if (TryVisitBinopWithMemoryOperand(this, node, kS390_And, false, true)) {
+    return;
+  }
   VisitLogical<Int32BinopMatcher>(
       this, node, &m, kS390_And, CanCover(node, m.left().node()),
       CanCover(node, m.right().node()), kInt16Imm_Unsigned);
@@ -576,6 +675,9 @@ void InstructionSelector::VisitWord64And(Node* node) {
       }
     }
   }
+  if (TryVisitBinopWithMemoryOperand(this, node, kS390_And, true, true)) {
+    return;
+  }
   VisitLogical<Int64BinopMatcher>(
       this, node, &m, kS390_And, CanCover(node, m.left().node()),
       CanCover(node, m.right().node()), kInt16Imm_Unsigned);
@@ -584,6 +686,9 @@ void InstructionSelector::VisitWord64And(Node* node) {
 
 
 void InstructionSelector::VisitWord32Or(Node* node) {
+  if (TryVisitBinopWithMemoryOperand(this, node, kS390_Or, false, true)) {
+    return;
+  }
   Int32BinopMatcher m(node);
   VisitLogical<Int32BinopMatcher>(
       this, node, &m, kS390_Or, CanCover(node, m.left().node()),
@@ -593,6 +698,9 @@ void InstructionSelector::VisitWord32Or(Node* node) {
 
 #if V8_TARGET_ARCH_S390X
 void InstructionSelector::VisitWord64Or(Node* node) {
+  if (TryVisitBinopWithMemoryOperand(this, node, kS390_Or, true, true)) {
+    return;
+  }
   Int64BinopMatcher m(node);
   VisitLogical<Int64BinopMatcher>(
       this, node, &m, kS390_Or, CanCover(node, m.left().node()),
@@ -606,7 +714,8 @@ void InstructionSelector::VisitWord32Xor(Node* node) {
   Int32BinopMatcher m(node);
   if (m.right().Is(-1)) {
     Emit(kS390_Not, g.DefineAsRegister(node), g.UseRegister(m.left().node()));
-  } else {
+  } else if (!TryVisitBinopWithMemoryOperand(this, node, kS390_Xor, false,
+                                             true)) {
     VisitBinop<Int32BinopMatcher>(this, node, kS390_Xor, kInt16Imm_Unsigned);
   }
 }
@@ -618,7 +727,8 @@ void InstructionSelector::VisitWord64Xor(Node* node) {
   Int64BinopMatcher m(node);
   if (m.right().Is(-1)) {
     Emit(kS390_Not, g.DefineAsRegister(node), g.UseRegister(m.left().node()));
-  } else {
+  } else if (!TryVisitBinopWithMemoryOperand(this, node, kS390_Xor, true,
+                                             true)) {
     VisitBinop<Int64BinopMatcher>(this, node, kS390_Xor, kInt16Imm_Unsigned);
   }
 }
@@ -837,29 +947,51 @@ void InstructionSelector::VisitWord64Popcnt(Node* node) {
 #endif
 
 
-void InstructionSelector::VisitWord32Ctz(Node* node) { UNREACHABLE(); }
+void InstructionSelector::VisitWord32Ctz(Node* node) {
+  S390OperandGenerator g(this);
+  Emit(kS390_Ctz32, g.DefineAsRegister(node),
+       g.UseRegister(node->InputAt(0)));
+}
 
 
 #if V8_TARGET_ARCH_S390X
-void InstructionSelector::VisitWord64Ctz(Node* node) { UNREACHABLE(); }
+void InstructionSelector::VisitWord64Ctz(Node* node) {
+  S390OperandGenerator g(this);
+  Emit(kS390_Ctz64, g.DefineAsRegister(node),
+       g.UseRegister(node->InputAt(0)));
+}
 #endif
 
 
-void InstructionSelector::VisitWord32ReverseBits(Node* node) { UNREACHABLE(); }
+void InstructionSelector::VisitWord32ReverseBits(Node* node) {
+  S390OperandGenerator g(this);
+  Emit(kS390_ReverseBits32, g.DefineAsRegister(node),
+       g.UseRegister(node->InputAt(0)));
+}
 
 
 #if V8_TARGET_ARCH_S390X
-void InstructionSelector::VisitWord64ReverseBits(Node* node) { UNREACHABLE(); }
+void InstructionSelector::VisitWord64ReverseBits(Node* node) {
+  S390OperandGenerator g(this);
+  Emit(kS390_ReverseBits64, g.DefineAsRegister(node),
+       g.UseRegister(node->InputAt(0)));
+}
 #endif
 
 
 void InstructionSelector::VisitInt32Add(Node* node) {
+  if (TryVisitBinopWithMemoryOperand(this, node, kS390_Add, false, true)) {
+    return;
+  }
   VisitBinop<Int32BinopMatcher>(this, node, kS390_Add, kInt16Imm);
 }
 
 
 #if V8_TARGET_ARCH_S390X
 void InstructionSelector::VisitInt64Add(Node* node) {
+  if (TryVisitBinopWithMemoryOperand(this, node, kS390_Add, true, true)) {
+    return;
+  }
   VisitBinop<Int64BinopMatcher>(this, node, kS390_Add, kInt16Imm);
 }
 #endif
@@ -870,7 +1002,8 @@ void InstructionSelector::VisitInt32Sub(Node* node) {
   Int32BinopMatcher m(node);
   if (m.left().Is(0)) {
     Emit(kS390_Neg, g.DefineAsRegister(node), g.UseRegister(m.right().node()));
-  } else {
+  } else if (!TryVisitBinopWithMemoryOperand(this, node, kS390_Sub, false,
+                                             false)) {
     VisitBinop<Int32BinopMatcher>(this, node, kS390_Sub, kInt16Imm_Negate);
   }
 }
@@ -882,7 +1015,8 @@ void InstructionSelector::VisitInt64Sub(Node* node) {
   Int64BinopMatcher m(node);
   if (m.left().Is(0)) {
     Emit(kS390_Neg, g.DefineAsRegister(node), g.UseRegister(m.right().node()));
-  } else {
+  } else if (!TryVisitBinopWithMemoryOperand(this, node, kS390_Sub, true,
+                                             false)) {
     VisitBinop<Int64BinopMatcher>(this, node, kS390_Sub, kInt16Imm_Negate);
   }
 }
@@ -1256,12 +1390,12 @@ void InstructionSelector::VisitFloat64RoundTiesAway(Node* node) {
 
 
 void InstructionSelector::VisitFloat32RoundTiesEven(Node* node) {
-  UNREACHABLE();
+  VisitRR(this, kS390_RoundTiesEvenFloat, node);
 }
 
 
 void InstructionSelector::VisitFloat64RoundTiesEven(Node* node) {
-  UNREACHABLE();
+  VisitRR(this, kS390_RoundTiesEvenDouble, node);
 }
 
 
@@ -1346,10 +1480,34 @@ void VisitCompare(InstructionSelector* selector, InstructionCode opcode,
 }
 
 
+// Shared routine for compares of a register against a folded load.
+void VisitCompareWithMemoryOperand(InstructionSelector* selector,
+                                   InstructionCode opcode, Node* left,
+                                   Node* load, FlagsContinuation* cont) {
+  S390OperandGenerator g(selector);
+  InstructionOperand inputs[6];
+  size_t input_count = 0;
+  inputs[input_count++] = g.UseRegister(left);
+  AddressingMode mode = g.GenerateMemoryOperandInputs(
+      load, load->InputAt(0), load->InputAt(1), inputs, &input_count);
+  opcode = cont->Encode(opcode | AddressingModeField::encode(mode));
+  if (cont->IsBranch()) {
+    inputs[input_count++] = g.Label(cont->true_block());
+    inputs[input_count++] = g.Label(cont->false_block());
+    selector->Emit(opcode, 0, nullptr, input_count, inputs);
+  } else {
+    DCHECK(cont->IsSet());
+    InstructionOperand output = g.DefineAsRegister(cont->result());
+    selector->Emit(opcode, 1, &output, input_count, inputs);
+  }
+}
+
+
 // Shared routine for multiple word compare operations.
 void VisitWordCompare(InstructionSelector* selector, Node* node,
                       InstructionCode opcode, FlagsContinuation* cont,
-                      bool commutative, ImmediateMode immediate_mode) {
+                      bool commutative, ImmediateMode immediate_mode,
+                      bool is_64bit) {
   S390OperandGenerator g(selector);
   Node* left = node->InputAt(0);
   Node* right = node->InputAt(1);
@@ -1362,6 +1520,11 @@ void VisitWordCompare(InstructionSelector* selector, Node* node,
     if (!commutative) cont->Commute();
     VisitCompare(selector, opcode, g.UseRegister(right), g.UseImmediate(left),
                  cont);
+  } else if (CanBeMemoryOperand(selector, node, right, is_64bit)) {
+    VisitCompareWithMemoryOperand(selector, opcode, left, right, cont);
+  } else if (CanBeMemoryOperand(selector, node, left, is_64bit)) {
+    if (!commutative) cont->Commute();
+    VisitCompareWithMemoryOperand(selector, opcode, right, left, cont);
   } else {
     VisitCompare(selector, opcode, g.UseRegister(left), g.UseRegister(right),
                  cont);
@@ -1372,7 +1535,7 @@ void VisitWordCompare(InstructionSelector* selector, Node* node,
 void VisitWord32Compare(InstructionSelector* selector, Node* node,
                         FlagsContinuation* cont) {
   ImmediateMode mode = (CompareLogical(cont) ? kInt16Imm_Unsigned : kInt16Imm);
-  VisitWordCompare(selector, node, kS390_Cmp32, cont, false, mode);
+  VisitWordCompare(selector, node, kS390_Cmp32, cont, false, mode, false);
 }
 
 
@@ -1380,7 +1543,7 @@ void VisitWord32Compare(InstructionSelector* selector, Node* node,
 void VisitWord64Compare(InstructionSelector* selector, Node* node,
                         FlagsContinuation* cont) {
   ImmediateMode mode = (CompareLogical(cont) ? kInt16Imm_Unsigned : kInt16Imm);
-  VisitWordCompare(selector, node, kS390_Cmp64, cont, false, mode);
+  VisitWordCompare(selector, node, kS390_Cmp64, cont, false, mode, true);
 }
 #endif
 
@@ -1516,7 +1679,7 @@ void VisitWordCompareZero(InstructionSelector* selector, Node* user,
       case IrOpcode::kWord32And:
         // TODO(mbandy): opportunity for rlwinm?
         return VisitWordCompare(selector, value, kS390_Tst32, cont, true,
-                                kInt16Imm_Unsigned);
+                                kInt16Imm_Unsigned, false);
 // TODO(mbrandy): Handle?
 // case IrOpcode::kInt32Add:
 // case IrOpcode::kWord32Or:
@@ -1531,7 +1694,7 @@ void VisitWordCompareZero(InstructionSelector* selector, Node* user,
       case IrOpcode::kWord64And:
         // TODO(mbandy): opportunity for rldic?
         return VisitWordCompare(selector, value, kS390_Tst64, cont, true,
-                                kInt16Imm_Unsigned);
+                                kInt16Imm_Unsigned, true);
 // TODO(mbrandy): Handle?
 // case IrOpcode::kInt64Add:
 // case IrOpcode::kWord64Or:
@@ -1810,8 +1973,14 @@ InstructionSelector::SupportedMachineOperatorFlags() {
          MachineOperatorBuilder::kFloat32RoundTruncate |
          MachineOperatorBuilder::kFloat64RoundTruncate |
          MachineOperatorBuilder::kFloat64RoundTiesAway |
+         MachineOperatorBuilder::kFloat32RoundTiesEven |
+         MachineOperatorBuilder::kFloat64RoundTiesEven |
+         MachineOperatorBuilder::kWord32Ctz |
+         MachineOperatorBuilder::kWord64Ctz |
          MachineOperatorBuilder::kWord32Popcnt |
-         MachineOperatorBuilder::kWord64Popcnt;
+         MachineOperatorBuilder::kWord64Popcnt |
+         MachineOperatorBuilder::kWord32ReverseBits |
+         MachineOperatorBuilder::kWord64ReverseBits;
   // We omit kWord32ShiftIsSafe as s[rl]w use 0x3f as a mask rather than 0x1f.
 }
 
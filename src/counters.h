@@ -567,6 +567,10 @@ double AggregatedMemoryHistogram<Histogram>::Aggregate(double current_ms,
   SC(global_handles, V8.GlobalHandles)                                \
   /* OS Memory allocated */                                           \
   SC(memory_allocated, V8.OsMemoryAllocated)                          \
+  /* Zone segment pool statistics, updated after each GC. */          \
+  SC(zone_segments_requested, V8.ZoneSegmentsRequested)               \
+  SC(zone_segments_reused, V8.ZoneSegmentsReused)                     \
+  SC(zone_segment_pool_bytes, V8.ZoneSegmentPoolBytes)                \
   SC(maps_normalized, V8.MapsNormalized)                            \
   SC(maps_created, V8.MapsCreated)                                  \
   SC(elements_transitions, V8.ObjectElementsTransitions)            \
@@ -698,6 +702,11 @@ double AggregatedMemoryHistogram<Histogram>::Aggregate(double current_ms,
   SC(crankshaft_escape_allocs_replaced, V8.CrankshaftEscapeAllocsReplaced)     \
   SC(turbo_escape_loads_replaced, V8.TurboEscapeLoadsReplaced)                 \
   SC(crankshaft_escape_loads_replaced, V8.CrankshaftEscapeLoadsReplaced)       \
+  /* Pretenured literals allocated in Crankshaft code, and old space */        \
+  /* allocations of any generated code that took the runtime path. */          \
+  SC(pretenured_allocations_native, V8.PretenuredAllocationsNative)            \
+  SC(pretenured_allocations_runtime, V8.PretenuredAllocationsRuntime)          \
+  SC(pretenuring_lab_refills, V8.PretenuringLabRefills)                        \
   /* Total code size (including metadata) of baseline code or bytecode. */     \
   SC(total_baseline_code_size, V8.TotalBaselineCodeSize)                       \
   /* Total count of functions compiled using the baseline compiler. */         \
@@ -11803,6 +11803,9 @@ HInstruction* HOptimizedGraphBuilder::BuildFastLiteral(
   if (FLAG_allocation_site_pretenuring) {
     pretenure_flag = top_site->GetPretenureMode();
   }
+  if (pretenure_flag == TENURED) {
+    AddIncrementCounter(isolate()->counters()->pretenured_allocations_native());
+  }
 
   Handle<AllocationSite> current_site(*site_context->current(), isolate());
   if (*top_site == *current_site) {
@@ -277,6 +277,9 @@ DEFINE_BOOL(compiled_keyed_generic_loads, false,
             "use optimizing compiler to generate keyed generic load stubs")
 DEFINE_BOOL(allocation_site_pretenuring, true,
             "pretenure with allocation sites")
+DEFINE_BOOL(pretenuring_lab, true,
+            "refill the old space linear allocation area with a large buffer "
+            "on the slow path of inline pretenured allocation")
 DEFINE_BOOL(trace_pretenuring, false,
             "trace pretenuring decisions of HAllocate instructions")
 DEFINE_BOOL(trace_pretenuring_statistics, false,
@@ -601,6 +604,10 @@ DEFINE_INT(min_preparse_length, 1024,
 DEFINE_INT(max_opt_count, 10,
            "maximum number of optimization attempts before giving up.")
 
+// zone.cc
+DEFINE_INT(zone_segment_pool_size, 8,
+           "maximum size of freed zone segments kept for reuse (in Mbytes)")
+
 // compilation-cache.cc
 DEFINE_BOOL(compilation_cache, true, "enable compilation cache")
 
@@ -653,6 +660,11 @@ DEFINE_BOOL(experimental_new_space_growth_heuristic, false,
 DEFINE_INT(max_old_space_size, 0, "max size of the old space (in Mbytes)")
 DEFINE_INT(initial_old_space_size, 0, "initial old space size (in Mbytes)")
 DEFINE_INT(max_executable_size, 0, "max size of executable memory (in Mbytes)")
+DEFINE_INT(memory_budget, 0,
+           "memory budget of the process (in Mbytes) the heap size adapts to")
+DEFINE_BOOL(memory_budget_from_cgroup, false,
+            "use the memory limit of the cgroup of the process as memory "
+            "budget")
 DEFINE_BOOL(gc_global, false, "always perform global GCs")
 DEFINE_INT(gc_interval, -1, "garbage collect after <n> allocations")
 DEFINE_INT(retain_maps_for_n_gc, 2,
@@ -698,7 +710,23 @@ DEFINE_INT(min_progress_during_incremental_marking_finalization, 32,
 DEFINE_INT(max_incremental_marking_finalization_rounds, 3,
            "at most try this many times to finalize incremental marking")
 DEFINE_BOOL(concurrent_sweeping, true, "use concurrent sweeping")
+DEFINE_BOOL(concurrent_array_buffer_freeing, true,
+            "free array buffer backing stores on a background thread")
+DEFINE_BOOL(concurrent_marking, false,
+            "use a background thread for incremental marking (experimental, "
+            "x64 only)")
+DEFINE_NEG_IMPLICATION(concurrent_marking, unbox_double_fields)
+DEFINE_BOOL(parallel_marking, false,
+            "use parallel marking in the atomic pause of mark-compact")
+DEFINE_BOOL(parallel_scavenge, false, "use parallel scavenge")
+DEFINE_BOOL(young_large_objects, false,
+            "allocate large objects in a young large object space that is "
+            "promoted or freed by scavenges")
+DEFINE_BOOL(parallel_global_handles, true,
+            "identify weak global handles in parallel")
 DEFINE_BOOL(parallel_compaction, true, "use parallel compaction")
+DEFINE_BOOL(parallel_pointer_update, true,
+            "use parallel pointer update during compaction")
 DEFINE_BOOL(trace_incremental_marking, false,
             "trace progress of the incremental marking")
 DEFINE_BOOL(track_gc_object_stats, false,
@@ -706,6 +734,9 @@ DEFINE_BOOL(track_gc_object_stats, false,
 DEFINE_BOOL(trace_gc_object_stats, false,
             "trace object counts and memory usage")
 DEFINE_IMPLICATION(trace_gc_object_stats, track_gc_object_stats)
+DEFINE_INT(gc_object_stats_sampling_rate, 0,
+           "track object counts and memory usage on one in n pages "
+           "(0 disables, --track-gc-object-stats tracks all pages)")
 DEFINE_BOOL(track_detached_contexts, true,
             "track native contexts that are expected to be garbage collected")
 DEFINE_BOOL(trace_detached_contexts, false,
@@ -716,6 +747,9 @@ DEFINE_BOOL(verify_heap, false, "verify heap pointers before and after GC")
 #endif
 DEFINE_BOOL(move_object_start, true, "enable moving of object starts")
 DEFINE_BOOL(memory_reducer, true, "use memory reducer")
+DEFINE_BOOL(huge_pages, false,
+            "place heap pages and the code range in huge page aligned "
+            "regions and advise the OS to back them with huge pages")
 DEFINE_BOOL(scavenge_reclaim_unmodified_objects, false,
             "remove unmodified and unreferenced objects")
 DEFINE_INT(heap_growing_percent, 0,
@@ -729,6 +763,13 @@ DEFINE_INT(histogram_interval, 600000,
 // heap-snapshot-generator.cc
 DEFINE_BOOL(heap_profiler_trace_objects, false,
             "Dump heap object allocations/movements/size_updates")
+DEFINE_BOOL(parallel_heap_snapshot_serialization, true,
+            "format heap snapshot nodes and edges on background threads")
+DEFINE_BOOL(parallel_heap_snapshot_extraction, true,
+            "extract heap snapshot references on background threads")
+DEFINE_BOOL(heap_snapshot_counts_trailer, false,
+            "write heap snapshot node and edge counts after the strings "
+            "instead of in the snapshot header")
 
 
 // sampling-heap-profiler.cc
@@ -752,6 +793,11 @@ DEFINE_BOOL(always_compact, false, "Perform compaction on every full GC")
 DEFINE_BOOL(never_compact, false,
             "Never perform compaction on full GC - testing only")
 DEFINE_BOOL(compact_code_space, true, "Compact code space on full collections")
+DEFINE_BOOL(hot_code_layout, false,
+            "pack hot code onto separate pages when compacting code space")
+DEFINE_IMPLICATION(hot_code_layout, compact_code_space)
+DEFINE_BOOL(trace_hot_code_layout, false,
+            "trace the code working set before and after hot code layout")
 DEFINE_BOOL(cleanup_code_caches_at_gc, true,
             "Flush inline caches prior to mark compact collection and "
             "flush code caches in maps during mark compact cycle.")
@@ -862,7 +908,13 @@ DEFINE_BOOL(predictable, false, "enable predictable mode")
 DEFINE_NEG_IMPLICATION(predictable, concurrent_recompilation)
 DEFINE_NEG_IMPLICATION(predictable, concurrent_osr)
 DEFINE_NEG_IMPLICATION(predictable, concurrent_sweeping)
+DEFINE_NEG_IMPLICATION(predictable, concurrent_array_buffer_freeing)
+DEFINE_NEG_IMPLICATION(predictable, concurrent_marking)
 DEFINE_NEG_IMPLICATION(predictable, parallel_compaction)
+DEFINE_NEG_IMPLICATION(predictable, parallel_marking)
+DEFINE_NEG_IMPLICATION(predictable, parallel_pointer_update)
+DEFINE_NEG_IMPLICATION(predictable, parallel_scavenge)
+DEFINE_NEG_IMPLICATION(predictable, parallel_global_handles)
 DEFINE_NEG_IMPLICATION(predictable, memory_reducer)
 
 // mark-compact.cc
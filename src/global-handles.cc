@@ -5,6 +5,9 @@
 #include "src/global-handles.h"
 
 #include "src/api.h"
+#include "src/cancelable-task.h"
+#include "src/heap/gc-tracer.h"
+#include "src/parallel-job.h"
 #include "src/v8.h"
 #include "src/vm-state-inl.h"
 
@@ -522,32 +525,100 @@ class GlobalHandles::NodeIterator {
   DISALLOW_COPY_AND_ASSIGN(NodeIterator);
 };
 
+// Applies a callback to the nodes of the used node blocks, one block per item.
+template <typename Callback>
+class GlobalHandles::UsedNodesJob : public ItemParallelJob {
+ public:
+  UsedNodesJob(Isolate* isolate, const List<NodeBlock*>& blocks,
+               Callback callback)
+      : ItemParallelJob(isolate), blocks_(blocks), callback_(callback) {}
+
+  int NumberOfItems() override { return blocks_.length(); }
+
+ protected:
+  void ProcessItem(int item) override {
+    NodeBlock* block = blocks_[item];
+    for (int i = 0; i < NodeBlock::kSize; i++) {
+      callback_(block->node_at(i));
+    }
+  }
+
+ private:
+  const List<NodeBlock*>& blocks_;
+  Callback callback_;
+};
+
+
+// Applies a callback to the nodes in new_space_nodes_, NodeBlock::kSize nodes
+// per item.
+template <typename Callback>
+class GlobalHandles::NewSpaceNodesJob : public ItemParallelJob {
+ public:
+  NewSpaceNodesJob(Isolate* isolate, const List<Node*>& nodes,
+                   Callback callback)
+      : ItemParallelJob(isolate), nodes_(nodes), callback_(callback) {}
+
+  int NumberOfItems() override {
+    return (nodes_.length() + NodeBlock::kSize - 1) / NodeBlock::kSize;
+  }
+
+ protected:
+  void ProcessItem(int item) override {
+    int start = item * NodeBlock::kSize;
+    int end = Min(start + NodeBlock::kSize, nodes_.length());
+    for (int i = start; i < end; i++) {
+      callback_(nodes_[i]);
+    }
+  }
+
+ private:
+  const List<Node*>& nodes_;
+  Callback callback_;
+};
+
+
 class GlobalHandles::PendingPhantomCallbacksSecondPassTask
     : public v8::internal::CancelableTask {
  public:
-  // Takes ownership of the contents of pending_phantom_callbacks, leaving it in
-  // the same state it would be after a call to Clear().
-  PendingPhantomCallbacksSecondPassTask(
-      List<PendingPhantomCallback>* pending_phantom_callbacks, Isolate* isolate)
-      : CancelableTask(isolate) {
-    pending_phantom_callbacks_.Swap(pending_phantom_callbacks);
-  }
+  PendingPhantomCallbacksSecondPassTask(Isolate* isolate,
+                                        GlobalHandles* global_handles)
+      : CancelableTask(isolate), global_handles_(global_handles) {}
 
   void RunInternal() override {
-    isolate()->heap()->CallGCPrologueCallbacks(
-        GCType::kGCTypeProcessWeakCallbacks, kNoGCCallbackFlags);
-    InvokeSecondPassPhantomCallbacks(&pending_phantom_callbacks_, isolate());
-    isolate()->heap()->CallGCEpilogueCallbacks(
-        GCType::kGCTypeProcessWeakCallbacks, kNoGCCallbackFlags);
+    double deadline_in_ms =
+        isolate()->heap()->MonotonicallyIncreasingTimeInMs() +
+        kSecondPassCallbacksBudgetInMs;
+    global_handles_->InvokeQueuedSecondPassPhantomCallbacks(deadline_in_ms);
   }
 
  private:
-  List<PendingPhantomCallback> pending_phantom_callbacks_;
+  GlobalHandles* global_handles_;
 
   DISALLOW_COPY_AND_ASSIGN(PendingPhantomCallbacksSecondPassTask);
 };
 
 
+class GlobalHandles::PendingPhantomCallbacksSecondPassIdleTask
+    : public v8::internal::CancelableIdleTask {
+ public:
+  PendingPhantomCallbacksSecondPassIdleTask(Isolate* isolate,
+                                            GlobalHandles* global_handles)
+      : CancelableIdleTask(isolate), global_handles_(global_handles) {}
+
+  void RunInternal(double deadline_in_seconds) override {
+    double deadline_in_ms =
+        deadline_in_seconds *
+        static_cast<double>(base::Time::kMillisecondsPerSecond);
+    global_handles_->InvokeQueuedSecondPassPhantomCallbacks(deadline_in_ms);
+  }
+
+ private:
+  GlobalHandles* global_handles_;
+
+  DISALLOW_COPY_AND_ASSIGN(PendingPhantomCallbacksSecondPassIdleTask);
+};
+
+
 GlobalHandles::GlobalHandles(Isolate* isolate)
     : isolate_(isolate),
       number_of_global_handles_(0),
@@ -555,7 +626,8 @@ GlobalHandles::GlobalHandles(Isolate* isolate)
       first_used_block_(NULL),
       first_free_(NULL),
       post_gc_processing_count_(0),
-      object_group_connections_(kObjectGroupConnectionsCapacity) {}
+      object_group_connections_(kObjectGroupConnectionsCapacity),
+      second_pass_task_posted_(false) {}
 
 
 GlobalHandles::~GlobalHandles() {
@@ -645,6 +717,49 @@ bool GlobalHandles::IsWeak(Object** location) {
 }
 
 
+void GlobalHandles::RunInParallel(ItemParallelJob* job) {
+  // The main thread takes part in processing the items.
+  const int kMaxTasks = 4;
+  job->Run(Min(ParallelJob::NumberOfTasks(kMaxTasks), job->NumberOfItems()));
+}
+
+
+template <typename Callback>
+void GlobalHandles::ForEachUsedNode(Callback callback) {
+  List<NodeBlock*> blocks;
+  for (NodeBlock* block = first_used_block_; block != NULL;
+       block = block->next_used()) {
+    blocks.Add(block);
+  }
+  if (FLAG_parallel_global_handles &&
+      blocks.length() >= kMinBlocksForParallelProcessing) {
+    UsedNodesJob<Callback> job(isolate_, blocks, callback);
+    RunInParallel(&job);
+    return;
+  }
+  for (int i = 0; i < blocks.length(); i++) {
+    for (int j = 0; j < NodeBlock::kSize; j++) {
+      callback(blocks[i]->node_at(j));
+    }
+  }
+}
+
+
+template <typename Callback>
+void GlobalHandles::ForEachNewSpaceNode(Callback callback) {
+  if (FLAG_parallel_global_handles &&
+      new_space_nodes_.length() >=
+          kMinBlocksForParallelProcessing * NodeBlock::kSize) {
+    NewSpaceNodesJob<Callback> job(isolate_, new_space_nodes_, callback);
+    RunInParallel(&job);
+    return;
+  }
+  for (int i = 0; i < new_space_nodes_.length(); ++i) {
+    callback(new_space_nodes_[i]);
+  }
+}
+
+
 void GlobalHandles::IterateWeakRoots(ObjectVisitor* v) {
   for (NodeIterator it(this); !it.done(); it.Advance()) {
     Node* node = it.node();
@@ -663,11 +778,11 @@ void GlobalHandles::IterateWeakRoots(ObjectVisitor* v) {
 
 
 void GlobalHandles::IdentifyWeakHandles(WeakSlotCallback f) {
-  for (NodeIterator it(this); !it.done(); it.Advance()) {
-    if (it.node()->IsWeak() && f(it.node()->location())) {
-      it.node()->MarkPending();
+  ForEachUsedNode([f](Node* node) {
+    if (node->IsWeak() && f(node->location())) {
+      node->MarkPending();
     }
-  }
+  });
 }
 
 
@@ -693,14 +808,14 @@ void GlobalHandles::IterateNewSpaceStrongAndDependentRoots(ObjectVisitor* v) {
 
 void GlobalHandles::IdentifyNewSpaceWeakIndependentHandles(
     WeakSlotCallbackWithHeap f) {
-  for (int i = 0; i < new_space_nodes_.length(); ++i) {
-    Node* node = new_space_nodes_[i];
+  Heap* heap = isolate_->heap();
+  ForEachNewSpaceNode([heap, f](Node* node) {
     DCHECK(node->is_in_new_space_list());
     if ((node->is_independent() || node->is_partially_dependent()) &&
-        node->IsWeak() && f(isolate_->heap(), node->location())) {
+        node->IsWeak() && f(heap, node->location())) {
       node->MarkPending();
     }
-  }
+  });
 }
 
 
@@ -725,25 +840,24 @@ void GlobalHandles::IterateNewSpaceWeakIndependentRoots(ObjectVisitor* v) {
 
 void GlobalHandles::IdentifyWeakUnmodifiedObjects(
     WeakSlotCallback is_unmodified) {
-  for (int i = 0; i < new_space_nodes_.length(); ++i) {
-    Node* node = new_space_nodes_[i];
+  ForEachNewSpaceNode([is_unmodified](Node* node) {
     if (node->IsWeak() && !is_unmodified(node->location())) {
       node->set_active(true);
     }
-  }
+  });
 }
 
 
 void GlobalHandles::MarkNewSpaceWeakUnmodifiedObjectsPending(
     WeakSlotCallbackWithHeap is_unscavenged) {
-  for (int i = 0; i < new_space_nodes_.length(); ++i) {
-    Node* node = new_space_nodes_[i];
+  Heap* heap = isolate_->heap();
+  ForEachNewSpaceNode([heap, is_unscavenged](Node* node) {
     DCHECK(node->is_in_new_space_list());
     if ((node->is_independent() || !node->is_active()) && node->IsWeak() &&
-        is_unscavenged(isolate_->heap(), node->location())) {
+        is_unscavenged(heap, node->location())) {
       node->MarkPending();
     }
-  }
+  });
 }
 
 
@@ -936,24 +1050,80 @@ int GlobalHandles::DispatchPendingPhantomCallbacks(
     }
   }
   pending_phantom_callbacks_.Clear();
-  if (second_pass_callbacks.length() > 0) {
-    if (FLAG_optimize_for_size || FLAG_predictable || synchronous_second_pass) {
+  // The queue is bounded, since nothing but the task drains it and the task
+  // may never get to run, e.g. if the embedder does not have idle time.
+  bool queue_full = second_pass_callbacks_.length() +
+                        second_pass_callbacks.length() >
+                    kMaxQueuedSecondPassCallbacks;
+  if (FLAG_optimize_for_size || FLAG_predictable || synchronous_second_pass ||
+      queue_full) {
+    // Callbacks still queued from previous garbage collections are flushed as
+    // well, so that they all ran when a forced GC returns.
+    second_pass_callbacks.AddAll(second_pass_callbacks_);
+    second_pass_callbacks_.Clear();
+    if (second_pass_callbacks.length() > 0) {
       isolate()->heap()->CallGCPrologueCallbacks(
           GCType::kGCTypeProcessWeakCallbacks, kNoGCCallbackFlags);
       InvokeSecondPassPhantomCallbacks(&second_pass_callbacks, isolate());
       isolate()->heap()->CallGCEpilogueCallbacks(
           GCType::kGCTypeProcessWeakCallbacks, kNoGCCallbackFlags);
-    } else {
-      auto task = new PendingPhantomCallbacksSecondPassTask(
-          &second_pass_callbacks, isolate());
-      V8::GetCurrentPlatform()->CallOnForegroundThread(
-          reinterpret_cast<v8::Isolate*>(isolate()), task);
     }
+  } else if (second_pass_callbacks.length() > 0) {
+    second_pass_callbacks_.AddAll(second_pass_callbacks);
+    PostSecondPassPhantomCallbacksTask();
   }
   return freed_nodes;
 }
 
 
+void GlobalHandles::PostSecondPassPhantomCallbacksTask() {
+  if (second_pass_task_posted_) return;
+  second_pass_task_posted_ = true;
+  v8::Isolate* isolate = reinterpret_cast<v8::Isolate*>(isolate_);
+  if (V8::GetCurrentPlatform()->IdleTasksEnabled(isolate)) {
+    auto task = new PendingPhantomCallbacksSecondPassIdleTask(isolate_, this);
+    V8::GetCurrentPlatform()->CallIdleOnForegroundThread(isolate, task);
+  } else {
+    auto task = new PendingPhantomCallbacksSecondPassTask(isolate_, this);
+    V8::GetCurrentPlatform()->CallOnForegroundThread(isolate, task);
+  }
+}
+
+
+void GlobalHandles::InvokeQueuedSecondPassPhantomCallbacks(
+    double deadline_in_ms) {
+  // Checking the time for every callback would dominate the cost of cheap
+  // callbacks.
+  const int kCallbacksPerTimeCheck = 16;
+  second_pass_task_posted_ = false;
+  if (second_pass_callbacks_.is_empty()) return;
+  Heap* heap = isolate()->heap();
+  double start_ms = heap->MonotonicallyIncreasingTimeInMs();
+  double now_ms = start_ms;
+  int invoked = 0;
+  heap->CallGCPrologueCallbacks(GCType::kGCTypeProcessWeakCallbacks,
+                                kNoGCCallbackFlags);
+  // The callbacks may trigger garbage collections which add to or flush the
+  // queue, so it is only accessed through RemoveLast.
+  while (!second_pass_callbacks_.is_empty()) {
+    auto callback = second_pass_callbacks_.RemoveLast();
+    DCHECK(callback.node() == nullptr);
+    callback.Invoke(isolate());
+    if (++invoked % kCallbacksPerTimeCheck == 0) {
+      now_ms = heap->MonotonicallyIncreasingTimeInMs();
+      if (now_ms >= deadline_in_ms) break;
+    }
+  }
+  heap->CallGCEpilogueCallbacks(GCType::kGCTypeProcessWeakCallbacks,
+                                kNoGCCallbackFlags);
+  now_ms = heap->MonotonicallyIncreasingTimeInMs();
+  heap->tracer()->AddSecondPassPhantomCallbacks(now_ms - start_ms, invoked);
+  if (!second_pass_callbacks_.is_empty()) {
+    PostSecondPassPhantomCallbacksTask();
+  }
+}
+
+
 void GlobalHandles::PendingPhantomCallback::Invoke(Isolate* isolate) {
   Data::Callback* callback_addr = nullptr;
   if (node_ != nullptr) {
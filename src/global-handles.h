@@ -16,6 +16,7 @@ namespace v8 {
 namespace internal {
 
 class HeapStats;
+class ItemParallelJob;
 class ObjectVisitor;
 
 // Structure for tracking global handles.
@@ -179,6 +180,11 @@ class GlobalHandles {
   // Tells whether global handle is weak.
   static bool IsWeak(Object** location);
 
+  // Second pass phantom callbacks are left to tasks until more than this many
+  // are queued. Then they are invoked right away, so that embedders that do
+  // not run idle tasks do not keep the memory of dead objects alive.
+  static const int kMaxQueuedSecondPassCallbacks = 8192;
+
   // Process pending weak handles.
   // Returns the number of freed nodes.
   int PostGarbageCollectionProcessing(
@@ -307,6 +313,13 @@ class GlobalHandles {
 
   class PendingPhantomCallback;
 
+  // Node sets of at least this many blocks are identified in parallel.
+  static const int kMinBlocksForParallelProcessing = 8;
+
+  // Time budget of a foreground task invoking second pass phantom callbacks
+  // when the platform does not provide idle tasks.
+  static const int kSecondPassCallbacksBudgetInMs = 2;
+
   // Helpers for PostGarbageCollectionProcessing.
   static void InvokeSecondPassPhantomCallbacks(
       List<PendingPhantomCallback>* callbacks, Isolate* isolate);
@@ -315,11 +328,31 @@ class GlobalHandles {
   int DispatchPendingPhantomCallbacks(bool synchronous_second_pass);
   void UpdateListOfNewSpaceNodes();
 
+  // Invokes queued second pass phantom callbacks until the deadline is
+  // reached. Posts another task if callbacks are left.
+  void InvokeQueuedSecondPassPhantomCallbacks(double deadline_in_ms);
+  void PostSecondPassPhantomCallbacksTask();
+
+  // Apply the callback to all used nodes or to all nodes in new_space_nodes_.
+  // Large sets of nodes are split up among background tasks, so the callback
+  // must not touch anything but the node it is given.
+  template <typename Callback>
+  void ForEachUsedNode(Callback callback);
+  template <typename Callback>
+  void ForEachNewSpaceNode(Callback callback);
+
   // Internal node structures.
   class Node;
   class NodeBlock;
   class NodeIterator;
+  template <typename Callback>
+  class UsedNodesJob;
+  template <typename Callback>
+  class NewSpaceNodesJob;
   class PendingPhantomCallbacksSecondPassTask;
+  class PendingPhantomCallbacksSecondPassIdleTask;
+
+  void RunInParallel(ItemParallelJob* job);
 
   Isolate* isolate_;
 
@@ -354,6 +387,10 @@ class GlobalHandles {
 
   List<PendingPhantomCallback> pending_phantom_callbacks_;
 
+  // Second pass phantom callbacks waiting to be invoked by a task.
+  List<PendingPhantomCallback> second_pass_callbacks_;
+  bool second_pass_task_posted_;
+
   friend class Isolate;
 
   DISALLOW_COPY_AND_ASSIGN(GlobalHandles);
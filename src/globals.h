@@ -723,7 +723,6 @@ enum CpuFeature {
   MIPSr2,
   MIPSr6,
   // ARM64
-  ALWAYS_ALIGN_CSP,
   COHERENT_CACHE,
   // PPC
   FPR_GPR_MOV,
@@ -733,6 +732,7 @@ enum CpuFeature {
   DISTINCT_OPS,
   GENERAL_INSTR_EXT,
   FLOATING_POINT_EXT,
+  VECTOR_FACILITY,
   NUMBER_OF_CPU_FEATURES
 };
 
@@ -3,7 +3,10 @@
 // found in the LICENSE file.
 
 #include "src/heap/array-buffer-tracker.h"
+#include "src/cancelable-task.h"
 #include "src/heap/heap.h"
+#include "src/heap/mark-compact.h"
+#include "src/heap/spaces-inl.h"
 #include "src/isolate.h"
 #include "src/objects.h"
 #include "src/objects-inl.h"
@@ -12,26 +15,41 @@
 namespace v8 {
 namespace internal {
 
-ArrayBufferTracker::~ArrayBufferTracker() {
-  Isolate* isolate = heap()->isolate();
-  size_t freed_memory = 0;
-  for (auto& buffer : live_array_buffers_) {
-    isolate->array_buffer_allocator()->Free(buffer.first, buffer.second);
-    freed_memory += buffer.second;
-  }
-  for (auto& buffer : live_array_buffers_for_scavenge_) {
-    isolate->array_buffer_allocator()->Free(buffer.first, buffer.second);
-    freed_memory += buffer.second;
-  }
-  live_array_buffers_.clear();
-  live_array_buffers_for_scavenge_.clear();
-  not_yet_discovered_array_buffers_.clear();
-  not_yet_discovered_array_buffers_for_scavenge_.clear();
+LocalArrayBufferTracker::BackingStore LocalArrayBufferTracker::Remove(
+    JSArrayBuffer* buffer) {
+  TrackingMap::iterator it = array_buffers_.find(buffer);
+  DCHECK(it != array_buffers_.end());
+  BackingStore backing_store = it->second;
+  array_buffers_.erase(it);
+  return backing_store;
+}
 
-  if (freed_memory > 0) {
-    heap()->update_amount_of_external_allocated_memory(
-        -static_cast<int64_t>(freed_memory));
-  }
+
+class ArrayBufferTracker::FreeingTask : public CancelableTask {
+ public:
+  FreeingTask(Isolate* isolate, ArrayBufferTracker* tracker)
+      : CancelableTask(isolate), tracker_(tracker) {}
+
+  virtual ~FreeingTask() {}
+
+ private:
+  // v8::internal::CancelableTask overrides.
+  void RunInternal() override { tracker_->FreeQueued(); }
+
+  ArrayBufferTracker* tracker_;
+
+  DISALLOW_COPY_AND_ASSIGN(FreeingTask);
+};
+
+
+ArrayBufferTracker::ArrayBufferTracker(Heap* heap)
+    : heap_(heap), task_running_(false), task_id_(0) {}
+
+
+ArrayBufferTracker::~ArrayBufferTracker() {
+  DCHECK(!task_running_);
+  DCHECK(dead_.empty());
+  DCHECK(queued_.empty());
 }
 
 
@@ -39,13 +57,11 @@ void ArrayBufferTracker::RegisterNew(JSArrayBuffer* buffer) {
   void* data = buffer->backing_store();
   if (!data) return;
 
-  bool in_new_space = heap()->InNewSpace(buffer);
   size_t length = NumberToSize(heap()->isolate(), buffer->byte_length());
-  if (in_new_space) {
-    live_array_buffers_for_scavenge_[data] = length;
-  } else {
-    live_array_buffers_[data] = length;
-  }
+  MemoryChunk* chunk = MemoryChunk::FromAddress(buffer->address());
+  LocalArrayBufferTracker* tracker = chunk->local_tracker();
+  if (tracker == nullptr) tracker = chunk->AllocateLocalTracker();
+  tracker->Add(buffer, LocalArrayBufferTracker::BackingStore(data, length));
 
   // We may go over the limit of externally allocated memory here. We call the
   // api function to trigger a GC in this case.
@@ -58,83 +74,188 @@ void ArrayBufferTracker::Unregister(JSArrayBuffer* buffer) {
   void* data = buffer->backing_store();
   if (!data) return;
 
-  bool in_new_space = heap()->InNewSpace(buffer);
-  std::map<void*, size_t>* live_buffers =
-      in_new_space ? &live_array_buffers_for_scavenge_ : &live_array_buffers_;
-  std::map<void*, size_t>* not_yet_discovered_buffers =
-      in_new_space ? &not_yet_discovered_array_buffers_for_scavenge_
-                   : &not_yet_discovered_array_buffers_;
-
-  DCHECK(live_buffers->count(data) > 0);
-
-  size_t length = (*live_buffers)[data];
-  live_buffers->erase(data);
-  not_yet_discovered_buffers->erase(data);
+  MemoryChunk* chunk = MemoryChunk::FromAddress(buffer->address());
+  LocalArrayBufferTracker* tracker = chunk->local_tracker();
+  DCHECK_NOT_NULL(tracker);
+  size_t length = tracker->Remove(buffer).length;
+  if (tracker->IsEmpty()) chunk->ReleaseLocalTracker();
 
   heap()->update_amount_of_external_allocated_memory(
       -static_cast<int64_t>(length));
 }
 
 
-void ArrayBufferTracker::MarkLive(JSArrayBuffer* buffer) {
-  base::LockGuard<base::Mutex> guard(&mutex_);
-  void* data = buffer->backing_store();
+void ArrayBufferTracker::ProcessPage(MemoryChunk* page, ProcessingMode mode) {
+  LocalArrayBufferTracker* tracker = page->local_tracker();
+  if (tracker == nullptr) return;
 
-  // ArrayBuffer might be in the middle of being constructed.
-  if (data == heap()->undefined_value()) return;
-  if (heap()->InNewSpace(buffer)) {
-    not_yet_discovered_array_buffers_for_scavenge_.erase(data);
-  } else {
-    not_yet_discovered_array_buffers_.erase(data);
+  size_t freed_memory = 0;
+  LocalArrayBufferTracker::TrackingMap* array_buffers =
+      &tracker->array_buffers_;
+  for (auto it = array_buffers->begin(); it != array_buffers->end();) {
+    JSArrayBuffer* buffer = it->first;
+    MapWord map_word = buffer->map_word();
+    if (map_word.IsForwardingAddress()) {
+      // The array buffer was copied or promoted, its backing store moves along
+      // to the new page.
+      JSArrayBuffer* target =
+          JSArrayBuffer::cast(map_word.ToForwardingAddress());
+      MemoryChunk* target_page = MemoryChunk::FromAddress(target->address());
+      DCHECK_NE(page, target_page);
+      LocalArrayBufferTracker* target_tracker = target_page->local_tracker();
+      if (target_tracker == nullptr) {
+        target_tracker = target_page->AllocateLocalTracker();
+      }
+      target_tracker->Add(target, it->second);
+      it = array_buffers->erase(it);
+    } else if (mode == kMarkCompact &&
+               Marking::IsBlack(Marking::MarkBitFrom(buffer))) {
+      // The array buffer stays on its page.
+      ++it;
+    } else {
+      dead_.push_back(it->second);
+      freed_memory += it->second.length;
+      it = array_buffers->erase(it);
+    }
+  }
+  if (tracker->IsEmpty()) page->ReleaseLocalTracker();
+
+  // Do not call through the api as this code is triggered while doing a GC.
+  if (freed_memory > 0) {
+    heap()->update_amount_of_external_allocated_memory(
+        -static_cast<int64_t>(freed_memory));
   }
 }
 
 
-void ArrayBufferTracker::FreeDead(bool from_scavenge) {
-  size_t freed_memory = 0;
-  Isolate* isolate = heap()->isolate();
-  for (auto& buffer : not_yet_discovered_array_buffers_for_scavenge_) {
-    isolate->array_buffer_allocator()->Free(buffer.first, buffer.second);
-    freed_memory += buffer.second;
-    live_array_buffers_for_scavenge_.erase(buffer.first);
+void ArrayBufferTracker::FreeDeadInNewSpace() {
+  NewSpace* new_space = heap()->new_space();
+  NewSpacePageIterator it(new_space->FromSpaceStart(),
+                          new_space->FromSpaceEnd());
+  while (it.has_next()) {
+    ProcessPage(it.next(), kScavenge);
   }
+  FreeDead();
+}
 
-  if (!from_scavenge) {
-    for (auto& buffer : not_yet_discovered_array_buffers_) {
-      isolate->array_buffer_allocator()->Free(buffer.first, buffer.second);
-      freed_memory += buffer.second;
-      live_array_buffers_.erase(buffer.first);
+
+void ArrayBufferTracker::ProcessEvacuatedPage(MemoryChunk* page) {
+  ProcessPage(page, kMarkCompact);
+}
+
+
+void ArrayBufferTracker::FreeDeadInOldSpace() {
+  PageIterator it(heap()->old_space());
+  while (it.has_next()) {
+    Page* page = it.next();
+    // Evacuation candidates are processed once their live objects moved.
+    if (page->IsEvacuationCandidate()) continue;
+    ProcessPage(page, kMarkCompact);
+  }
+}
+
+
+void ArrayBufferTracker::FreeDead() {
+  if (dead_.empty()) return;
+  if (!FLAG_concurrent_array_buffer_freeing) {
+    v8::ArrayBuffer::Allocator* allocator =
+        heap()->isolate()->array_buffer_allocator();
+    for (auto& backing_store : dead_) {
+      allocator->Free(backing_store.data, backing_store.length);
     }
+    dead_.clear();
+    return;
   }
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  queued_.insert(queued_.end(), dead_.begin(), dead_.end());
+  dead_.clear();
+  if (!task_running_) {
+    FreeingTask* task = new FreeingTask(heap()->isolate(), this);
+    task_id_ = task->id();
+    task_running_ = true;
+    V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        task, v8::Platform::kShortRunningTask);
+  }
+}
 
-  not_yet_discovered_array_buffers_for_scavenge_ =
-      live_array_buffers_for_scavenge_;
-  if (!from_scavenge) not_yet_discovered_array_buffers_ = live_array_buffers_;
 
-  // Do not call through the api as this code is triggered while doing a GC.
-  heap()->update_amount_of_external_allocated_memory(
-      -static_cast<int64_t>(freed_memory));
+void ArrayBufferTracker::FreeQueued() {
+  v8::ArrayBuffer::Allocator* allocator =
+      heap()->isolate()->array_buffer_allocator();
+  std::vector<LocalArrayBufferTracker::BackingStore> backing_stores;
+  while (true) {
+    {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      if (queued_.empty()) {
+        task_running_ = false;
+        task_finished_.NotifyOne();
+        return;
+      }
+      backing_stores.swap(queued_);
+    }
+    for (auto& backing_store : backing_stores) {
+      allocator->Free(backing_store.data, backing_store.length);
+    }
+    backing_stores.clear();
+  }
 }
 
 
-void ArrayBufferTracker::PrepareDiscoveryInNewSpace() {
-  not_yet_discovered_array_buffers_for_scavenge_ =
-      live_array_buffers_for_scavenge_;
+size_t ArrayBufferTracker::FreeAll(MemoryChunk* chunk) {
+  LocalArrayBufferTracker* tracker = chunk->local_tracker();
+  if (tracker == nullptr) return 0;
+  v8::ArrayBuffer::Allocator* allocator =
+      heap()->isolate()->array_buffer_allocator();
+  size_t freed_memory = 0;
+  for (auto& entry : tracker->array_buffers_) {
+    allocator->Free(entry.second.data, entry.second.length);
+    freed_memory += entry.second.length;
+  }
+  chunk->ReleaseLocalTracker();
+  return freed_memory;
 }
 
 
-void ArrayBufferTracker::Promote(JSArrayBuffer* buffer) {
-  base::LockGuard<base::Mutex> guard(&mutex_);
+void ArrayBufferTracker::TearDown() {
+  {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    if (task_running_) {
+      if (heap()->isolate()->cancelable_task_manager()->TryAbort(task_id_)) {
+        // The task never ran and thus never got to reset the flag.
+        task_running_ = false;
+      } else {
+        while (task_running_) task_finished_.Wait(&mutex_);
+      }
+    }
+  }
+  // Backing stores that were queued but not freed yet are already accounted
+  // for.
+  FreeQueued();
+  DCHECK(dead_.empty());
 
-  if (buffer->is_external()) return;
-  void* data = buffer->backing_store();
-  if (!data) return;
-  // ArrayBuffer might be in the middle of being constructed.
-  if (data == heap()->undefined_value()) return;
-  DCHECK(live_array_buffers_for_scavenge_.count(data) > 0);
-  live_array_buffers_[data] = live_array_buffers_for_scavenge_[data];
-  live_array_buffers_for_scavenge_.erase(data);
-  not_yet_discovered_array_buffers_for_scavenge_.erase(data);
+  if (!heap()->HasBeenSetUp()) return;
+  size_t freed_memory = 0;
+  NewSpace* new_space = heap()->new_space();
+  NewSpacePageIterator to_space_it(new_space);
+  while (to_space_it.has_next()) {
+    freed_memory += FreeAll(to_space_it.next());
+  }
+  if (new_space->IsFromSpaceCommitted()) {
+    NewSpacePageIterator from_space_it(new_space->FromSpaceStart(),
+                                       new_space->FromSpaceEnd());
+    while (from_space_it.has_next()) {
+      freed_memory += FreeAll(from_space_it.next());
+    }
+  }
+  PageIterator old_space_it(heap()->old_space());
+  while (old_space_it.has_next()) {
+    freed_memory += FreeAll(old_space_it.next());
+  }
+
+  if (freed_memory > 0) {
+    heap()->update_amount_of_external_allocated_memory(
+        -static_cast<int64_t>(freed_memory));
+  }
 }
 
 }  // namespace internal
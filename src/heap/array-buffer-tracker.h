@@ -6,7 +6,9 @@
 #define V8_HEAP_ARRAY_BUFFER_TRACKER_H_
 
 #include <map>
+#include <vector>
 
+#include "src/base/platform/condition-variable.h"
 #include "src/base/platform/mutex.h"
 #include "src/globals.h"
 
@@ -16,59 +18,117 @@ namespace internal {
 // Forward declarations.
 class Heap;
 class JSArrayBuffer;
+class MemoryChunk;
+
+// Tracks the backing stores of the array buffers allocated on a single memory
+// chunk. The entries are keyed by the address of the array buffer, so that
+// the liveness of a buffer follows from the mark bits and forwarding
+// addresses of the page, and garbage collections only need to look at the
+// trackers of the pages they evacuated or swept.
+class LocalArrayBufferTracker {
+ public:
+  struct BackingStore {
+    BackingStore() : data(nullptr), length(0) {}
+    BackingStore(void* data, size_t length) : data(data), length(length) {}
+
+    void* data;
+    size_t length;
+  };
+
+  LocalArrayBufferTracker() {}
+
+  void Add(JSArrayBuffer* buffer, const BackingStore& backing_store) {
+    array_buffers_[buffer] = backing_store;
+  }
+
+  // Removes the entry of the given array buffer and returns its backing
+  // store.
+  BackingStore Remove(JSArrayBuffer* buffer);
+
+  bool IsEmpty() const { return array_buffers_.empty(); }
+
+ private:
+  typedef std::map<JSArrayBuffer*, BackingStore> TrackingMap;
+
+  TrackingMap array_buffers_;
+
+  friend class ArrayBufferTracker;
+  DISALLOW_COPY_AND_ASSIGN(LocalArrayBufferTracker);
+};
+
 
+// Owns the backing stores of all array buffers of the heap, which are tracked
+// per memory chunk by LocalArrayBufferTracker. Trackers are only accessed on
+// the main thread. Backing stores of dead array buffers are freed through the
+// ArrayBuffer::Allocator on a background thread with
+// --concurrent_array_buffer_freeing.
 class ArrayBufferTracker {
  public:
-  explicit ArrayBufferTracker(Heap* heap) : heap_(heap) {}
+  explicit ArrayBufferTracker(Heap* heap);
   ~ArrayBufferTracker();
 
   inline Heap* heap() { return heap_; }
 
-  // The following methods are used to track raw C++ pointers to externally
-  // allocated memory used as backing store in live array buffers.
-
   // A new ArrayBuffer was created with |data| as backing store.
   void RegisterNew(JSArrayBuffer* buffer);
 
   // The backing store |data| is no longer owned by V8.
   void Unregister(JSArrayBuffer* buffer);
 
-  // A live ArrayBuffer was discovered during marking/scavenge.
-  void MarkLive(JSArrayBuffer* buffer);
+  // Processes the from-space pages after a scavenge. Entries of array buffers
+  // that survived are moved to the pages the buffers were copied or promoted
+  // to, the backing stores of the others are freed.
+  void FreeDeadInNewSpace();
+
+  // Processes an evacuated page after mark-compact, like FreeDeadInNewSpace.
+  // Array buffers that were neither moved nor marked are dead. Must be
+  // called before the forwarding addresses on the page are overwritten.
+  void ProcessEvacuatedPage(MemoryChunk* page);
 
-  // Frees all backing store pointers that weren't discovered in the previous
-  // marking or scavenge phase.
-  void FreeDead(bool from_scavenge);
+  // Frees the backing stores of unmarked array buffers on the old space pages
+  // that are swept. Must be called after marking and before sweeping.
+  void FreeDeadInOldSpace();
 
-  // Prepare for a new scavenge phase. A new marking phase is implicitly
-  // prepared by finishing the previous one.
-  void PrepareDiscoveryInNewSpace();
+  // Starts freeing the backing stores of the dead array buffers that were
+  // found since the last call, on a background thread if possible.
+  void FreeDead();
 
-  // An ArrayBuffer moved from new space to old space.
-  void Promote(JSArrayBuffer* buffer);
+  // Frees the backing stores of all array buffers in the heap and waits for
+  // the background task to finish.
+  void TearDown();
 
  private:
-  base::Mutex mutex_;
+  class FreeingTask;
+
+  enum ProcessingMode { kScavenge, kMarkCompact };
+
+  // Queues the backing stores of the dead array buffers in the tracker of the
+  // given chunk for freeing and moves the entries of evacuated array buffers
+  // to the trackers of their new pages.
+  void ProcessPage(MemoryChunk* page, ProcessingMode mode);
+
+  // Frees all backing stores in the tracker of the given chunk and returns
+  // their total size.
+  size_t FreeAll(MemoryChunk* chunk);
+
+  // Frees the queued backing stores. Runs on the background thread, or on the
+  // main thread once the background task is gone.
+  void FreeQueued();
+
   Heap* heap_;
 
-  // |live_array_buffers_| maps externally allocated memory used as backing
-  // store for ArrayBuffers to the length of the respective memory blocks.
-  //
-  // At the beginning of mark/compact, |not_yet_discovered_array_buffers_| is
-  // a copy of |live_array_buffers_| and we remove pointers as we discover live
-  // ArrayBuffer objects during marking. At the end of mark/compact, the
-  // remaining memory blocks can be freed.
-  std::map<void*, size_t> live_array_buffers_;
-  std::map<void*, size_t> not_yet_discovered_array_buffers_;
-
-  // To be able to free memory held by ArrayBuffers during scavenge as well, we
-  // have a separate list of allocated memory held by ArrayBuffers in new space.
-  //
-  // Since mark/compact also evacuates the new space, all pointers in the
-  // |live_array_buffers_for_scavenge_| list are also in the
-  // |live_array_buffers_| list.
-  std::map<void*, size_t> live_array_buffers_for_scavenge_;
-  std::map<void*, size_t> not_yet_discovered_array_buffers_for_scavenge_;
+  // Backing stores found dead by the last processing, not yet handed over to
+  // the background task. Only accessed on the main thread.
+  std::vector<LocalArrayBufferTracker::BackingStore> dead_;
+
+  // Protects the state shared with the background task.
+  base::Mutex mutex_;
+  std::vector<LocalArrayBufferTracker::BackingStore> queued_;
+  bool task_running_;
+  uint32_t task_id_;
+  base::ConditionVariable task_finished_;
+
+  DISALLOW_COPY_AND_ASSIGN(ArrayBufferTracker);
 };
 }  // namespace internal
 }  // namespace v8
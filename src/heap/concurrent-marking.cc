@@ -0,0 +1,278 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/concurrent-marking.h"
+
+#include "src/cancelable-task.h"
+#include "src/heap/gc-tracer.h"
+#include "src/heap/heap-inl.h"
+#include "src/heap/heap.h"
+#include "src/heap/mark-compact-inl.h"
+#include "src/heap/objects-visiting.h"
+#include "src/heap/spaces-inl.h"
+#include "src/objects-inl.h"
+#include "src/v8.h"
+
+namespace v8 {
+namespace internal {
+
+// Marks through objects on the background thread. Mark bits are only updated
+// with atomic transitions, everything else is collected locally by the
+// ParallelMarkingVisitor base and published by ConcurrentMarking::Run with the
+// mutex held.
+class ConcurrentMarking::Visitor : public ParallelMarkingVisitor<Visitor> {
+ public:
+  Visitor(Heap* heap, MarkingWorklist* shared)
+      : ParallelMarkingVisitor<Visitor>(heap),
+        worklist_(shared),
+        bytes_marked_(0) {}
+
+  // Marks the object grey and pushes it on the local worklist.
+  void MarkObject(HeapObject* object) {
+    if (Marking::WhiteToGreyAtomic(Marking::MarkBitFrom(object))) {
+      worklist_.Push(object);
+    }
+  }
+
+  // Visits a grey object or adds it to the bailout list if it has to be
+  // visited on the main thread.
+  void ProcessObject(HeapObject* object) {
+    Map* map = object->synchronized_map();
+    if (map == heap()->one_pointer_filler_map() ||
+        map == heap()->two_pointer_filler_map()) {
+      return;
+    }
+    int visitor_id = map->visitor_id();
+    bool is_data_object = IsDataObject(visitor_id);
+    if (!is_data_object && !CanVisitConcurrently(object, visitor_id)) {
+      bailout()->Add(object);
+      return;
+    }
+    // The size is read before the object turns black. Trimming the object
+    // afterwards only adjusts live bytes of black objects, so this may over-
+    // but never under-approximate the live bytes of the page.
+    int size = object->SizeFromMap(map);
+    if (!Marking::GreyToBlackAtomic(Marking::MarkBitFrom(object))) return;
+    // Pairs with the barrier in IncrementalMarking::BaseRecordWrite: fields
+    // are read only after the object is black, so a store that this visitor
+    // misses sees the object black and greys the stored value.
+    base::MemoryBarrier();
+    IncrementLiveBytes(object, size);
+    bytes_marked_ += size;
+    MarkObject(map);
+    if (is_data_object) return;
+    VisitBody(object, map, size);
+  }
+
+  MarkingWorklist::Local* worklist() { return &worklist_; }
+
+  intptr_t TakeBytesMarked() {
+    intptr_t bytes = bytes_marked_;
+    bytes_marked_ = 0;
+    return bytes;
+  }
+
+ private:
+  static bool IsDataObject(int visitor_id) {
+    return visitor_id == StaticVisitorBase::kVisitSeqOneByteString ||
+           visitor_id == StaticVisitorBase::kVisitSeqTwoByteString ||
+           visitor_id == StaticVisitorBase::kVisitByteArray ||
+           visitor_id == StaticVisitorBase::kVisitFixedDoubleArray ||
+           (visitor_id >= StaticVisitorBase::kVisitDataObject &&
+            visitor_id <= StaticVisitorBase::kVisitDataObjectGeneric);
+  }
+
+  // Objects that contain only tagged fields and do not need any special
+  // treatment by the marking visitor. Concurrent trimming and map migrations
+  // of these objects can only leave filler objects or stale tagged values
+  // behind, which are safe to mark. Large fixed arrays are scanned with a
+  // progress bar on the main thread.
+  static bool CanVisitConcurrently(HeapObject* object, int visitor_id) {
+    if (visitor_id == StaticVisitorBase::kVisitFixedArray) {
+      MemoryChunk* chunk = MemoryChunk::FromAddress(object->address());
+      return chunk->owner()->identity() != LO_SPACE;
+    }
+    if (visitor_id >= StaticVisitorBase::kVisitJSObject &&
+        visitor_id <= StaticVisitorBase::kVisitJSObjectGeneric) {
+      // In-object double fields may change representation concurrently.
+      return !FLAG_unbox_double_fields;
+    }
+    return (visitor_id >= StaticVisitorBase::kVisitStruct &&
+            visitor_id <= StaticVisitorBase::kVisitStructGeneric);
+  }
+
+  MarkingWorklist::Local worklist_;
+  intptr_t bytes_marked_;
+};
+
+
+class ConcurrentMarking::Task : public CancelableTask {
+ public:
+  Task(Isolate* isolate, ConcurrentMarking* concurrent_marking)
+      : CancelableTask(isolate), concurrent_marking_(concurrent_marking) {}
+
+  virtual ~Task() {}
+
+ private:
+  // v8::internal::CancelableTask overrides.
+  void RunInternal() override { concurrent_marking_->Run(); }
+
+  ConcurrentMarking* concurrent_marking_;
+
+  DISALLOW_COPY_AND_ASSIGN(Task);
+};
+
+
+ConcurrentMarking::ConcurrentMarking(Heap* heap)
+    : heap_(heap),
+      live_bytes_(HashMap::PointersMatch),
+      task_running_(false),
+      task_id_(0),
+      abort_(false),
+      duration_(0.0),
+      bytes_marked_(0) {}
+
+
+ConcurrentMarking::~ConcurrentMarking() { DCHECK(!task_running_); }
+
+
+void ConcurrentMarking::Run() {
+  Visitor visitor(heap_, &shared_);
+  MarkingWorklist::Local* worklist = visitor.worklist();
+  double start = heap_->MonotonicallyIncreasingTimeInMs();
+  while (true) {
+    HeapObject* object;
+    for (int i = 0; i < kObjectsPerBatch && worklist->Pop(&object); i++) {
+      visitor.ProcessObject(object);
+    }
+    double end = heap_->MonotonicallyIncreasingTimeInMs();
+
+    // Publish the local state every kObjectsPerBatch objects so that the main
+    // thread can pick up bailouts and abort requests are noticed in time.
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    bailout_.AddAll(*visitor.bailout());
+    visitor.bailout()->Clear();
+    recorded_slots_.AddAll(*visitor.slots());
+    visitor.slots()->Clear();
+    visitor.FlushLiveBytes(&live_bytes_);
+    duration_ += end - start;
+    bytes_marked_ += visitor.TakeBytesMarked();
+    start = end;
+
+    if (worklist->length() < kObjectsPerBatch) worklist->TryTake();
+    if (worklist->IsEmpty() || abort_) {
+      // Objects on the local worklist are grey and must not get lost.
+      worklist->FlushToGlobal();
+      task_running_ = false;
+      task_finished_.NotifyOne();
+      return;
+    }
+  }
+}
+
+
+void ConcurrentMarking::PublishToHeap() {
+  MarkingDeque* marking_deque =
+      heap_->mark_compact_collector()->marking_deque();
+  for (int i = 0; i < bailout_.length(); i++) {
+    marking_deque->Push(bailout_[i]);
+  }
+  bailout_.Clear();
+
+  MarkCompactCollector* collector = heap_->mark_compact_collector();
+  for (int i = 0; i < recorded_slots_.length(); i++) {
+    RecordedSlot& recorded = recorded_slots_[i];
+    Object* target = *recorded.slot;
+    if (target->IsHeapObject()) {
+      collector->RecordSlot(recorded.host, recorded.slot, target);
+    }
+  }
+  recorded_slots_.Clear();
+
+  for (HashMap::Entry* p = live_bytes_.Start(); p != nullptr;
+       p = live_bytes_.Next(p)) {
+    MemoryChunk* chunk = reinterpret_cast<MemoryChunk*>(p->key);
+    chunk->IncrementLiveBytes(
+        static_cast<int>(reinterpret_cast<intptr_t>(p->value)));
+  }
+  live_bytes_.Clear();
+
+  if (duration_ > 0.0) {
+    heap_->tracer()->AddConcurrentMarkingStep(duration_, bytes_marked_);
+    duration_ = 0.0;
+    bytes_marked_ = 0;
+  }
+}
+
+
+void ConcurrentMarking::Step() {
+  MarkingDeque* marking_deque =
+      heap_->mark_compact_collector()->marking_deque();
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  PublishToHeap();
+  // Keep the background task supplied, but leave the main thread with work
+  // for its own steps.
+  MarkingWorklist::Local transfer(&shared_);
+  int capacity = kMaxObjectsPerStep - shared_.GlobalPoolSize();
+  while (transfer.length() < capacity && !marking_deque->IsEmpty()) {
+    HeapObject* object = marking_deque->Pop();
+    if (marking_deque->IsEmpty()) {
+      // Objects the background task cannot visit would only bounce back.
+      marking_deque->Push(object);
+      break;
+    }
+    transfer.Push(object);
+  }
+  transfer.FlushToGlobal();
+  if (!task_running_ && !shared_.IsGlobalPoolEmpty()) {
+    Task* task = new Task(heap_->isolate(), this);
+    task_id_ = task->id();
+    task_running_ = true;
+    V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        task, v8::Platform::kShortRunningTask);
+  }
+}
+
+
+void ConcurrentMarking::Stop() {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  if (task_running_) {
+    if (heap_->isolate()->cancelable_task_manager()->TryAbort(task_id_)) {
+      // The task never ran and thus never got to reset the flag.
+      task_running_ = false;
+    } else {
+      abort_ = true;
+      while (task_running_) task_finished_.Wait(&mutex_);
+      abort_ = false;
+    }
+  }
+  DCHECK(!task_running_);
+  MarkingDeque* marking_deque =
+      heap_->mark_compact_collector()->marking_deque();
+  if (!marking_deque->in_use()) {
+    // Incremental marking was aborted and the marking state is discarded.
+    shared_.Clear();
+    bailout_.Clear();
+    recorded_slots_.Clear();
+    live_bytes_.Clear();
+    duration_ = 0.0;
+    bytes_marked_ = 0;
+    return;
+  }
+  MarkingWorklist::Local remaining(&shared_);
+  HeapObject* object;
+  while (remaining.TryTake()) {
+    while (remaining.Pop(&object)) marking_deque->Push(object);
+  }
+  PublishToHeap();
+}
+
+
+bool ConcurrentMarking::IsIdle() {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  return !task_running_ && shared_.IsGlobalPoolEmpty() && bailout_.is_empty();
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,115 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_CONCURRENT_MARKING_H_
+#define V8_HEAP_CONCURRENT_MARKING_H_
+
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
+#include "src/hashmap.h"
+#include "src/heap/parallel-marking-visitor.h"
+#include "src/heap/worklist.h"
+#include "src/list.h"
+
+namespace v8 {
+namespace internal {
+
+// Forward declarations.
+class Heap;
+class HeapObject;
+class Object;
+
+// Drains part of the incremental marking work on a background thread while
+// JavaScript is running (--concurrent_marking).
+//
+// The main thread hands grey objects from the marking deque over to a shared
+// worklist. The background task marks through objects whose layout cannot
+// change in a way that is unsafe to observe concurrently (fixed arrays, plain
+// JavaScript objects, structs and data-only objects) using atomic color
+// transitions. All other objects, e.g. maps, code, functions and objects with
+// weak semantics, are handed back to the main thread, which visits them with
+// the regular incremental marking visitor. Slots pointing into evacuation
+// candidates and live bytes are collected locally and published on the main
+// thread.
+//
+// The background task is stopped and all pending work is moved back to the
+// marking deque before any garbage collection starts, so the final atomic
+// pause only sees the regular incremental marking state.
+class ConcurrentMarking {
+ public:
+  explicit ConcurrentMarking(Heap* heap);
+  ~ConcurrentMarking();
+
+  // Hands grey objects from the marking deque over to the background task,
+  // starting a new task if needed, and publishes the results of the
+  // background task. Called on the main thread after each incremental
+  // marking step.
+  void Step();
+
+  // Stops the background task and moves all pending work back to the marking
+  // deque. Called on the main thread before the heap is modified by a
+  // garbage collection or when incremental marking is stopped.
+  void Stop();
+
+  // Returns true if there is no pending work on the background thread or in
+  // any of the worklists shared with it.
+  bool IsIdle();
+
+ private:
+  class Task;
+  class Visitor;
+
+  typedef Worklist<HeapObject*> MarkingWorklist;
+
+  // Upper bound for the number of objects handed over in a single step.
+  static const int kMaxObjectsPerStep = 1024;
+
+  // Number of objects the background task processes between publishing its
+  // local state and checking for abort requests.
+  static const int kObjectsPerBatch = 256;
+
+  // Body of the background task.
+  void Run();
+
+  // Moves bailout objects, recorded slots and live bytes published by the
+  // background task into the heap. Needs to be called on the main thread with
+  // mutex_ held.
+  void PublishToHeap();
+
+  Heap* heap_;
+
+  base::Mutex mutex_;
+
+  // Grey objects to be processed by the background task. The worklist is
+  // synchronized on its own and does not need mutex_.
+  MarkingWorklist shared_;
+
+  // Grey objects the background task could not process.
+  List<HeapObject*> bailout_;
+
+  // Slots in objects marked by the background task that point into
+  // evacuation candidates.
+  List<RecordedSlot> recorded_slots_;
+
+  // Live bytes per memory chunk that are not yet accounted for.
+  HashMap live_bytes_;
+
+  // State of the background task. There is at most one task at a time.
+  bool task_running_;
+  uint32_t task_id_;
+  bool abort_;
+  base::ConditionVariable task_finished_;
+
+  // Time spent and bytes marked by background tasks since the last report
+  // to the GC tracer.
+  double duration_;
+  intptr_t bytes_marked_;
+
+  DISALLOW_COPY_AND_ASSIGN(ConcurrentMarking);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_CONCURRENT_MARKING_H_
@@ -4,6 +4,8 @@
 
 #include "src/heap/gc-idle-time-handler.h"
 
+#include <algorithm>
+
 #include "src/flags.h"
 #include "src/heap/gc-tracer.h"
 #include "src/utils.h"
@@ -32,6 +34,9 @@ void GCIdleTimeAction::Print() {
         PrintF("; finalized marking");
       }
       break;
+    case DO_SCAVENGE:
+      PrintF("scavenge");
+      break;
     case DO_FULL_GC:
       PrintF("full GC");
       break;
@@ -45,6 +50,27 @@ void GCIdleTimeHeapState::Print() {
   PrintF("size_of_objects=%" V8_SIZET_PREFIX V8_PTR_PREFIX "d ",
                              size_of_objects);
   PrintF("incremental_marking_stopped=%d ", incremental_marking_stopped);
+  PrintF("used_new_space_size=%" V8_SIZET_PREFIX V8_PTR_PREFIX "d ",
+         used_new_space_size);
+  PrintF("new_space_capacity=%" V8_SIZET_PREFIX V8_PTR_PREFIX "d ",
+         new_space_capacity);
+  PrintF("old_generation_near_limit=%d ", old_generation_near_limit);
+}
+
+
+void GCIdleGapHistory::AddGap(double gap_in_ms) {
+  gaps_[next_gap_] = gap_in_ms;
+  next_gap_ = (next_gap_ + 1) % kMaxGaps;
+  if (gaps_count_ < kMaxGaps) gaps_count_++;
+}
+
+
+double GCIdleGapHistory::PredictGap() const {
+  if (gaps_count_ < kMinGapsForPrediction) return 0;
+  double sorted_gaps[kMaxGaps];
+  std::copy(gaps_, gaps_ + gaps_count_, sorted_gaps);
+  std::sort(sorted_gaps, sorted_gaps + gaps_count_);
+  return sorted_gaps[gaps_count_ / 10];
 }
 
 
@@ -128,6 +154,21 @@ bool GCIdleTimeHandler::ShouldDoOverApproximateWeakClosure(
 }
 
 
+bool GCIdleTimeHandler::ShouldDoScavenge(
+    size_t idle_time_in_ms, size_t new_space_capacity,
+    size_t used_new_space_size, size_t scavenge_speed_in_bytes_per_ms) {
+  if (used_new_space_size * 100 <
+      new_space_capacity * kServerScavengeNewSpacePercent) {
+    return false;
+  }
+  if (scavenge_speed_in_bytes_per_ms == 0) {
+    scavenge_speed_in_bytes_per_ms = kInitialConservativeScavengeSpeed;
+  }
+  return used_new_space_size <= scavenge_speed_in_bytes_per_ms *
+                                    idle_time_in_ms * kConservativeTimeRatio;
+}
+
+
 GCIdleTimeAction GCIdleTimeHandler::NothingOrDone(double idle_time_in_ms) {
   if (idle_time_in_ms >= kMinBackgroundIdleTime) {
     return GCIdleTimeAction::Nothing();
@@ -181,5 +222,34 @@ GCIdleTimeAction GCIdleTimeHandler::Compute(double idle_time_in_ms,
 }
 
 
+// The server policy only picks work that is predicted to fit in the idle gap,
+// as work that overruns the gap delays the next request:
+// (1) If the new space is at least half full and a scavenge is predicted to
+// fit, a scavenge is performed.
+// (2) If incremental marking is in progress, or the old generation is close to
+// its limit and marking should be started, we perform a marking step. Marking
+// steps are bounded by the deadline.
+GCIdleTimeAction GCIdleTimeHandler::ComputeForServer(
+    double idle_time_in_ms, GCIdleTimeHeapState heap_state) {
+  if (idle_time_in_ms < kIncrementalMarkingStepTimeInMs) {
+    return GCIdleTimeAction::Nothing();
+  }
+
+  if (ShouldDoScavenge(static_cast<size_t>(idle_time_in_ms),
+                       heap_state.new_space_capacity,
+                       heap_state.used_new_space_size,
+                       heap_state.scavenge_speed_in_bytes_per_ms)) {
+    return GCIdleTimeAction::Scavenge();
+  }
+
+  if (FLAG_incremental_marking && (!heap_state.incremental_marking_stopped ||
+                                   heap_state.old_generation_near_limit)) {
+    return GCIdleTimeAction::IncrementalStep();
+  }
+
+  return GCIdleTimeAction::Done();
+}
+
+
 }  // namespace internal
 }  // namespace v8
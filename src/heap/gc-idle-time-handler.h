@@ -14,6 +14,7 @@ enum GCIdleTimeActionType {
   DONE,
   DO_NOTHING,
   DO_INCREMENTAL_STEP,
+  DO_SCAVENGE,
   DO_FULL_GC,
 };
 
@@ -41,6 +42,13 @@ class GCIdleTimeAction {
     return result;
   }
 
+  static GCIdleTimeAction Scavenge() {
+    GCIdleTimeAction result;
+    result.type = DO_SCAVENGE;
+    result.additional_work = false;
+    return result;
+  }
+
   static GCIdleTimeAction FullGC() {
     GCIdleTimeAction result;
     result.type = DO_FULL_GC;
@@ -63,6 +71,57 @@ class GCIdleTimeHeapState {
   double contexts_disposal_rate;
   size_t size_of_objects;
   bool incremental_marking_stopped;
+  size_t used_new_space_size;
+  size_t new_space_capacity;
+  size_t scavenge_speed_in_bytes_per_ms;
+  bool old_generation_near_limit;
+};
+
+
+// Keeps the lengths of the recent idle gaps between the requests of a server
+// embedder, and whether the garbage collection work done in the gaps finished
+// before the next request arrived (a hit) or delayed it (a miss).
+class GCIdleGapHistory {
+ public:
+  // Number of recorded gaps below which no prediction is made.
+  static const int kMinGapsForPrediction = 4;
+
+  // Number of most recent gaps that are kept.
+  static const int kMaxGaps = 32;
+
+  GCIdleGapHistory()
+      : gaps_count_(0),
+        next_gap_(0),
+        hits_(0),
+        misses_(0),
+        total_delay_in_ms_(0) {}
+
+  void AddGap(double gap_in_ms);
+
+  // Predicts the length of the next idle gap conservatively as the 10th
+  // percentile of the recent gaps. Returns 0 if there are too few gaps.
+  double PredictGap() const;
+
+  void RecordHit() { hits_++; }
+  void RecordMiss(double delay_in_ms) {
+    misses_++;
+    total_delay_in_ms_ += delay_in_ms;
+  }
+
+  int gaps_count() const { return gaps_count_; }
+  size_t hits() const { return hits_; }
+  size_t misses() const { return misses_; }
+  double total_delay_in_ms() const { return total_delay_in_ms_; }
+
+ private:
+  double gaps_[kMaxGaps];
+  int gaps_count_;
+  int next_gap_;
+  size_t hits_;
+  size_t misses_;
+  double total_delay_in_ms_;
+
+  DISALLOW_COPY_AND_ASSIGN(GCIdleGapHistory);
 };
 
 
@@ -116,6 +175,14 @@ class GCIdleTimeHandler {
   // Incremental marking step time.
   static const size_t kIncrementalMarkingStepTimeInMs = 1;
 
+  // If we haven't recorded any scavenge events yet, we use a conservative
+  // lower bound for the scavenger speed.
+  static const size_t kInitialConservativeScavengeSpeed = 100 * KB;
+
+  // The server policy scavenges in idle time once the new space is at least
+  // this full, so that the next scavenge is less likely to hit a request.
+  static const int kServerScavengeNewSpacePercent = 50;
+
   static const size_t kMinTimeForOverApproximatingWeakClosureInMs;
 
   // Number of times we will return a Nothing action in the current mode
@@ -128,6 +195,13 @@ class GCIdleTimeHandler {
   GCIdleTimeAction Compute(double idle_time_in_ms,
                            GCIdleTimeHeapState heap_state);
 
+  // Policy for server embedders that are idle in short bursts between
+  // requests. Only picks work that is predicted to fit in |idle_time_in_ms|.
+  GCIdleTimeAction ComputeForServer(double idle_time_in_ms,
+                                    GCIdleTimeHeapState heap_state);
+
+  GCIdleGapHistory* idle_gaps() { return &idle_gaps_; }
+
   void ResetNoProgressCounter() { idle_times_which_made_no_progress_ = 0; }
 
   static size_t EstimateMarkingStepSize(size_t idle_time_in_ms,
@@ -152,12 +226,19 @@ class GCIdleTimeHandler {
 
   static bool ShouldDoOverApproximateWeakClosure(size_t idle_time_in_ms);
 
+  static bool ShouldDoScavenge(size_t idle_time_in_ms,
+                               size_t new_space_capacity,
+                               size_t used_new_space_size,
+                               size_t scavenge_speed_in_bytes_per_ms);
+
  private:
   GCIdleTimeAction NothingOrDone(double idle_time_in_ms);
 
   // Idle notifications with no progress.
   int idle_times_which_made_no_progress_;
 
+  GCIdleGapHistory idle_gaps_;
+
   DISALLOW_COPY_AND_ASSIGN(GCIdleTimeHandler);
 };
 
@@ -73,7 +73,16 @@ GCTracer::Event::Event(Type type, const char* gc_reason,
       incremental_marking_duration(0.0),
       cumulative_pure_incremental_marking_duration(0.0),
       pure_incremental_marking_duration(0.0),
-      longest_incremental_marking_step(0.0) {
+      longest_incremental_marking_step(0.0),
+      cumulative_concurrent_marking_duration(0.0),
+      concurrent_marking_duration(0.0),
+      cumulative_concurrent_marking_bytes(0),
+      concurrent_marking_bytes(0),
+      heap_growing_factor(0.0),
+      old_generation_allocation_limit(0),
+      limited_by_memory_budget(false),
+      second_pass_callbacks(0),
+      second_pass_callbacks_duration(0.0) {
   for (int i = 0; i < Scope::NUMBER_OF_SCOPES; i++) {
     scopes[i] = 0;
   }
@@ -116,6 +125,10 @@ GCTracer::GCTracer(Heap* heap)
       cumulative_incremental_marking_finalization_steps_(0),
       cumulative_incremental_marking_finalization_duration_(0.0),
       longest_incremental_marking_finalization_step_(0.0),
+      cumulative_concurrent_marking_duration_(0.0),
+      cumulative_concurrent_marking_bytes_(0),
+      second_pass_callbacks_since_gc_(0),
+      second_pass_callbacks_duration_since_gc_(0.0),
       cumulative_marking_duration_(0.0),
       cumulative_sweeping_duration_(0.0),
       allocation_time_ms_(0.0),
@@ -172,6 +185,15 @@ void GCTracer::Start(GarbageCollector collector, const char* gc_reason,
   current_.cumulative_pure_incremental_marking_duration =
       cumulative_pure_incremental_marking_duration_;
   current_.longest_incremental_marking_step = longest_incremental_marking_step_;
+  current_.cumulative_concurrent_marking_duration =
+      cumulative_concurrent_marking_duration_;
+  current_.cumulative_concurrent_marking_bytes =
+      cumulative_concurrent_marking_bytes_;
+  current_.second_pass_callbacks = second_pass_callbacks_since_gc_;
+  current_.second_pass_callbacks_duration =
+      second_pass_callbacks_duration_since_gc_;
+  second_pass_callbacks_since_gc_ = 0;
+  second_pass_callbacks_duration_since_gc_ = 0.0;
 
   for (int i = 0; i < Scope::NUMBER_OF_SCOPES; i++) {
     current_.scopes[i] = 0;
@@ -228,6 +250,12 @@ void GCTracer::Stop(GarbageCollector collector) {
     current_.pure_incremental_marking_duration =
         current_.cumulative_pure_incremental_marking_duration -
         previous_.cumulative_pure_incremental_marking_duration;
+    current_.concurrent_marking_duration =
+        current_.cumulative_concurrent_marking_duration -
+        previous_.cumulative_concurrent_marking_duration;
+    current_.concurrent_marking_bytes =
+        current_.cumulative_concurrent_marking_bytes -
+        previous_.cumulative_concurrent_marking_bytes;
     scavenger_events_.push_front(current_);
   } else if (current_.type == Event::INCREMENTAL_MARK_COMPACTOR) {
     current_.incremental_marking_steps =
@@ -246,6 +274,14 @@ void GCTracer::Stop(GarbageCollector collector) {
         current_.cumulative_pure_incremental_marking_duration -
         previous_incremental_mark_compactor_event_
             .cumulative_pure_incremental_marking_duration;
+    current_.concurrent_marking_duration =
+        current_.cumulative_concurrent_marking_duration -
+        previous_incremental_mark_compactor_event_
+            .cumulative_concurrent_marking_duration;
+    current_.concurrent_marking_bytes =
+        current_.cumulative_concurrent_marking_bytes -
+        previous_incremental_mark_compactor_event_
+            .cumulative_concurrent_marking_bytes;
     longest_incremental_marking_step_ = 0.0;
     incremental_mark_compactor_events_.push_front(current_);
     combined_mark_compact_speed_cache_ = 0.0;
@@ -362,6 +398,12 @@ void GCTracer::AddIncrementalMarkingFinalizationStep(double duration) {
 }
 
 
+void GCTracer::AddConcurrentMarkingStep(double duration, intptr_t bytes) {
+  cumulative_concurrent_marking_duration_ += duration;
+  cumulative_concurrent_marking_bytes_ += bytes;
+}
+
+
 void GCTracer::Output(const char* format, ...) const {
   if (FLAG_trace_gc) {
     va_list arguments;
@@ -413,6 +455,10 @@ void GCTracer::Print() const {
           current_.incremental_marking_steps,
           current_.longest_incremental_marking_step);
     }
+    if (current_.concurrent_marking_duration > 0) {
+      Output(" (+ %.1f ms concurrent marking)",
+             current_.concurrent_marking_duration);
+    }
   }
 
   if (current_.gc_reason != NULL) {
@@ -448,6 +494,7 @@ void GCTracer::PrintNVP() const {
                    "code=%.2f "
                    "semispace=%.2f "
                    "object_groups=%.2f "
+                   "parallel=%.2f "
                    "steps_count=%d "
                    "steps_took=%.1f "
                    "scavenge_throughput=%" V8_PTR_PREFIX
@@ -475,7 +522,14 @@ void GCTracer::PrintNVP() const {
                    "semi_space_copy_rate=%.1f%% "
                    "new_space_allocation_throughput=%" V8_PTR_PREFIX
                    "d "
-                   "context_disposal_rate=%.1f\n",
+                   "context_disposal_rate=%.1f "
+                   "semi_space_capacity=%" V8_PTR_PREFIX
+                   "d "
+                   "memory_budget=%" V8_PTR_PREFIX
+                   "d "
+                   "limited_by_memory_budget=%d "
+                   "second_pass_callbacks=%d "
+                   "second_pass_callbacks_took=%.1f\n",
                    heap_->isolate()->time_millis_since_init(), duration,
                    spent_in_mutator, current_.TypeName(true),
                    current_.reduce_memory,
@@ -486,6 +540,7 @@ void GCTracer::PrintNVP() const {
                    current_.scopes[Scope::SCAVENGER_CODE_FLUSH_CANDIDATES],
                    current_.scopes[Scope::SCAVENGER_SEMISPACE],
                    current_.scopes[Scope::SCAVENGER_OBJECT_GROUPS],
+                   current_.scopes[Scope::SCAVENGER_PARALLEL],
                    current_.incremental_marking_steps,
                    current_.incremental_marking_duration,
                    ScavengeSpeedInBytesPerMillisecond(),
@@ -498,7 +553,11 @@ void GCTracer::PrintNVP() const {
                    heap_->promotion_ratio_, AverageSurvivalRatio(),
                    heap_->promotion_rate_, heap_->semi_space_copied_rate_,
                    NewSpaceAllocationThroughputInBytesPerMillisecond(),
-                   ContextDisposalRateInMilliseconds());
+                   ContextDisposalRateInMilliseconds(),
+                   heap_->new_space()->TotalCapacity(), heap_->memory_budget(),
+                   current_.limited_by_memory_budget,
+                   current_.second_pass_callbacks,
+                   current_.second_pass_callbacks_duration);
       break;
     case Event::MARK_COMPACTOR:
     case Event::INCREMENTAL_MARK_COMPACTOR:
@@ -527,12 +586,13 @@ void GCTracer::PrintNVP() const {
           "evacuate.new_space=%.1f "
           "evacuate.update_pointers=%.1f "
           "evacuate.update_pointers.between_evacuated=%.1f "
-          "evacuate.update_pointers.to_evacuated=%.1f "
+          "evacuate.update_pointers.parallel=%.1f "
           "evacuate.update_pointers.to_new=%.1f "
           "evacuate.update_pointers.weak=%.1f "
           "finish=%.1f "
           "mark=%.1f "
           "mark.finish_incremental=%.1f "
+          "mark.parallel=%.1f "
           "mark.prepare_code_flush=%.1f "
           "mark.roots=%.1f "
           "mark.weak_closure=%.1f "
@@ -547,6 +607,9 @@ void GCTracer::PrintNVP() const {
           "finalization_steps_count=%d "
           "finalization_steps_took=%.1f "
           "finalization_longest_step=%.1f "
+          "concurrent_marking=%.1f "
+          "concurrent_marking_bytes=%" V8_PTR_PREFIX
+          "d "
           "incremental_marking_throughput=%" V8_PTR_PREFIX
           "d "
           "total_size_before=%" V8_PTR_PREFIX
@@ -573,7 +636,16 @@ void GCTracer::PrintNVP() const {
           "new_space_allocation_throughput=%" V8_PTR_PREFIX
           "d "
           "context_disposal_rate=%.1f "
-          "compaction_speed=%" V8_PTR_PREFIX "d\n",
+          "compaction_speed=%" V8_PTR_PREFIX
+          "d "
+          "heap_growing_factor=%.2f "
+          "allocation_limit=%" V8_PTR_PREFIX
+          "d "
+          "memory_budget=%" V8_PTR_PREFIX
+          "d "
+          "limited_by_memory_budget=%d "
+          "second_pass_callbacks=%d "
+          "second_pass_callbacks_took=%.1f\n",
           heap_->isolate()->time_millis_since_init(), duration,
           spent_in_mutator, current_.TypeName(true), current_.reduce_memory,
           current_.scopes[Scope::EXTERNAL], current_.scopes[Scope::MC_CLEAR],
@@ -593,11 +665,12 @@ void GCTracer::PrintNVP() const {
           current_.scopes[Scope::MC_EVACUATE_NEW_SPACE],
           current_.scopes[Scope::MC_EVACUATE_UPDATE_POINTERS],
           current_.scopes[Scope::MC_EVACUATE_UPDATE_POINTERS_BETWEEN_EVACUATED],
-          current_.scopes[Scope::MC_EVACUATE_UPDATE_POINTERS_TO_EVACUATED],
+          current_.scopes[Scope::MC_EVACUATE_UPDATE_POINTERS_PARALLEL],
           current_.scopes[Scope::MC_EVACUATE_UPDATE_POINTERS_TO_NEW],
           current_.scopes[Scope::MC_EVACUATE_UPDATE_POINTERS_WEAK],
           current_.scopes[Scope::MC_FINISH], current_.scopes[Scope::MC_MARK],
           current_.scopes[Scope::MC_MARK_FINISH_INCREMENTAL],
+          current_.scopes[Scope::MC_MARK_PARALLEL],
           current_.scopes[Scope::MC_MARK_PREPARE_CODE_FLUSH],
           current_.scopes[Scope::MC_MARK_ROOTS],
           current_.scopes[Scope::MC_MARK_WEAK_CLOSURE],
@@ -612,6 +685,8 @@ void GCTracer::PrintNVP() const {
           cumulative_incremental_marking_finalization_steps_,
           cumulative_incremental_marking_finalization_duration_,
           longest_incremental_marking_finalization_step_,
+          current_.concurrent_marking_duration,
+          current_.concurrent_marking_bytes,
           IncrementalMarkingSpeedInBytesPerMillisecond(),
           current_.start_object_size, current_.end_object_size,
           current_.start_holes_size, current_.end_holes_size,
@@ -623,7 +698,10 @@ void GCTracer::PrintNVP() const {
           heap_->semi_space_copied_rate_,
           NewSpaceAllocationThroughputInBytesPerMillisecond(),
           ContextDisposalRateInMilliseconds(),
-          CompactionSpeedInBytesPerMillisecond());
+          CompactionSpeedInBytesPerMillisecond(), current_.heap_growing_factor,
+          current_.old_generation_allocation_limit, heap_->memory_budget(),
+          current_.limited_by_memory_budget, current_.second_pass_callbacks,
+          current_.second_pass_callbacks_duration);
       break;
     case Event::START:
       break;
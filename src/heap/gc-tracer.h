@@ -115,13 +115,14 @@ class GCTracer {
       MC_EVACUATE_NEW_SPACE,
       MC_EVACUATE_UPDATE_POINTERS,
       MC_EVACUATE_UPDATE_POINTERS_BETWEEN_EVACUATED,
-      MC_EVACUATE_UPDATE_POINTERS_TO_EVACUATED,
+      MC_EVACUATE_UPDATE_POINTERS_PARALLEL,
       MC_EVACUATE_UPDATE_POINTERS_TO_NEW,
       MC_EVACUATE_UPDATE_POINTERS_WEAK,
       MC_FINISH,
       MC_INCREMENTAL_FINALIZE,
       MC_MARK,
       MC_MARK_FINISH_INCREMENTAL,
+      MC_MARK_PARALLEL,
       MC_MARK_PREPARE_CODE_FLUSH,
       MC_MARK_ROOTS,
       MC_MARK_WEAK_CLOSURE,
@@ -132,6 +133,7 @@ class GCTracer {
       SCAVENGER_CODE_FLUSH_CANDIDATES,
       SCAVENGER_OBJECT_GROUPS,
       SCAVENGER_OLD_TO_NEW_POINTERS,
+      SCAVENGER_PARALLEL,
       SCAVENGER_ROOTS,
       SCAVENGER_SCAVENGE,
       SCAVENGER_SEMISPACE,
@@ -303,6 +305,40 @@ class GCTracer {
     // (value at start of event)
     double longest_incremental_marking_step;
 
+    // Cumulative duration of concurrent marking on background threads since
+    // creation of tracer. (value at start of event)
+    double cumulative_concurrent_marking_duration;
+
+    // Duration of concurrent marking since
+    // - last event for SCAVENGER events
+    // - last INCREMENTAL_MARK_COMPACTOR event for INCREMENTAL_MARK_COMPACTOR
+    // events
+    double concurrent_marking_duration;
+
+    // Bytes marked concurrently since creation of tracer (value at start of
+    // event).
+    intptr_t cumulative_concurrent_marking_bytes;
+
+    // Bytes marked concurrently since
+    // - last event for SCAVENGER events
+    // - last INCREMENTAL_MARK_COMPACTOR event for INCREMENTAL_MARK_COMPACTOR
+    // events
+    intptr_t concurrent_marking_bytes;
+
+    // Heap growing factor and old generation allocation limit chosen at the
+    // end of MARK_COMPACTOR and INCREMENTAL_MARK_COMPACTOR events.
+    double heap_growing_factor;
+    intptr_t old_generation_allocation_limit;
+
+    // Whether the allocation limit or new space growth was capped by the
+    // memory budget during the event.
+    bool limited_by_memory_budget;
+
+    // Second pass phantom callbacks invoked by tasks since the last event and
+    // the time they took, including the GC callbacks around them.
+    int second_pass_callbacks;
+    double second_pass_callbacks_duration;
+
     // Amounts of time spent in different scopes during GC.
     double scopes[Scope::NUMBER_OF_SCOPES];
   };
@@ -349,6 +385,34 @@ class GCTracer {
 
   void AddIncrementalMarkingFinalizationStep(double duration);
 
+  // Log marking work done on a background thread. This is main-thread
+  // marking time saved by concurrent marking.
+  void AddConcurrentMarkingStep(double duration, intptr_t bytes);
+
+  // Log the heap growing decision of the current mark-compact event.
+  void RecordHeapGrowing(double factor, intptr_t old_generation_limit,
+                         bool limited_by_memory_budget) {
+    current_.heap_growing_factor = factor;
+    current_.old_generation_allocation_limit = old_generation_limit;
+    current_.limited_by_memory_budget |= limited_by_memory_budget;
+  }
+
+  // Log that the memory budget prevented the heap from growing.
+  void NotifyLimitedByMemoryBudget() {
+    current_.limited_by_memory_budget = true;
+  }
+
+  // Log a batch of second pass phantom callbacks invoked outside of a GC.
+  void AddSecondPassPhantomCallbacks(double duration, int callbacks) {
+    second_pass_callbacks_since_gc_ += callbacks;
+    second_pass_callbacks_duration_since_gc_ += duration;
+  }
+
+  // Second pass phantom callbacks invoked since the last GC started.
+  int second_pass_callbacks_since_gc() const {
+    return second_pass_callbacks_since_gc_;
+  }
+
   // Log time spent in marking.
   void AddMarkingTime(double duration) {
     cumulative_marking_duration_ += duration;
@@ -502,6 +566,8 @@ class GCTracer {
     cumulative_incremental_marking_finalization_steps_ = 0;
     cumulative_incremental_marking_finalization_duration_ = 0;
     longest_incremental_marking_finalization_step_ = 0;
+    cumulative_concurrent_marking_duration_ = 0;
+    cumulative_concurrent_marking_bytes_ = 0;
     cumulative_marking_duration_ = 0;
     cumulative_sweeping_duration_ = 0;
   }
@@ -569,6 +635,18 @@ class GCTracer {
   // Longest incremental marking finalization step since start of marking.
   double longest_incremental_marking_finalization_step_;
 
+  // Cumulative duration of concurrent marking on background threads since
+  // creation of tracer.
+  double cumulative_concurrent_marking_duration_;
+
+  // Cumulative bytes marked on background threads since creation of tracer.
+  intptr_t cumulative_concurrent_marking_bytes_;
+
+  // Second pass phantom callbacks invoked since the last GC and their
+  // duration.
+  int second_pass_callbacks_since_gc_;
+  double second_pass_callbacks_duration_since_gc_;
+
   // Total marking time.
   // This timer is precise when run with --print-cumulative-gc-stat
   double cumulative_marking_duration_;
@@ -209,7 +209,13 @@ AllocationResult Heap::AllocateRaw(int size_in_bytes, AllocationSpace space,
   HeapObject* object = nullptr;
   AllocationResult allocation;
   if (NEW_SPACE == space) {
-    if (large_object) {
+    if (large_object && FLAG_young_large_objects) {
+      allocation = new_lo_space_->AllocateRaw(size_in_bytes);
+      if (allocation.To(&object)) {
+        OnAllocationEvent(object, size_in_bytes);
+      }
+      return allocation;
+    } else if (large_object) {
       space = LO_SPACE;
     } else {
       allocation = new_space_.AllocateRaw(size_in_bytes, alignment);
@@ -370,6 +376,10 @@ bool Heap::InToSpace(Object* object) {
 
 bool Heap::InOldSpace(Object* object) { return old_space_->Contains(object); }
 
+bool Heap::IsLargeObject(HeapObject* object) {
+  return lo_space_->Contains(object) || new_lo_space_->Contains(object);
+}
+
 bool Heap::InNewSpaceSlow(Address address) {
   return new_space_.ContainsSlow(address);
 }
@@ -461,11 +471,17 @@ void Heap::MoveBlock(Address dst, Address src, int byte_size) {
 
 template <Heap::FindMementoMode mode>
 AllocationMemento* Heap::FindAllocationMemento(HeapObject* object) {
+  return FindAllocationMemento<mode>(object, object->Size());
+}
+
+template <Heap::FindMementoMode mode>
+AllocationMemento* Heap::FindAllocationMemento(HeapObject* object,
+                                               int object_size) {
   // Check if there is potentially a memento behind the object. If
   // the last word of the memento is on another page we return
   // immediately.
   Address object_address = object->address();
-  Address memento_address = object_address + object->Size();
+  Address memento_address = object_address + object_size;
   Address last_memento_word_address = memento_address + kPointerSize;
   if (!NewSpacePage::OnSamePage(object_address, last_memento_word_address)) {
     return nullptr;
@@ -510,11 +526,23 @@ AllocationMemento* Heap::FindAllocationMemento(HeapObject* object) {
 template <Heap::UpdateAllocationSiteMode mode>
 void Heap::UpdateAllocationSite(HeapObject* object,
                                 HashMap* pretenuring_feedback) {
+  Map* map = object->map();
+  if (!FLAG_allocation_site_pretenuring ||
+      !AllocationSite::CanTrack(map->instance_type()))
+    return;
+  UpdateAllocationSite<mode>(map, object, object->SizeFromMap(map),
+                             pretenuring_feedback);
+}
+
+template <Heap::UpdateAllocationSiteMode mode>
+void Heap::UpdateAllocationSite(Map* map, HeapObject* object, int object_size,
+                                HashMap* pretenuring_feedback) {
   DCHECK(InFromSpace(object));
   if (!FLAG_allocation_site_pretenuring ||
-      !AllocationSite::CanTrack(object->map()->instance_type()))
+      !AllocationSite::CanTrack(map->instance_type()))
     return;
-  AllocationMemento* memento_candidate = FindAllocationMemento<kForGC>(object);
+  AllocationMemento* memento_candidate =
+      FindAllocationMemento<kForGC>(object, object_size);
   if (memento_candidate == nullptr) return;
 
   if (mode == kGlobal) {
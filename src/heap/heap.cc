@@ -9,6 +9,7 @@
 #include "src/ast/scopeinfo.h"
 #include "src/base/bits.h"
 #include "src/base/once.h"
+#include "src/base/sys-info.h"
 #include "src/base/utils/random-number-generator.h"
 #include "src/bootstrapper.h"
 #include "src/codegen.h"
@@ -18,6 +19,7 @@
 #include "src/deoptimizer.h"
 #include "src/global-handles.h"
 #include "src/heap/array-buffer-tracker.h"
+#include "src/heap/concurrent-marking.h"
 #include "src/heap/gc-idle-time-handler.h"
 #include "src/heap/gc-tracer.h"
 #include "src/heap/incremental-marking.h"
@@ -89,6 +91,7 @@ Heap::Heap()
       // Will be 4 * reserved_semispace_size_ to ensure that young
       // generation can be aligned to its size.
       maximum_committed_(0),
+      memory_budget_(0),
       survived_since_last_expansion_(0),
       survived_last_scavenge_(0),
       always_allocate_scope_count_(0),
@@ -100,6 +103,7 @@ Heap::Heap()
       code_space_(NULL),
       map_space_(NULL),
       lo_space_(NULL),
+      new_lo_space_(NULL),
       gc_state_(NOT_IN_GC),
       gc_post_processing_depth_(0),
       allocations_count_(0),
@@ -133,11 +137,14 @@ Heap::Heap()
       marking_time_(0.0),
       sweeping_time_(0.0),
       last_idle_notification_time_(0.0),
+      idle_gap_start_time_(0.0),
+      idle_gap_work_end_time_(0.0),
       last_gc_time_(0.0),
       scavenge_collector_(nullptr),
       mark_compact_collector_(nullptr),
       store_buffer_(this),
       incremental_marking_(nullptr),
+      concurrent_marking_(nullptr),
       gc_idle_time_handler_(nullptr),
       memory_reducer_(nullptr),
       object_stats_(nullptr),
@@ -207,7 +214,8 @@ intptr_t Heap::CommittedOldGenerationMemory() {
 intptr_t Heap::CommittedMemory() {
   if (!HasBeenSetUp()) return 0;
 
-  return new_space_.CommittedMemory() + CommittedOldGenerationMemory();
+  return new_space_.CommittedMemory() + new_lo_space_->Size() +
+         CommittedOldGenerationMemory();
 }
 
 
@@ -215,6 +223,7 @@ size_t Heap::CommittedPhysicalMemory() {
   if (!HasBeenSetUp()) return 0;
 
   return new_space_.CommittedPhysicalMemory() +
+         new_lo_space_->CommittedPhysicalMemory() +
          old_space_->CommittedPhysicalMemory() +
          code_space_->CommittedPhysicalMemory() +
          map_space_->CommittedPhysicalMemory() +
@@ -369,6 +378,9 @@ void Heap::PrintShortHeapStatistics() {
                          ", committed: %6" V8_PTR_PREFIX "d KB\n",
                map_space_->SizeOfObjects() / KB, map_space_->Available() / KB,
                map_space_->CommittedMemory() / KB);
+  old_space_->PrintFreeListStatistics("Old space");
+  code_space_->PrintFreeListStatistics("Code space");
+  map_space_->PrintFreeListStatistics("Map space");
   PrintIsolate(isolate_, "Large object space, used: %6" V8_PTR_PREFIX
                          "d KB"
                          ", available: %6" V8_PTR_PREFIX
@@ -424,6 +436,9 @@ void Heap::IncrementDeferredCount(v8::Isolate::UseCounterFeature feature) {
 
 
 void Heap::GarbageCollectionPrologue() {
+  // The concurrent marker must not access the heap while it is collected.
+  concurrent_marking()->Stop();
+
   {
     AllowHeapAllocation for_the_first_part_of_prologue;
     gc_count_++;
@@ -474,7 +489,7 @@ intptr_t Heap::SizeOfObjects() {
   for (Space* space = spaces.next(); space != NULL; space = spaces.next()) {
     total += space->SizeOfObjects();
   }
-  return total;
+  return total + new_lo_space_->SizeOfObjects();
 }
 
 
@@ -681,6 +696,13 @@ void Heap::GarbageCollectionEpilogue() {
   isolate_->counters()->number_of_symbols()->Set(
       string_table()->NumberOfElements());
 
+  isolate_->counters()->zone_segments_requested()->Set(
+      static_cast<int>(ZoneSegmentPool::requested_segments()));
+  isolate_->counters()->zone_segments_reused()->Set(
+      static_cast<int>(ZoneSegmentPool::reused_segments()));
+  isolate_->counters()->zone_segment_pool_bytes()->Set(
+      static_cast<int>(ZoneSegmentPool::retained_bytes()));
+
   if (full_codegen_bytes_generated_ + crankshaft_codegen_bytes_generated_ > 0) {
     isolate_->counters()->codegen_fraction_crankshaft()->AddSample(
         static_cast<int>((crankshaft_codegen_bytes_generated_ * 100.0) /
@@ -903,6 +925,7 @@ void Heap::CollectAllAvailableGarbage(const char* gc_reason) {
   set_current_gc_flags(kNoGCFlags);
   new_space_.Shrink();
   UncommitFromSpace();
+  ZoneSegmentPool::Purge();
 }
 
 
@@ -1426,6 +1449,8 @@ void Heap::MarkCompact() {
 
   uint64_t size_of_objects_before_gc = SizeOfObjects();
 
+  PromoteYoungLargeObjects();
+
   mark_compact_collector()->Prepare();
 
   ms_count_++;
@@ -1510,21 +1535,24 @@ static void VerifyNonPointerSpacePointers(Heap* heap) {
 
 
 void Heap::CheckNewSpaceExpansionCriteria() {
+  if (new_space_.TotalCapacity() >= new_space_.MaximumCapacity()) return;
   if (FLAG_experimental_new_space_growth_heuristic) {
-    if (new_space_.TotalCapacity() < new_space_.MaximumCapacity() &&
-        survived_last_scavenge_ * 100 / new_space_.TotalCapacity() >= 10) {
-      // Grow the size of new space if there is room to grow, and more than 10%
-      // have survived the last scavenge.
-      new_space_.Grow();
-      survived_since_last_expansion_ = 0;
+    // Grow the size of new space if there is room to grow, and more than 10%
+    // have survived the last scavenge.
+    if (survived_last_scavenge_ * 100 / new_space_.TotalCapacity() < 10) {
+      return;
     }
-  } else if (new_space_.TotalCapacity() < new_space_.MaximumCapacity() &&
-             survived_since_last_expansion_ > new_space_.TotalCapacity()) {
+  } else if (survived_since_last_expansion_ <= new_space_.TotalCapacity()) {
     // Grow the size of new space if there is room to grow, and enough data
     // has survived scavenge since the last expansion.
-    new_space_.Grow();
-    survived_since_last_expansion_ = 0;
+    return;
+  }
+  if (!CanGrowNewSpaceWithinMemoryBudget()) {
+    tracer()->NotifyLimitedByMemoryBudget();
+    return;
   }
+  new_space_.Grow();
+  survived_since_last_expansion_ = 0;
 }
 
 
@@ -1636,12 +1664,11 @@ void Heap::Scavenge() {
 
   scavenge_collector_->SelectScavengingVisitorsTable();
 
-  array_buffer_tracker()->PrepareDiscoveryInNewSpace();
-
   // Flip the semispaces.  After flipping, to space is empty, from space has
   // live objects.
   new_space_.Flip();
   new_space_.ResetAllocationInfo();
+  new_lo_space_->Flip();
 
   // We need to sweep newly copied objects which can be either in the
   // to space or promoted to the old generation.  For to-space
@@ -1670,41 +1697,51 @@ void Heap::Scavenge() {
         &IsUnmodifiedHeapObject);
   }
 
-  {
-    // Copy roots.
-    GCTracer::Scope gc_scope(tracer(), GCTracer::Scope::SCAVENGER_ROOTS);
-    IterateRoots(&scavenge_visitor, VISIT_ALL_IN_SCAVENGE);
-  }
+  if (scavenge_collector_->CanScavengeInParallel()) {
+    // Roots, old-to-new pointers and the transitive closure are processed by
+    // multiple tasks. Everything below operates on the copied objects only.
+    GCTracer::Scope gc_scope(tracer(), GCTracer::Scope::SCAVENGER_PARALLEL);
+    scavenge_collector_->ScavengeInParallel();
+    new_space_front = new_space_.top();
+    promotion_queue_.SetNewLimit(new_space_.top());
+  } else {
+    {
+      // Copy roots.
+      GCTracer::Scope gc_scope(tracer(), GCTracer::Scope::SCAVENGER_ROOTS);
+      IterateRoots(&scavenge_visitor, VISIT_ALL_IN_SCAVENGE);
+    }
 
-  {
-    // Copy objects reachable from the old generation.
-    GCTracer::Scope gc_scope(tracer(),
-                             GCTracer::Scope::SCAVENGER_OLD_TO_NEW_POINTERS);
-    RememberedSet<OLD_TO_NEW>::IterateWithWrapper(this,
-                                                  Scavenger::ScavengeObject);
-  }
+    {
+      // Copy objects reachable from the old generation.
+      GCTracer::Scope gc_scope(tracer(),
+                               GCTracer::Scope::SCAVENGER_OLD_TO_NEW_POINTERS);
+      RememberedSet<OLD_TO_NEW>::IterateWithWrapper(this,
+                                                    Scavenger::ScavengeObject);
+    }
 
-  {
-    GCTracer::Scope gc_scope(tracer(), GCTracer::Scope::SCAVENGER_WEAK);
-    // Copy objects reachable from the encountered weak collections list.
-    scavenge_visitor.VisitPointer(&encountered_weak_collections_);
-    // Copy objects reachable from the encountered weak cells.
-    scavenge_visitor.VisitPointer(&encountered_weak_cells_);
-  }
+    {
+      GCTracer::Scope gc_scope(tracer(), GCTracer::Scope::SCAVENGER_WEAK);
+      // Copy objects reachable from the encountered weak collections list.
+      scavenge_visitor.VisitPointer(&encountered_weak_collections_);
+      // Copy objects reachable from the encountered weak cells.
+      scavenge_visitor.VisitPointer(&encountered_weak_cells_);
+    }
 
-  {
-    // Copy objects reachable from the code flushing candidates list.
-    GCTracer::Scope gc_scope(tracer(),
-                             GCTracer::Scope::SCAVENGER_CODE_FLUSH_CANDIDATES);
-    MarkCompactCollector* collector = mark_compact_collector();
-    if (collector->is_code_flushing_enabled()) {
-      collector->code_flusher()->IteratePointersToFromSpace(&scavenge_visitor);
+    {
+      // Copy objects reachable from the code flushing candidates list.
+      GCTracer::Scope gc_scope(
+          tracer(), GCTracer::Scope::SCAVENGER_CODE_FLUSH_CANDIDATES);
+      MarkCompactCollector* collector = mark_compact_collector();
+      if (collector->is_code_flushing_enabled()) {
+        collector->code_flusher()->IteratePointersToFromSpace(
+            &scavenge_visitor);
+      }
     }
-  }
 
-  {
-    GCTracer::Scope gc_scope(tracer(), GCTracer::Scope::SCAVENGER_SEMISPACE);
-    new_space_front = DoScavenge(&scavenge_visitor, new_space_front);
+    {
+      GCTracer::Scope gc_scope(tracer(), GCTracer::Scope::SCAVENGER_SEMISPACE);
+      new_space_front = DoScavenge(&scavenge_visitor, new_space_front);
+    }
   }
 
   if (FLAG_scavenge_reclaim_unmodified_objects) {
@@ -1742,12 +1779,16 @@ void Heap::Scavenge() {
   ScavengeWeakObjectRetainer weak_object_retainer(this);
   ProcessYoungWeakReferences(&weak_object_retainer);
 
+  // Young large objects are not copied. The ones that were reached change
+  // owner, all others are freed.
+  IncrementPromotedObjectsSize(new_lo_space_->PromoteSurvivors());
+
   DCHECK(new_space_front == new_space_.top());
 
   // Set age mark.
   new_space_.set_age_mark(new_space_.top());
 
-  array_buffer_tracker()->FreeDead(true);
+  array_buffer_tracker()->FreeDeadInNewSpace();
 
   // Update how much has survived scavenge.
   IncrementYoungSurvivorsCounter(static_cast<int>(
@@ -3066,7 +3107,13 @@ bool Heap::CanMoveObjectStart(HeapObject* object) {
 
   Address address = object->address();
 
-  if (lo_space()->Contains(object)) return false;
+  if (IsLargeObject(object)) return false;
+
+  // The concurrent marker may be visiting the object and updating its mark
+  // bits while Marking::TransferMark moves them to the new start.
+  if (FLAG_concurrent_marking && incremental_marking()->IsMarking()) {
+    return false;
+  }
 
   Page* page = Page::FromAddress(address);
   // We can move the object start if:
@@ -3107,7 +3154,7 @@ FixedArrayBase* Heap::LeftTrimFixedArray(FixedArrayBase* object,
   // For now this trick is only applied to objects in new and paged space.
   // In large object space the object's start must coincide with chunk
   // and thus the trick is just not applicable.
-  DCHECK(!lo_space()->Contains(object));
+  DCHECK(!IsLargeObject(object));
   DCHECK(object->map() != fixed_cow_array_map());
 
   // Ensure that the no handle-scope has more than one pointer to the same
@@ -3205,7 +3252,7 @@ void Heap::RightTrimFixedArray(FixedArrayBase* object, int elements_to_trim) {
   // We do not create a filler for objects in large object space.
   // TODO(hpayer): We should shrink the large object page if the size
   // of the object changed significantly.
-  if (!lo_space()->Contains(object)) {
+  if (!IsLargeObject(object)) {
     CreateFillerObjectAt(new_end, bytes_to_trim);
     if (mark_compact_collector()->sweeping_in_progress()) {
       // Array trimming during sweeping can add invalid slots in free list.
@@ -4035,8 +4082,10 @@ AllocationResult Heap::AllocateStruct(InstanceType type) {
 
 bool Heap::IsHeapIterable() {
   // TODO(hpayer): This function is not correct. Allocation folding in old
-  // space breaks the iterability.
-  return new_space_top_after_last_gc_ == new_space()->top();
+  // space breaks the iterability. Young large objects are not visited by the
+  // heap iterator, a full GC promotes them.
+  return new_space_top_after_last_gc_ == new_space()->top() &&
+         new_lo_space_->IsEmpty();
 }
 
 
@@ -4211,6 +4260,12 @@ GCIdleTimeHeapState Heap::ComputeHeapState() {
       tracer()->ContextDisposalRateInMilliseconds();
   heap_state.size_of_objects = static_cast<size_t>(SizeOfObjects());
   heap_state.incremental_marking_stopped = incremental_marking()->IsStopped();
+  heap_state.used_new_space_size = static_cast<size_t>(new_space_.Size());
+  heap_state.new_space_capacity = static_cast<size_t>(new_space_.Capacity());
+  heap_state.scavenge_speed_in_bytes_per_ms =
+      static_cast<size_t>(tracer()->ScavengeSpeedInBytesPerMillisecond());
+  heap_state.old_generation_near_limit =
+      OldGenerationSpaceAvailable() < old_generation_allocation_limit_ / 5;
   return heap_state;
 }
 
@@ -4227,6 +4282,7 @@ bool Heap::PerformIdleTimeAction(GCIdleTimeAction action,
       if (incremental_marking()->incremental_marking_job()->IdleTaskPending()) {
         result = true;
       } else {
+        if (incremental_marking()->IsStopped()) StartIdleIncrementalMarking();
         incremental_marking()
             ->incremental_marking_job()
             ->NotifyIdleTaskProgress();
@@ -4235,6 +4291,9 @@ bool Heap::PerformIdleTimeAction(GCIdleTimeAction action,
       }
       break;
     }
+    case DO_SCAVENGE:
+      CollectGarbage(NEW_SPACE, "idle notification: scavenge");
+      break;
     case DO_FULL_GC: {
       DCHECK(contexts_disposed_ > 0);
       HistogramTimerScope scope(isolate_->counters()->gc_context());
@@ -4343,6 +4402,70 @@ bool Heap::IdleNotification(double deadline_in_seconds) {
 }
 
 
+bool Heap::IdleNotificationRequestFinished() {
+  CHECK(HasBeenSetUp());
+  HistogramTimerScope idle_notification_scope(
+      isolate_->counters()->gc_idle_notification());
+  TRACE_EVENT0("v8", "V8.GCIdleNotification");
+  double start_ms = MonotonicallyIncreasingTimeInMs();
+  idle_gap_start_time_ = start_ms;
+  idle_gap_work_end_time_ = 0.0;
+
+  double idle_time_in_ms =
+      gc_idle_time_handler_->idle_gaps()->PredictGap() *
+      GCIdleTimeHandler::kConservativeTimeRatio;
+  double deadline_in_ms = start_ms + idle_time_in_ms;
+
+  tracer()->SampleAllocation(start_ms, NewSpaceAllocationCounter(),
+                             OldGenerationAllocationCounter());
+
+  GCIdleTimeHeapState heap_state = ComputeHeapState();
+
+  GCIdleTimeAction action =
+      gc_idle_time_handler_->ComputeForServer(idle_time_in_ms, heap_state);
+
+  bool result = PerformIdleTimeAction(action, heap_state, deadline_in_ms);
+  if (action.type != DONE && action.type != DO_NOTHING) {
+    idle_gap_work_end_time_ = MonotonicallyIncreasingTimeInMs();
+  }
+
+  IdleNotificationEpilogue(action, heap_state, start_ms, deadline_in_ms);
+  return result;
+}
+
+
+void Heap::IdleNotificationRequestArrived(double arrival_time_in_seconds) {
+  if (idle_gap_start_time_ == 0.0) return;
+  double arrival_time_in_ms =
+      arrival_time_in_seconds *
+      static_cast<double>(base::Time::kMillisecondsPerSecond);
+  GCIdleGapHistory* idle_gaps = gc_idle_time_handler_->idle_gaps();
+  idle_gaps->AddGap(Max(0.0, arrival_time_in_ms - idle_gap_start_time_));
+  if (idle_gap_work_end_time_ > 0.0) {
+    if (idle_gap_work_end_time_ <= arrival_time_in_ms) {
+      idle_gaps->RecordHit();
+    } else {
+      idle_gaps->RecordMiss(idle_gap_work_end_time_ - arrival_time_in_ms);
+    }
+  }
+  if (FLAG_trace_idle_notification) {
+    PrintIsolate(isolate_,
+                 "%8.0f ms: Idle gap of %.2f ms, hits %" V8_SIZET_PREFIX
+                 "u, misses %" V8_SIZET_PREFIX "u, delay %.2f ms\n",
+                 isolate()->time_millis_since_init(),
+                 arrival_time_in_ms - idle_gap_start_time_, idle_gaps->hits(),
+                 idle_gaps->misses(), idle_gaps->total_delay_in_ms());
+  }
+  idle_gap_start_time_ = 0.0;
+  idle_gap_work_end_time_ = 0.0;
+}
+
+
+GCIdleGapHistory* Heap::idle_gaps() {
+  return gc_idle_time_handler_->idle_gaps();
+}
+
+
 bool Heap::RecentIdleNotificationHappened() {
   return (last_idle_notification_time_ +
           GCIdleTimeHandler::kMaxScheduledIdleTime) >
@@ -4412,7 +4535,7 @@ bool Heap::Contains(HeapObject* value) {
   return HasBeenSetUp() &&
          (new_space_.ToSpaceContains(value) || old_space_->Contains(value) ||
           code_space_->Contains(value) || map_space_->Contains(value) ||
-          lo_space_->Contains(value));
+          lo_space_->Contains(value) || new_lo_space_->Contains(value));
 }
 
 bool Heap::ContainsSlow(Address addr) {
@@ -4422,7 +4545,8 @@ bool Heap::ContainsSlow(Address addr) {
   return HasBeenSetUp() &&
          (new_space_.ToSpaceContainsSlow(addr) ||
           old_space_->ContainsSlow(addr) || code_space_->ContainsSlow(addr) ||
-          map_space_->ContainsSlow(addr) || lo_space_->ContainsSlow(addr));
+          map_space_->ContainsSlow(addr) || lo_space_->ContainsSlow(addr) ||
+          new_lo_space_->ContainsSlow(addr));
 }
 
 bool Heap::InSpace(HeapObject* value, AllocationSpace space) {
@@ -4527,6 +4651,7 @@ void Heap::Verify() {
   code_space_->Verify(&no_dirty_regions_visitor);
 
   lo_space_->Verify();
+  new_lo_space_->Verify();
 
   mark_compact_collector()->VerifyWeakEmbeddedObjectsInCode();
   if (FLAG_omit_map_checks_for_leaf_maps) {
@@ -4606,6 +4731,53 @@ class IteratePointersToFromSpaceVisitor final : public ObjectVisitor {
 };
 
 
+// Records the slots of a young large object that is promoted outside of a
+// scavenge: pointers into new space and, if the object is black while
+// incremental marking is compacting, pointers to evacuation candidates.
+// Neither were recorded while the object was young.
+class RecordSlotsOfPromotedLargeObjectVisitor final : public ObjectVisitor {
+ public:
+  RecordSlotsOfPromotedLargeObjectVisitor(Heap* heap, HeapObject* target,
+                                          bool record_slots)
+      : heap_(heap), target_(target), record_slots_(record_slots) {}
+
+  void VisitPointers(Object** start, Object** end) override {
+    Page* page = Page::FromAddress(target_->address());
+    for (Object** slot = start; slot < end; slot++) {
+      Object* value = *slot;
+      if (!value->IsHeapObject()) continue;
+      if (heap_->InNewSpace(value)) {
+        RememberedSet<OLD_TO_NEW>::Insert(page,
+                                          reinterpret_cast<Address>(slot));
+      } else if (record_slots_ &&
+                 MarkCompactCollector::IsOnEvacuationCandidate(value)) {
+        heap_->mark_compact_collector()->RecordSlot(target_, slot, value);
+      }
+    }
+  }
+
+ private:
+  Heap* heap_;
+  HeapObject* target_;
+  bool record_slots_;
+};
+
+
+void Heap::PromoteYoungLargeObjects() {
+  while (!new_lo_space_->IsEmpty()) {
+    LargePage* page = new_lo_space_->first_page();
+    HeapObject* object = page->GetObject();
+    new_lo_space_->PromotePage(page);
+    bool record_slots = incremental_marking()->IsCompacting() &&
+                        Marking::IsBlack(Marking::MarkBitFrom(object));
+    RecordSlotsOfPromotedLargeObjectVisitor visitor(this, object,
+                                                    record_slots);
+    object->IterateBody(object->map()->instance_type(), object->Size(),
+                        &visitor);
+  }
+}
+
+
 void Heap::IteratePointersToFromSpace(HeapObject* target, int size,
                                       ObjectSlotCallback callback) {
   // We are not collecting slots on new space objects during mutation
@@ -4733,7 +4905,8 @@ void Heap::IterateStrongRoots(ObjectVisitor* v, VisitMode mode) {
 // and through the API, we should gracefully handle the case that the heap
 // size is not big enough to fit all the initial objects.
 bool Heap::ConfigureHeap(int max_semi_space_size, int max_old_space_size,
-                         int max_executable_size, size_t code_range_size) {
+                         int max_executable_size, size_t code_range_size,
+                         int memory_budget) {
   if (HasBeenSetUp()) return false;
 
   // Overwrite default configuration.
@@ -4759,6 +4932,19 @@ bool Heap::ConfigureHeap(int max_semi_space_size, int max_old_space_size,
     max_executable_size_ = static_cast<intptr_t>(FLAG_max_executable_size) * MB;
   }
 
+  int64_t memory_budget_in_bytes = static_cast<int64_t>(memory_budget) * MB;
+  if (FLAG_memory_budget > 0) {
+    memory_budget_in_bytes = static_cast<int64_t>(FLAG_memory_budget) * MB;
+  } else if (memory_budget_in_bytes == 0 && FLAG_memory_budget_from_cgroup) {
+    memory_budget_in_bytes = base::SysInfo::AmountOfContainerMemory();
+  }
+  if (memory_budget_in_bytes > 0) {
+    memory_budget_ = static_cast<intptr_t>(
+        Min(memory_budget_in_bytes,
+            static_cast<int64_t>(std::numeric_limits<intptr_t>::max())));
+    ApplyMemoryBudget();
+  }
+
   if (Page::kPageSize > MB) {
     max_semi_space_size_ = ROUND_UP(max_semi_space_size_, Page::kPageSize);
     max_old_generation_size_ =
@@ -4877,7 +5063,7 @@ void Heap::GetFromRingBuffer(char* buffer) {
 }
 
 
-bool Heap::ConfigureHeapDefault() { return ConfigureHeap(0, 0, 0, 0); }
+bool Heap::ConfigureHeapDefault() { return ConfigureHeap(0, 0, 0, 0, 0); }
 
 
 void Heap::RecordStats(HeapStats* stats, bool take_snapshot) {
@@ -5030,13 +5216,16 @@ void Heap::SetOldGenerationAllocationLimit(intptr_t old_gen_size,
   }
 
   // We set the old generation growing factor to 2 to grow the heap slower on
-  // memory-constrained devices.
-  if (max_old_generation_size_ <= kMaxOldSpaceSizeMediumMemoryDevice ||
+  // memory-constrained devices. With a memory budget the limit is capped by
+  // the budget below instead.
+  if ((max_old_generation_size_ <= kMaxOldSpaceSizeMediumMemoryDevice &&
+       memory_budget_ == 0) ||
       FLAG_optimize_for_size) {
     factor = Min(factor, kMaxHeapGrowingFactorMemoryConstrained);
   }
 
-  if (memory_reducer_->ShouldGrowHeapSlowly() || optimize_for_memory_usage_) {
+  if (memory_reducer_->ShouldGrowHeapSlowly() ||
+      ShouldOptimizeForMemoryUsage()) {
     factor = Min(factor, kConservativeHeapGrowingFactor);
   }
 
@@ -5048,18 +5237,84 @@ void Heap::SetOldGenerationAllocationLimit(intptr_t old_gen_size,
     factor = 1.0 + FLAG_heap_growing_percent / 100.0;
   }
 
-  old_generation_allocation_limit_ =
-      CalculateOldGenerationAllocationLimit(factor, old_gen_size);
+  intptr_t limit = CalculateOldGenerationAllocationLimit(factor, old_gen_size);
+  bool limited_by_memory_budget = false;
+  if (memory_budget_ > 0) {
+    // Stay under the memory budget but leave some room for allocation, as
+    // back-to-back full garbage collections would not free enough memory to
+    // make up for their cost.
+    intptr_t budget_limit =
+        Max(OldGenerationMemoryBudget(),
+            old_gen_size + kMinimumOldGenerationAllocationLimit);
+    if (limit > budget_limit) {
+      limit = budget_limit;
+      limited_by_memory_budget = true;
+    }
+  }
+  old_generation_allocation_limit_ = limit;
+  tracer()->RecordHeapGrowing(factor, limit, limited_by_memory_budget);
 
   if (FLAG_trace_gc_verbose) {
     PrintIsolate(isolate_, "Grow: old size: %" V8_PTR_PREFIX
-                           "d KB, new limit: %" V8_PTR_PREFIX "d KB (%.1f)\n",
+                           "d KB, new limit: %" V8_PTR_PREFIX "d KB (%.1f)%s\n",
                  old_gen_size / KB, old_generation_allocation_limit_ / KB,
-                 factor);
+                 factor, limited_by_memory_budget ? ", memory budget" : "");
   }
 }
 
 
+void Heap::ApplyMemoryBudget() {
+  intptr_t heap_budget = HeapMemoryBudget();
+  // New space consists of two semi-spaces and may take up to an eighth of the
+  // budget.
+  intptr_t semi_space_budget = Max(
+      heap_budget / 16, static_cast<intptr_t>(Page::kPageSize));
+  if (max_semi_space_size_ > semi_space_budget) {
+    max_semi_space_size_ = static_cast<int>(base::bits::RoundDownToPowerOfTwo32(
+        static_cast<uint32_t>(semi_space_budget)));
+  }
+  max_old_generation_size_ = Min(max_old_generation_size_,
+                                 heap_budget - 2 * max_semi_space_size_);
+  if (FLAG_trace_gc) {
+    PrintIsolate(isolate_,
+                 "Memory budget of %" V8_PTR_PREFIX
+                 "d MB: max semi-space size %d KB, max old generation size "
+                 "%" V8_PTR_PREFIX "d MB\n",
+                 memory_budget_ / MB, max_semi_space_size_ / KB,
+                 max_old_generation_size_ / MB);
+  }
+}
+
+
+intptr_t Heap::OldGenerationMemoryBudget() {
+  // External memory allocated since the last full garbage collection is
+  // accounted for in PromotedTotalSize, which is checked against the limit.
+  int64_t budget = HeapMemoryBudget() -
+                   2 * static_cast<int64_t>(new_space_.TotalCapacity()) -
+                   amount_of_external_allocated_memory_at_last_global_gc_;
+  return static_cast<intptr_t>(Max(budget, static_cast<int64_t>(0)));
+}
+
+
+bool Heap::IsCloseToMemoryBudget() {
+  if (memory_budget_ == 0) return false;
+  int64_t used = CommittedMemory() + amount_of_external_allocated_memory_;
+  return used > HeapMemoryBudget() / 100 * kMemoryBudgetPressurePercent;
+}
+
+
+bool Heap::CanGrowNewSpaceWithinMemoryBudget() {
+  if (memory_budget_ == 0) return true;
+  intptr_t capacity = new_space_.TotalCapacity();
+  intptr_t new_capacity =
+      Min(static_cast<intptr_t>(new_space_.MaximumCapacity()),
+          FLAG_semi_space_growth_factor * capacity);
+  int64_t used = CommittedMemory() + amount_of_external_allocated_memory_ +
+                 2 * (new_capacity - capacity);
+  return used <= HeapMemoryBudget() / 100 * kMemoryBudgetPressurePercent;
+}
+
+
 void Heap::DampenOldGenerationAllocationLimit(intptr_t old_gen_size,
                                               double gc_speed,
                                               double mutator_speed) {
@@ -5088,6 +5343,22 @@ void Heap::EnableInlineAllocation() {
 }
 
 
+void Heap::RefillPretenuringLab() {
+  if (inline_allocation_disabled_) return;
+  if (old_space_->limit() - old_space_->top() >= kPretenuringLabSize) return;
+  // A single free list lookup for a large node instead of one per allocation
+  // that does not fit into the remainder of a small node.
+  LocalAllocationBuffer lab = LocalAllocationBuffer::FromResult(
+      this, old_space_->AllocateRawUnaligned(kPretenuringLabSize),
+      kPretenuringLabSize);
+  // Failing to get a buffer is fine, the regular allocation path takes care
+  // of triggering a GC.
+  if (!lab.IsValid()) return;
+  lab.InstallAsLinearAllocationArea(old_space_);
+  isolate_->counters()->pretenuring_lab_refills()->Increment();
+}
+
+
 void Heap::DisableInlineAllocation() {
   if (inline_allocation_disabled_) return;
   inline_allocation_disabled_ = true;
@@ -5139,6 +5410,8 @@ bool Heap::SetUp() {
   // Initialize incremental marking.
   incremental_marking_ = new IncrementalMarking(this);
 
+  concurrent_marking_ = new ConcurrentMarking(this);
+
   // Set up new space.
   if (!new_space_.SetUp(reserved_semispace_size_, max_semi_space_size_)) {
     return false;
@@ -5170,6 +5443,9 @@ bool Heap::SetUp() {
   if (lo_space_ == NULL) return false;
   if (!lo_space_->SetUp()) return false;
 
+  new_lo_space_ = new NewLargeObjectSpace(this);
+  if (!new_lo_space_->SetUp()) return false;
+
   // Set up the seed that is used to randomize the string hash function.
   DCHECK(hash_seed() == 0);
   if (FLAG_randomize_hashes) {
@@ -5316,6 +5592,12 @@ void Heap::TearDown() {
   delete idle_scavenge_observer_;
   idle_scavenge_observer_ = nullptr;
 
+  if (concurrent_marking_ != nullptr) {
+    concurrent_marking_->Stop();
+    delete concurrent_marking_;
+    concurrent_marking_ = nullptr;
+  }
+
   delete scavenge_collector_;
   scavenge_collector_ = nullptr;
 
@@ -5345,8 +5627,11 @@ void Heap::TearDown() {
 
   WaitUntilUnmappingOfFreeChunksCompleted();
 
-  delete array_buffer_tracker_;
-  array_buffer_tracker_ = nullptr;
+  if (array_buffer_tracker_ != nullptr) {
+    array_buffer_tracker_->TearDown();
+    delete array_buffer_tracker_;
+    array_buffer_tracker_ = nullptr;
+  }
 
   isolate_->global_handles()->TearDown();
 
@@ -5378,6 +5663,12 @@ void Heap::TearDown() {
     lo_space_ = NULL;
   }
 
+  if (new_lo_space_ != NULL) {
+    new_lo_space_->TearDown();
+    delete new_lo_space_;
+    new_lo_space_ = NULL;
+  }
+
   store_buffer()->TearDown();
 
   isolate_->memory_allocator()->TearDown();
@@ -6154,19 +6445,20 @@ void Heap::ExternalStringTable::TearDown() {
 
 class Heap::UnmapFreeMemoryTask : public v8::Task {
  public:
-  UnmapFreeMemoryTask(Heap* heap, MemoryChunk* head)
-      : heap_(heap), head_(head) {}
+  UnmapFreeMemoryTask(Heap* heap, MemoryChunk* head, bool pool_chunks)
+      : heap_(heap), head_(head), pool_chunks_(pool_chunks) {}
   virtual ~UnmapFreeMemoryTask() {}
 
  private:
   // v8::Task overrides.
   void Run() override {
-    heap_->FreeQueuedChunks(head_);
+    heap_->FreeQueuedChunks(head_, pool_chunks_);
     heap_->pending_unmapping_tasks_semaphore_.Signal();
   }
 
   Heap* heap_;
   MemoryChunk* head_;
+  bool pool_chunks_;
 
   DISALLOW_COPY_AND_ASSIGN(UnmapFreeMemoryTask);
 };
@@ -6192,13 +6484,16 @@ void Heap::QueueMemoryChunkForFree(MemoryChunk* chunk) {
 
 
 void Heap::FreeQueuedChunks() {
+  // Freed pages are kept for reuse unless the heap is trying to give memory
+  // back to the system.
+  const bool pool_chunks = !ShouldReduceMemory();
   if (chunks_queued_for_free_ != NULL) {
     if (FLAG_concurrent_sweeping) {
       V8::GetCurrentPlatform()->CallOnBackgroundThread(
-          new UnmapFreeMemoryTask(this, chunks_queued_for_free_),
+          new UnmapFreeMemoryTask(this, chunks_queued_for_free_, pool_chunks),
           v8::Platform::kShortRunningTask);
     } else {
-      FreeQueuedChunks(chunks_queued_for_free_);
+      FreeQueuedChunks(chunks_queued_for_free_, pool_chunks);
       pending_unmapping_tasks_semaphore_.Signal();
     }
     chunks_queued_for_free_ = NULL;
@@ -6211,13 +6506,19 @@ void Heap::FreeQueuedChunks() {
 }
 
 
-void Heap::FreeQueuedChunks(MemoryChunk* list_head) {
+void Heap::FreeQueuedChunks(MemoryChunk* list_head, bool pool_chunks) {
+  MemoryAllocator* allocator = isolate_->memory_allocator();
   MemoryChunk* next;
   MemoryChunk* chunk;
   for (chunk = list_head; chunk != NULL; chunk = next) {
     next = chunk->next_chunk();
-    isolate_->memory_allocator()->PerformFreeMemory(chunk);
+    if (pool_chunks) {
+      allocator->PerformFreeMemoryOrPool(chunk);
+    } else {
+      allocator->PerformFreeMemory(chunk);
+    }
   }
+  if (!pool_chunks) allocator->ReleasePooledChunks();
 }
 
 
@@ -6282,6 +6583,16 @@ size_t Heap::ObjectSizeAtLastGC(size_t index) {
 }
 
 
+int Heap::ObjectStatsGCCount() {
+  return object_stats_->gc_count_last_time();
+}
+
+
+int Heap::ObjectStatsSamplingRate() {
+  return object_stats_->sampling_rate_last_time();
+}
+
+
 bool Heap::GetObjectTypeName(size_t index, const char** object_type,
                              const char** object_sub_type) {
   if (index >= ObjectStats::OBJECT_STATS_COUNT) return false;
@@ -276,7 +276,9 @@ namespace internal {
 // Forward declarations.
 class AllocationObserver;
 class ArrayBufferTracker;
+class GCIdleGapHistory;
 class GCIdleTimeAction;
+class ConcurrentMarking;
 class GCIdleTimeHandler;
 class GCIdleTimeHeapState;
 class GCTracer;
@@ -510,6 +512,15 @@ class Heap {
   static const int kMaxExecutableSizeHugeMemoryDevice =
       256 * kPointerMultiplier;
 
+  // Percentage of the memory budget of the process the heap, including
+  // external memory, tries to stay under. The rest is left for malloc, code
+  // and stacks.
+  static const int kMemoryBudgetHeapPercent = 75;
+
+  // Percentage of the heap's share of the memory budget above which the heap
+  // grows conservatively and the memory reducer starts reclaiming memory.
+  static const int kMemoryBudgetPressurePercent = 90;
+
   static const int kTraceRingBufferSize = 512;
   static const int kStacktraceBufferSize = 512;
 
@@ -533,6 +544,11 @@ class Heap {
   // The minimum size of a HeapObject on the heap.
   static const int kMinObjectSizeInWords = 2;
 
+  // Size of the linear allocation buffers taken from old space on the slow
+  // path of inline pretenured allocation. Stays below the allocation threshold
+  // of incremental marking.
+  static const int kPretenuringLabSize = 32 * KB;
+
   STATIC_ASSERT(kUndefinedValueRootIndex ==
                 Internals::kUndefinedValueRootIndex);
   STATIC_ASSERT(kNullValueRootIndex == Internals::kNullValueRootIndex);
@@ -712,6 +728,12 @@ class Heap {
   template <FindMementoMode mode>
   inline AllocationMemento* FindAllocationMemento(HeapObject* object);
 
+  // Same as above for callers that already know the size of {object}, e.g.
+  // because its map word may be overwritten concurrently.
+  template <FindMementoMode mode>
+  inline AllocationMemento* FindAllocationMemento(HeapObject* object,
+                                                  int object_size);
+
   // Returns false if not able to reserve.
   bool ReserveSpace(Reservation* reservations);
 
@@ -724,6 +746,12 @@ class Heap {
   // Implements the corresponding V8 API function.
   bool IdleNotification(double deadline_in_seconds);
   bool IdleNotification(int idle_time_in_ms);
+  bool IdleNotificationRequestFinished();
+  void IdleNotificationRequestArrived(double arrival_time_in_seconds);
+
+  // Lengths of the recent idle gaps between requests and how well the
+  // garbage collection work done in them fit.
+  GCIdleGapHistory* idle_gaps();
 
   double MonotonicallyIncreasingTimeInMs();
 
@@ -755,7 +783,7 @@ class Heap {
   inline bool OldGenerationAllocationLimitReached();
 
   void QueueMemoryChunkForFree(MemoryChunk* chunk);
-  void FreeQueuedChunks(MemoryChunk* list_head);
+  void FreeQueuedChunks(MemoryChunk* list_head, bool pool_chunks);
   void FreeQueuedChunks();
   void WaitUntilUnmappingOfFreeChunksCompleted();
 
@@ -822,16 +850,27 @@ class Heap {
 
   void SetOptimizeForLatency() { optimize_for_memory_usage_ = false; }
   void SetOptimizeForMemoryUsage();
-  bool ShouldOptimizeForMemoryUsage() { return optimize_for_memory_usage_; }
+  bool ShouldOptimizeForMemoryUsage() {
+    return optimize_for_memory_usage_ || IsCloseToMemoryBudget();
+  }
+
+  // Returns the memory budget of the process in bytes or 0 if there is none.
+  intptr_t memory_budget() { return memory_budget_; }
+
+  // Returns true if the heap and external memory use most of their share of
+  // the memory budget.
+  bool IsCloseToMemoryBudget();
 
   // ===========================================================================
   // Initialization. ===========================================================
   // ===========================================================================
 
   // Configure heap size in MB before setup. Return false if the heap has been
-  // set up already.
+  // set up already. A non-zero memory budget caps the maximum heap size and
+  // makes the heap growing strategy adapt to stay under the budget.
   bool ConfigureHeap(int max_semi_space_size, int max_old_space_size,
-                     int max_executable_size, size_t code_range_size);
+                     int max_executable_size, size_t code_range_size,
+                     int memory_budget);
   bool ConfigureHeapDefault();
 
   // Prepares the heap, setting up memory areas that are needed in the isolate
@@ -863,6 +902,7 @@ class Heap {
   OldSpace* code_space() { return code_space_; }
   MapSpace* map_space() { return map_space_; }
   LargeObjectSpace* lo_space() { return lo_space_; }
+  NewLargeObjectSpace* new_lo_space() { return new_lo_space_; }
 
   PagedSpace* paged_space(int idx) {
     switch (idx) {
@@ -996,6 +1036,12 @@ class Heap {
   void EnableInlineAllocation();
   void DisableInlineAllocation();
 
+  // Makes sure that old space has a linear allocation area of at least
+  // kPretenuringLabSize bytes, so that pretenured allocations in generated
+  // code take the inline bump-pointer path again. Called on the runtime slow
+  // path of inline pretenured allocation.
+  void RefillPretenuringLab();
+
   // ===========================================================================
   // Methods triggering GCs. ===================================================
   // ===========================================================================
@@ -1082,6 +1128,8 @@ class Heap {
 
   IncrementalMarking* incremental_marking() { return incremental_marking_; }
 
+  ConcurrentMarking* concurrent_marking() { return concurrent_marking_; }
+
   // ===========================================================================
   // External string table API. ================================================
   // ===========================================================================
@@ -1105,6 +1153,10 @@ class Heap {
   // Returns whether the object resides in old space.
   inline bool InOldSpace(Object* object);
 
+  // Returns whether the object resides in the old or the young large object
+  // space.
+  inline bool IsLargeObject(HeapObject* object);
+
   // Checks whether an address/object in the heap (including auxiliary
   // area and unused area).
   bool Contains(HeapObject* value);
@@ -1135,6 +1187,12 @@ class Heap {
   size_t ObjectCountAtLastGC(size_t index);
   size_t ObjectSizeAtLastGC(size_t index);
 
+  // Returns the number of the major GC the object statistics were collected
+  // at, or 0 if they were not collected yet, and the sampling rate they were
+  // collected with.
+  int ObjectStatsGCCount();
+  int ObjectStatsSamplingRate();
+
   // Retrieves names of buckets used by object statistics tracking.
   bool GetObjectTypeName(size_t index, const char** object_type,
                          const char** object_sub_type);
@@ -1333,6 +1391,14 @@ class Heap {
   inline void UpdateAllocationSite(HeapObject* object,
                                    HashMap* pretenuring_feedback);
 
+  // Same as above, but takes the {map} and {object_size} of {object} from the
+  // caller instead of reading the map word, which a parallel scavenger may
+  // replace with a forwarding address at any time.
+  template <UpdateAllocationSiteMode mode>
+  inline void UpdateAllocationSite(Map* map, HeapObject* object,
+                                   int object_size,
+                                   HashMap* pretenuring_feedback);
+
   // Removes an entry from the global pretenuring storage.
   inline void RemoveAllocationSitePretenuringFeedback(AllocationSite* site);
 
@@ -1656,6 +1722,10 @@ class Heap {
   void MarkCompactPrologue();
   void MarkCompactEpilogue();
 
+  // Hands all young large objects over to the old large object space before
+  // a mark-compact and records their slots.
+  void PromoteYoungLargeObjects();
+
   // Performs a minor collection in new generation.
   void Scavenge();
 
@@ -1715,6 +1785,22 @@ class Heap {
   void SetOldGenerationAllocationLimit(intptr_t old_gen_size, double gc_speed,
                                        double mutator_speed);
 
+  // Caps the maximum heap size such that the heap fits into its share of the
+  // memory budget.
+  void ApplyMemoryBudget();
+
+  // Returns the heap's share of the memory budget.
+  intptr_t HeapMemoryBudget() {
+    return memory_budget_ / 100 * kMemoryBudgetHeapPercent;
+  }
+
+  // Returns the part of the heap's share of the memory budget that is left
+  // for the old generation after new space and external memory.
+  intptr_t OldGenerationMemoryBudget();
+
+  // Returns true if growing new space does not exceed the memory budget.
+  bool CanGrowNewSpaceWithinMemoryBudget();
+
   // ===========================================================================
   // Idle notification. ========================================================
   // ===========================================================================
@@ -1971,6 +2057,10 @@ class Heap {
   intptr_t max_executable_size_;
   intptr_t maximum_committed_;
 
+  // Memory budget of the process, e.g. the memory limit of its container, or
+  // 0 if there is none.
+  intptr_t memory_budget_;
+
   // For keeping track of how much data has survived
   // scavenge since last new space expansion.
   intptr_t survived_since_last_expansion_;
@@ -1997,6 +2087,7 @@ class Heap {
   OldSpace* code_space_;
   MapSpace* map_space_;
   LargeObjectSpace* lo_space_;
+  NewLargeObjectSpace* new_lo_space_;
   HeapState gc_state_;
   int gc_post_processing_depth_;
   Address new_space_top_after_last_gc_;
@@ -2107,6 +2198,11 @@ class Heap {
   // Last time an idle notification happened.
   double last_idle_notification_time_;
 
+  // Start of the current idle gap between requests and the time the garbage
+  // collection work in it ended, 0 if there is no gap or no work.
+  double idle_gap_start_time_;
+  double idle_gap_work_end_time_;
+
   // Last time a garbage collection happened.
   double last_gc_time_;
 
@@ -2118,6 +2214,8 @@ class Heap {
 
   IncrementalMarking* incremental_marking_;
 
+  ConcurrentMarking* concurrent_marking_;
+
   GCIdleTimeHandler* gc_idle_time_handler_;
 
   MemoryReducer* memory_reducer_;
@@ -2213,7 +2311,6 @@ class Heap {
   friend class MarkCompactCollector;
   friend class MarkCompactMarkingVisitor;
   friend class NewSpace;
-  friend class ObjectStatsVisitor;
   friend class Page;
   friend class Scavenger;
   friend class StoreBuffer;
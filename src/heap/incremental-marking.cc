@@ -7,6 +7,7 @@
 #include "src/code-stubs.h"
 #include "src/compilation-cache.h"
 #include "src/conversions.h"
+#include "src/heap/concurrent-marking.h"
 #include "src/heap/gc-idle-time-handler.h"
 #include "src/heap/gc-tracer.h"
 #include "src/heap/mark-compact-inl.h"
@@ -53,7 +54,16 @@ bool IncrementalMarking::BaseRecordWrite(HeapObject* obj, Object* value) {
 
   MarkBit obj_bit = Marking::MarkBitFrom(obj);
   DCHECK(!Marking::IsImpossible(obj_bit));
-  bool is_black = Marking::IsBlack(obj_bit);
+  bool is_black;
+  if (FLAG_concurrent_marking) {
+    // The concurrent marker turns an object black before it reads its fields.
+    // Order the store before the color check, so that either the marker sees
+    // the new value or the host is seen black here.
+    base::MemoryBarrier();
+    is_black = Marking::IsBlackAtomic(obj_bit);
+  } else {
+    is_black = Marking::IsBlack(obj_bit);
+  }
 
   if (is_black && Marking::IsWhite(value_bit)) {
     WhiteToGreyAndPush(value_heap_obj, value_bit);
@@ -162,7 +172,11 @@ void IncrementalMarking::BlackToGreyAndUnshift(HeapObject* obj,
   DCHECK(Marking::MarkBitFrom(obj) == mark_bit);
   DCHECK(obj->Size() >= 2 * kPointerSize);
   DCHECK(IsMarking());
-  Marking::BlackToGrey(mark_bit);
+  if (FLAG_concurrent_marking) {
+    Marking::BlackToGreyAtomic(mark_bit);
+  } else {
+    Marking::BlackToGrey(mark_bit);
+  }
   int obj_size = obj->Size();
   MemoryChunk::IncrementLiveBytesFromGC(obj, -obj_size);
   bytes_scanned_ -= obj_size;
@@ -189,7 +203,12 @@ void IncrementalMarking::BlackToGreyAndUnshift(HeapObject* obj,
 
 
 void IncrementalMarking::WhiteToGreyAndPush(HeapObject* obj, MarkBit mark_bit) {
-  Marking::WhiteToGrey(mark_bit);
+  if (FLAG_concurrent_marking) {
+    // The concurrent marker may have greyed the object in the meantime.
+    if (!Marking::WhiteToGreyAtomic(mark_bit)) return;
+  } else {
+    Marking::WhiteToGrey(mark_bit);
+  }
   heap_->mark_compact_collector()->marking_deque()->Push(obj);
 }
 
@@ -201,7 +220,11 @@ static void MarkObjectGreyDoNotEnqueue(Object* obj) {
     if (Marking::IsBlack(mark_bit)) {
       MemoryChunk::IncrementLiveBytesFromGC(heap_obj, -heap_obj->Size());
     }
-    Marking::AnyToGrey(mark_bit);
+    if (FLAG_concurrent_marking) {
+      Marking::AnyToGreyAtomic(mark_bit);
+    } else {
+      Marking::AnyToGrey(mark_bit);
+    }
   }
 }
 
@@ -209,8 +232,14 @@ static void MarkObjectGreyDoNotEnqueue(Object* obj) {
 static inline void MarkBlackOrKeepBlack(HeapObject* heap_object,
                                         MarkBit mark_bit, int size) {
   DCHECK(!Marking::IsImpossible(mark_bit));
-  if (Marking::IsBlack(mark_bit)) return;
-  Marking::MarkBlack(mark_bit);
+  if (FLAG_concurrent_marking) {
+    // Only the thread that sets the second bit accounts for the object.
+    Marking::WhiteToGreyAtomic(mark_bit);
+    if (!Marking::GreyToBlackAtomic(mark_bit)) return;
+  } else {
+    if (Marking::IsBlack(mark_bit)) return;
+    Marking::MarkBlack(mark_bit);
+  }
   MemoryChunk::IncrementLiveBytesFromGC(heap_object, size);
 }
 
@@ -314,12 +343,14 @@ class IncrementalMarkingMarkingVisitor
   INLINE(static bool MarkObjectWithoutPush(Heap* heap, Object* obj)) {
     HeapObject* heap_object = HeapObject::cast(obj);
     MarkBit mark_bit = Marking::MarkBitFrom(heap_object);
-    if (Marking::IsWhite(mark_bit)) {
+    if (FLAG_concurrent_marking) {
+      if (!Marking::WhiteToBlackAtomic(mark_bit)) return false;
+    } else {
+      if (!Marking::IsWhite(mark_bit)) return false;
       Marking::MarkBlack(mark_bit);
-      MemoryChunk::IncrementLiveBytesFromGC(heap_object, heap_object->Size());
-      return true;
     }
-    return false;
+    MemoryChunk::IncrementLiveBytesFromGC(heap_object, heap_object->Size());
+    return true;
   }
 };
 
@@ -408,6 +439,12 @@ void IncrementalMarking::DeactivateIncrementalWriteBarrier() {
     SetOldSpacePageFlags(lop, false, false);
     lop = lop->next_page();
   }
+
+  lop = heap_->new_lo_space()->first_page();
+  while (lop->is_valid()) {
+    SetNewSpacePageFlags(lop, false);
+    lop = lop->next_page();
+  }
 }
 
 
@@ -440,6 +477,12 @@ void IncrementalMarking::ActivateIncrementalWriteBarrier() {
     SetOldSpacePageFlags(lop, true, is_compacting_);
     lop = lop->next_page();
   }
+
+  lop = heap_->new_lo_space()->first_page();
+  while (lop->is_valid()) {
+    SetNewSpacePageFlags(lop, true);
+    lop = lop->next_page();
+  }
 }
 
 
@@ -597,6 +640,10 @@ void IncrementalMarking::StartMarking() {
   IncrementalMarkingRootMarkingVisitor visitor(this);
   heap_->IterateStrongRoots(&visitor, VISIT_ONLY_STRONG);
 
+  if (FLAG_concurrent_marking) {
+    heap_->concurrent_marking()->Step();
+  }
+
   // Ready to start incremental marking.
   if (FLAG_trace_incremental_marking) {
     PrintF("[IncrementalMarking] Running\n");
@@ -905,6 +952,7 @@ void IncrementalMarking::ProcessMarkingDeque() {
 
 void IncrementalMarking::Hurry() {
   if (state() == MARKING) {
+    heap_->concurrent_marking()->Stop();
     double start = 0.0;
     if (FLAG_trace_incremental_marking || FLAG_print_cumulative_gc_stat) {
       start = heap_->MonotonicallyIncreasingTimeInMs();
@@ -958,6 +1006,7 @@ void IncrementalMarking::Stop() {
     PrintF("[IncrementalMarking] Stopping.\n");
   }
 
+  heap_->concurrent_marking()->Stop();
   heap_->new_space()->RemoveAllocationObserver(&observer_);
   IncrementalMarking::set_should_hurry(false);
   ResetStepCounters();
@@ -1189,7 +1238,13 @@ intptr_t IncrementalMarking::Step(intptr_t allocated_bytes,
       }
     } else if (state_ == MARKING) {
       bytes_processed = ProcessMarkingDeque(bytes_to_process);
-      if (heap_->mark_compact_collector()->marking_deque()->IsEmpty()) {
+      bool concurrent_marking_idle = true;
+      if (FLAG_concurrent_marking) {
+        heap_->concurrent_marking()->Step();
+        concurrent_marking_idle = heap_->concurrent_marking()->IsIdle();
+      }
+      if (heap_->mark_compact_collector()->marking_deque()->IsEmpty() &&
+          concurrent_marking_idle) {
         if (completion == FORCE_COMPLETION ||
             IsIdleMarkingDelayCounterLimitReached()) {
           if (!finalize_marking_completed_) {
@@ -21,10 +21,12 @@
 #include "src/heap/object-stats.h"
 #include "src/heap/objects-visiting-inl.h"
 #include "src/heap/objects-visiting.h"
+#include "src/heap/parallel-marking-visitor.h"
 #include "src/heap/slots-buffer.h"
 #include "src/heap/spaces-inl.h"
 #include "src/ic/ic.h"
 #include "src/ic/stub-cache.h"
+#include "src/parallel-job.h"
 #include "src/profiler/cpu-profiler.h"
 #include "src/utils-inl.h"
 #include "src/v8.h"
@@ -62,6 +64,9 @@ MarkCompactCollector::MarkCompactCollector(Heap* heap)
       marking_deque_memory_committed_(0),
       code_flusher_(nullptr),
       have_code_to_deoptimize_(false),
+      hot_code_pages_before_evacuation_(0),
+      hot_code_pages_after_evacuation_(0),
+      hot_code_space_(nullptr),
       compacting_(false),
       sweeping_in_progress_(false),
       compaction_in_progress_(false),
@@ -288,6 +293,9 @@ static void TraceFragmentation(PagedSpace* space) {
 bool MarkCompactCollector::StartCompaction(CompactionMode mode) {
   if (!compacting_) {
     DCHECK(evacuation_candidates_.length() == 0);
+    hot_code_pages_before_evacuation_ = 0;
+    hot_code_evacuation_candidates_.Rewind(0);
+    hot_code_pages_after_evacuation_ = 0;
 
     CollectEvacuationCandidates(heap()->old_space());
 
@@ -596,6 +604,10 @@ void Marking::TransferMark(Heap* heap, Address old_start, Address new_start) {
   // size, so the adjustment to the live data count will be zero anyway.
   if (old_start == new_start) return;
 
+  // Objects are not moved while the concurrent marker may update their mark
+  // bits, see Heap::CanMoveObjectStart.
+  DCHECK(!FLAG_concurrent_marking);
+
   MarkBit new_mark_bit = MarkBitFrom(new_start);
   MarkBit old_mark_bit = MarkBitFrom(old_start);
 
@@ -800,6 +812,14 @@ void MarkCompactCollector::CollectEvacuationCandidates(PagedSpace* space) {
     for (int i = 0; i < candidate_count; i++) {
       AddEvacuationCandidate(pages[i].second);
     }
+    if (FLAG_hot_code_layout && space->identity() == CODE_SPACE) {
+      int evacuated_bytes = 0;
+      for (int i = 0; i < candidate_count; i++) {
+        evacuated_bytes += pages[i].first;
+      }
+      CollectHotCodeEvacuationCandidates(pages,
+                                         max_evacuated_bytes - evacuated_bytes);
+    }
   }
 
   if (FLAG_trace_fragmentation) {
@@ -812,6 +832,83 @@ void MarkCompactCollector::CollectEvacuationCandidates(PagedSpace* space) {
 }
 
 
+bool MarkCompactCollector::IsHotCode(Code* code) {
+  // Optimized code was hot enough to be optimized. Unoptimized code is hot if
+  // the runtime profiler has seen it on the stack since its last IC change.
+  switch (code->kind()) {
+    case Code::OPTIMIZED_FUNCTION:
+      return true;
+    case Code::FUNCTION:
+      return code->profiler_ticks() > 0;
+    default:
+      return false;
+  }
+}
+
+
+void MarkCompactCollector::CollectHotCodeEvacuationCandidates(
+    const std::vector<std::pair<int, Page*> >& pages,
+    int max_evacuated_bytes) {
+  // Pages on which less than half of the live bytes are hot code are
+  // evacuated, so that their hot code is packed onto fewer pages.
+  const int kMaxHotCodePercent = 50;
+  int evacuated_bytes = 0;
+  int added_pages = 0;
+  intptr_t hot_code_bytes = 0;
+  for (const std::pair<int, Page*>& entry : pages) {
+    int live_bytes = entry.first;
+    Page* p = entry.second;
+    int page_hot_code_bytes = 0;
+    HeapObjectIterator it(p);
+    for (HeapObject* object = it.Next(); object != nullptr;
+         object = it.Next()) {
+      if (object->IsCode() && IsHotCode(Code::cast(object))) {
+        page_hot_code_bytes += object->Size();
+      }
+    }
+    if (page_hot_code_bytes == 0) continue;
+    hot_code_pages_before_evacuation_++;
+    hot_code_bytes += page_hot_code_bytes;
+    if (!p->IsEvacuationCandidate() &&
+        page_hot_code_bytes * 100 < live_bytes * kMaxHotCodePercent &&
+        evacuated_bytes + live_bytes <= max_evacuated_bytes) {
+      evacuated_bytes += live_bytes;
+      added_pages++;
+      AddEvacuationCandidate(p);
+    }
+    if (p->IsEvacuationCandidate()) hot_code_evacuation_candidates_.Add(p);
+  }
+  if (FLAG_trace_hot_code_layout) {
+    PrintIsolate(isolate(),
+                 "hot-code-layout-selection: hot_code_pages=%d "
+                 "hot_code_kb=%" V8_PTR_PREFIX "d added_pages=%d "
+                 "evacuated_kb=%d\n",
+                 hot_code_pages_before_evacuation_, hot_code_bytes / KB,
+                 added_pages, evacuated_bytes / KB);
+  }
+}
+
+
+void MarkCompactCollector::ReportHotCodeLayout() {
+  int hot_code_pages_after = hot_code_pages_before_evacuation_ +
+                             hot_code_pages_after_evacuation_;
+  for (Page* p : hot_code_evacuation_candidates_) {
+    // Pages that were evicted or not fully evacuated keep their hot code.
+    if (p->IsEvacuationCandidate() &&
+        !p->IsFlagSet(Page::COMPACTION_WAS_ABORTED)) {
+      hot_code_pages_after--;
+    }
+  }
+  int page_kb = static_cast<int>(heap()->code_space()->AreaSize() / KB);
+  PrintIsolate(isolate(),
+               "hot-code-layout: code_working_set_before_kb=%d "
+               "code_working_set_after_kb=%d pages_before=%d pages_after=%d\n",
+               hot_code_pages_before_evacuation_ * page_kb,
+               hot_code_pages_after * page_kb,
+               hot_code_pages_before_evacuation_, hot_code_pages_after);
+}
+
+
 void MarkCompactCollector::AbortCompaction() {
   if (compacting_) {
     for (Page* p : evacuation_candidates_) {
@@ -1283,10 +1380,6 @@ void MarkCompactMarkingVisitor::Initialize() {
   StaticMarkingVisitor<MarkCompactMarkingVisitor>::Initialize();
 
   table_.Register(kVisitJSRegExp, &VisitRegExpAndFlushCode);
-
-  if (FLAG_track_gc_object_stats) {
-    ObjectStatsVisitor::Initialize(&table_);
-  }
 }
 
 
@@ -1413,8 +1506,9 @@ class RootMarkingVisitor : public ObjectVisitor {
     MarkCompactMarkingVisitor::IterateBody(map, object);
 
     // Mark all the objects reachable from the map and body.  May leave
-    // overflowed objects in the heap.
-    collector_->EmptyMarkingDeque();
+    // overflowed objects in the heap. With parallel marking the objects are
+    // left on the marking stack for the next ProcessMarkingDeque.
+    if (!collector_->CanMarkInParallel()) collector_->EmptyMarkingDeque();
   }
 
   MarkCompactCollector* collector_;
@@ -1537,11 +1631,20 @@ class MarkCompactCollector::EvacuateVisitorBase
         compaction_spaces_(compaction_spaces),
         local_store_buffer_(local_store_buffer) {}
 
+  // If |allocation_mutex| is given, target_space is shared between tasks and
+  // only the allocation happens under the mutex.
   bool TryEvacuateObject(PagedSpace* target_space, HeapObject* object,
-                         HeapObject** target_object) {
+                         HeapObject** target_object,
+                         base::Mutex* allocation_mutex = nullptr) {
     int size = object->Size();
     AllocationAlignment alignment = object->RequiredAlignment();
-    AllocationResult allocation = target_space->AllocateRaw(size, alignment);
+    AllocationResult allocation;
+    if (allocation_mutex != nullptr) {
+      base::LockGuard<base::Mutex> guard(allocation_mutex);
+      allocation = target_space->AllocateRaw(size, alignment);
+    } else {
+      allocation = target_space->AllocateRaw(size, alignment);
+    }
     if (allocation.To(target_object)) {
       heap_->mark_compact_collector()->MigrateObject(
           *target_object, object, size, target_space->identity(),
@@ -1586,11 +1689,6 @@ class MarkCompactCollector::EvacuateNewSpaceVisitor final
     if (heap_->ShouldBePromoted(object->address(), size) &&
         TryEvacuateObject(compaction_spaces_->Get(OLD_SPACE), object,
                           &target_object)) {
-      // If we end up needing more special cases, we should factor this out.
-      if (V8_UNLIKELY(target_object->IsJSArrayBuffer())) {
-        heap_->array_buffer_tracker()->Promote(
-            JSArrayBuffer::cast(target_object));
-      }
       promoted_size_ += size;
       return true;
     }
@@ -1600,9 +1698,6 @@ class MarkCompactCollector::EvacuateNewSpaceVisitor final
         HeapObject::cast(target), object, size, space,
         (space == NEW_SPACE) ? nullptr : evacuation_slots_buffer_,
         (space == NEW_SPACE) ? nullptr : local_store_buffer_);
-    if (V8_UNLIKELY(target->IsJSArrayBuffer())) {
-      heap_->array_buffer_tracker()->MarkLive(JSArrayBuffer::cast(target));
-    }
     semispace_copied_size_ += size;
     return true;
   }
@@ -1727,8 +1822,16 @@ class MarkCompactCollector::EvacuateOldSpaceVisitor final
   bool Visit(HeapObject* object) override {
     CompactionSpace* target_space = compaction_spaces_->Get(
         Page::FromAddress(object->address())->owner()->identity());
+    base::Mutex* allocation_mutex = nullptr;
+    MarkCompactCollector* collector = heap_->mark_compact_collector();
+    if (collector->hot_code_space_ != nullptr && object->IsCode() &&
+        MarkCompactCollector::IsHotCode(Code::cast(object))) {
+      target_space = collector->hot_code_space_;
+      allocation_mutex = &collector->hot_code_space_mutex_;
+    }
     HeapObject* target_object = nullptr;
-    if (TryEvacuateObject(target_space, object, &target_object)) {
+    if (TryEvacuateObject(target_space, object, &target_object,
+                          allocation_mutex)) {
       DCHECK(object->map_word().IsForwardingAddress());
       return true;
     }
@@ -1903,6 +2006,10 @@ void MarkCompactCollector::RefillMarkingDeque() {
 // pointers.  After: the marking stack is empty and there are no overflowed
 // objects in the heap.
 void MarkCompactCollector::ProcessMarkingDeque() {
+  if (CanMarkInParallel()) {
+    ProcessMarkingDequeInParallel();
+    return;
+  }
   EmptyMarkingDeque();
   while (marking_deque_.overflowed()) {
     RefillMarkingDeque();
@@ -1911,6 +2018,205 @@ void MarkCompactCollector::ProcessMarkingDeque() {
 }
 
 
+// Task-local state of parallel marking. Objects are marked black with an
+// atomic transition when they are discovered, so exactly one task visits
+// every object. Live bytes, slots pointing into evacuation candidates and
+// objects that have to be visited by the regular marking visitor are
+// collected locally and handed over to the main thread in {Finalize}.
+class MarkCompactCollector::ParallelMarker
+    : public ParallelMarkingVisitor<ParallelMarker> {
+ public:
+  ParallelMarker(Heap* heap, MarkingWorklist* worklist)
+      : ParallelMarkingVisitor<ParallelMarker>(heap),
+        local_worklist_(worklist) {}
+
+  // Marks the target of a visited slot and pushes it on the local worklist.
+  void MarkObject(HeapObject* object) {
+    if (Marking::WhiteToBlackAtomic(Marking::MarkBitFrom(object))) {
+      IncrementLiveBytes(object, object->Size());
+      local_worklist_.Push(object);
+    }
+  }
+
+  // Processes the local worklist and steals from other tasks until all tasks
+  // are out of work. The task must have been registered with the worklist.
+  void Run();
+
+  // Accounts for live bytes, records slots and pushes the objects that were
+  // not visited onto the marking stack. Needs to be called on the main thread
+  // after all tasks finished.
+  void Finalize(MarkCompactCollector* collector);
+
+ private:
+  // Objects that only contain tagged fields or raw data and are visited by
+  // the plain body visitors of MarkCompactMarkingVisitor. Everything else,
+  // e.g. maps, code, functions and objects with weak semantics, is visited on
+  // the main thread.
+  static bool CanVisitInParallel(int visitor_id) {
+    switch (visitor_id) {
+      case StaticVisitorBase::kVisitSeqOneByteString:
+      case StaticVisitorBase::kVisitSeqTwoByteString:
+      case StaticVisitorBase::kVisitShortcutCandidate:
+      case StaticVisitorBase::kVisitConsString:
+      case StaticVisitorBase::kVisitSlicedString:
+      case StaticVisitorBase::kVisitSymbol:
+      case StaticVisitorBase::kVisitByteArray:
+      case StaticVisitorBase::kVisitFreeSpace:
+      case StaticVisitorBase::kVisitFixedArray:
+      case StaticVisitorBase::kVisitFixedDoubleArray:
+        return true;
+      default:
+        break;
+    }
+    return (visitor_id >= StaticVisitorBase::kVisitDataObject &&
+            visitor_id <= StaticVisitorBase::kVisitDataObjectGeneric) ||
+           (visitor_id >= StaticVisitorBase::kVisitJSObject &&
+            visitor_id <= StaticVisitorBase::kVisitJSObjectGeneric) ||
+           (visitor_id >= StaticVisitorBase::kVisitStruct &&
+            visitor_id <= StaticVisitorBase::kVisitStructGeneric);
+  }
+
+  void ProcessObject(HeapObject* object) {
+    Map* map = object->map();
+    // Explicitly skip one word fillers. Incremental markbit patterns are
+    // correct only for objects that occupy at least two words.
+    if (map == heap()->one_pointer_filler_map()) return;
+    MarkObject(map);
+    if (!CanVisitInParallel(map->visitor_id())) {
+      bailout()->Add(object);
+      return;
+    }
+    VisitBody(object, map, object->SizeFromMap(map));
+  }
+
+  MarkingWorklist::Local local_worklist_;
+};
+
+
+void MarkCompactCollector::ParallelMarker::Run() {
+  HeapObject* object;
+  do {
+    while (local_worklist_.Pop(&object)) ProcessObject(object);
+  } while (local_worklist_.Steal());
+  DCHECK(local_worklist_.IsEmpty());
+}
+
+
+void MarkCompactCollector::ParallelMarker::Finalize(
+    MarkCompactCollector* collector) {
+  DCHECK(local_worklist_.IsEmpty());
+  FlushLiveBytesToHeap();
+  List<RecordedSlot>* recorded_slots = slots();
+  for (int i = 0; i < recorded_slots->length(); i++) {
+    RecordedSlot& recorded = recorded_slots->at(i);
+    collector->RecordSlot(recorded.host, recorded.slot, *recorded.slot);
+  }
+  // The objects are black and their live bytes have been counted above.
+  List<HeapObject*>* bailout_objects = bailout();
+  for (int i = 0; i < bailout_objects->length(); i++) {
+    collector->UnshiftBlack(bailout_objects->at(i));
+  }
+}
+
+
+class MarkCompactCollector::MarkingJob : public ParallelJob {
+ public:
+  MarkingJob(Isolate* isolate, MarkingWorklist* worklist,
+             ParallelMarker** markers)
+      : ParallelJob(isolate), worklist_(worklist), markers_(markers) {}
+
+ private:
+  void RunTask(int task_index) override {
+    // The main thread registered before the job started. Tasks that fail to
+    // register started after marking was complete.
+    if (task_index == 0 || worklist_->Register()) {
+      markers_[task_index]->Run();
+    }
+  }
+
+  MarkingWorklist* worklist_;
+  ParallelMarker** markers_;
+
+  DISALLOW_COPY_AND_ASSIGN(MarkingJob);
+};
+
+
+bool MarkCompactCollector::CanMarkInParallel() {
+  return FLAG_parallel_marking;
+}
+
+
+int MarkCompactCollector::NumberOfMarkingTasks() {
+  const int kMaxMarkingTasks = 8;
+  return ParallelJob::NumberOfTasks(kMaxMarkingTasks);
+}
+
+
+void MarkCompactCollector::MarkInParallel() {
+  DCHECK(CanMarkInParallel());
+  GCTracer::Scope gc_scope(heap()->tracer(), GCTracer::Scope::MC_MARK_PARALLEL);
+  MarkingWorklist worklist;
+  {
+    MarkingWorklist::Local initial_worklist(&worklist);
+    while (!marking_deque_.IsEmpty()) {
+      initial_worklist.Push(marking_deque_.Pop());
+    }
+    initial_worklist.FlushToGlobal();
+  }
+
+  const int num_tasks = NumberOfMarkingTasks();
+  ParallelMarker** markers = new ParallelMarker*[num_tasks];
+  for (int i = 0; i < num_tasks; i++) {
+    markers[i] = new ParallelMarker(heap(), &worklist);
+  }
+
+  // The main thread registers first, so that marking cannot be considered
+  // complete before it had a chance to steal work.
+  CHECK(worklist.Register());
+  MarkingJob job(isolate(), &worklist, markers);
+  job.Run(num_tasks);
+
+  for (int i = 0; i < num_tasks; i++) {
+    markers[i]->Finalize(this);
+    delete markers[i];
+  }
+  delete[] markers;
+}
+
+
+// Mark all objects reachable (transitively) from objects on the marking
+// stack. Parallel marking only empties the marking stack down to the objects
+// that need the regular marking visitor. These are visited on the main
+// thread and the objects they discover are left on the marking stack for the
+// next round of parallel marking.
+void MarkCompactCollector::ProcessMarkingDequeInParallel() {
+  const int kMinObjectsForParallelMarking = 64;
+  Map* filler_map = heap_->one_pointer_filler_map();
+  List<HeapObject*> objects;
+  do {
+    if (marking_deque_.overflowed()) RefillMarkingDeque();
+    while (!marking_deque_.IsEmpty()) {
+      if (marking_deque_.Length() >= kMinObjectsForParallelMarking) {
+        MarkInParallel();
+      }
+      while (!marking_deque_.IsEmpty()) {
+        objects.Add(marking_deque_.Pop());
+      }
+      for (int i = 0; i < objects.length(); i++) {
+        HeapObject* object = objects[i];
+        Map* map = object->map();
+        if (map == filler_map) continue;
+        DCHECK(!Marking::IsWhite(Marking::MarkBitFrom(object)));
+        MarkBit map_mark = Marking::MarkBitFrom(map);
+        MarkObject(map, map_mark);
+        MarkCompactMarkingVisitor::IterateBody(map, object);
+      }
+      objects.Rewind(0);
+    }
+  } while (marking_deque_.overflowed());
+}
+
+
 // Mark all objects reachable (transitively) from objects on the marking
 // stack including references only considered in the atomic marking pause.
 void MarkCompactCollector::ProcessEphemeralMarking(
@@ -2111,11 +2417,14 @@ void MarkCompactCollector::MarkLiveObjects() {
     heap_->tracer()->AddMarkingTime(heap_->MonotonicallyIncreasingTimeInMs() -
                                     start_time);
   }
-  if (FLAG_track_gc_object_stats) {
+  int object_stats_sampling_rate = ObjectStats::SamplingRate();
+  if (object_stats_sampling_rate > 0) {
+    ObjectStatsCollector collector(heap(), heap()->object_stats_);
+    collector.CollectStatistics(object_stats_sampling_rate);
     if (FLAG_trace_gc_object_stats) {
       heap()->object_stats_->TraceObjectStats();
     }
-    heap()->object_stats_->CheckpointObjectStats();
+    heap()->object_stats_->CheckpointObjectStats(object_stats_sampling_rate);
   }
 }
 
@@ -2838,7 +3147,9 @@ class PointersUpdatingVisitor : public ObjectVisitor {
              Page::FromAddress(heap_obj->address())
                  ->IsFlagSet(Page::COMPACTION_WAS_ABORTED));
       HeapObject* target = map_word.ToForwardingAddress();
-      base::NoBarrier_CompareAndSwap(
+      // The slot may be updated by several pointer updating tasks. The
+      // release store publishes the migrated object to the other tasks.
+      base::Release_CompareAndSwap(
           reinterpret_cast<base::AtomicWord*>(slot),
           reinterpret_cast<base::AtomicWord>(obj),
           reinterpret_cast<base::AtomicWord>(target));
@@ -3090,7 +3401,6 @@ class MarkCompactCollector::Evacuator : public Malloced {
         newspace_evacuation_candidates_(newspace_evacuation_candidates),
         compaction_spaces_(collector->heap()),
         local_slots_buffer_(nullptr),
-        local_store_buffer_(collector->heap()),
         local_pretenuring_feedback_(HashMap::PointersMatch,
                                     kInitialLocalPretenuringFeedbackCapacity),
         new_space_visitor_(collector->heap(), &compaction_spaces_,
@@ -3291,6 +3601,8 @@ void MarkCompactCollector::EvacuatePagesInParallel() {
   const int num_tasks = NumberOfParallelCompactionTasks(num_pages, live_bytes);
 
   // Set up compaction spaces.
+  CompactionSpace hot_code_space(heap(), CODE_SPACE, EXECUTABLE);
+  if (FLAG_hot_code_layout) hot_code_space_ = &hot_code_space;
   Evacuator** evacuators = new Evacuator*[num_tasks];
   for (int i = 0; i < num_tasks; i++) {
     evacuators[i] = new Evacuator(this, evacuation_candidates_,
@@ -3308,6 +3620,11 @@ void MarkCompactCollector::EvacuatePagesInParallel() {
     delete evacuators[i];
   }
   delete[] evacuators;
+  if (hot_code_space_ != nullptr) {
+    hot_code_pages_after_evacuation_ = hot_code_space_->CountTotalPages();
+    heap()->code_space()->MergeCompactionSpace(hot_code_space_);
+    hot_code_space_ = nullptr;
+  }
 
   // Finalize pages sequentially.
   for (NewSpacePage* p : newspace_evacuation_candidates_) {
@@ -3364,6 +3681,9 @@ void MarkCompactCollector::EvacuatePagesInParallel() {
                  base::SysInfo::NumberOfProcessors(), live_bytes,
                  compaction_speed);
   }
+  if (FLAG_trace_hot_code_layout && FLAG_hot_code_layout) {
+    ReportHotCodeLayout();
+  }
 }
 
 void MarkCompactCollector::StartParallelCompaction(Evacuator** evacuators,
@@ -3649,6 +3969,19 @@ void MarkCompactCollector::SweepAbortedPages() {
 }
 
 
+void MarkCompactCollector::ProcessArrayBuffersOfEvacuatedPages() {
+  // Forwarding addresses are still intact at this point, aborted pages have
+  // not been swept yet.
+  ArrayBufferTracker* tracker = heap()->array_buffer_tracker();
+  for (NewSpacePage* p : newspace_evacuation_candidates_) {
+    tracker->ProcessEvacuatedPage(p);
+  }
+  for (Page* p : evacuation_candidates_) {
+    tracker->ProcessEvacuatedPage(p);
+  }
+}
+
+
 void MarkCompactCollector::EvacuateNewSpaceAndCandidates() {
   GCTracer::Scope gc_scope(heap()->tracer(), GCTracer::Scope::MC_EVACUATE);
   Heap::RelocationLock relocation_lock(heap());
@@ -3660,6 +3993,7 @@ void MarkCompactCollector::EvacuateNewSpaceAndCandidates() {
 
     EvacuateNewSpacePrologue();
     EvacuatePagesInParallel();
+    ProcessArrayBuffersOfEvacuatedPages();
     EvacuateNewSpaceEpilogue();
     heap()->new_space()->set_age_mark(heap()->new_space()->top());
   }
@@ -3679,10 +4013,9 @@ void MarkCompactCollector::EvacuateNewSpaceAndCandidates() {
     // effectively overriding any forward pointers.
     SweepAbortedPages();
 
-    // EvacuateNewSpaceAndCandidates iterates over new space objects and for
-    // ArrayBuffers either re-registers them as live or promotes them. This is
-    // needed to properly free them.
-    heap()->array_buffer_tracker()->FreeDead(false);
+    // Backing stores of array buffers found dead during sweeping and
+    // evacuation are handed over to the background task.
+    heap()->array_buffer_tracker()->FreeDead();
 
     // Deallocate evacuated candidate pages.
     ReleaseEvacuationCandidates();
@@ -3696,50 +4029,162 @@ void MarkCompactCollector::EvacuateNewSpaceAndCandidates() {
 }
 
 
-void MarkCompactCollector::UpdatePointersAfterEvacuation() {
-  GCTracer::Scope gc_scope(heap()->tracer(),
-                           GCTracer::Scope::MC_EVACUATE_UPDATE_POINTERS);
-  {
-    GCTracer::Scope gc_scope(
-        heap()->tracer(),
-        GCTracer::Scope::MC_EVACUATE_UPDATE_POINTERS_TO_EVACUATED);
-    UpdateSlotsRecordedIn(migration_slots_buffer_);
+// Shared state of the parallel pointer updating phase. Work is split into
+// items of page granularity that are claimed by the main thread and the
+// pointer updating tasks until all of them are processed.
+class MarkCompactCollector::PointersUpdatingJob : public ItemParallelJob {
+ public:
+  explicit PointersUpdatingJob(Heap* heap)
+      : ItemParallelJob(heap->isolate()), heap_(heap) {}
+
+  // Slots recorded in a chain of slots buffers.
+  void AddSlotsBuffer(SlotsBuffer* buffer) {
+    if (buffer != nullptr) items_.Add(Item(Item::kSlotsBuffer, buffer, nullptr));
+  }
+
+  // The old-to-new remembered set of a chunk.
+  void AddOldToNewSlots(MemoryChunk* chunk) {
+    items_.Add(Item(Item::kOldToNewSlots, nullptr, chunk));
+  }
+
+  // All objects on a page in to-space.
+  void AddToSpacePage(NewSpacePage* page) {
+    items_.Add(Item(Item::kToSpacePage, nullptr, page));
+  }
+
+  int NumberOfItems() override { return items_.length(); }
+
+ protected:
+  void ProcessItem(int item) override { Process(items_[item]); }
+
+ private:
+  struct Item {
+    enum Kind { kSlotsBuffer, kOldToNewSlots, kToSpacePage };
+
+    Item() : kind(kSlotsBuffer), buffer(nullptr), chunk(nullptr) {}
+    Item(Kind kind, SlotsBuffer* buffer, MemoryChunk* chunk)
+        : kind(kind), buffer(buffer), chunk(chunk) {}
+
+    Kind kind;
+    SlotsBuffer* buffer;
+    MemoryChunk* chunk;
+  };
+
+  void Process(const Item& item) {
+    switch (item.kind) {
+      case Item::kSlotsBuffer:
+        heap_->mark_compact_collector()->UpdateSlotsRecordedIn(item.buffer);
+        break;
+      case Item::kOldToNewSlots:
+        RememberedSet<OLD_TO_NEW>::IterateChunkWithWrapper(heap_, item.chunk,
+                                                           UpdatePointer);
+        break;
+      case Item::kToSpacePage:
+        UpdateToSpacePage(item.chunk);
+        break;
+    }
+  }
+
+  void UpdateToSpacePage(MemoryChunk* page) {
+    PointersUpdatingVisitor visitor(heap_);
+    Address top = heap_->new_space()->top();
+    Address limit = page->ContainsLimit(top) ? top : page->area_end();
+    Address current = page->area_start();
+    while (current < limit) {
+      HeapObject* object = HeapObject::FromAddress(current);
+      Map* map = object->map();
+      int size = object->SizeFromMap(map);
+      if (!object->IsFiller()) {
+        object->IterateBody(map->instance_type(), size, &visitor);
+      }
+      current += size;
+    }
+  }
+
+  Heap* heap_;
+  List<Item> items_;
+
+  DISALLOW_COPY_AND_ASSIGN(PointersUpdatingJob);
+};
+
+
+int MarkCompactCollector::NumberOfPointerUpdatingTasks(int items) {
+  if (!FLAG_parallel_pointer_update) return 1;
+  // The number of tasks, including the main thread, is limited by:
+  // - #items / kItemsPerTask,
+  // - #cores,
+  // - kMaxPointerUpdatingTasks.
+  const int kItemsPerTask = 4;
+  const int kMaxPointerUpdatingTasks = 8;
+  int tasks = (items + kItemsPerTask - 1) / kItemsPerTask;
+  tasks = Min(tasks, base::SysInfo::NumberOfProcessors());
+  return Max(1, Min(tasks, kMaxPointerUpdatingTasks));
+}
+
+
+void MarkCompactCollector::UpdatePointersInParallel() {
+  GCTracer::Scope gc_scope(
+      heap()->tracer(), GCTracer::Scope::MC_EVACUATE_UPDATE_POINTERS_PARALLEL);
+  PointersUpdatingJob job(heap());
+
+  // Slots pointing to evacuated objects.
+  if (FLAG_trace_fragmentation_verbose) {
+    PrintF("  migration slots buffer: %d\n",
+           SlotsBuffer::SizeOfChain(migration_slots_buffer_));
+  }
+  job.AddSlotsBuffer(migration_slots_buffer_);
+  for (SlotsBuffer* buffer : evacuation_slots_buffers_) {
+    job.AddSlotsBuffer(buffer);
+  }
+  for (Page* p : evacuation_candidates_) {
+    if (!p->IsEvacuationCandidate()) continue;
     if (FLAG_trace_fragmentation_verbose) {
-      PrintF("  migration slots buffer: %d\n",
-             SlotsBuffer::SizeOfChain(migration_slots_buffer_));
+      PrintF("  page %p slots buffer: %d\n", reinterpret_cast<void*>(p),
+             SlotsBuffer::SizeOfChain(p->slots_buffer()));
     }
-    slots_buffer_allocator_->DeallocateChain(&migration_slots_buffer_);
-    DCHECK(migration_slots_buffer_ == NULL);
+    job.AddSlotsBuffer(p->slots_buffer());
+  }
 
-    // TODO(hpayer): Process the slots buffers in parallel. This has to be done
-    // after evacuation of all pages finishes.
-    int buffers = evacuation_slots_buffers_.length();
-    for (int i = 0; i < buffers; i++) {
-      SlotsBuffer* buffer = evacuation_slots_buffers_[i];
-      UpdateSlotsRecordedIn(buffer);
-      slots_buffer_allocator_->DeallocateChain(&buffer);
+  // Slots pointing to new space.
+  NewSpacePageIterator it(heap()->new_space()->bottom(),
+                          heap()->new_space()->top());
+  while (it.has_next()) {
+    job.AddToSpacePage(it.next());
+  }
+  PointerChunkIterator chunks(heap());
+  MemoryChunk* chunk;
+  while ((chunk = chunks.next()) != nullptr) {
+    if (RememberedSet<OLD_TO_NEW>::HasSlots(chunk)) {
+      job.AddOldToNewSlots(chunk);
     }
-    evacuation_slots_buffers_.Rewind(0);
   }
 
-  // Second pass: find pointers to new space and update them.
+  job.Run(NumberOfPointerUpdatingTasks(job.NumberOfItems()));
+
+  slots_buffer_allocator_->DeallocateChain(&migration_slots_buffer_);
+  DCHECK(migration_slots_buffer_ == NULL);
+  for (SlotsBuffer* buffer : evacuation_slots_buffers_) {
+    slots_buffer_allocator_->DeallocateChain(&buffer);
+  }
+  evacuation_slots_buffers_.Rewind(0);
+}
+
+
+void MarkCompactCollector::UpdatePointersAfterEvacuation() {
+  GCTracer::Scope gc_scope(heap()->tracer(),
+                           GCTracer::Scope::MC_EVACUATE_UPDATE_POINTERS);
+  // Slots recorded in slots buffers and remembered sets as well as objects in
+  // to-space are updated in parallel. Updating a slot is idempotent, so slots
+  // that are reachable through several items are safe.
+  UpdatePointersInParallel();
+
   PointersUpdatingVisitor updating_visitor(heap());
 
   {
     GCTracer::Scope gc_scope(
         heap()->tracer(), GCTracer::Scope::MC_EVACUATE_UPDATE_POINTERS_TO_NEW);
-    // Update pointers in to space.
-    SemiSpaceIterator to_it(heap()->new_space());
-    for (HeapObject* object = to_it.Next(); object != NULL;
-         object = to_it.Next()) {
-      Map* map = object->map();
-      object->IterateBody(map->instance_type(), object->SizeFromMap(map),
-                          &updating_visitor);
-    }
     // Update roots.
     heap_->IterateRoots(&updating_visitor, VISIT_ALL_IN_SWEEP_NEWSPACE);
-
-    RememberedSet<OLD_TO_NEW>::IterateWithWrapper(heap_, UpdatePointer);
   }
 
   {
@@ -3751,11 +4196,7 @@ void MarkCompactCollector::UpdatePointersAfterEvacuation() {
              p->IsFlagSet(Page::RESCAN_ON_EVACUATION));
 
       if (p->IsEvacuationCandidate()) {
-        UpdateSlotsRecordedIn(p->slots_buffer());
-        if (FLAG_trace_fragmentation_verbose) {
-          PrintF("  page %p slots buffer: %d\n", reinterpret_cast<void*>(p),
-                 SlotsBuffer::SizeOfChain(p->slots_buffer()));
-        }
+        // The slots buffer has been processed by UpdatePointersInParallel.
         slots_buffer_allocator_->DeallocateChain(p->slots_buffer_address());
 
         // Important: skip list should be cleared only after roots were updated
@@ -3961,6 +4402,10 @@ void MarkCompactCollector::SweepSpaces() {
   state_ = SWEEP_SPACES;
 #endif
 
+  // Array buffers are looked up by their mark bits, which are not reliable
+  // anymore once sweeping started.
+  heap()->array_buffer_tracker()->FreeDeadInOldSpace();
+
   {
     sweeping_in_progress_ = true;
     {
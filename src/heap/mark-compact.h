@@ -8,6 +8,7 @@
 #include "src/base/bits.h"
 #include "src/heap/spaces.h"
 #include "src/heap/store-buffer.h"
+#include "src/heap/worklist.h"
 
 namespace v8 {
 namespace internal {
@@ -116,11 +117,51 @@ class Marking : public AllStatic {
     BlackToGrey(MarkBitFrom(obj));
   }
 
+  // Atomic color checks and transitions for concurrent and parallel marking.
+  // The transitions return false if another thread performed them first.
+  INLINE(static bool IsBlackAtomic(MarkBit mark_bit)) {
+    return mark_bit.GetAtomic() && mark_bit.Next().GetAtomic();
+  }
+
+  INLINE(static bool IsWhiteAtomic(MarkBit mark_bit)) {
+    return !mark_bit.GetAtomic();
+  }
+
+  INLINE(static bool WhiteToGreyAtomic(MarkBit markbit)) {
+    return markbit.SetAtomic();
+  }
+
+  INLINE(static bool GreyToBlackAtomic(MarkBit markbit)) {
+    return markbit.Next().SetAtomic();
+  }
+
+  // The first bit decides which thread wins. Other threads may observe the
+  // object as grey until the second bit is set.
+  INLINE(static bool WhiteToBlackAtomic(MarkBit markbit)) {
+    if (!markbit.SetAtomic()) return false;
+    bool second_bit_set = markbit.Next().SetAtomic();
+    DCHECK(second_bit_set);
+    USE(second_bit_set);
+    return true;
+  }
+
   INLINE(static void AnyToGrey(MarkBit markbit)) {
     markbit.Set();
     markbit.Next().Clear();
   }
 
+  // Main thread transitions that may run while the concurrent marker updates
+  // other bits of the same cell.
+  INLINE(static void BlackToGreyAtomic(MarkBit markbit)) {
+    DCHECK(IsBlack(markbit));
+    markbit.Next().ClearAtomic();
+  }
+
+  INLINE(static void AnyToGreyAtomic(MarkBit markbit)) {
+    markbit.SetAtomic();
+    markbit.Next().ClearAtomic();
+  }
+
   static void TransferMark(Heap* heap, Address old_start, Address new_start);
 
 #ifdef DEBUG
@@ -196,6 +237,8 @@ class MarkingDeque {
 
   inline bool IsEmpty() { return top_ == bottom_; }
 
+  inline int Length() { return (top_ - bottom_) & mask_; }
+
   bool overflowed() const { return overflowed_; }
 
   bool in_use() const { return in_use_; }
@@ -338,6 +381,10 @@ class MarkCompactCollector {
 
   void AddEvacuationCandidate(Page* p);
 
+  // Code that is likely to be executed frequently. With --hot-code-layout
+  // hot code is evacuated to its own pages to reduce the code working set.
+  static bool IsHotCode(Code* code);
+
   // Prepares for GC by resetting relocation info in old and map spaces and
   // choosing spaces to compact.
   void Prepare();
@@ -513,8 +560,12 @@ class MarkCompactCollector {
   class EvacuateVisitorBase;
   class Evacuator;
   class HeapObjectVisitor;
+  class MarkingJob;
+  class ParallelMarker;
+  class PointersUpdatingJob;
   class SweeperTask;
 
+  typedef Worklist<HeapObject*> MarkingWorklist;
   typedef std::vector<Page*> SweepingList;
 
   explicit MarkCompactCollector(Heap* heap);
@@ -529,6 +580,16 @@ class MarkCompactCollector {
                                    int* target_fragmentation_percent,
                                    int* max_evacuated_bytes);
 
+  // Selects code space pages that mix hot and cold code as additional
+  // evacuation candidates, as long as the evacuated bytes stay within
+  // |max_evacuated_bytes|. Also records the code working set, i.e. the pages
+  // containing hot code, before evacuation.
+  void CollectHotCodeEvacuationCandidates(
+      const std::vector<std::pair<int, Page*> >& pages,
+      int max_evacuated_bytes);
+
+  void ReportHotCodeLayout();
+
 #ifdef DEBUG
   enum CollectorState {
     IDLE,
@@ -610,6 +671,23 @@ class MarkCompactCollector {
   // or overflowed in the heap.
   void ProcessMarkingDeque();
 
+  // Parallel marking support (--parallel_marking). Objects on the marking
+  // stack are marked through by several tasks that only visit objects without
+  // special marking semantics. All other objects are handed back to the
+  // main thread.
+  bool CanMarkInParallel();
+
+  // The number of parallel marking tasks, including the main thread.
+  int NumberOfMarkingTasks();
+
+  // Like {ProcessMarkingDeque}, but alternates between parallel marking and
+  // visiting the objects that were handed back on the main thread.
+  void ProcessMarkingDequeInParallel();
+
+  // Empties the marking stack using parallel marking tasks. Objects that
+  // cannot be visited in parallel are pushed back onto the marking stack.
+  void MarkInParallel();
+
   // Mark objects reachable (transitively) from objects in the marking stack
   // or overflowed in the heap.  This respects references only considered in
   // the final atomic marking pause including the following:
@@ -707,6 +785,10 @@ class MarkCompactCollector {
   void EvacuateNewSpacePrologue();
   void EvacuateNewSpaceEpilogue();
 
+  // Moves the backing stores of evacuated array buffers to the trackers of
+  // their new pages and frees the dead ones of the evacuated pages.
+  void ProcessArrayBuffersOfEvacuatedPages();
+
   void AddEvacuationSlotsBufferSynchronized(
       SlotsBuffer* evacuation_slots_buffer);
 
@@ -722,6 +804,13 @@ class MarkCompactCollector {
 
   void UpdatePointersAfterEvacuation();
 
+  // The number of parallel pointer updating tasks, including the main thread.
+  int NumberOfPointerUpdatingTasks(int items);
+
+  // Updates slots recorded in slots buffers and the old-to-new remembered set
+  // and pointers in to-space objects using page granular tasks.
+  void UpdatePointersInParallel();
+
   // Iterates through all live objects on a page using marking information.
   // Returns whether all objects have successfully been visited.
   bool VisitLiveObjects(MemoryChunk* page, HeapObjectVisitor* visitor,
@@ -774,6 +863,19 @@ class MarkCompactCollector {
   List<Page*> evacuation_candidates_;
   List<NewSpacePage*> newspace_evacuation_candidates_;
 
+  // Code working set bookkeeping for --hot-code-layout: the number of code
+  // pages with hot code before evacuation, the evacuation candidates among
+  // them, and the number of pages the hot code was evacuated to.
+  int hot_code_pages_before_evacuation_;
+  List<Page*> hot_code_evacuation_candidates_;
+  int hot_code_pages_after_evacuation_;
+
+  // Space that all evacuators move hot code into during evacuation, so that
+  // hot code is packed onto as few pages as possible. Allocation in it is
+  // guarded by hot_code_space_mutex_.
+  CompactionSpace* hot_code_space_;
+  base::Mutex hot_code_space_mutex_;
+
   // The evacuation_slots_buffers_ are used by the compaction threads.
   // When a compaction task finishes, it uses
   // AddEvacuationSlotsbufferSynchronized to adds its slots buffer to the
@@ -811,72 +913,111 @@ class MarkCompactCollector {
 };
 
 
-class MarkBitCellIterator BASE_EMBEDDED {
- public:
-  explicit MarkBitCellIterator(MemoryChunk* chunk) : chunk_(chunk) {
-    last_cell_index_ = Bitmap::IndexToCell(Bitmap::CellAlignIndex(
-        chunk_->AddressToMarkbitIndex(chunk_->area_end())));
-    cell_base_ = chunk_->area_start();
-    cell_index_ = Bitmap::IndexToCell(
-        Bitmap::CellAlignIndex(chunk_->AddressToMarkbitIndex(cell_base_)));
-    cells_ = chunk_->markbits()->cells();
-  }
-
-  inline bool Done() { return cell_index_ == last_cell_index_; }
-
-  inline bool HasNext() { return cell_index_ < last_cell_index_ - 1; }
-
-  inline MarkBit::CellType* CurrentCell() {
-    DCHECK(cell_index_ == Bitmap::IndexToCell(Bitmap::CellAlignIndex(
-                              chunk_->AddressToMarkbitIndex(cell_base_))));
-    return &cells_[cell_index_];
-  }
+enum LiveObjectIterationMode { kBlackObjects, kGreyObjects, kAllLiveObjects };
 
-  inline Address CurrentCellBase() {
-    DCHECK(cell_index_ == Bitmap::IndexToCell(Bitmap::CellAlignIndex(
-                              chunk_->AddressToMarkbitIndex(cell_base_))));
-    return cell_base_;
+// Iterates over the mark bits of objects in a range of mark bit cells, 64 mark
+// bits at a time. Unmarked parts of the bitmap are skipped a whole word at a
+// time and objects within a word are found by counting trailing zeros. Next()
+// returns the index of the first mark bit of the next object with color T,
+// relative to the first cell of the range, or kDone.
+template <LiveObjectIterationMode T>
+class MarkBitWordIterator BASE_EMBEDDED {
+ public:
+  static const int kDone = -1;
+
+  MarkBitWordIterator(MarkBit::CellType* cells, uint32_t cell_count)
+      : cells_(cells),
+        cell_count_(cell_count),
+        cell_index_(0),
+        word_base_index_(0),
+        current_word_(cell_count > 0 ? LoadWord(0) : 0) {}
+
+  inline int Next() {
+    while (true) {
+      while (current_word_ == 0) {
+        if (!Advance()) return kDone;
+      }
+      unsigned first_bit = base::bits::CountTrailingZeros64(current_word_);
+      int index = word_base_index_ + static_cast<int>(first_bit);
+      current_word_ = base::bits::ClearLowestSetBit64(current_word_);
+      bool second_bit;
+      if (first_bit < kBitsPerWord - 1) {
+        uint64_t mask = static_cast<uint64_t>(1) << (first_bit + 1);
+        second_bit = (current_word_ & mask) != 0;
+        current_word_ &= ~mask;
+      } else {
+        // The overlapping case; the second mark bit is the first bit of the
+        // next word, which has to exist.
+        bool has_next = Advance();
+        DCHECK(has_next);
+        USE(has_next);
+        second_bit = (current_word_ & 1) != 0;
+        current_word_ &= ~static_cast<uint64_t>(1);
+      }
+      if (T == kAllLiveObjects || second_bit == (T == kBlackObjects)) {
+        return index;
+      }
+    }
   }
 
-  inline void Advance() {
-    cell_index_++;
-    cell_base_ += 32 * kPointerSize;
+ private:
+  static const int kBitsPerWord = 64;
+
+  // Combines the two cells of a word. This does not depend on the byte order
+  // or the alignment of the bitmap.
+  inline uint64_t LoadWord(uint32_t cell) {
+    uint64_t low = cells_[cell];
+    uint64_t high = (cell + 1 < cell_count_) ? cells_[cell + 1] : 0;
+    return low | (high << Bitmap::kBitsPerCell);
   }
 
-  // Return the next mark bit cell. If there is no next it returns 0;
-  inline MarkBit::CellType PeekNext() {
-    if (HasNext()) {
-      return cells_[cell_index_ + 1];
+  inline bool Advance() {
+    cell_index_ += 2;
+    word_base_index_ += kBitsPerWord;
+    if (cell_index_ >= cell_count_) {
+      current_word_ = 0;
+      return false;
     }
-    return 0;
+    current_word_ = LoadWord(cell_index_);
+    return true;
   }
 
- private:
-  MemoryChunk* chunk_;
   MarkBit::CellType* cells_;
-  unsigned int last_cell_index_;
-  unsigned int cell_index_;
-  Address cell_base_;
+  uint32_t cell_count_;
+  // Index of the low cell of the current word.
+  uint32_t cell_index_;
+  // Mark bit index of the first bit of the current word.
+  int word_base_index_;
+  uint64_t current_word_;
 };
 
-enum LiveObjectIterationMode { kBlackObjects, kGreyObjects, kAllLiveObjects };
 
 template <LiveObjectIterationMode T>
 class LiveObjectIterator BASE_EMBEDDED {
  public:
   explicit LiveObjectIterator(MemoryChunk* chunk)
-      : chunk_(chunk),
-        it_(chunk_),
-        cell_base_(it_.CurrentCellBase()),
-        current_cell_(*it_.CurrentCell()) {}
+      : cell_base_(chunk->area_start()),
+        it_(chunk->markbits()->cells() + FirstCell(chunk),
+            LastCell(chunk) - FirstCell(chunk)) {
+    DCHECK_EQ(Bitmap::CellToIndex(FirstCell(chunk)),
+              chunk->AddressToMarkbitIndex(cell_base_));
+  }
 
   HeapObject* Next();
 
  private:
-  MemoryChunk* chunk_;
-  MarkBitCellIterator it_;
+  static uint32_t FirstCell(MemoryChunk* chunk) {
+    return Bitmap::IndexToCell(Bitmap::CellAlignIndex(
+        chunk->AddressToMarkbitIndex(chunk->area_start())));
+  }
+
+  static uint32_t LastCell(MemoryChunk* chunk) {
+    return Bitmap::IndexToCell(Bitmap::CellAlignIndex(
+        chunk->AddressToMarkbitIndex(chunk->area_end())));
+  }
+
   Address cell_base_;
-  MarkBit::CellType current_cell_;
+  MarkBitWordIterator<T> it_;
 };
 
 
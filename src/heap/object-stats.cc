@@ -6,6 +6,7 @@
 
 #include "src/counters.h"
 #include "src/heap/heap-inl.h"
+#include "src/heap/mark-compact-inl.h"
 #include "src/isolate.h"
 #include "src/utils.h"
 
@@ -73,7 +74,7 @@ void ObjectStats::TraceObjectStats() {
 }
 
 
-void ObjectStats::CheckpointObjectStats() {
+void ObjectStats::CheckpointObjectStats(int sampling_rate) {
   base::LockGuard<base::Mutex> lock_guard(object_stats_mutex.Pointer());
   Counters* counters = isolate()->counters();
 #define ADJUST_LAST_TIME_OBJECT_COUNT(name)              \
@@ -128,6 +129,8 @@ void ObjectStats::CheckpointObjectStats() {
 
   MemCopy(object_counts_last_time_, object_counts_, sizeof(object_counts_));
   MemCopy(object_sizes_last_time_, object_sizes_, sizeof(object_sizes_));
+  gc_count_last_time_ = heap()->ms_count();
+  sampling_rate_last_time_ = sampling_rate;
   ClearObjectStats();
 }
 
@@ -135,117 +138,129 @@ void ObjectStats::CheckpointObjectStats() {
 Isolate* ObjectStats::isolate() { return heap()->isolate(); }
 
 
-void ObjectStatsVisitor::CountFixedArray(
-    FixedArrayBase* fixed_array, FixedArraySubInstanceType fast_type,
-    FixedArraySubInstanceType dictionary_type) {
-  Heap* heap = fixed_array->map()->GetHeap();
-  if (fixed_array->map() != heap->fixed_cow_array_map() &&
-      fixed_array->map() != heap->fixed_double_array_map() &&
-      fixed_array != heap->empty_fixed_array()) {
-    if (fixed_array->IsDictionary()) {
-      heap->object_stats_->RecordFixedArraySubTypeStats(dictionary_type,
-                                                        fixed_array->Size());
-    } else {
-      heap->object_stats_->RecordFixedArraySubTypeStats(fast_type,
-                                                        fixed_array->Size());
+void ObjectStatsCollector::CollectStatistics(int sampling_rate) {
+  DCHECK_GT(sampling_rate, 0);
+  // Pick a different subset of the pages at every mark-compact.
+  int offset = heap_->ms_count() % sampling_rate;
+  int index = 0;
+  stats_->set_weight(sampling_rate);
+  NewSpacePageIterator new_space_it(heap_->new_space());
+  while (new_space_it.has_next()) {
+    NewSpacePage* page = new_space_it.next();
+    if (index++ % sampling_rate == offset) CollectStatistics(page);
+  }
+  PagedSpaces spaces(heap_);
+  for (PagedSpace* space = spaces.next(); space != NULL;
+       space = spaces.next()) {
+    PageIterator it(space);
+    while (it.has_next()) {
+      Page* page = it.next();
+      if (index++ % sampling_rate == offset) CollectStatistics(page);
     }
   }
+  stats_->set_weight(1);
+  LargeObjectIterator lo_it(heap_->lo_space());
+  for (HeapObject* obj = lo_it.Next(); obj != NULL; obj = lo_it.Next()) {
+    if (Marking::IsBlack(Marking::MarkBitFrom(obj))) CollectStatistics(obj);
+  }
 }
 
 
-void ObjectStatsVisitor::VisitBase(VisitorId id, Map* map, HeapObject* obj) {
-  Heap* heap = map->GetHeap();
-  int object_size = obj->Size();
-  heap->object_stats_->RecordObjectStats(map->instance_type(), object_size);
-  table_.GetVisitorById(id)(map, obj);
-  if (obj->IsJSObject()) {
-    JSObject* object = JSObject::cast(obj);
-    CountFixedArray(object->elements(), DICTIONARY_ELEMENTS_SUB_TYPE,
-                    FAST_ELEMENTS_SUB_TYPE);
-    CountFixedArray(object->properties(), DICTIONARY_PROPERTIES_SUB_TYPE,
-                    FAST_PROPERTIES_SUB_TYPE);
+void ObjectStatsCollector::CollectStatistics(MemoryChunk* chunk) {
+  LiveObjectIterator<kBlackObjects> it(chunk);
+  HeapObject* obj = nullptr;
+  while ((obj = it.Next()) != nullptr) {
+    CollectStatistics(obj);
   }
 }
 
 
-template <ObjectStatsVisitor::VisitorId id>
-void ObjectStatsVisitor::Visit(Map* map, HeapObject* obj) {
-  VisitBase(id, map, obj);
+void ObjectStatsCollector::CollectStatistics(HeapObject* obj) {
+  Map* map = obj->map();
+  stats_->RecordObjectStats(map->instance_type(), obj->Size());
+  switch (map->instance_type()) {
+    case MAP_TYPE:
+      RecordMapDetails(Map::cast(obj));
+      break;
+    case CODE_TYPE:
+      RecordCodeDetails(Code::cast(obj));
+      break;
+    case SHARED_FUNCTION_INFO_TYPE:
+      RecordSharedFunctionInfoDetails(SharedFunctionInfo::cast(obj));
+      break;
+    case FIXED_ARRAY_TYPE:
+      RecordFixedArrayDetails(FixedArray::cast(obj));
+      break;
+    default:
+      break;
+  }
+  if (obj->IsJSObject()) RecordJSObjectDetails(JSObject::cast(obj));
 }
 
 
-template <>
-void ObjectStatsVisitor::Visit<ObjectStatsVisitor::kVisitMap>(Map* map,
-                                                              HeapObject* obj) {
-  Heap* heap = map->GetHeap();
-  Map* map_obj = Map::cast(obj);
-  DCHECK(map->instance_type() == MAP_TYPE);
+void ObjectStatsCollector::RecordMapDetails(Map* map_obj) {
   DescriptorArray* array = map_obj->instance_descriptors();
-  if (map_obj->owns_descriptors() && array != heap->empty_descriptor_array()) {
+  if (map_obj->owns_descriptors() && array != heap_->empty_descriptor_array()) {
     int fixed_array_size = array->Size();
-    heap->object_stats_->RecordFixedArraySubTypeStats(DESCRIPTOR_ARRAY_SUB_TYPE,
-                                                      fixed_array_size);
+    stats_->RecordFixedArraySubTypeStats(DESCRIPTOR_ARRAY_SUB_TYPE,
+                                         fixed_array_size);
   }
   if (map_obj->has_code_cache()) {
     CodeCache* cache = CodeCache::cast(map_obj->code_cache());
-    heap->object_stats_->RecordFixedArraySubTypeStats(
-        MAP_CODE_CACHE_SUB_TYPE, cache->default_cache()->Size());
+    stats_->RecordFixedArraySubTypeStats(MAP_CODE_CACHE_SUB_TYPE,
+                                         cache->default_cache()->Size());
     if (!cache->normal_type_cache()->IsUndefined()) {
-      heap->object_stats_->RecordFixedArraySubTypeStats(
+      stats_->RecordFixedArraySubTypeStats(
           MAP_CODE_CACHE_SUB_TYPE,
           FixedArray::cast(cache->normal_type_cache())->Size());
     }
   }
-  VisitBase(kVisitMap, map, obj);
 }
 
 
-template <>
-void ObjectStatsVisitor::Visit<ObjectStatsVisitor::kVisitCode>(
-    Map* map, HeapObject* obj) {
-  Heap* heap = map->GetHeap();
-  int object_size = obj->Size();
-  DCHECK(map->instance_type() == CODE_TYPE);
-  Code* code_obj = Code::cast(obj);
-  heap->object_stats_->RecordCodeSubTypeStats(code_obj->kind(),
-                                              code_obj->GetAge(), object_size);
-  VisitBase(kVisitCode, map, obj);
+void ObjectStatsCollector::RecordCodeDetails(Code* code) {
+  stats_->RecordCodeSubTypeStats(code->kind(), code->GetAge(), code->Size());
 }
 
 
-template <>
-void ObjectStatsVisitor::Visit<ObjectStatsVisitor::kVisitSharedFunctionInfo>(
-    Map* map, HeapObject* obj) {
-  Heap* heap = map->GetHeap();
-  SharedFunctionInfo* sfi = SharedFunctionInfo::cast(obj);
-  if (sfi->scope_info() != heap->empty_fixed_array()) {
-    heap->object_stats_->RecordFixedArraySubTypeStats(
+void ObjectStatsCollector::RecordSharedFunctionInfoDetails(
+    SharedFunctionInfo* sfi) {
+  if (sfi->scope_info() != heap_->empty_fixed_array()) {
+    stats_->RecordFixedArraySubTypeStats(
         SCOPE_INFO_SUB_TYPE, FixedArray::cast(sfi->scope_info())->Size());
   }
-  VisitBase(kVisitSharedFunctionInfo, map, obj);
 }
 
 
-template <>
-void ObjectStatsVisitor::Visit<ObjectStatsVisitor::kVisitFixedArray>(
-    Map* map, HeapObject* obj) {
-  Heap* heap = map->GetHeap();
-  FixedArray* fixed_array = FixedArray::cast(obj);
-  if (fixed_array == heap->string_table()) {
-    heap->object_stats_->RecordFixedArraySubTypeStats(STRING_TABLE_SUB_TYPE,
-                                                      fixed_array->Size());
+void ObjectStatsCollector::RecordFixedArrayDetails(FixedArray* fixed_array) {
+  if (fixed_array == heap_->string_table()) {
+    stats_->RecordFixedArraySubTypeStats(STRING_TABLE_SUB_TYPE,
+                                         fixed_array->Size());
   }
-  VisitBase(kVisitFixedArray, map, obj);
 }
 
 
-void ObjectStatsVisitor::Initialize(VisitorDispatchTable<Callback>* original) {
-  // Copy the original visitor table to make call-through possible. After we
-  // preserved a copy locally, we patch the original table to call us.
-  table_.CopyFrom(original);
-#define COUNT_FUNCTION(id) original->Register(kVisit##id, Visit<kVisit##id>);
-  VISITOR_ID_LIST(COUNT_FUNCTION)
-#undef COUNT_FUNCTION
+void ObjectStatsCollector::RecordJSObjectDetails(JSObject* object) {
+  CountFixedArray(object->elements(), FAST_ELEMENTS_SUB_TYPE,
+                  DICTIONARY_ELEMENTS_SUB_TYPE);
+  CountFixedArray(object->properties(), FAST_PROPERTIES_SUB_TYPE,
+                  DICTIONARY_PROPERTIES_SUB_TYPE);
+}
+
+
+void ObjectStatsCollector::CountFixedArray(
+    FixedArrayBase* fixed_array, FixedArraySubInstanceType fast_type,
+    FixedArraySubInstanceType dictionary_type) {
+  if (fixed_array->map() != heap_->fixed_cow_array_map() &&
+      fixed_array->map() != heap_->fixed_double_array_map() &&
+      fixed_array != heap_->empty_fixed_array()) {
+    if (fixed_array->IsDictionary()) {
+      stats_->RecordFixedArraySubTypeStats(dictionary_type,
+                                           fixed_array->Size());
+    } else {
+      stats_->RecordFixedArraySubTypeStats(fast_type, fixed_array->Size());
+    }
+  }
 }
 
 }  // namespace internal
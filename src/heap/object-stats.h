@@ -6,7 +6,6 @@
 #define V8_HEAP_OBJECT_STATS_H_
 
 #include "src/heap/heap.h"
-#include "src/heap/objects-visiting.h"
 #include "src/objects.h"
 
 namespace v8 {
@@ -14,7 +13,11 @@ namespace internal {
 
 class ObjectStats {
  public:
-  explicit ObjectStats(Heap* heap) : heap_(heap) {}
+  explicit ObjectStats(Heap* heap)
+      : heap_(heap),
+        weight_(1),
+        gc_count_last_time_(0),
+        sampling_rate_last_time_(0) {}
 
   // ObjectStats are kept in two arrays, counts and sizes. Related stats are
   // stored in a contiguous linear buffer. Stats groups are stored one after
@@ -28,16 +31,28 @@ class ObjectStats {
     OBJECT_STATS_COUNT = FIRST_CODE_AGE_SUB_TYPE + Code::kCodeAgeCount + 1
   };
 
+  // Returns the fraction of pages, 1 in n, whose objects are recorded at
+  // mark-compact. 1 means exact statistics, 0 means object statistics are
+  // not tracked.
+  static int SamplingRate() {
+    if (FLAG_track_gc_object_stats) return 1;
+    return FLAG_gc_object_stats_sampling_rate;
+  }
+
   void ClearObjectStats(bool clear_last_time_stats = false);
 
   void TraceObjectStats();
   void TraceObjectStat(const char* name, int count, int size, double time);
-  void CheckpointObjectStats();
+  void CheckpointObjectStats(int sampling_rate);
+
+  // Every object recorded from now on stands for |weight| objects, e.g. the
+  // sampling rate for objects on sampled pages.
+  void set_weight(size_t weight) { weight_ = weight; }
 
   void RecordObjectStats(InstanceType type, size_t size) {
     DCHECK(type <= LAST_TYPE);
-    object_counts_[type]++;
-    object_sizes_[type] += size;
+    object_counts_[type] += weight_;
+    object_sizes_[type] += size * weight_;
   }
 
   void RecordCodeSubTypeStats(int code_sub_type, int code_age, size_t size) {
@@ -48,16 +63,17 @@ class ObjectStats {
            code_sub_type_index < FIRST_CODE_AGE_SUB_TYPE);
     DCHECK(code_age_index >= FIRST_CODE_AGE_SUB_TYPE &&
            code_age_index < OBJECT_STATS_COUNT);
-    object_counts_[code_sub_type_index]++;
-    object_sizes_[code_sub_type_index] += size;
-    object_counts_[code_age_index]++;
-    object_sizes_[code_age_index] += size;
+    object_counts_[code_sub_type_index] += weight_;
+    object_sizes_[code_sub_type_index] += size * weight_;
+    object_counts_[code_age_index] += weight_;
+    object_sizes_[code_age_index] += size * weight_;
   }
 
   void RecordFixedArraySubTypeStats(int array_sub_type, size_t size) {
     DCHECK(array_sub_type <= LAST_FIXED_ARRAY_SUB_TYPE);
-    object_counts_[FIRST_FIXED_ARRAY_SUB_TYPE + array_sub_type]++;
-    object_sizes_[FIRST_FIXED_ARRAY_SUB_TYPE + array_sub_type] += size;
+    object_counts_[FIRST_FIXED_ARRAY_SUB_TYPE + array_sub_type] += weight_;
+    object_sizes_[FIRST_FIXED_ARRAY_SUB_TYPE + array_sub_type] +=
+        size * weight_;
   }
 
   size_t object_count_last_gc(size_t index) {
@@ -68,11 +84,22 @@ class ObjectStats {
     return object_sizes_last_time_[index];
   }
 
+  // The number of the mark-compact that produced the last checkpoint, 0 if
+  // there was none yet.
+  int gc_count_last_time() { return gc_count_last_time_; }
+
+  // The sampling rate the statistics of the last checkpoint were collected
+  // with. Their counts and sizes are already scaled by it.
+  int sampling_rate_last_time() { return sampling_rate_last_time_; }
+
   Isolate* isolate();
   Heap* heap() { return heap_; }
 
  private:
   Heap* heap_;
+  size_t weight_;
+  int gc_count_last_time_;
+  int sampling_rate_last_time_;
 
   // Object counts and used memory by InstanceType
   size_t object_counts_[OBJECT_STATS_COUNT];
@@ -82,18 +109,34 @@ class ObjectStats {
 };
 
 
-class ObjectStatsVisitor : public StaticMarkingVisitor<ObjectStatsVisitor> {
+// Records the statistics of the objects that are live after marking. The
+// marked objects of one in |sampling_rate| pages of the paged spaces and the
+// new space are visited and stand for the objects of the skipped pages, so
+// that statistics can be collected at a fraction of the cost of visiting the
+// whole heap. Large objects are always recorded exactly.
+class ObjectStatsCollector {
  public:
-  static void Initialize(VisitorDispatchTable<Callback>* original);
+  ObjectStatsCollector(Heap* heap, ObjectStats* stats)
+      : heap_(heap), stats_(stats) {}
 
-  static void VisitBase(VisitorId id, Map* map, HeapObject* obj);
+  void CollectStatistics(int sampling_rate);
 
-  static void CountFixedArray(FixedArrayBase* fixed_array,
-                              FixedArraySubInstanceType fast_type,
-                              FixedArraySubInstanceType dictionary_type);
+ private:
+  void CollectStatistics(MemoryChunk* chunk);
+  void CollectStatistics(HeapObject* obj);
+
+  void RecordMapDetails(Map* map);
+  void RecordCodeDetails(Code* code);
+  void RecordSharedFunctionInfoDetails(SharedFunctionInfo* sfi);
+  void RecordFixedArrayDetails(FixedArray* fixed_array);
+  void RecordJSObjectDetails(JSObject* object);
 
-  template <VisitorId id>
-  static inline void Visit(Map* map, HeapObject* obj);
+  void CountFixedArray(FixedArrayBase* fixed_array,
+                       FixedArraySubInstanceType fast_type,
+                       FixedArraySubInstanceType dictionary_type);
+
+  Heap* heap_;
+  ObjectStats* stats_;
 };
 
 }  // namespace internal
@@ -0,0 +1,125 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_PARALLEL_MARKING_VISITOR_H_
+#define V8_HEAP_PARALLEL_MARKING_VISITOR_H_
+
+#include "src/base/atomicops.h"
+#include "src/hashmap.h"
+#include "src/heap/spaces.h"
+#include "src/list.h"
+#include "src/objects.h"
+
+namespace v8 {
+namespace internal {
+
+// Slot in an object marked off the main thread that points into an
+// evacuation candidate. The slot is recorded on the main thread later on.
+struct RecordedSlot {
+  RecordedSlot() : host(nullptr), slot(nullptr) {}
+  RecordedSlot(HeapObject* host, Object** slot) : host(host), slot(slot) {}
+
+  HeapObject* host;
+  Object** slot;
+};
+
+
+// Base of the visitors that mark objects off the main thread, i.e. the
+// parallel marker of the full collector and the concurrent marker. Fields are
+// read with relaxed loads, since the mutator may write them concurrently.
+// Slots pointing into evacuation candidates, live bytes and objects that have
+// to be visited by the regular marking visitor are collected locally and
+// published on the main thread by the owner of the visitor.
+//
+// ConcreteVisitor has to provide a MarkObject(HeapObject*) method that marks
+// the target of a visited slot.
+template <typename ConcreteVisitor>
+class ParallelMarkingVisitor : public ObjectVisitor {
+ public:
+  explicit ParallelMarkingVisitor(Heap* heap)
+      : heap_(heap),
+        host_(nullptr),
+        live_bytes_(HashMap::PointersMatch, kInitialLiveBytesCapacity) {}
+
+  void VisitPointers(Object** start, Object** end) override {
+    for (Object** p = start; p < end; p++) {
+      Object* target = reinterpret_cast<Object*>(
+          base::NoBarrier_Load(reinterpret_cast<base::AtomicWord*>(p)));
+      if (!target->IsHeapObject()) continue;
+      HeapObject* target_object = HeapObject::cast(target);
+      if (Page::FromAddress(target_object->address())
+              ->IsEvacuationCandidate()) {
+        slots_.Add(RecordedSlot(host_, p));
+      }
+      static_cast<ConcreteVisitor*>(this)->MarkObject(target_object);
+    }
+  }
+
+  void VisitCodeEntry(Address entry_address) override { UNREACHABLE(); }
+
+  List<HeapObject*>* bailout() { return &bailout_; }
+  List<RecordedSlot>* slots() { return &slots_; }
+  HashMap* live_bytes() { return &live_bytes_; }
+
+  // Adds the locally collected live bytes to {target}, which is keyed by
+  // memory chunk as well, and clears them.
+  void FlushLiveBytes(HashMap* target) {
+    for (HashMap::Entry* p = live_bytes_.Start(); p != nullptr;
+         p = live_bytes_.Next(p)) {
+      HashMap::Entry* entry = target->LookupOrInsert(p->key, p->hash);
+      entry->value =
+          reinterpret_cast<void*>(reinterpret_cast<intptr_t>(entry->value) +
+                                  reinterpret_cast<intptr_t>(p->value));
+    }
+    live_bytes_.Clear();
+  }
+
+  // Adds the locally collected live bytes to their memory chunks and clears
+  // them. Needs to be called on the main thread.
+  void FlushLiveBytesToHeap() {
+    for (HashMap::Entry* p = live_bytes_.Start(); p != nullptr;
+         p = live_bytes_.Next(p)) {
+      MemoryChunk* chunk = reinterpret_cast<MemoryChunk*>(p->key);
+      chunk->IncrementLiveBytes(
+          static_cast<int>(reinterpret_cast<intptr_t>(p->value)));
+    }
+    live_bytes_.Clear();
+  }
+
+ protected:
+  Heap* heap() { return heap_; }
+
+  // Visits the fields of a black object. Slots are recorded with {object} as
+  // their host.
+  void VisitBody(HeapObject* object, Map* map, int size) {
+    host_ = object;
+    object->IterateBody(map->instance_type(), size, this);
+    host_ = nullptr;
+  }
+
+  void IncrementLiveBytes(HeapObject* object, int by) {
+    MemoryChunk* chunk = MemoryChunk::FromAddress(object->address());
+    HashMap::Entry* entry = live_bytes_.LookupOrInsert(
+        chunk, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(chunk) >>
+                                     kPageSizeBits));
+    entry->value = reinterpret_cast<void*>(
+        reinterpret_cast<intptr_t>(entry->value) + by);
+  }
+
+ private:
+  static const int kInitialLiveBytesCapacity = 64;
+
+  Heap* heap_;
+  HeapObject* host_;
+  List<HeapObject*> bailout_;
+  List<RecordedSlot> slots_;
+  HashMap live_bytes_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelMarkingVisitor);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_PARALLEL_MARKING_VISITOR_H_
@@ -29,6 +29,26 @@ class RememberedSet {
     slot_set[offset / Page::kPageSize].Insert(offset % Page::kPageSize);
   }
 
+  // Given a page and a range of consecutive slots in that page, this function
+  // adds the slots to the remembered set. The range must not cross a
+  // Page::kPageSize boundary of a large object page.
+  static void InsertRange(Page* page, Address start, Address end) {
+    DCHECK(page->Contains(start));
+    SlotSet* slot_set = GetSlotSet(page);
+    if (slot_set == nullptr) {
+      slot_set = AllocateSlotSet(page);
+    }
+    uintptr_t start_offset = start - page->address();
+    uintptr_t end_offset = end - page->address();
+    DCHECK_LT(start_offset, end_offset);
+    uintptr_t index = start_offset / Page::kPageSize;
+    DCHECK_EQ(index, (end_offset - kPointerSize) / Page::kPageSize);
+    uintptr_t slot_set_start = index * Page::kPageSize;
+    slot_set[index].InsertRange(
+        static_cast<int>(start_offset - slot_set_start),
+        static_cast<int>(end_offset - slot_set_start));
+  }
+
   // Given a page and a slot in that page, this function removes the slot from
   // the remembered set.
   // If the slot was never added, then the function does nothing.
@@ -62,20 +82,33 @@ class RememberedSet {
     PointerChunkIterator it(heap);
     MemoryChunk* chunk;
     while ((chunk = it.next()) != nullptr) {
-      SlotSet* slots = GetSlotSet(chunk);
-      if (slots != nullptr) {
-        size_t pages = (chunk->size() + Page::kPageSize - 1) / Page::kPageSize;
-        int new_count = 0;
-        for (size_t page = 0; page < pages; page++) {
-          new_count += slots[page].Iterate(callback);
-        }
-        if (new_count == 0) {
-          ReleaseSlotSet(chunk);
-        }
+      IterateChunk(chunk, callback);
+    }
+  }
+
+  // Iterates and filters the remembered set of a single chunk with the given
+  // callback. The callback should take (Address slot) and return
+  // SlotSet::CallbackResult. Different chunks can be processed in parallel.
+  template <typename Callback>
+  static void IterateChunk(MemoryChunk* chunk, Callback callback) {
+    SlotSet* slots = GetSlotSet(chunk);
+    if (slots != nullptr) {
+      size_t pages = (chunk->size() + Page::kPageSize - 1) / Page::kPageSize;
+      int new_count = 0;
+      for (size_t page = 0; page < pages; page++) {
+        new_count += slots[page].Iterate(callback);
+      }
+      if (new_count == 0) {
+        ReleaseSlotSet(chunk);
       }
     }
   }
 
+  // Returns true if the given chunk has a non-empty remembered set.
+  static bool HasSlots(MemoryChunk* chunk) {
+    return GetSlotSet(chunk) != nullptr;
+  }
+
   // Iterates and filters the remembered set with the given callback.
   // The callback should take (HeapObject** slot, HeapObject* target) and
   // update the slot.
@@ -89,6 +122,15 @@ class RememberedSet {
     });
   }
 
+  // Same as above, restricted to the remembered set of a single chunk.
+  template <typename Callback>
+  static void IterateChunkWithWrapper(Heap* heap, MemoryChunk* chunk,
+                                      Callback callback) {
+    IterateChunk(chunk, [heap, callback](Address addr) {
+      return Wrapper(heap, addr, callback);
+    });
+  }
+
   // Eliminates all stale slots from the remembered set, i.e.
   // slots that are not part of live objects anymore. This method must be
   // called after marking, when the whole transitive closure is known and
@@ -4,13 +4,24 @@
 
 #include "src/heap/scavenger.h"
 
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/sys-info.h"
 #include "src/contexts.h"
+#include "src/heap/array-buffer-tracker.h"
+#include "src/heap/gc-tracer.h"
 #include "src/heap/heap.h"
+#include "src/heap/mark-compact.h"
 #include "src/heap/objects-visiting-inl.h"
+#include "src/heap/remembered-set.h"
 #include "src/heap/scavenger-inl.h"
+#include "src/heap/spaces-inl.h"
+#include "src/heap/store-buffer-inl.h"
 #include "src/isolate.h"
 #include "src/log.h"
+#include "src/parallel-job.h"
 #include "src/profiler/cpu-profiler.h"
+#include "src/v8.h"
 
 namespace v8 {
 namespace internal {
@@ -198,10 +209,20 @@ class ScavengingVisitor : public StaticVisitorBase {
   template <ObjectContents object_contents, AllocationAlignment alignment>
   static inline void EvacuateObject(Map* map, HeapObject** slot,
                                     HeapObject* object, int object_size) {
-    SLOW_DCHECK(object_size <= Page::kAllocatableMemory);
     SLOW_DCHECK(object->Size() == object_size);
     Heap* heap = map->GetHeap();
 
+    if (object_size > Page::kMaxRegularHeapObjectSize) {
+      // Young large objects stay where they are. Their page is promoted after
+      // the scavenge.
+      if (heap->new_lo_space()->MarkSurvivor(object) &&
+          object_contents == POINTER_OBJECT) {
+        heap->promotion_queue()->insert(object, object_size);
+      }
+      return;
+    }
+    SLOW_DCHECK(object_size <= Page::kAllocatableMemory);
+
     if (!heap->ShouldBePromoted(object->address(), object_size)) {
       // A semi-space copy may fail due to fragmentation. In that case, we
       // try to promote the object.
@@ -282,15 +303,9 @@ class ScavengingVisitor : public StaticVisitorBase {
 
   static inline void EvacuateJSArrayBuffer(Map* map, HeapObject** slot,
                                            HeapObject* object) {
+    // The backing store is moved along by ArrayBufferTracker after the
+    // scavenge.
     ObjectEvacuationStrategy<POINTER_OBJECT>::Visit(map, slot, object);
-
-    Heap* heap = map->GetHeap();
-    MapWord map_word = object->map_word();
-    DCHECK(map_word.IsForwardingAddress());
-    HeapObject* target = map_word.ToForwardingAddress();
-    if (!heap->InNewSpace(target)) {
-      heap->array_buffer_tracker()->Promote(JSArrayBuffer::cast(target));
-    }
   }
 
 
@@ -448,6 +463,407 @@ void Scavenger::SelectScavengingVisitorsTable() {
 Isolate* Scavenger::isolate() { return heap()->isolate(); }
 
 
+// Copied object that still needs to be visited by a parallel scavenge.
+struct Scavenger::ScavengingEntry {
+  ScavengingEntry() : object(nullptr), size(0) {}
+  ScavengingEntry(HeapObject* object, int size) : object(object), size(size) {}
+
+  HeapObject* object;
+  int size;
+};
+
+
+// Task-local state of a parallel scavenge. Objects are copied into a local
+// allocation buffer in to-space or promoted into a local allocation buffer in
+// old space. Forwarding addresses are installed with a compare-and-swap on the
+// map word, so that exactly one task wins when several tasks reach the same
+// object. Old-to-new slots of promoted objects, pretenuring feedback and
+// statistics are collected locally and merged on the main thread in
+// {Finalize}.
+class Scavenger::LocalScavenger : public ObjectVisitor {
+ public:
+  static const intptr_t kLabSize = 4 * KB;
+  static const int kMaxLabObjectSize = 256;
+
+  LocalScavenger(Heap* heap, ScavengingWorklist* worklist)
+      : heap_(heap),
+        local_worklist_(worklist),
+        new_space_lab_(LocalAllocationBuffer::InvalidBuffer()),
+        old_space_lab_(LocalAllocationBuffer::InvalidBuffer()),
+        compaction_spaces_(heap),
+        local_pretenuring_feedback_(HashMap::PointersMatch,
+                                    kInitialLocalPretenuringFeedbackCapacity),
+        promoted_size_(0),
+        semispace_copied_size_(0) {}
+
+  // ObjectVisitor overrides used for visiting the roots.
+  void VisitPointer(Object** p) override { ScavengePointer(p); }
+
+  void VisitPointers(Object** start, Object** end) override {
+    for (Object** p = start; p < end; p++) ScavengePointer(p);
+  }
+
+  // Processes old-to-new chunks and the transitive closure until all tasks
+  // are out of work. The task must have been registered with the worklist.
+  void Run(Scavenger* scavenger);
+
+  // Merges back the locally cached state. Needs to be called on the main
+  // thread after all tasks finished.
+  void Finalize();
+
+ private:
+  static const int kInitialLocalPretenuringFeedbackCapacity = 256;
+
+  // Visits the body of a copied object. Slots of promoted objects that still
+  // point into new space after scavenging are recorded in the local store
+  // buffer.
+  class BodyVisitor : public ObjectVisitor {
+   public:
+    BodyVisitor(LocalScavenger* scavenger, bool record_slots)
+        : scavenger_(scavenger), record_slots_(record_slots) {}
+
+    void VisitPointers(Object** start, Object** end) override {
+      for (Object** p = start; p < end; p++) {
+        scavenger_->ScavengePointer(p);
+        if (record_slots_ && scavenger_->heap_->InNewSpace(*p)) {
+          scavenger_->local_store_buffer_.Record(reinterpret_cast<Address>(p));
+        }
+      }
+    }
+
+    void VisitCodeEntry(Address code_entry_slot) override {}
+
+   private:
+    LocalScavenger* scavenger_;
+    bool record_slots_;
+  };
+
+  inline void ScavengePointer(Object** p) {
+    Object* object = *p;
+    if (!heap_->InFromSpace(object)) return;
+    ScavengeObject(reinterpret_cast<HeapObject**>(p),
+                   reinterpret_cast<HeapObject*>(object));
+  }
+
+  void ScavengeObject(HeapObject** slot, HeapObject* object);
+  void ProcessWorklist();
+
+  static bool ContainsPointers(Map* map);
+  static AllocationAlignment RequiredAlignment(Map* map);
+
+  AllocationResult AllocateInNewSpace(int size_in_bytes,
+                                      AllocationAlignment alignment);
+  AllocationResult AllocateInOldSpace(int size_in_bytes,
+                                      AllocationAlignment alignment);
+  AllocationResult AllocateRawInNewSpace(int size_in_bytes,
+                                         AllocationAlignment alignment);
+
+  Heap* heap_;
+  ScavengingWorklist::Local local_worklist_;
+
+  LocalAllocationBuffer new_space_lab_;
+  LocalAllocationBuffer old_space_lab_;
+  CompactionSpaceCollection compaction_spaces_;
+  LocalStoreBuffer local_store_buffer_;
+  HashMap local_pretenuring_feedback_;
+
+  intptr_t promoted_size_;
+  intptr_t semispace_copied_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(LocalScavenger);
+};
+
+
+// static
+bool Scavenger::LocalScavenger::ContainsPointers(Map* map) {
+  // Mirrors the DATA_OBJECT evacuation strategies of the sequential visitors.
+  int id = map->visitor_id();
+  return id != StaticVisitorBase::kVisitSeqOneByteString &&
+         id != StaticVisitorBase::kVisitSeqTwoByteString &&
+         id != StaticVisitorBase::kVisitByteArray &&
+         id != StaticVisitorBase::kVisitFixedDoubleArray &&
+         (id < StaticVisitorBase::kVisitDataObject ||
+          id > StaticVisitorBase::kVisitDataObjectGeneric);
+}
+
+
+// static
+AllocationAlignment Scavenger::LocalScavenger::RequiredAlignment(Map* map) {
+  // The map word of the object cannot be used here, as other tasks may be
+  // installing a forwarding address concurrently.
+  InstanceType type = map->instance_type();
+  if (type == FIXED_DOUBLE_ARRAY_TYPE || type == FIXED_FLOAT64_ARRAY_TYPE) {
+    return kDoubleAligned;
+  }
+  return kWordAligned;
+}
+
+
+AllocationResult Scavenger::LocalScavenger::AllocateRawInNewSpace(
+    int size_in_bytes, AllocationAlignment alignment) {
+  NewSpace* new_space = heap_->new_space();
+  AllocationResult allocation =
+      new_space->AllocateRawSynchronized(size_in_bytes, alignment);
+  if (allocation.IsRetry() && new_space->AddFreshPageSynchronized()) {
+    allocation = new_space->AllocateRawSynchronized(size_in_bytes, alignment);
+  }
+  return allocation;
+}
+
+
+AllocationResult Scavenger::LocalScavenger::AllocateInNewSpace(
+    int size_in_bytes, AllocationAlignment alignment) {
+  if (size_in_bytes > kMaxLabObjectSize) {
+    return AllocateRawInNewSpace(size_in_bytes, alignment);
+  }
+  AllocationResult allocation =
+      new_space_lab_.AllocateRawAligned(size_in_bytes, alignment);
+  if (allocation.IsRetry()) {
+    LocalAllocationBuffer saved_lab = new_space_lab_;
+    new_space_lab_ = LocalAllocationBuffer::FromResult(
+        heap_, AllocateRawInNewSpace(kLabSize, kWordAligned), kLabSize);
+    if (!new_space_lab_.IsValid()) return AllocationResult::Retry(NEW_SPACE);
+    new_space_lab_.TryMerge(&saved_lab);
+    allocation = new_space_lab_.AllocateRawAligned(size_in_bytes, alignment);
+  }
+  return allocation;
+}
+
+
+AllocationResult Scavenger::LocalScavenger::AllocateInOldSpace(
+    int size_in_bytes, AllocationAlignment alignment) {
+  CompactionSpace* old_space = compaction_spaces_.Get(OLD_SPACE);
+  if (size_in_bytes > kMaxLabObjectSize) {
+    return old_space->AllocateRaw(size_in_bytes, alignment);
+  }
+  AllocationResult allocation =
+      old_space_lab_.AllocateRawAligned(size_in_bytes, alignment);
+  if (allocation.IsRetry()) {
+    LocalAllocationBuffer saved_lab = old_space_lab_;
+    old_space_lab_ = LocalAllocationBuffer::FromResult(
+        heap_, old_space->AllocateRaw(kLabSize, kWordAligned), kLabSize);
+    if (!old_space_lab_.IsValid()) return AllocationResult::Retry(OLD_SPACE);
+    old_space_lab_.TryMerge(&saved_lab);
+    allocation = old_space_lab_.AllocateRawAligned(size_in_bytes, alignment);
+  }
+  return allocation;
+}
+
+
+void Scavenger::LocalScavenger::ScavengeObject(HeapObject** slot,
+                                               HeapObject* object) {
+  DCHECK(heap_->InFromSpace(object));
+  MapWord first_word = object->synchronized_map_word();
+  if (first_word.IsForwardingAddress()) {
+    *slot = first_word.ToForwardingAddress();
+    return;
+  }
+
+  // Size and alignment are computed from the map read above, since the map
+  // word may be replaced by another task at any time from here on.
+  Map* map = first_word.ToMap();
+  int size = object->SizeFromMap(map);
+  AllocationAlignment alignment = RequiredAlignment(map);
+
+  if (size > Page::kMaxRegularHeapObjectSize) {
+    // Young large objects stay where they are, see ScavengingVisitor.
+    if (heap_->new_lo_space()->MarkSurvivor(object) && ContainsPointers(map)) {
+      local_worklist_.Push(ScavengingEntry(object, size));
+    }
+    return;
+  }
+  SLOW_DCHECK(size <= Page::kAllocatableMemory);
+
+  HeapObject* target = nullptr;
+  bool promoted = false;
+  if (heap_->ShouldBePromoted(object->address(), size) ||
+      !AllocateInNewSpace(size, alignment).To(&target)) {
+    // A semi-space copy may fail due to fragmentation. In that case, we try to
+    // promote the object. If promotion fails as well, we try to copy the
+    // object to the other semi-space.
+    promoted = AllocateInOldSpace(size, alignment).To(&target);
+    if (!promoted && !AllocateInNewSpace(size, alignment).To(&target)) {
+      FatalProcessOutOfMemory("Scavenger: semi-space copy\n");
+    }
+  }
+
+  heap_->CopyBlock(target->address(), object->address(), size);
+  target->set_map_no_write_barrier(map);
+  if (!object->synchronized_compare_and_swap_map_word(
+          first_word, MapWord::FromForwardingAddress(target))) {
+    // Another task copied the object in the meantime. Give up our copy and
+    // use theirs.
+    heap_->CreateFillerObjectAt(target->address(), size);
+    first_word = object->synchronized_map_word();
+    DCHECK(first_word.IsForwardingAddress());
+    *slot = first_word.ToForwardingAddress();
+    return;
+  }
+  *slot = target;
+
+  heap_->UpdateAllocationSite<Heap::kCached>(map, object, size,
+                                             &local_pretenuring_feedback_);
+  if (promoted) {
+    promoted_size_ += size;
+  } else {
+    semispace_copied_size_ += size;
+  }
+  if (ContainsPointers(map)) {
+    local_worklist_.Push(ScavengingEntry(target, size));
+  }
+}
+
+
+void Scavenger::LocalScavenger::ProcessWorklist() {
+  ScavengingEntry entry;
+  while (local_worklist_.Pop(&entry)) {
+    HeapObject* target = entry.object;
+    BodyVisitor visitor(this, !heap_->InNewSpace(target));
+    target->IterateBody(target->map()->instance_type(), entry.size, &visitor);
+  }
+}
+
+
+void Scavenger::LocalScavenger::Run(Scavenger* scavenger) {
+  do {
+    MemoryChunk* chunk = nullptr;
+    while ((chunk = scavenger->NextOldToNewChunk()) != nullptr) {
+      RememberedSet<OLD_TO_NEW>::IterateChunkWithWrapper(
+          heap_, chunk, [this](HeapObject** slot, HeapObject* object) {
+            ScavengeObject(slot, object);
+          });
+      ProcessWorklist();
+    }
+    ProcessWorklist();
+  } while (local_worklist_.Steal());
+  DCHECK(local_worklist_.IsEmpty());
+}
+
+
+void Scavenger::LocalScavenger::Finalize() {
+  // Closing the buffers fills their remaining memory with filler objects.
+  new_space_lab_ = LocalAllocationBuffer::InvalidBuffer();
+  old_space_lab_ = LocalAllocationBuffer::InvalidBuffer();
+  heap_->old_space()->MergeCompactionSpace(compaction_spaces_.Get(OLD_SPACE));
+  heap_->IncrementPromotedObjectsSize(promoted_size_);
+  heap_->IncrementSemiSpaceCopiedObjectSize(semispace_copied_size_);
+  heap_->MergeAllocationSitePretenuringFeedback(local_pretenuring_feedback_);
+  local_store_buffer_.Process(heap_->store_buffer());
+}
+
+
+// The main thread scavenges the roots before it joins the tasks in processing
+// the old-to-new chunks and the transitive closure.
+class Scavenger::ScavengingJob : public ParallelJob {
+ public:
+  ScavengingJob(Scavenger* scavenger, ScavengingWorklist* worklist,
+                LocalScavenger** local_scavengers)
+      : ParallelJob(scavenger->isolate()),
+        scavenger_(scavenger),
+        worklist_(worklist),
+        local_scavengers_(local_scavengers) {}
+
+ private:
+  void RunTask(int task_index) override {
+    LocalScavenger* local_scavenger = local_scavengers_[task_index];
+    if (task_index == 0) {
+      scavenger_->ScavengeRoots(local_scavenger);
+    } else if (!worklist_->Register()) {
+      // The transitive closure is already complete.
+      return;
+    }
+    local_scavenger->Run(scavenger_);
+  }
+
+  Scavenger* scavenger_;
+  ScavengingWorklist* worklist_;
+  LocalScavenger** local_scavengers_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScavengingJob);
+};
+
+
+bool Scavenger::CanScavengeInParallel() {
+  if (!FLAG_parallel_scavenge) return false;
+  bool logging_and_profiling =
+      FLAG_verify_predictable || isolate()->logger()->is_logging() ||
+      isolate()->cpu_profiler()->is_profiling() ||
+      (isolate()->heap_profiler() != NULL &&
+       isolate()->heap_profiler()->is_tracking_object_moves());
+  return !logging_and_profiling && !heap()->incremental_marking()->IsMarking();
+}
+
+
+int Scavenger::NumberOfScavengingTasks() {
+  // The number of tasks, including the main thread, is limited by:
+  // - the semi-space capacity, one task per kBytesPerTask,
+  // - #cores,
+  // - kMaxScavengingTasks.
+  const intptr_t kBytesPerTask = 1 * MB;
+  const int kMaxScavengingTasks = 8;
+  int tasks = 1 + static_cast<int>(heap()->new_space()->TotalCapacity() /
+                                   kBytesPerTask);
+  tasks = Min(tasks, base::SysInfo::NumberOfProcessors());
+  return Max(1, Min(tasks, kMaxScavengingTasks));
+}
+
+
+MemoryChunk* Scavenger::NextOldToNewChunk() {
+  intptr_t index = next_old_to_new_chunk_.Increment(1) - 1;
+  if (index >= old_to_new_chunks_.length()) return nullptr;
+  return old_to_new_chunks_[static_cast<int>(index)];
+}
+
+
+void Scavenger::ScavengeInParallel() {
+  DCHECK(CanScavengeInParallel());
+  DCHECK(old_to_new_chunks_.is_empty());
+  PointerChunkIterator it(heap());
+  MemoryChunk* chunk;
+  while ((chunk = it.next()) != nullptr) {
+    if (RememberedSet<OLD_TO_NEW>::HasSlots(chunk)) {
+      old_to_new_chunks_.Add(chunk);
+    }
+  }
+  next_old_to_new_chunk_.SetValue(0);
+
+  ScavengingWorklist worklist;
+  const int num_tasks = NumberOfScavengingTasks();
+  LocalScavenger** local_scavengers = new LocalScavenger*[num_tasks];
+  for (int i = 0; i < num_tasks; i++) {
+    local_scavengers[i] = new LocalScavenger(heap(), &worklist);
+  }
+
+  // The main thread registers first, so that the transitive closure cannot be
+  // considered complete before it is done with the roots.
+  CHECK(worklist.Register());
+  ScavengingJob job(this, &worklist, local_scavengers);
+  job.Run(num_tasks);
+
+  for (int i = 0; i < num_tasks; i++) {
+    local_scavengers[i]->Finalize();
+    delete local_scavengers[i];
+  }
+  delete[] local_scavengers;
+  old_to_new_chunks_.Clear();
+}
+
+
+void Scavenger::ScavengeRoots(ObjectVisitor* visitor) {
+  GCTracer::Scope gc_scope(heap()->tracer(), GCTracer::Scope::SCAVENGER_ROOTS);
+  heap()->IterateRoots(visitor, VISIT_ALL_IN_SCAVENGE);
+  // Copy objects reachable from the encountered weak collections list and
+  // the encountered weak cells.
+  visitor->VisitPointer(&heap()->encountered_weak_collections_);
+  visitor->VisitPointer(&heap()->encountered_weak_cells_);
+  // Copy objects reachable from the code flushing candidates list.
+  MarkCompactCollector* collector = heap()->mark_compact_collector();
+  if (collector->is_code_flushing_enabled()) {
+    collector->code_flusher()->IteratePointersToFromSpace(visitor);
+  }
+}
+
+
 void ScavengeVisitor::VisitPointer(Object** p) { ScavengePointer(p); }
 
 
@@ -5,7 +5,9 @@
 #ifndef V8_HEAP_SCAVENGER_H_
 #define V8_HEAP_SCAVENGER_H_
 
+#include "src/atomic-utils.h"
 #include "src/heap/objects-visiting.h"
+#include "src/heap/worklist.h"
 
 namespace v8 {
 namespace internal {
@@ -33,12 +35,45 @@ class Scavenger {
   // of the heap (i.e. incremental marking, logging and profiling).
   void SelectScavengingVisitorsTable();
 
+  // Returns true if the current scavenge can be performed by parallel tasks
+  // (--parallel_scavenge). Transferring incremental marking colors and
+  // reporting object moves to loggers and profilers is only supported by the
+  // sequential visitors.
+  bool CanScavengeInParallel();
+
+  // Scavenges the roots, the old-to-new remembered set and their transitive
+  // closure using parallel tasks. The main thread processes the roots while
+  // the remembered set is divided up among the tasks on a per-chunk basis.
+  // Returns after all tasks finished and their local state has been merged
+  // back into the heap.
+  void ScavengeInParallel();
+
   Isolate* isolate();
   Heap* heap() { return heap_; }
 
  private:
+  class LocalScavenger;
+  class ScavengingJob;
+  struct ScavengingEntry;
+
+  typedef Worklist<ScavengingEntry> ScavengingWorklist;
+
+  int NumberOfScavengingTasks();
+
+  // Scavenges the roots of a parallel scavenge on the main thread.
+  void ScavengeRoots(ObjectVisitor* visitor);
+
+  // Returns the next chunk with old-to-new slots that has not been claimed by
+  // any task yet, or nullptr if all chunks are taken.
+  MemoryChunk* NextOldToNewChunk();
+
   Heap* heap_;
   VisitorDispatchTable<ScavengingCallback> scavenging_visitors_table_;
+
+  // Chunks with a non-empty old-to-new remembered set at the beginning of a
+  // parallel scavenge and the index of the next chunk to be claimed.
+  List<MemoryChunk*> old_to_new_chunks_;
+  AtomicNumber<intptr_t> next_old_to_new_chunk_;
 };
 
 
@@ -45,6 +45,39 @@ class SlotSet : public Malloced {
     bucket[bucket_index][cell_index] |= 1u << bit_index;
   }
 
+  // The slot offsets specify a range of slots at addresses:
+  // [page_start_ + start_offset ... page_start_ + end_offset).
+  // Whole cells are set at once, which makes inserting long runs of
+  // consecutive slots much cheaper than inserting them one by one.
+  void InsertRange(int start_offset, int end_offset) {
+    DCHECK_LT(start_offset, end_offset);
+    int start_bucket, start_cell, start_bit;
+    SlotToIndices(start_offset, &start_bucket, &start_cell, &start_bit);
+    // The range is converted using its last slot, so that a range ending at
+    // the end of the page does not refer to a non-existing bucket.
+    int end_bucket, end_cell, end_bit;
+    SlotToIndices(end_offset - kPointerSize, &end_bucket, &end_cell, &end_bit);
+    for (int bucket_index = start_bucket; bucket_index <= end_bucket;
+         bucket_index++) {
+      if (bucket[bucket_index] == nullptr) {
+        bucket[bucket_index] = AllocateBucket();
+      }
+      int first_cell = (bucket_index == start_bucket) ? start_cell : 0;
+      int last_cell =
+          (bucket_index == end_bucket) ? end_cell : kCellsPerBucket - 1;
+      for (int i = first_cell; i <= last_cell; i++) {
+        uint32_t mask = ~0u;
+        if (bucket_index == start_bucket && i == start_cell) {
+          mask &= ~((1u << start_bit) - 1);
+        }
+        if (bucket_index == end_bucket && i == end_cell) {
+          mask &= ~0u >> (kBitsPerCell - 1 - end_bit);
+        }
+        bucket[bucket_index][i] |= mask;
+      }
+    }
+  }
+
   // The slot offset specifies a slot at address page_start_ + slot_offset.
   void Remove(int slot_offset) {
     int bucket_index, cell_index, bit_index;
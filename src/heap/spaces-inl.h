@@ -300,6 +300,7 @@ MemoryChunk* MemoryChunk::FromAnyPointerAddress(Heap* heap, Address addr) {
   uintptr_t offset = addr - chunk->address();
   if (offset < MemoryChunk::kHeaderSize || !chunk->HasPageHeader()) {
     chunk = heap->lo_space()->FindPage(addr);
+    if (chunk == nullptr) chunk = heap->new_lo_space()->FindPage(addr);
   }
   return chunk;
 }
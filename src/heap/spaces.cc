@@ -7,6 +7,7 @@
 #include "src/base/bits.h"
 #include "src/base/platform/platform.h"
 #include "src/full-codegen/full-codegen.h"
+#include "src/heap/array-buffer-tracker.h"
 #include "src/heap/slot-set.h"
 #include "src/heap/slots-buffer.h"
 #include "src/macro-assembler.h"
@@ -123,7 +124,12 @@ bool CodeRange::SetUp(size_t requested) {
   // region.
   code_range_ = new base::VirtualMemory(requested, kMaximalCodeRangeSize);
 #else
-  code_range_ = new base::VirtualMemory(requested);
+  if (FLAG_huge_pages) {
+    code_range_ =
+        new base::VirtualMemory(requested, MemoryAllocator::kHugePageSize);
+  } else {
+    code_range_ = new base::VirtualMemory(requested);
+  }
 #endif
   CHECK(code_range_ != NULL);
   if (!code_range_->IsReserved()) {
@@ -229,6 +235,9 @@ Address CodeRange::AllocateRawMemory(const size_t requested_size,
     ReleaseBlock(&current);
     return NULL;
   }
+  if (FLAG_huge_pages) {
+    base::OS::AdviseHugePages(current.start, commit_size);
+  }
   return current.start;
 }
 
@@ -316,6 +325,8 @@ bool MemoryAllocator::SetUp(intptr_t capacity, intptr_t capacity_executable) {
 
 
 void MemoryAllocator::TearDown() {
+  ReleasePooledChunks();
+  ReleaseHugePageRegions();
   // Check that spaces were torn down before MemoryAllocator.
   DCHECK(size_.Value() == 0);
   // TODO(gc) this will be true again when we fix FreeMemory.
@@ -325,6 +336,71 @@ void MemoryAllocator::TearDown() {
 }
 
 
+Address MemoryAllocator::AllocateHugePageSlot() {
+  base::LockGuard<base::Mutex> guard(&huge_page_mutex_);
+  if (free_huge_page_slots_.is_empty()) {
+    size_t alignment = kHugePageSize;
+    if (alignment < static_cast<size_t>(MemoryChunk::kAlignment)) {
+      alignment = MemoryChunk::kAlignment;
+    }
+    base::VirtualMemory* region = new base::VirtualMemory(
+        kPagesPerHugePageRegion * Page::kPageSize, alignment);
+    if (!region->IsReserved()) {
+      delete region;
+      return NULL;
+    }
+    huge_page_regions_.Add(region);
+    Address start = RoundUp(static_cast<Address>(region->address()), alignment);
+    // Hand out the slots in address order.
+    for (int i = kPagesPerHugePageRegion - 1; i >= 0; i--) {
+      free_huge_page_slots_.Add(start + i * Page::kPageSize);
+    }
+  }
+  Address slot = free_huge_page_slots_.RemoveLast();
+  if (!CommitMemory(slot, Page::kPageSize, NOT_EXECUTABLE)) {
+    free_huge_page_slots_.Add(slot);
+    return NULL;
+  }
+  // Committing maps fresh memory over the slot, so the advice has to be
+  // given again every time.
+  base::OS::AdviseHugePages(slot, Page::kPageSize);
+  return slot;
+}
+
+
+bool MemoryAllocator::InHugePageRegion(Address address) {
+  base::LockGuard<base::Mutex> guard(&huge_page_mutex_);
+  for (int i = 0; i < huge_page_regions_.length(); i++) {
+    Address start = static_cast<Address>(huge_page_regions_[i]->address());
+    if (address >= start && address < start + huge_page_regions_[i]->size()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+void MemoryAllocator::FreeHugePageSlot(Address address, size_t size) {
+  DCHECK_EQ(static_cast<size_t>(Page::kPageSize), size);
+  bool result = base::VirtualMemory::UncommitRegion(address, size);
+  USE(result);
+  DCHECK(result);
+  base::LockGuard<base::Mutex> guard(&huge_page_mutex_);
+  free_huge_page_slots_.Add(address);
+}
+
+
+void MemoryAllocator::ReleaseHugePageRegions() {
+  base::LockGuard<base::Mutex> guard(&huge_page_mutex_);
+  DCHECK_EQ(huge_page_regions_.length() * kPagesPerHugePageRegion,
+            free_huge_page_slots_.length());
+  while (!huge_page_regions_.is_empty()) {
+    delete huge_page_regions_.RemoveLast();
+  }
+  free_huge_page_slots_.Free();
+}
+
+
 bool MemoryAllocator::CommitMemory(Address base, size_t size,
                                    Executability executable) {
   if (!base::VirtualMemory::CommitRegion(base, size,
@@ -372,6 +448,9 @@ void MemoryAllocator::FreeMemory(Address base, size_t size,
       isolate_->code_range()->contains(static_cast<Address>(base))) {
     DCHECK(executable == EXECUTABLE);
     isolate_->code_range()->FreeRawMemory(base, size);
+  } else if (FLAG_huge_pages && InHugePageRegion(base)) {
+    DCHECK(executable == NOT_EXECUTABLE);
+    FreeHugePageSlot(base, size);
   } else {
     DCHECK(executable == NOT_EXECUTABLE || isolate_->code_range() == NULL ||
            !isolate_->code_range()->valid());
@@ -494,6 +573,7 @@ MemoryChunk* MemoryChunk::Initialize(Heap* heap, Address base, size_t size,
   Bitmap::Clear(chunk);
   chunk->set_next_chunk(nullptr);
   chunk->set_prev_chunk(nullptr);
+  chunk->local_tracker_ = nullptr;
 
   DCHECK(OFFSET_OF(MemoryChunk, flags_) == kFlagsOffset);
   DCHECK(OFFSET_OF(MemoryChunk, live_byte_count_) == kLiveBytesOffset);
@@ -682,9 +762,17 @@ MemoryChunk* MemoryAllocator::AllocateChunk(intptr_t reserve_area_size,
     size_t commit_size =
         RoundUp(MemoryChunk::kObjectStartOffset + commit_area_size,
                 base::OS::CommitPageSize());
-    base =
-        AllocateAlignedMemory(chunk_size, commit_size, MemoryChunk::kAlignment,
-                              executable, &reservation);
+    if (FLAG_huge_pages && chunk_size == static_cast<size_t>(Page::kPageSize) &&
+        commit_size == chunk_size) {
+      // The chunk does not own its memory. It is handed back to the region
+      // by FreeMemory.
+      base = AllocateHugePageSlot();
+      if (base != NULL) size_.Increment(static_cast<intptr_t>(chunk_size));
+    } else {
+      base = AllocateAlignedMemory(chunk_size, commit_size,
+                                   MemoryChunk::kAlignment, executable,
+                                   &reservation);
+    }
 
     if (base == NULL) return NULL;
 
@@ -720,7 +808,11 @@ void Page::ResetFreeListStatistics() {
 
 Page* MemoryAllocator::AllocatePage(intptr_t size, PagedSpace* owner,
                                     Executability executable) {
-  MemoryChunk* chunk = AllocateChunk(size, size, executable, owner);
+  MemoryChunk* chunk = NULL;
+  if (size == Page::kAllocatableMemory && executable == NOT_EXECUTABLE) {
+    chunk = AllocatePooledChunk(owner);
+  }
+  if (chunk == NULL) chunk = AllocateChunk(size, size, executable, owner);
   if (chunk == NULL) return NULL;
   return Page::Initialize(isolate_->heap(), chunk, executable, owner);
 }
@@ -787,9 +879,78 @@ void MemoryAllocator::Free(MemoryChunk* chunk) {
 }
 
 
+void MemoryAllocator::PerformFreeMemoryOrPool(MemoryChunk* chunk) {
+  DCHECK(chunk->IsFlagSet(MemoryChunk::PRE_FREED));
+  // Only regular pages that own their reservation can be reused as is.
+  if (chunk->size() == static_cast<size_t>(Page::kPageSize) &&
+      chunk->executable() == NOT_EXECUTABLE &&
+      chunk->reserved_memory()->IsReserved()) {
+    base::LockGuard<base::Mutex> guard(&pool_mutex_);
+    if (pooled_chunks_.length() < kMaxPooledChunks) {
+      chunk->ReleaseAllocatedMemory();
+      pooled_chunks_.Add(chunk);
+      return;
+    }
+  }
+  PerformFreeMemory(chunk);
+}
+
+
+void MemoryAllocator::ReleasePooledChunks() {
+  base::LockGuard<base::Mutex> guard(&pool_mutex_);
+  while (!pooled_chunks_.is_empty()) {
+    MemoryChunk* chunk = pooled_chunks_.RemoveLast();
+    FreeMemory(chunk->reserved_memory(), NOT_EXECUTABLE);
+  }
+}
+
+
+int MemoryAllocator::NumberOfPooledChunks() {
+  base::LockGuard<base::Mutex> guard(&pool_mutex_);
+  return pooled_chunks_.length();
+}
+
+
+MemoryChunk* MemoryAllocator::AllocatePooledChunk(Space* owner) {
+  MemoryChunk* chunk = NULL;
+  {
+    base::LockGuard<base::Mutex> guard(&pool_mutex_);
+    if (pooled_chunks_.is_empty()) return NULL;
+    chunk = pooled_chunks_.RemoveLast();
+  }
+  base::VirtualMemory reservation;
+  reservation.TakeControl(chunk->reserved_memory());
+  Address base = chunk->address();
+  const size_t chunk_size = Page::kPageSize;
+  const intptr_t reserved_size = static_cast<intptr_t>(reservation.size());
+
+  // Undo the bookkeeping of PreFreeMemory.
+  size_.Increment(reserved_size);
+  isolate_->counters()->memory_allocated()->Increment(
+      static_cast<int>(reserved_size));
+
+  if (Heap::ShouldZapGarbage()) {
+    ZapBlock(base, chunk_size);
+  }
+
+  LOG(isolate_, NewEvent("MemoryChunk", base, chunk_size));
+  if (owner != NULL) {
+    ObjectSpace space = static_cast<ObjectSpace>(1 << owner->identity());
+    PerformAllocationCallback(space, kAllocationActionAllocate, chunk_size);
+  }
+
+  Address area_start = base + Page::kObjectStartOffset;
+  Address area_end = area_start + Page::kAllocatableMemory;
+  return MemoryChunk::Initialize(isolate_->heap(), base, chunk_size,
+                                 area_start, area_end, NOT_EXECUTABLE, owner,
+                                 &reservation);
+}
+
+
 bool MemoryAllocator::CommitBlock(Address start, size_t size,
                                   Executability executable) {
   if (!CommitMemory(start, size, executable)) return false;
+  if (FLAG_huge_pages) base::OS::AdviseHugePages(start, size);
 
   if (Heap::ShouldZapGarbage()) {
     ZapBlock(start, size);
@@ -940,6 +1101,7 @@ void MemoryChunk::ReleaseAllocatedMemory() {
   mutex_ = nullptr;
   ReleaseOldToNewSlots();
   ReleaseOldToOldSlots();
+  ReleaseLocalTracker();
 }
 
 static SlotSet* AllocateSlotSet(size_t size, Address page_start) {
@@ -972,6 +1134,17 @@ void MemoryChunk::ReleaseOldToOldSlots() {
   old_to_old_slots_ = nullptr;
 }
 
+LocalArrayBufferTracker* MemoryChunk::AllocateLocalTracker() {
+  DCHECK_NULL(local_tracker_);
+  local_tracker_ = new LocalArrayBufferTracker();
+  return local_tracker_;
+}
+
+void MemoryChunk::ReleaseLocalTracker() {
+  delete local_tracker_;
+  local_tracker_ = nullptr;
+}
+
 // -----------------------------------------------------------------------------
 // PagedSpace implementation
 
@@ -1437,6 +1610,15 @@ void LocalAllocationBuffer::Close() {
 }
 
 
+void LocalAllocationBuffer::InstallAsLinearAllocationArea(PagedSpace* space) {
+  DCHECK(IsValid());
+  DCHECK(space->Contains(allocation_info_.top()));
+  space->EmptyAllocationInfo();
+  space->SetTopAndLimit(allocation_info_.top(), allocation_info_.limit());
+  allocation_info_.Reset(nullptr, nullptr);
+}
+
+
 LocalAllocationBuffer::LocalAllocationBuffer(Heap* heap,
                                              AllocationInfo allocation_info)
     : heap_(heap), allocation_info_(allocation_info) {
@@ -2245,18 +2427,6 @@ FreeSpace* FreeListCategory::PickNodeFromList(int* node_size) {
 }
 
 
-FreeSpace* FreeListCategory::PickNodeFromList(int size_in_bytes,
-                                              int* node_size) {
-  FreeSpace* node = PickNodeFromList(node_size);
-  if ((node != nullptr) && (*node_size < size_in_bytes)) {
-    Free(node, *node_size);
-    *node_size = 0;
-    return nullptr;
-  }
-  return node;
-}
-
-
 FreeSpace* FreeListCategory::SearchForNodeInList(int size_in_bytes,
                                                  int* node_size) {
   FreeSpace* prev_non_evac_node = nullptr;
@@ -2294,6 +2464,15 @@ FreeSpace* FreeListCategory::SearchForNodeInList(int size_in_bytes,
 }
 
 
+int FreeListCategory::LargestNodeSize() {
+  int largest = 0;
+  for (FreeSpace* node = top(); node != nullptr; node = node->next()) {
+    largest = Max(largest, node->Size());
+  }
+  return largest;
+}
+
+
 void FreeListCategory::Free(FreeSpace* free_space, int size_in_bytes) {
   free_space->set_next(top());
   set_top(free_space);
@@ -2317,7 +2496,13 @@ void FreeListCategory::RepairFreeList(Heap* heap) {
   }
 }
 
-FreeList::FreeList(PagedSpace* owner) : owner_(owner), wasted_bytes_(0) {
+FreeList::FreeList(PagedSpace* owner)
+    : owner_(owner),
+      wasted_bytes_(0),
+      non_empty_categories_(0),
+      allocations_(0),
+      allocation_time_ms_(0.0),
+      max_allocation_time_ms_(0.0) {
   for (int i = kFirstCategory; i < kNumberOfCategories; i++) {
     category_[i].Initialize(this, static_cast<FreeListCategoryType>(i));
   }
@@ -2340,10 +2525,17 @@ intptr_t FreeList::Concatenate(FreeList* other) {
   wasted_bytes_ += wasted_bytes;
   other->wasted_bytes_ = 0;
 
-  for (int i = kFirstCategory; i < kNumberOfCategories; i++) {
-    usable_bytes += category_[i].Concatenate(
-        other->GetFreeListCategory(static_cast<FreeListCategoryType>(i)));
+  // Only the non-empty categories of {other} need to be visited.
+  uint32_t categories = other->non_empty_categories_;
+  while (categories != 0) {
+    FreeListCategoryType type = static_cast<FreeListCategoryType>(
+        base::bits::CountTrailingZeros32(categories));
+    categories = base::bits::ClearLowestSetBit32(categories);
+    usable_bytes +=
+        category_[type].Concatenate(other->GetFreeListCategory(type));
+    UpdateNonEmptyCategories(type);
   }
+  other->non_empty_categories_ = 0;
 
   if (!other->owner()->is_local()) other->mutex()->Unlock();
   if (!owner()->is_local()) mutex_.Unlock();
@@ -2355,6 +2547,7 @@ void FreeList::Reset() {
   for (int i = kFirstCategory; i < kNumberOfCategories; i++) {
     category_[i].Reset();
   }
+  non_empty_categories_ = 0;
   ResetStats();
 }
 
@@ -2378,6 +2571,7 @@ int FreeList::Free(Address start, int size_in_bytes) {
   // magnitude.
   FreeListCategoryType type = SelectFreeListCategoryType(size_in_bytes);
   category_[type].Free(free_space, size_in_bytes);
+  non_empty_categories_ |= 1u << type;
   page->add_available_in_free_list(size_in_bytes);
 
   DCHECK(IsVeryLong() || Available() == SumFreeLists());
@@ -2387,6 +2581,7 @@ int FreeList::Free(Address start, int size_in_bytes) {
 
 FreeSpace* FreeList::FindNodeIn(FreeListCategoryType category, int* node_size) {
   FreeSpace* node = GetFreeListCategory(category)->PickNodeFromList(node_size);
+  UpdateNonEmptyCategories(category);
   if (node != nullptr) {
     Page::FromAddress(node->address())
         ->add_available_in_free_list(-(*node_size));
@@ -2397,40 +2592,30 @@ FreeSpace* FreeList::FindNodeIn(FreeListCategoryType category, int* node_size) {
 
 
 FreeSpace* FreeList::FindNodeFor(int size_in_bytes, int* node_size) {
-  FreeSpace* node = nullptr;
-  Page* page = nullptr;
-
-  // First try the allocation fast path: try to allocate the minimum element
-  // size of a free list category. This operation is constant time.
-  FreeListCategoryType type =
-      SelectFastAllocationFreeListCategoryType(size_in_bytes);
-  for (int i = type; i < kHuge; i++) {
-    node = FindNodeIn(static_cast<FreeListCategoryType>(i), node_size);
+  // First try the allocation fast path: take the first block of the smallest
+  // non-empty category whose blocks all fit. This operation is constant time
+  // unless blocks on evacuation candidates have to be dropped.
+  int type = SelectFastAllocationFreeListCategoryType(size_in_bytes);
+  while (type < kNumberOfCategories) {
+    uint32_t categories = non_empty_categories_ & ~((1u << type) - 1);
+    if (categories == 0) break;
+    type = static_cast<int>(base::bits::CountTrailingZeros32(categories));
+    FreeSpace* node =
+        FindNodeIn(static_cast<FreeListCategoryType>(type), node_size);
     if (node != nullptr) return node;
+    type++;
   }
 
-  // Next search the huge list for free list nodes. This takes linear time in
-  // the number of huge elements.
-  node = category_[kHuge].SearchForNodeInList(size_in_bytes, node_size);
-  if (node != nullptr) {
-    page = Page::FromAddress(node->address());
-    page->add_available_in_free_list(-(*node_size));
-    DCHECK(IsVeryLong() || Available() == SumFreeLists());
-    return node;
-  }
-
-  // We need a huge block of memory, but we didn't find anything in the huge
-  // list.
-  if (type == kHuge) return nullptr;
-
-  // Now search the best fitting free list for a node that has at least the
-  // requested size. This takes linear time in the number of elements.
-  type = SelectFreeListCategoryType(size_in_bytes);
-  node = category_[type].PickNodeFromList(size_in_bytes, node_size);
+  // Next search the category holding blocks of the requested size for a block
+  // that fits. This takes linear time in the number of blocks in the category.
+  FreeListCategoryType category = SelectFreeListCategoryType(size_in_bytes);
+  FreeSpace* node =
+      category_[category].SearchForNodeInList(size_in_bytes, node_size);
+  UpdateNonEmptyCategories(category);
   if (node != nullptr) {
     DCHECK(size_in_bytes <= *node_size);
-    page = Page::FromAddress(node->address());
-    page->add_available_in_free_list(-(*node_size));
+    Page::FromAddress(node->address())
+        ->add_available_in_free_list(-(*node_size));
   }
 
   DCHECK(IsVeryLong() || Available() == SumFreeLists());
@@ -2446,8 +2631,11 @@ FreeSpace* FreeList::TryRemoveMemory(intptr_t hint_size_in_bytes) {
   // Try to find a node that fits exactly.
   node = FindNodeFor(static_cast<int>(hint_size_in_bytes), &node_size);
   // If no node could be found get as much memory as possible.
-  if (node == nullptr) node = FindNodeIn(kHuge, &node_size);
-  if (node == nullptr) node = FindNodeIn(kLarge, &node_size);
+  while (node == nullptr && non_empty_categories_ != 0) {
+    FreeListCategoryType type = static_cast<FreeListCategoryType>(
+        31 - base::bits::CountLeadingZeros32(non_empty_categories_));
+    node = FindNodeIn(type, &node_size);
+  }
   if (node != nullptr) {
     // We round up the size to (kSmallListMin + kPointerSize) to (a) have a
     // size larger then the minimum size required for FreeSpace, and (b) to get
@@ -2491,7 +2679,17 @@ HeapObject* FreeList::Allocate(int size_in_bytes) {
                                                       old_linear_size);
 
   int new_node_size = 0;
-  FreeSpace* new_node = FindNodeFor(size_in_bytes, &new_node_size);
+  FreeSpace* new_node = nullptr;
+  if (FLAG_trace_gc_verbose) {
+    double start = owner_->heap()->MonotonicallyIncreasingTimeInMs();
+    new_node = FindNodeFor(size_in_bytes, &new_node_size);
+    double duration = owner_->heap()->MonotonicallyIncreasingTimeInMs() - start;
+    allocations_++;
+    allocation_time_ms_ += duration;
+    max_allocation_time_ms_ = Max(max_allocation_time_ms_, duration);
+  } else {
+    new_node = FindNodeFor(size_in_bytes, &new_node_size);
+  }
   if (new_node == nullptr) return nullptr;
   owner_->AllocationStep(new_node->address(), size_in_bytes);
 
@@ -2544,11 +2742,14 @@ HeapObject* FreeList::Allocate(int size_in_bytes) {
 
 
 intptr_t FreeList::EvictFreeListItems(Page* p) {
-  intptr_t sum = category_[kHuge].EvictFreeListItemsInList(p);
-  if (sum < p->area_size()) {
-    for (int i = kFirstCategory; i <= kLarge; i++) {
-      sum += category_[i].EvictFreeListItemsInList(p);
-    }
+  intptr_t sum = 0;
+  // Start with the largest categories, an empty page is evicted as a whole.
+  for (int i = kLastCategory; i >= kFirstCategory && sum < p->area_size();
+       i--) {
+    FreeListCategoryType type = static_cast<FreeListCategoryType>(i);
+    if (category_[type].IsEmpty()) continue;
+    sum += category_[type].EvictFreeListItemsInList(p);
+    UpdateNonEmptyCategories(type);
   }
   return sum;
 }
@@ -2556,7 +2757,7 @@ intptr_t FreeList::EvictFreeListItems(Page* p) {
 
 bool FreeList::ContainsPageFreeListItems(Page* p) {
   for (int i = kFirstCategory; i < kNumberOfCategories; i++) {
-    if (category_[i].EvictFreeListItemsInList(p)) {
+    if (category_[i].ContainsPageFreeListItemsInList(p)) {
       return true;
     }
   }
@@ -2571,6 +2772,36 @@ void FreeList::RepairLists(Heap* heap) {
 }
 
 
+int FreeList::LargestBlockSize() {
+  if (non_empty_categories_ == 0) return 0;
+  int type = 31 - base::bits::CountLeadingZeros32(non_empty_categories_);
+  return category_[type].LargestNodeSize();
+}
+
+
+void FreeList::PrintStatistics(const char* name) {
+  intptr_t available = Available();
+  int largest = LargestBlockSize();
+  // External fragmentation: the share of free memory that cannot be used for
+  // a single allocation of the largest free block size.
+  int fragmentation =
+      available > 0 ? static_cast<int>(100 - (100 * largest) / available) : 0;
+  PrintIsolate(owner_->heap()->isolate(),
+               "%s free list, available: %6" V8_PTR_PREFIX
+               "d KB, largest block: %6d KB, fragmentation: %3d%%, "
+               "size classes: %2u, allocations: %6d, "
+               "average: %.3f ms, max: %.3f ms\n",
+               name, available / KB, largest / KB, fragmentation,
+               base::bits::CountPopulation32(non_empty_categories_),
+               allocations_,
+               allocations_ > 0 ? allocation_time_ms_ / allocations_ : 0.0,
+               max_allocation_time_ms_);
+  allocations_ = 0;
+  allocation_time_ms_ = 0.0;
+  max_allocation_time_ms_ = 0.0;
+}
+
+
 #ifdef DEBUG
 intptr_t FreeListCategory::SumFreeList() {
   intptr_t sum = 0;
@@ -2979,10 +3210,32 @@ AllocationResult LargeObjectSpace::AllocateRaw(int object_size,
   if (page == NULL) return AllocationResult::Retry(identity());
   DCHECK(page->area_size() >= object_size);
 
+  AddPage(page, object_size);
+
+  HeapObject* object = page->GetObject();
+
+  MSAN_ALLOCATED_UNINITIALIZED_MEMORY(object->address(), object_size);
+
+  if (Heap::ShouldZapGarbage()) {
+    // Make the object consistent so the heap can be verified in OldSpaceStep.
+    // We only need to do this in debug builds or if verify_heap is on.
+    reinterpret_cast<Object**>(object->address())[0] =
+        heap()->fixed_array_map();
+    reinterpret_cast<Object**>(object->address())[1] = Smi::FromInt(0);
+  }
+
+  heap()->incremental_marking()->OldSpaceStep(object_size);
+  AllocationStep(object->address(), object_size);
+  return object;
+}
+
+
+void LargeObjectSpace::AddPage(LargePage* page, int object_size) {
   size_ += static_cast<int>(page->size());
   AccountCommitted(static_cast<intptr_t>(page->size()));
   objects_size_ += object_size;
   page_count_++;
+  page->set_owner(this);
   page->set_next_page(first_page_);
   first_page_ = page;
 
@@ -2996,22 +3249,35 @@ AllocationResult LargeObjectSpace::AllocateRaw(int object_size,
     DCHECK(entry != NULL);
     entry->value = page;
   }
+}
 
-  HeapObject* object = page->GetObject();
-
-  MSAN_ALLOCATED_UNINITIALIZED_MEMORY(object->address(), object_size);
 
-  if (Heap::ShouldZapGarbage()) {
-    // Make the object consistent so the heap can be verified in OldSpaceStep.
-    // We only need to do this in debug builds or if verify_heap is on.
-    reinterpret_cast<Object**>(object->address())[0] =
-        heap()->fixed_array_map();
-    reinterpret_cast<Object**>(object->address())[1] = Smi::FromInt(0);
+void LargeObjectSpace::RemovePage(LargePage* page, int object_size) {
+  LargePage* previous = NULL;
+  LargePage* current = first_page_;
+  while (current != page) {
+    DCHECK(current != NULL);
+    previous = current;
+    current = current->next_page();
+  }
+  if (previous == NULL) {
+    first_page_ = page->next_page();
+  } else {
+    previous->set_next_page(page->next_page());
   }
+  page->set_next_page(NULL);
 
-  heap()->incremental_marking()->OldSpaceStep(object_size);
-  AllocationStep(object->address(), object_size);
-  return object;
+  size_ -= static_cast<int>(page->size());
+  AccountUncommitted(static_cast<intptr_t>(page->size()));
+  objects_size_ -= object_size;
+  page_count_--;
+
+  uintptr_t base = reinterpret_cast<uintptr_t>(page) / MemoryChunk::kAlignment;
+  uintptr_t limit = base + (page->size() - 1) / MemoryChunk::kAlignment;
+  for (uintptr_t key = base; key <= limit; key++) {
+    chunk_map_.Remove(reinterpret_cast<void*>(key),
+                      static_cast<uint32_t>(key));
+  }
 }
 
 
@@ -3124,6 +3390,83 @@ bool LargeObjectSpace::Contains(HeapObject* object) {
 }
 
 
+// -----------------------------------------------------------------------------
+// NewLargeObjectSpace
+
+NewLargeObjectSpace::NewLargeObjectSpace(Heap* heap)
+    : LargeObjectSpace(heap, LO_SPACE) {}
+
+
+AllocationResult NewLargeObjectSpace::AllocateRaw(int object_size) {
+  if (!IsEmpty() && !heap()->always_allocate() &&
+      SizeOfObjects() + object_size > heap()->new_space()->Capacity()) {
+    return AllocationResult::Retry(NEW_SPACE);
+  }
+
+  LargePage* page = heap()->isolate()->memory_allocator()->AllocateLargePage(
+      object_size, this, NOT_EXECUTABLE);
+  if (page == NULL) return AllocationResult::Retry(NEW_SPACE);
+  DCHECK(page->area_size() >= object_size);
+
+  page->SetFlag(MemoryChunk::IN_TO_SPACE);
+  heap()->incremental_marking()->SetNewSpacePageFlags(page);
+  AddPage(page, object_size);
+
+  HeapObject* object = page->GetObject();
+  MSAN_ALLOCATED_UNINITIALIZED_MEMORY(object->address(), object_size);
+  AllocationStep(object->address(), object_size);
+  return object;
+}
+
+
+void NewLargeObjectSpace::Flip() {
+  for (LargePage* page = first_page(); page != NULL;
+       page = page->next_page()) {
+    page->ClearFlag(MemoryChunk::IN_TO_SPACE);
+    page->SetFlag(MemoryChunk::IN_FROM_SPACE);
+  }
+}
+
+
+bool NewLargeObjectSpace::MarkSurvivor(HeapObject* object) {
+  MemoryChunk* page = MemoryChunk::FromAddress(object->address());
+  DCHECK(page->owner() == this);
+  base::LockGuard<base::Mutex> guard(&survivor_mutex_);
+  if (!page->InFromSpace()) return false;
+  page->ClearFlag(MemoryChunk::IN_FROM_SPACE);
+  return true;
+}
+
+
+intptr_t NewLargeObjectSpace::PromoteSurvivors() {
+  intptr_t promoted_size = 0;
+  LargePage* current = first_page();
+  while (current != NULL) {
+    LargePage* page = current;
+    current = current->next_page();
+    if (page->InFromSpace()) {
+      // The object was not reached by the scavenge.
+      RemovePage(page, page->GetObject()->Size());
+      heap()->isolate()->memory_allocator()->Free(page);
+    } else {
+      promoted_size += page->GetObject()->Size();
+      PromotePage(page);
+    }
+  }
+  return promoted_size;
+}
+
+
+void NewLargeObjectSpace::PromotePage(LargePage* page) {
+  int object_size = page->GetObject()->Size();
+  RemovePage(page, object_size);
+  page->ClearFlag(MemoryChunk::IN_FROM_SPACE);
+  page->ClearFlag(MemoryChunk::IN_TO_SPACE);
+  heap()->incremental_marking()->SetOldSpacePageFlags(page);
+  heap()->lo_space()->AddPage(page, object_size);
+}
+
+
 #ifdef VERIFY_HEAP
 // We do not assume that the large object iterator works, because it depends
 // on the invariants we are checking during verification.
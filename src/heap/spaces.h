@@ -25,6 +25,7 @@ class CompactionSpace;
 class CompactionSpaceCollection;
 class FreeList;
 class Isolate;
+class LocalArrayBufferTracker;
 class MemoryAllocator;
 class MemoryChunk;
 class PagedSpace;
@@ -138,6 +139,32 @@ class MarkBit {
   inline bool Get() { return (*cell_ & mask_) != 0; }
   inline void Clear() { *cell_ &= ~mask_; }
 
+  // Atomic variants used while the concurrent marker may update the same
+  // cell. SetAtomic returns false if the bit was already set.
+  inline bool GetAtomic() {
+    return (base::NoBarrier_Load(reinterpret_cast<base::Atomic32*>(cell_)) &
+            mask_) != 0;
+  }
+  inline bool SetAtomic() {
+    base::Atomic32* cell = reinterpret_cast<base::Atomic32*>(cell_);
+    base::Atomic32 old_value;
+    do {
+      old_value = base::NoBarrier_Load(cell);
+      if (old_value & mask_) return false;
+    } while (base::Release_CompareAndSwap(cell, old_value,
+                                          old_value | mask_) != old_value);
+    return true;
+  }
+  inline void ClearAtomic() {
+    base::Atomic32* cell = reinterpret_cast<base::Atomic32*>(cell_);
+    base::Atomic32 old_value;
+    do {
+      old_value = base::NoBarrier_Load(cell);
+      if (!(old_value & mask_)) return;
+    } while (base::Release_CompareAndSwap(cell, old_value,
+                                          old_value & ~mask_) != old_value);
+  }
+
   CellType* cell_;
   CellType mask_;
 
@@ -410,7 +437,8 @@ class MemoryChunk {
       + kPointerSize      // AtomicValue parallel_compaction_
       + 2 * kPointerSize  // AtomicNumber free-list statistics
       + kPointerSize      // AtomicValue next_chunk_
-      + kPointerSize;     // AtomicValue prev_chunk_
+      + kPointerSize      // AtomicValue prev_chunk_
+      + kPointerSize;     // LocalArrayBufferTracker* local_tracker_
 
   // We add some more space to the computed header size to amount for missing
   // alignment requirements in our computation.
@@ -521,6 +549,12 @@ class MemoryChunk {
   void AllocateOldToOldSlots();
   void ReleaseOldToOldSlots();
 
+  // Array buffers allocated on this chunk, see ArrayBufferTracker. Null when
+  // the chunk holds no array buffers with a tracked backing store.
+  LocalArrayBufferTracker* local_tracker() { return local_tracker_; }
+  LocalArrayBufferTracker* AllocateLocalTracker();
+  void ReleaseLocalTracker();
+
   Address area_start() { return area_start_; }
   Address area_end() { return area_end_; }
   int area_size() { return static_cast<int>(area_end() - area_start()); }
@@ -713,6 +747,8 @@ class MemoryChunk {
   // prev_chunk_ holds a pointer of type MemoryChunk
   AtomicValue<MemoryChunk*> prev_chunk_;
 
+  LocalArrayBufferTracker* local_tracker_;
+
  private:
   void InitializeReservedMemory() { reservation_.Reset(); }
 
@@ -720,14 +756,12 @@ class MemoryChunk {
   friend class MemoryChunkValidator;
 };
 
+// Free list categories are power-of-two size classes of free blocks, see
+// FreeList. The first category holds blocks of 32 to 63 words, the last
+// category holds all blocks of at least half a page.
 enum FreeListCategoryType {
-  kSmall,
-  kMedium,
-  kLarge,
-  kHuge,
-
-  kFirstCategory = kSmall,
-  kLastCategory = kHuge,
+  kFirstCategory = 0,
+  kLastCategory = (kPageSizeBits - 1 - kPointerSizeLog2) - 5,
   kNumberOfCategories = kLastCategory + 1
 };
 
@@ -1168,6 +1202,17 @@ class MemoryAllocator {
   // together.
   void Free(MemoryChunk* chunk);
 
+  // Like PerformFreeMemory, but keeps regular non-executable pages mapped for
+  // reuse by AllocatePage as long as the pool is not full. Can be called
+  // concurrently when PreFree was executed before.
+  void PerformFreeMemoryOrPool(MemoryChunk* chunk);
+
+  // Unmaps all pooled pages. Can be called concurrently.
+  void ReleasePooledChunks();
+
+  // Returns the number of pages that are currently pooled.
+  int NumberOfPooledChunks();
+
   // Returns allocated spaces in bytes.
   intptr_t Size() { return size_.Value(); }
 
@@ -1272,6 +1317,9 @@ class MemoryAllocator {
                                               Address start, size_t commit_size,
                                               size_t reserved_size);
 
+  // Alignment of the regions that back the heap with --huge-pages.
+  static const size_t kHugePageSize = 2 * MB;
+
  private:
   Isolate* isolate_;
 
@@ -1306,6 +1354,38 @@ class MemoryAllocator {
   // A List of callback that are triggered when memory is allocated or free'd
   List<MemoryAllocationCallbackRegistration> memory_allocation_callbacks_;
 
+  // Upper bound for the number of freed pages that are kept mapped.
+  static const int kMaxPooledChunks = 8;
+
+  // Regular pages that have been freed but are still mapped. Pages are added
+  // by the unmapping task and taken by AllocatePage, so access needs to be
+  // synchronized with pool_mutex_.
+  base::Mutex pool_mutex_;
+  List<MemoryChunk*> pooled_chunks_;
+
+  // Takes a page from the pool and initializes it for the given owner.
+  // Returns nullptr if the pool is empty.
+  MemoryChunk* AllocatePooledChunk(Space* owner);
+
+  // With --huge-pages, regular pages are carved out of regions that are
+  // aligned to kHugePageSize, so that neighbouring pages can be backed by a
+  // single huge page and share one TLB entry.
+  static const int kPagesPerHugePageRegion = 8;
+
+  // The reserved regions and the page sized slots in them that are not in
+  // use. Slots are returned by the unmapping task, so access needs to be
+  // synchronized with huge_page_mutex_.
+  base::Mutex huge_page_mutex_;
+  List<base::VirtualMemory*> huge_page_regions_;
+  List<Address> free_huge_page_slots_;
+
+  // Commits a free slot, reserving a new region if there is none. Returns
+  // NULL on failure.
+  Address AllocateHugePageSlot();
+  bool InHugePageRegion(Address address);
+  void FreeHugePageSlot(Address address, size_t size);
+  void ReleaseHugePageRegions();
+
   // Initializes pages in a chunk. Returns the first page address.
   // This function and GetChunkId() are provided for the mark-compact
   // collector to rebuild page headers in the from space, which is
@@ -1581,13 +1661,13 @@ class FreeListCategory {
   // Pick a node from the list.
   FreeSpace* PickNodeFromList(int* node_size);
 
-  // Pick a node from the list and compare it against {size_in_bytes}. If the
-  // node's size is greater or equal return the node and null otherwise.
-  FreeSpace* PickNodeFromList(int size_in_bytes, int* node_size);
-
   // Search for a node of size {size_in_bytes}.
   FreeSpace* SearchForNodeInList(int size_in_bytes, int* node_size);
 
+  // Returns the size of the largest node in the list. Takes linear time in the
+  // number of nodes.
+  int LargestNodeSize();
+
   intptr_t EvictFreeListItemsInList(Page* p);
   bool ContainsPageFreeListItemsInList(Page* p);
 
@@ -1636,37 +1716,26 @@ class FreeListCategory {
 // a way to encourage objects allocated around the same time to be near each
 // other. The normal way to allocate is intended to be by bumping a 'top'
 // pointer until it hits a 'limit' pointer.  When the limit is hit we need to
-// find a new space to allocate from. This is done with the free list, which is
-// divided up into rough categories to cut down on waste. Having finer
-// categories would scatter allocation more.
+// find a new space to allocate from. This is done with the free list.
 
-// The free list is organized in categories as follows:
+// The free list is organized in power-of-two size classes as follows:
 // 1-31 words (too small): Such small free areas are discarded for efficiency
 //   reasons. They can be reclaimed by the compactor. However the distance
 //   between top and limit may be this small.
-// 32-255 words (small): Used for allocating free space between 1-31 words in
-//   size.
-// 256-2047 words (medium): Used for allocating free space between 32-255 words
-//   in size.
-// 1048-16383 words (large): Used for allocating free space between 256-2047
-//   words in size.
-// At least 16384 words (huge): This list is for objects of 2048 words or
-//   larger. Empty pages are also added to this list.
+// 2^(5+i) to 2^(6+i)-1 words (category i): The last category is unbounded and
+//   also holds empty pages.
+// A bitmap of non-empty categories allows to find the smallest category whose
+// blocks all fit a given size in constant time. Blocks of that category are
+// at most twice as large as needed, which keeps linear allocation areas and
+// fragmentation in check.
 class FreeList {
  public:
   // This method returns how much memory can be allocated after freeing
   // maximum_freed memory.
+  // Blocks that are large enough are either found in a category whose blocks
+  // all fit or by searching the category of the requested size.
   static inline int GuaranteedAllocatable(int maximum_freed) {
-    if (maximum_freed <= kSmallListMin) {
-      return 0;
-    } else if (maximum_freed <= kSmallListMax) {
-      return kSmallAllocationMax;
-    } else if (maximum_freed <= kMediumListMax) {
-      return kMediumAllocationMax;
-    } else if (maximum_freed <= kLargeListMax) {
-      return kLargeAllocationMax;
-    }
-    return maximum_freed;
+    return (maximum_freed <= kSmallListMin) ? 0 : maximum_freed;
   }
 
   explicit FreeList(PagedSpace* owner);
@@ -1707,17 +1776,12 @@ class FreeList {
   // The method tries to find a {FreeSpace} node of at least {size_in_bytes}
   // size in the free list category exactly matching the size. If no suitable
   // node could be found, the method falls back to retrieving a {FreeSpace}
-  // from the large or huge free list category.
+  // from the largest non-empty free list category.
   //
   // Can be used concurrently.
   MUST_USE_RESULT FreeSpace* TryRemoveMemory(intptr_t hint_size_in_bytes);
 
-  bool IsEmpty() {
-    for (int i = kFirstCategory; i < kNumberOfCategories; i++) {
-      if (!category_[i].IsEmpty()) return false;
-    }
-    return true;
-  }
+  bool IsEmpty() { return non_empty_categories_ == 0; }
 
   // Used after booting the VM.
   void RepairLists(Heap* heap);
@@ -1729,6 +1793,14 @@ class FreeList {
   intptr_t wasted_bytes() { return wasted_bytes_; }
   base::Mutex* mutex() { return &mutex_; }
 
+  // Returns the size of the largest block on the free list. Takes linear time
+  // in the number of blocks in the largest non-empty category.
+  int LargestBlockSize();
+
+  // Prints fragmentation and allocation latency statistics for
+  // --trace-gc-verbose and resets the latency statistics.
+  void PrintStatistics(const char* name);
+
 #ifdef DEBUG
   void Zap();
   intptr_t SumFreeLists();
@@ -1741,12 +1813,12 @@ class FreeList {
   static const int kMaxBlockSize = Page::kAllocatableMemory;
 
   static const int kSmallListMin = 0x1f * kPointerSize;
-  static const int kSmallListMax = 0xff * kPointerSize;
-  static const int kMediumListMax = 0x7ff * kPointerSize;
-  static const int kLargeListMax = 0x3fff * kPointerSize;
-  static const int kSmallAllocationMax = kSmallListMin;
-  static const int kMediumAllocationMax = kSmallListMax;
-  static const int kLargeAllocationMax = kMediumListMax;
+
+  // Blocks of the first category are at least 2^5 words large.
+  static const int kFirstCategoryWordsLog2 = 5;
+  STATIC_ASSERT(kSmallListMin + kPointerSize ==
+                (1 << kFirstCategoryWordsLog2) * kPointerSize);
+  STATIC_ASSERT(kNumberOfCategories <= 32);
 
   FreeSpace* FindNodeFor(int size_in_bytes, int* node_size);
   FreeSpace* FindNodeIn(FreeListCategoryType category, int* node_size);
@@ -1755,27 +1827,35 @@ class FreeList {
     return &category_[category];
   }
 
-  FreeListCategoryType SelectFreeListCategoryType(size_t size_in_bytes) {
-    if (size_in_bytes <= kSmallListMax) {
-      return kSmall;
-    } else if (size_in_bytes <= kMediumListMax) {
-      return kMedium;
-    } else if (size_in_bytes <= kLargeListMax) {
-      return kLarge;
-    }
-    return kHuge;
-  }
-
-  FreeListCategoryType SelectFastAllocationFreeListCategoryType(
-      size_t size_in_bytes) {
-    if (size_in_bytes <= kSmallAllocationMax) {
-      return kSmall;
-    } else if (size_in_bytes <= kMediumAllocationMax) {
-      return kMedium;
-    } else if (size_in_bytes <= kLargeAllocationMax) {
-      return kLarge;
+  // Returns the category holding blocks of {size_in_bytes}.
+  FreeListCategoryType SelectFreeListCategoryType(int size_in_bytes) {
+    uint32_t words = static_cast<uint32_t>(size_in_bytes) >> kPointerSizeLog2;
+    int type = 31 - static_cast<int>(base::bits::CountLeadingZeros32(words)) -
+               kFirstCategoryWordsLog2;
+    if (type < kFirstCategory) return kFirstCategory;
+    if (type > kLastCategory) return kLastCategory;
+    return static_cast<FreeListCategoryType>(type);
+  }
+
+  // Returns the smallest category whose blocks are all at least
+  // {size_in_bytes} large, or kNumberOfCategories if there is none.
+  int SelectFastAllocationFreeListCategoryType(int size_in_bytes) {
+    uint32_t words = static_cast<uint32_t>(size_in_bytes) >> kPointerSizeLog2;
+    if (words <= (1u << kFirstCategoryWordsLog2)) return kFirstCategory;
+    int words_log2 =
+        32 - static_cast<int>(base::bits::CountLeadingZeros32(words - 1));
+    int type = words_log2 - kFirstCategoryWordsLog2;
+    return Min(type, static_cast<int>(kNumberOfCategories));
+  }
+
+  // Keeps the bitmap of non-empty categories in sync after {category} has
+  // been modified.
+  void UpdateNonEmptyCategories(FreeListCategoryType category) {
+    if (category_[category].IsEmpty()) {
+      non_empty_categories_ &= ~(1u << category);
+    } else {
+      non_empty_categories_ |= 1u << category;
     }
-    return kHuge;
   }
 
   PagedSpace* owner_;
@@ -1783,6 +1863,16 @@ class FreeList {
   intptr_t wasted_bytes_;
   FreeListCategory category_[kNumberOfCategories];
 
+  // Bit i is set iff category i is non-empty.
+  uint32_t non_empty_categories_;
+
+  // Number of free list allocations and time spent finding blocks for them
+  // since the statistics were last printed. Only collected with
+  // --trace-gc-verbose.
+  int allocations_;
+  double allocation_time_ms_;
+  double max_allocation_time_ms_;
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(FreeList);
 };
 
@@ -1874,6 +1964,11 @@ class LocalAllocationBuffer {
   // Returns true if the merge was successful, false otherwise.
   inline bool TryMerge(LocalAllocationBuffer* other);
 
+  // Hands the unused part of the buffer over to {space} as its linear
+  // allocation area. The previous linear allocation area of {space} is
+  // returned to its free list. The buffer is invalid afterwards.
+  void InstallAsLinearAllocationArea(PagedSpace* space);
+
  private:
   LocalAllocationBuffer(Heap* heap, AllocationInfo allocation_info);
 
@@ -1965,6 +2060,11 @@ class PagedSpace : public Space {
   // due to being too small to use for allocation.
   virtual intptr_t Waste() { return free_list_.wasted_bytes(); }
 
+  // Prints free list statistics for --trace-gc-verbose.
+  void PrintFreeListStatistics(const char* name) {
+    free_list_.PrintStatistics(name);
+  }
+
   // Returns the allocation pointer in this space.
   Address top() { return allocation_info_.top(); }
   Address limit() { return allocation_info_.limit(); }
@@ -2952,6 +3052,12 @@ class LargeObjectSpace : public Space {
 
   LargePage* first_page() { return first_page_; }
 
+  // Adds a page holding an object of |object_size| bytes to the space and
+  // removes it again. Used to hand pages over between spaces without moving
+  // the object.
+  void AddPage(LargePage* page, int object_size);
+  void RemovePage(LargePage* page, int object_size);
+
 #ifdef VERIFY_HEAP
   virtual void Verify();
 #endif
@@ -2975,6 +3081,39 @@ class LargeObjectSpace : public Space {
 };
 
 
+// Large objects allocated in new space. Their pages are flagged like
+// to-space pages, so the write barrier and the scavenger treat them as young
+// objects. A scavenge does not copy them: survivors are promoted by handing
+// their page over to the old large object space and all other pages are
+// freed. A full GC promotes all of them up front.
+class NewLargeObjectSpace : public LargeObjectSpace {
+ public:
+  explicit NewLargeObjectSpace(Heap* heap);
+
+  // Fails with a retry in new space once the space holds as many bytes as
+  // the new space, so that a scavenge gets the chance to free it.
+  MUST_USE_RESULT AllocationResult AllocateRaw(int object_size);
+
+  // Moves all pages to from-space at the start of a scavenge.
+  void Flip();
+
+  // Takes the page of |object| out of from-space. Returns false if another
+  // visit of the object already did so. Can be called concurrently by
+  // scavenging tasks.
+  bool MarkSurvivor(HeapObject* object);
+
+  // Promotes the objects marked as survivors and frees all other pages.
+  // Returns the size of the promoted objects.
+  intptr_t PromoteSurvivors();
+
+  // Hands the page over to the old large object space.
+  void PromotePage(LargePage* page);
+
+ private:
+  base::Mutex survivor_mutex_;
+};
+
+
 class LargeObjectIterator : public ObjectIterator {
  public:
   explicit LargeObjectIterator(LargeObjectSpace* space);
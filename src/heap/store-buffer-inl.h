@@ -21,11 +21,8 @@ void LocalStoreBuffer::Record(Address addr) {
 void LocalStoreBuffer::Process(StoreBuffer* store_buffer) {
   Node* current = top_;
   while (current != nullptr) {
-    for (int i = 0; i < current->count; i++) {
-      Address slot = current->buffer[i];
-      Page* page = Page::FromAnyPointerAddress(heap_, slot);
-      RememberedSet<OLD_TO_NEW>::Insert(page, slot);
-    }
+    store_buffer->InsertEntries(current->buffer,
+                                current->buffer + current->count);
     current = current->next;
   }
 }
@@ -68,11 +68,37 @@ void StoreBuffer::MoveEntriesToRememberedSet() {
   if (top == start_) return;
   DCHECK(top <= limit_);
   heap_->set_store_buffer_top(reinterpret_cast<Smi*>(start_));
-  for (Address* current = start_; current < top; current++) {
-    DCHECK(!heap_->code_space()->Contains(*current));
-    Address addr = *current;
-    Page* page = Page::FromAnyPointerAddress(heap_, addr);
-    RememberedSet<OLD_TO_NEW>::Insert(page, addr);
+  InsertEntries(start_, top);
+}
+
+
+void StoreBuffer::InsertEntries(Address* start, Address* end) {
+  std::sort(start, end);
+  end = std::unique(start, end);
+  Address* current = start;
+  while (current < end) {
+    Page* page = Page::FromAnyPointerAddress(heap_, *current);
+    // Large object pages have one slot set per Page::kPageSize. Chunks are
+    // aligned to Page::kPageSize, so all slots up to the end of the slot set
+    // belong to the same page.
+    uintptr_t offset = *current - page->address();
+    Address slot_set_end =
+        page->address() + RoundUp(offset + 1, Page::kPageSize);
+    while (current < end && *current < slot_set_end) {
+      DCHECK(!heap_->code_space()->Contains(*current));
+      Address* run_end = current + 1;
+      while (run_end < end && *run_end == *(run_end - 1) + kPointerSize &&
+             *run_end < slot_set_end) {
+        run_end++;
+      }
+      if (run_end - current > 1) {
+        RememberedSet<OLD_TO_NEW>::InsertRange(page, *current,
+                                               *(run_end - 1) + kPointerSize);
+      } else {
+        RememberedSet<OLD_TO_NEW>::Insert(page, *current);
+      }
+      current = run_end;
+    }
   }
 }
 
@@ -23,12 +23,18 @@ class StoreBuffer {
   void SetUp();
   void TearDown();
 
-  static const int kStoreBufferOverflowBit = 1 << (14 + kPointerSizeLog2);
+  static const int kStoreBufferSizeLog2 = 15 + kPointerSizeLog2;
+  static const int kStoreBufferOverflowBit = 1 << kStoreBufferSizeLog2;
   static const int kStoreBufferSize = kStoreBufferOverflowBit;
   static const int kStoreBufferLength = kStoreBufferSize / sizeof(Address);
 
   void MoveEntriesToRememberedSet();
 
+  // Adds the slots in [start, end) to the old-to-new remembered set. The
+  // slots are sorted and deduplicated in place first, so that every page is
+  // looked up once and runs of consecutive slots are inserted as ranges.
+  void InsertEntries(Address* start, Address* end);
+
  private:
   Heap* heap_;
 
@@ -43,8 +49,7 @@ class StoreBuffer {
 
 class LocalStoreBuffer BASE_EMBEDDED {
  public:
-  explicit LocalStoreBuffer(Heap* heap)
-      : top_(new Node(nullptr)), heap_(heap) {}
+  LocalStoreBuffer() : top_(new Node(nullptr)) {}
 
   ~LocalStoreBuffer() {
     Node* current = top_;
@@ -72,7 +77,6 @@ class LocalStoreBuffer BASE_EMBEDDED {
   };
 
   Node* top_;
-  Heap* heap_;
 };
 
 }  // namespace internal
@@ -0,0 +1,191 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_WORKLIST_H_
+#define V8_HEAP_WORKLIST_H_
+
+#include "src/base/atomicops.h"
+#include "src/base/macros.h"
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
+#include "src/list.h"
+
+namespace v8 {
+namespace internal {
+
+// Worklist shared by the tasks of a parallel garbage collection phase. Every
+// task pushes and pops entries on a task-local view and only publishes
+// segments of up to kSegmentSize entries to the global pool, either when
+// other tasks ran out of work or when it flushes its view explicitly. The
+// mutex is only held to move segment pointers in and out of the pool.
+//
+// The worklist also detects termination for tasks that registered with it:
+// the transitive closure is complete once all registered tasks are waiting
+// for work in {Local::Steal}. Tasks that do not take part in termination
+// detection, e.g. a single background task, use {Local::TryTake} instead.
+template <typename EntryType>
+class Worklist {
+ public:
+  typedef List<EntryType> Segment;
+
+  static const int kSegmentSize = 64;
+
+  // Task-local view of the worklist. Must only be used by a single thread.
+  class Local {
+   public:
+    explicit Local(Worklist* worklist) : worklist_(worklist) {}
+    ~Local() { DCHECK(IsEmpty()); }
+
+    void Push(EntryType entry) { entries_.Add(entry); }
+
+    // Pops an entry from the local view. Publishes half of the local entries
+    // first if some other task is waiting for work. Returns false if the
+    // local view is empty.
+    bool Pop(EntryType* entry) {
+      if (entries_.is_empty()) return false;
+      if (entries_.length() > kShareThreshold && worklist_->HasIdleTasks()) {
+        Publish(entries_.length() / 2);
+      }
+      *entry = entries_.RemoveLast();
+      return true;
+    }
+
+    bool IsEmpty() const { return entries_.is_empty(); }
+    int length() const { return entries_.length(); }
+
+    // Refills the empty local view with a segment from the global pool.
+    // Blocks until either work becomes available or all registered tasks ran
+    // out of work, in which case false is returned.
+    bool Steal() {
+      DCHECK(IsEmpty());
+      Segment* segment = worklist_->StealSegment();
+      if (segment == nullptr) return false;
+      Take(segment);
+      return true;
+    }
+
+    // Like {Steal}, but returns false right away if the global pool is empty.
+    bool TryTake() {
+      Segment* segment = worklist_->TryTakeSegment();
+      if (segment == nullptr) return false;
+      Take(segment);
+      return true;
+    }
+
+    // Moves all local entries to the global pool.
+    void FlushToGlobal() { Publish(entries_.length()); }
+
+   private:
+    static const int kShareThreshold = 2 * kSegmentSize;
+
+    void Publish(int count) {
+      if (count == 0) return;
+      List<Segment*> segments((count + kSegmentSize - 1) / kSegmentSize);
+      while (count > 0) {
+        int segment_size = Min(count, kSegmentSize);
+        Segment* segment = new Segment(segment_size);
+        for (int i = 0; i < segment_size; i++) {
+          segment->Add(entries_.RemoveLast());
+        }
+        segments.Add(segment);
+        count -= segment_size;
+      }
+      worklist_->PublishSegments(&segments);
+    }
+
+    void Take(Segment* segment) {
+      entries_.AddAll(*segment);
+      delete segment;
+    }
+
+    Worklist* worklist_;
+    List<EntryType> entries_;
+
+    DISALLOW_COPY_AND_ASSIGN(Local);
+  };
+
+  Worklist() : registered_tasks_(0), idle_tasks_(0), done_(false) {}
+  ~Worklist() { Clear(); }
+
+  // Adds a task to the set of tasks that take part in termination detection.
+  // Returns false if the work has already been completed, in which case the
+  // task must not touch the heap at all.
+  bool Register() {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    if (done_) return false;
+    registered_tasks_++;
+    return true;
+  }
+
+  // Returns true if some task is waiting for work.
+  bool HasIdleTasks() { return base::NoBarrier_Load(&idle_tasks_) > 0; }
+
+  // Returns the number of entries in the global pool.
+  int GlobalPoolSize() {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    int size = 0;
+    for (int i = 0; i < global_pool_.length(); i++) {
+      size += global_pool_[i]->length();
+    }
+    return size;
+  }
+
+  bool IsGlobalPoolEmpty() {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    return global_pool_.is_empty();
+  }
+
+  // Drops all entries in the global pool.
+  void Clear() {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    for (int i = 0; i < global_pool_.length(); i++) {
+      delete global_pool_[i];
+    }
+    global_pool_.Clear();
+  }
+
+ private:
+  void PublishSegments(List<Segment*>* segments) {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    global_pool_.AddAll(*segments);
+    cv_.NotifyAll();
+  }
+
+  Segment* TryTakeSegment() {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    if (global_pool_.is_empty()) return nullptr;
+    return global_pool_.RemoveLast();
+  }
+
+  Segment* StealSegment() {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    base::NoBarrier_Store(&idle_tasks_, idle_tasks_ + 1);
+    while (true) {
+      if (!global_pool_.is_empty()) {
+        base::NoBarrier_Store(&idle_tasks_, idle_tasks_ - 1);
+        return global_pool_.RemoveLast();
+      }
+      if (done_ || idle_tasks_ == registered_tasks_) {
+        done_ = true;
+        cv_.NotifyAll();
+        return nullptr;
+      }
+      cv_.Wait(&mutex_);
+    }
+  }
+
+  base::Mutex mutex_;
+  base::ConditionVariable cv_;
+  List<Segment*> global_pool_;
+  int registered_tasks_;
+  base::Atomic32 idle_tasks_;
+  bool done_;
+
+  DISALLOW_COPY_AND_ASSIGN(Worklist);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_WORKLIST_H_
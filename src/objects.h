@@ -1505,6 +1505,11 @@ class HeapObject: public Object {
   inline void synchronized_set_map_no_write_barrier(Map* value);
   inline void synchronized_set_map_word(MapWord map_word);
 
+  // Atomically replace the map word if it still equals {old_map_word}, using
+  // release semantics. Returns false if another thread changed it first.
+  inline bool synchronized_compare_and_swap_map_word(MapWord old_map_word,
+                                                     MapWord new_map_word);
+
   // During garbage collection, the map word of a heap object does not
   // necessarily contain a map pointer.
   inline MapWord map_word() const;
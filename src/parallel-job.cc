@@ -0,0 +1,75 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/parallel-job.h"
+
+#include "src/base/sys-info.h"
+#include "src/cancelable-task.h"
+#include "src/isolate.h"
+#include "src/v8.h"
+
+namespace v8 {
+namespace internal {
+
+class ParallelJob::Task : public CancelableTask {
+ public:
+  Task(Isolate* isolate, ParallelJob* job, int task_index)
+      : CancelableTask(isolate), job_(job), task_index_(task_index) {}
+
+  virtual ~Task() {}
+
+ private:
+  // v8::internal::CancelableTask overrides.
+  void RunInternal() override {
+    job_->RunTask(task_index_);
+    job_->pending_tasks_semaphore_.Signal();
+  }
+
+  ParallelJob* job_;
+  int task_index_;
+
+  DISALLOW_COPY_AND_ASSIGN(Task);
+};
+
+
+ParallelJob::ParallelJob(Isolate* isolate)
+    : isolate_(isolate), pending_tasks_semaphore_(0) {}
+
+
+void ParallelJob::Run(int num_tasks) {
+  DCHECK_LE(1, num_tasks);
+  uint32_t* task_ids = new uint32_t[num_tasks];
+  for (int i = 1; i < num_tasks; i++) {
+    Task* task = new Task(isolate_, this, i);
+    task_ids[i] = task->id();
+    V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        task, v8::Platform::kShortRunningTask);
+  }
+
+  // Contribute on the calling thread.
+  RunTask(0);
+
+  // Tasks that are still in the queue can be canceled, as the job is done.
+  // Tasks that cannot be canceled have either already completed or are still
+  // running, hence we need to wait for their semaphore signal.
+  for (int i = 1; i < num_tasks; i++) {
+    if (!isolate_->cancelable_task_manager()->TryAbort(task_ids[i])) {
+      pending_tasks_semaphore_.Wait();
+    }
+  }
+  delete[] task_ids;
+}
+
+
+int ParallelJob::NumberOfTasks(int max_tasks) {
+  int background_threads = static_cast<int>(
+      V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads());
+  if (background_threads == 0) {
+    background_threads = base::SysInfo::NumberOfProcessors() - 1;
+  }
+  return Max(1, Min(1 + background_threads, max_tasks));
+}
+
+}  // namespace internal
+}  // namespace v8
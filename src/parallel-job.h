@@ -0,0 +1,86 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_PARALLEL_JOB_H_
+#define V8_PARALLEL_JOB_H_
+
+#include "src/atomic-utils.h"
+#include "src/base/macros.h"
+#include "src/base/platform/semaphore.h"
+
+namespace v8 {
+namespace internal {
+
+class Isolate;
+
+
+// Runs a job on the calling thread and on a number of background tasks at
+// the same time and returns once all of them are done.
+//
+// The calling thread has to be able to complete the job on its own, e.g.
+// because the work is split into items that are claimed by whichever thread
+// gets to them first, or because the threads balance their work with a
+// worklist that can only become empty once all of it is done. Background
+// tasks that did not start by the time the calling thread is done are
+// canceled instead of waited for.
+class ParallelJob {
+ public:
+  explicit ParallelJob(Isolate* isolate);
+  virtual ~ParallelJob() {}
+
+  // Runs RunTask(0) on the calling thread and RunTask(1) up to
+  // RunTask(num_tasks - 1) on background tasks.
+  void Run(int num_tasks);
+
+  // Returns the number of tasks, including the calling thread, that can run
+  // in parallel on the platform, but at most max_tasks.
+  static int NumberOfTasks(int max_tasks);
+
+ protected:
+  // Body of the task with the given index. Index 0 is the calling thread.
+  virtual void RunTask(int task_index) = 0;
+
+ private:
+  class Task;
+
+  Isolate* isolate_;
+
+  // Signaled by background tasks when they are done.
+  base::Semaphore pending_tasks_semaphore_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelJob);
+};
+
+
+// A parallel job that is split into items. All tasks claim and process items
+// until none are left.
+class ItemParallelJob : public ParallelJob {
+ public:
+  explicit ItemParallelJob(Isolate* isolate)
+      : ParallelJob(isolate), next_item_(0) {}
+
+  // The number of items must not change while the job is running.
+  virtual int NumberOfItems() = 0;
+
+ protected:
+  // Processes the item with the given index. May be called on any thread.
+  virtual void ProcessItem(int item) = 0;
+
+ private:
+  void RunTask(int task_index) final {
+    int item;
+    while ((item = next_item_.Increment(1) - 1) < NumberOfItems()) {
+      ProcessItem(item);
+    }
+  }
+
+  AtomicNumber<int> next_item_;
+
+  DISALLOW_COPY_AND_ASSIGN(ItemParallelJob);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_PARALLEL_JOB_H_
@@ -30,9 +30,13 @@ class HeapProfiler {
       v8::ActivityControl* control,
       v8::HeapProfiler::ObjectNameResolver* resolver);
 
-  bool StartSamplingHeapProfiler(uint64_t sample_interval, int stack_depth);
+  bool StartSamplingHeapProfiler(uint64_t sample_interval, int stack_depth,
+                                 v8::HeapProfiler::SamplingFlags flags);
   void StopSamplingHeapProfiler();
   AllocationProfile* GetAllocationProfile();
+  SamplingHeapProfiler* sampling_heap_profiler() const {
+    return sampling_heap_profiler_.get();
+  }
 
   void StartHeapObjectsTracking(bool track_allocations);
   void StopHeapObjectsTracking();
@@ -4,10 +4,13 @@
 
 #include "src/profiler/heap-snapshot-generator.h"
 
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
 #include "src/code-stubs.h"
 #include "src/conversions.h"
 #include "src/debug/debug.h"
 #include "src/objects-body-descriptors.h"
+#include "src/parallel-job.h"
 #include "src/profiler/allocation-tracker.h"
 #include "src/profiler/heap-profiler.h"
 #include "src/profiler/heap-snapshot-generator-inl.h"
@@ -787,7 +790,22 @@ V8HeapExplorer::V8HeapExplorer(
       heap_object_map_(snapshot_->profiler()->heap_object_map()),
       progress_(progress),
       filler_(NULL),
-      global_object_name_resolver_(resolver) {
+      global_object_name_resolver_(resolver),
+      main_explorer_(this),
+      pending_references_(nullptr) {
+}
+
+
+V8HeapExplorer::V8HeapExplorer(V8HeapExplorer* main_explorer)
+    : heap_(main_explorer->heap_),
+      snapshot_(main_explorer->snapshot_),
+      names_(main_explorer->names_),
+      heap_object_map_(main_explorer->heap_object_map_),
+      progress_(nullptr),
+      filler_(nullptr),
+      global_object_name_resolver_(nullptr),
+      main_explorer_(main_explorer),
+      pending_references_(nullptr) {
 }
 
 
@@ -804,7 +822,7 @@ HeapEntry* V8HeapExplorer::AddEntry(HeapObject* object) {
   if (object->IsJSFunction()) {
     JSFunction* func = JSFunction::cast(object);
     SharedFunctionInfo* shared = func->shared();
-    const char* name = names_->GetName(String::cast(shared->name()));
+    const char* name = GetName(String::cast(shared->name()));
     return AddEntry(object, HeapEntry::kClosure, name);
   } else if (object->IsJSBoundFunction()) {
     return AddEntry(object, HeapEntry::kClosure, "native_bind");
@@ -812,14 +830,14 @@ HeapEntry* V8HeapExplorer::AddEntry(HeapObject* object) {
     JSRegExp* re = JSRegExp::cast(object);
     return AddEntry(object,
                     HeapEntry::kRegExp,
-                    names_->GetName(re->Pattern()));
+                    GetName(re->Pattern()));
   } else if (object->IsJSObject()) {
-    const char* name = names_->GetName(
+    const char* name = GetName(
         GetConstructorName(JSObject::cast(object)));
     if (object->IsJSGlobalObject()) {
       const char* tag = objects_tags_.GetTag(object);
       if (tag != NULL) {
-        name = names_->GetFormatted("%s / %s", name, tag);
+        name = GetFormatted("%s / %s", name, tag);
       }
     }
     return AddEntry(object, HeapEntry::kObject, name);
@@ -835,7 +853,7 @@ HeapEntry* V8HeapExplorer::AddEntry(HeapObject* object) {
                       "(sliced string)");
     return AddEntry(object,
                     HeapEntry::kString,
-                    names_->GetName(String::cast(object)));
+                    GetName(String::cast(object)));
   } else if (object->IsSymbol()) {
     if (Symbol::cast(object)->is_private())
       return AddEntry(object, HeapEntry::kHidden, "private symbol");
@@ -847,13 +865,13 @@ HeapEntry* V8HeapExplorer::AddEntry(HeapObject* object) {
     String* name = String::cast(SharedFunctionInfo::cast(object)->name());
     return AddEntry(object,
                     HeapEntry::kCode,
-                    names_->GetName(name));
+                    GetName(name));
   } else if (object->IsScript()) {
     Object* name = Script::cast(object)->name();
     return AddEntry(object,
                     HeapEntry::kCode,
                     name->IsString()
-                        ? names_->GetName(String::cast(name))
+                        ? GetName(String::cast(name))
                         : "");
   } else if (object->IsNativeContext()) {
     return AddEntry(object, HeapEntry::kHidden, "system / NativeContext");
@@ -1113,7 +1131,7 @@ void V8HeapExplorer::ExtractJSObjectReferences(
                            js_fun->bound_target_function());
     FixedArray* bindings = js_fun->bound_arguments();
     for (int i = 0; i < bindings->length(); i++) {
-      const char* reference_name = names_->GetFormatted("bound_argument_%d", i);
+      const char* reference_name = GetFormatted("bound_argument_%d", i);
       SetNativeBindReference(js_obj, entry, reference_name, bindings->get(i));
     }
   } else if (obj->IsJSFunction()) {
@@ -1282,7 +1300,7 @@ void V8HeapExplorer::ExtractMapReferences(int entry, Map* map) {
           raw_transitions_or_prototype_info)) {
     TransitionArray* transitions =
         TransitionArray::cast(raw_transitions_or_prototype_info);
-    int transitions_entry = GetEntry(transitions)->index();
+    int transitions_entry = GetEntryIndex(transitions);
 
     if (map->CanTransition()) {
       if (transitions->HasPrototypeTransitions()) {
@@ -1346,11 +1364,11 @@ void V8HeapExplorer::ExtractSharedFunctionInfoReferences(
   HeapObject* obj = shared;
   String* shared_name = shared->DebugName();
   const char* name = NULL;
-  if (shared_name != *heap_->isolate()->factory()->empty_string()) {
-    name = names_->GetName(shared_name);
-    TagObject(shared->code(), names_->GetFormatted("(code for %s)", name));
+  if (shared_name != heap_->empty_string()) {
+    name = GetName(shared_name);
+    TagObject(shared->code(), GetFormatted("(code for %s)", name));
   } else {
-    TagObject(shared->code(), names_->GetFormatted("(%s code)",
+    TagObject(shared->code(), GetFormatted("(%s code)",
         Code::Kind2String(shared->code()->kind())));
   }
 
@@ -1371,7 +1389,7 @@ void V8HeapExplorer::ExtractSharedFunctionInfoReferences(
                        "script", shared->script(),
                        SharedFunctionInfo::kScriptOffset);
   const char* construct_stub_name = name ?
-      names_->GetFormatted("(construct stub code for %s)", name) :
+      GetFormatted("(construct stub code for %s)", name) :
       "(construct stub code)";
   TagObject(shared->construct_stub(), construct_stub_name);
   SetInternalReference(obj, entry,
@@ -1458,13 +1476,13 @@ void V8HeapExplorer::ExtractCodeCacheReferences(
 
 
 void V8HeapExplorer::TagBuiltinCodeObject(Code* code, const char* name) {
-  TagObject(code, names_->GetFormatted("(%s builtin)", name));
+  TagObject(code, GetFormatted("(%s builtin)", name));
 }
 
 
 void V8HeapExplorer::TagCodeObject(Code* code) {
   if (code->kind() == Code::STUB) {
-    TagObject(code, names_->GetFormatted(
+    TagObject(code, GetFormatted(
                         "(%s code)",
                         CodeStub::MajorName(CodeStub::GetMajorKey(code))));
   }
@@ -1555,6 +1573,7 @@ class JSArrayBufferDataEntryAllocator : public HeapEntriesAllocator {
 
 void V8HeapExplorer::ExtractJSArrayBufferReferences(
     int entry, JSArrayBuffer* buffer) {
+  DCHECK(!IsWorker());
   // Setup a reference to a native memory backing_store object.
   if (!buffer->backing_store())
     return;
@@ -1568,7 +1587,7 @@ void V8HeapExplorer::ExtractJSArrayBufferReferences(
 
 
 void V8HeapExplorer::ExtractFixedArrayReferences(int entry, FixedArray* array) {
-  bool is_weak = weak_containers_.Contains(array);
+  bool is_weak = main_explorer_->weak_containers_.Contains(array);
   for (int i = 0, l = array->length(); i < l; ++i) {
     if (is_weak) {
       SetWeakReference(array, entry,
@@ -1719,12 +1738,65 @@ String* V8HeapExplorer::GetConstructorName(JSObject* object) {
 }
 
 
+// An operation of the serial extraction that a worker could not perform
+// itself because it needs snapshot entries. The main thread performs them in
+// the order they were recorded, which is the order of the serial extraction,
+// so the snapshot does not depend on how pages are distributed.
+struct V8HeapExplorer::PendingReference {
+  enum Kind {
+    // Start of the references of |parent|.
+    kObject,
+    // The entry of |parent| is needed.
+    kEntry,
+    kNamedEdge,
+    kIndexedEdge,
+    // Tag |parent| with |name|.
+    kTag,
+    kWeakContainer,
+    // The references of |parent| have to be extracted on the main thread.
+    kMainThreadObject
+  };
+
+  PendingReference() {}
+  PendingReference(Kind kind, HeapObject* parent, const char* name = nullptr)
+      : kind(kind), parent(parent), name(name) {}
+  PendingReference(Kind kind, HeapGraphEdge::Type edge_type, HeapObject* parent,
+                   const char* name, int index, HeapObject* child,
+                   bool add_edge)
+      : kind(kind),
+        edge_type(edge_type),
+        add_edge(add_edge),
+        index(index),
+        parent(parent),
+        name(name),
+        child(child) {}
+
+  Kind kind;
+  HeapGraphEdge::Type edge_type;
+  bool add_edge;
+  int index;
+  HeapObject* parent;
+  const char* name;
+  HeapObject* child;
+};
+
+
 HeapEntry* V8HeapExplorer::GetEntry(Object* obj) {
+  DCHECK(!IsWorker());
   if (!obj->IsHeapObject()) return NULL;
   return filler_->FindOrAddEntry(obj, this);
 }
 
 
+int V8HeapExplorer::GetEntryIndex(HeapObject* obj) {
+  if (IsWorker()) {
+    pending_references_->Add(PendingReference(PendingReference::kEntry, obj));
+    return HeapEntry::kNoEntry;
+  }
+  return GetEntry(obj)->index();
+}
+
+
 class RootsReferencesExtractor : public ObjectVisitor {
  private:
   struct IndexTag {
@@ -1792,6 +1864,195 @@ class RootsReferencesExtractor : public ObjectVisitor {
 };
 
 
+// Runs a job whose batches are produced on all tasks and consumed in order on
+// the calling thread, which produces batches itself while it waits for the
+// next one. Batches are only handed out up to |max_buffered_batches| ahead of
+// the consumer, which bounds the memory used for their results.
+class OrderedBatchJob : public ParallelJob {
+ public:
+  OrderedBatchJob(Isolate* isolate, int batches, int max_buffered_batches)
+      : ParallelJob(isolate),
+        batches_(batches),
+        max_buffered_batches_(max_buffered_batches),
+        done_(new bool[batches]),
+        next_batch_(0),
+        consumed_batches_(0),
+        aborted_(false) {
+    for (int i = 0; i < batches_; i++) done_[i] = false;
+  }
+
+  virtual ~OrderedBatchJob() { delete[] done_; }
+
+  // Returns false if consuming a batch aborted the job.
+  bool Run(int num_tasks) {
+    ParallelJob::Run(Max(1, Min(num_tasks, batches_)));
+    return !aborted_;
+  }
+
+  int batches() const { return batches_; }
+
+ protected:
+  // Called on any task. The calling thread has task index 0.
+  virtual void ProduceBatch(int task_index, int batch) = 0;
+
+  // Called on the calling thread in batch order. Returning false aborts the
+  // job.
+  virtual bool ConsumeBatch(int batch) = 0;
+
+ private:
+  void RunTask(int task_index) final;
+
+  int ClaimBatch(bool wait);
+  void FinishBatch(int batch);
+  void ConsumeBatches();
+
+  const int batches_;
+  const int max_buffered_batches_;
+  // Protected by mutex_.
+  bool* const done_;
+  int next_batch_;
+  int consumed_batches_;
+  bool aborted_;
+  base::Mutex mutex_;
+  base::ConditionVariable batch_done_;
+  base::ConditionVariable batch_consumed_;
+
+  DISALLOW_COPY_AND_ASSIGN(OrderedBatchJob);
+};
+
+
+// Returns the next batch to produce, or -1 if there is none left or the job
+// was aborted. If the consumer is too far behind and |wait| is set, the
+// caller blocks until it catches up, otherwise -1 is returned.
+int OrderedBatchJob::ClaimBatch(bool wait) {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  while (!aborted_ && next_batch_ < batches_ &&
+         next_batch_ >= consumed_batches_ + max_buffered_batches_) {
+    if (!wait) return -1;
+    batch_consumed_.Wait(&mutex_);
+  }
+  if (aborted_ || next_batch_ == batches_) return -1;
+  return next_batch_++;
+}
+
+
+void OrderedBatchJob::FinishBatch(int batch) {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  done_[batch] = true;
+  batch_done_.NotifyAll();
+}
+
+
+void OrderedBatchJob::RunTask(int task_index) {
+  if (task_index == 0) {
+    ConsumeBatches();
+    return;
+  }
+  int batch;
+  while ((batch = ClaimBatch(true)) >= 0) {
+    ProduceBatch(task_index, batch);
+    FinishBatch(batch);
+  }
+}
+
+
+void OrderedBatchJob::ConsumeBatches() {
+  for (int batch = 0; batch < batches_; batch++) {
+    while (true) {
+      {
+        base::LockGuard<base::Mutex> guard(&mutex_);
+        if (done_[batch]) break;
+      }
+      int claimed = ClaimBatch(false);
+      if (claimed >= 0) {
+        ProduceBatch(0, claimed);
+        FinishBatch(claimed);
+      } else {
+        base::LockGuard<base::Mutex> guard(&mutex_);
+        while (!done_[batch]) batch_done_.Wait(&mutex_);
+      }
+    }
+    bool completed = ConsumeBatch(batch);
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    consumed_batches_++;
+    if (!completed) aborted_ = true;
+    batch_consumed_.NotifyAll();
+    if (aborted_) break;
+  }
+}
+
+
+// Extracts the references of one pass page by page. Workers record pending
+// references per page, and the main thread adds them to the snapshot page by
+// page while it helps extracting.
+class V8HeapExplorer::ParallelExtractionJob : public OrderedBatchJob {
+ public:
+  static const int kMaxTasks = 4;
+  static const int kMaxBufferedPages = 16;
+
+  ParallelExtractionJob(V8HeapExplorer* explorer,
+                        ExtractReferencesMethod extractor,
+                        List<HeapObject*>* objects, List<int>* page_starts)
+      : OrderedBatchJob(explorer->heap_->isolate(), page_starts->length() - 1,
+                        kMaxBufferedPages),
+        explorer_(explorer),
+        extractor_(extractor),
+        objects_(objects),
+        page_starts_(page_starts),
+        references_(new List<PendingReference>[batches()]) {}
+
+  ~ParallelExtractionJob() { delete[] references_; }
+
+  // Returns false if the extraction was interrupted.
+  bool Run();
+
+ private:
+  void ProduceBatch(int task_index, int page) override;
+  bool ConsumeBatch(int page) override;
+
+  V8HeapExplorer* const explorer_;
+  const ExtractReferencesMethod extractor_;
+  List<HeapObject*>* const objects_;
+  List<int>* const page_starts_;
+  List<PendingReference>* const references_;
+  List<V8HeapExplorer*> workers_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelExtractionJob);
+};
+
+
+bool V8HeapExplorer::ParallelExtractionJob::Run() {
+  int num_tasks = Min(ParallelJob::NumberOfTasks(kMaxTasks), batches());
+  for (int i = 0; i < num_tasks; i++) {
+    workers_.Add(new V8HeapExplorer(explorer_));
+  }
+  bool completed = OrderedBatchJob::Run(num_tasks);
+  for (int i = 0; i < workers_.length(); i++) delete workers_[i];
+  workers_.Clear();
+  return completed;
+}
+
+
+void V8HeapExplorer::ParallelExtractionJob::ProduceBatch(int task_index,
+                                                         int page) {
+  V8HeapExplorer* worker = workers_[task_index];
+  worker->pending_references_ = &references_[page];
+  for (int i = page_starts_->at(page); i < page_starts_->at(page + 1); i++) {
+    worker->ExtractObjectReferences(extractor_, HeapEntry::kNoEntry,
+                                    objects_->at(i));
+  }
+  worker->pending_references_ = nullptr;
+}
+
+
+bool V8HeapExplorer::ParallelExtractionJob::ConsumeBatch(int page) {
+  bool completed = explorer_->AddPendingReferences(extractor_,
+                                                   &references_[page]);
+  references_[page].Free();
+  return completed;
+}
+
+
 bool V8HeapExplorer::IterateAndExtractReferences(
     SnapshotFiller* filler) {
   filler_ = filler;
@@ -1815,8 +2076,12 @@ bool V8HeapExplorer::IterateAndExtractReferences(
   // to weakly hold their items, and it's impossible to distinguish
   // between these cases without processing the array owner first.
   bool interrupted =
-      IterateAndExtractSinglePass<&V8HeapExplorer::ExtractReferencesPass1>() ||
-      IterateAndExtractSinglePass<&V8HeapExplorer::ExtractReferencesPass2>();
+      FLAG_parallel_heap_snapshot_extraction
+          ? !IterateAndExtractInParallel()
+          : IterateAndExtractSinglePass(
+                &V8HeapExplorer::ExtractReferencesPass1) ||
+                IterateAndExtractSinglePass(
+                    &V8HeapExplorer::ExtractReferencesPass2);
 
   if (interrupted) {
     filler_ = NULL;
@@ -1828,8 +2093,8 @@ bool V8HeapExplorer::IterateAndExtractReferences(
 }
 
 
-template<V8HeapExplorer::ExtractReferencesMethod extractor>
-bool V8HeapExplorer::IterateAndExtractSinglePass() {
+bool V8HeapExplorer::IterateAndExtractSinglePass(
+    ExtractReferencesMethod extractor) {
   // Now iterate the whole heap.
   bool interrupted = false;
   HeapIterator iterator(heap_, HeapIterator::kFilterUnreachable);
@@ -1839,24 +2104,8 @@ bool V8HeapExplorer::IterateAndExtractSinglePass() {
        obj = iterator.next(), progress_->ProgressStep()) {
     if (interrupted) continue;
 
-    size_t max_pointer = obj->Size() / kPointerSize;
-    if (max_pointer > marks_.size()) {
-      // Clear the current bits.
-      std::vector<bool>().swap(marks_);
-      // Reallocate to right size.
-      marks_.resize(max_pointer, false);
-    }
-
     HeapEntry* heap_entry = GetEntry(obj);
-    int entry = heap_entry->index();
-    if ((this->*extractor)(entry, obj)) {
-      SetInternalReference(obj, entry,
-                           "map", obj->map(), HeapObject::kMapOffset);
-      // Extract unvisited fields as hidden references and restore tags
-      // of visited fields.
-      IndexedReferencesExtractor refs_extractor(this, obj, entry);
-      obj->Iterate(&refs_extractor);
-    }
+    ExtractObjectReferences(extractor, heap_entry->index(), obj);
 
     if (!progress_->ProgressReport(false)) interrupted = true;
   }
@@ -1864,6 +2113,113 @@ bool V8HeapExplorer::IterateAndExtractSinglePass() {
 }
 
 
+// Performs both passes with the objects split up by the page they live on.
+// The objects are collected up front in the order of the serial passes, so
+// the resulting snapshot is the same as with serial extraction.
+bool V8HeapExplorer::IterateAndExtractInParallel() {
+  List<HeapObject*> objects;
+  List<int> page_starts;
+  {
+    HeapIterator iterator(heap_, HeapIterator::kFilterUnreachable);
+    MemoryChunk* page = nullptr;
+    for (HeapObject* obj = iterator.next(); obj != NULL;
+         obj = iterator.next()) {
+      MemoryChunk* chunk = MemoryChunk::FromAddress(obj->address());
+      if (chunk != page) {
+        page_starts.Add(objects.length());
+        page = chunk;
+      }
+      objects.Add(obj);
+    }
+  }
+  page_starts.Add(objects.length());
+
+  DisallowHeapAllocation no_allocation;
+  ParallelExtractionJob pass1(this, &V8HeapExplorer::ExtractReferencesPass1,
+                              &objects, &page_starts);
+  if (!pass1.Run()) return false;
+  ParallelExtractionJob pass2(this, &V8HeapExplorer::ExtractReferencesPass2,
+                              &objects, &page_starts);
+  return pass2.Run();
+}
+
+
+void V8HeapExplorer::ExtractObjectReferences(ExtractReferencesMethod extractor,
+                                             int entry, HeapObject* obj) {
+  if (IsWorker()) {
+    pending_references_->Add(PendingReference(PendingReference::kObject, obj));
+    if (!CanExtractInParallel(obj)) {
+      pending_references_->Add(
+          PendingReference(PendingReference::kMainThreadObject, obj));
+      return;
+    }
+  }
+
+  size_t max_pointer = obj->Size() / kPointerSize;
+  if (max_pointer > marks_.size()) {
+    // Clear the current bits.
+    std::vector<bool>().swap(marks_);
+    // Reallocate to right size.
+    marks_.resize(max_pointer, false);
+  }
+
+  if ((this->*extractor)(entry, obj)) {
+    SetInternalReference(obj, entry,
+                         "map", obj->map(), HeapObject::kMapOffset);
+    // Extract unvisited fields as hidden references and restore tags
+    // of visited fields.
+    IndexedReferencesExtractor refs_extractor(this, obj, entry);
+    obj->Iterate(&refs_extractor);
+  }
+}
+
+
+bool V8HeapExplorer::AddPendingReferences(
+    ExtractReferencesMethod extractor, List<PendingReference>* references) {
+  DCHECK(!IsWorker());
+  int entry = HeapEntry::kNoEntry;
+  for (int i = 0; i < references->length(); i++) {
+    const PendingReference& reference = references->at(i);
+    switch (reference.kind) {
+      case PendingReference::kObject:
+        if (!progress_->ProgressReport(false)) return false;
+        progress_->ProgressStep();
+        entry = GetEntry(reference.parent)->index();
+        break;
+      case PendingReference::kEntry:
+        GetEntry(reference.parent);
+        break;
+      case PendingReference::kNamedEdge:
+        SetNamedEdge(reference.edge_type, reference.parent,
+                     GetEntry(reference.parent)->index(), reference.name,
+                     reference.child, reference.add_edge);
+        break;
+      case PendingReference::kIndexedEdge:
+        SetIndexedEdge(reference.edge_type, reference.parent,
+                       GetEntry(reference.parent)->index(), reference.index,
+                       reference.child, reference.add_edge);
+        break;
+      case PendingReference::kTag:
+        TagObject(reference.parent, reference.name);
+        break;
+      case PendingReference::kWeakContainer:
+        MarkAsWeakContainer(reference.parent);
+        break;
+      case PendingReference::kMainThreadObject:
+        ExtractObjectReferences(extractor, entry, reference.parent);
+        break;
+    }
+  }
+  return true;
+}
+
+
+// Array buffers add entries for their backing stores.
+bool V8HeapExplorer::CanExtractInParallel(HeapObject* obj) {
+  return !obj->IsJSArrayBuffer();
+}
+
+
 bool V8HeapExplorer::IsEssentialObject(Object* object) {
   return object->IsHeapObject() && !object->IsOddball() &&
          object != heap_->empty_byte_array() &&
@@ -1883,13 +2239,10 @@ void V8HeapExplorer::SetContextReference(HeapObject* parent_obj,
                                          String* reference_name,
                                          Object* child_obj,
                                          int field_offset) {
-  DCHECK(parent_entry == GetEntry(parent_obj)->index());
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry != NULL) {
-    filler_->SetNamedReference(HeapGraphEdge::kContextVariable,
-                               parent_entry,
-                               names_->GetName(reference_name),
-                               child_entry);
+  DCHECK(IsWorker() || parent_entry == GetEntry(parent_obj)->index());
+  if (child_obj->IsHeapObject()) {
+    SetNamedEdge(HeapGraphEdge::kContextVariable, parent_obj, parent_entry,
+                 GetName(reference_name), HeapObject::cast(child_obj), true);
     MarkVisitedField(parent_obj, field_offset);
   }
 }
@@ -1907,13 +2260,10 @@ void V8HeapExplorer::SetNativeBindReference(HeapObject* parent_obj,
                                             int parent_entry,
                                             const char* reference_name,
                                             Object* child_obj) {
-  DCHECK(parent_entry == GetEntry(parent_obj)->index());
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry != NULL) {
-    filler_->SetNamedReference(HeapGraphEdge::kShortcut,
-                               parent_entry,
-                               reference_name,
-                               child_entry);
+  DCHECK(IsWorker() || parent_entry == GetEntry(parent_obj)->index());
+  if (child_obj->IsHeapObject()) {
+    SetNamedEdge(HeapGraphEdge::kShortcut, parent_obj, parent_entry,
+                 reference_name, HeapObject::cast(child_obj), true);
   }
 }
 
@@ -1922,13 +2272,10 @@ void V8HeapExplorer::SetElementReference(HeapObject* parent_obj,
                                          int parent_entry,
                                          int index,
                                          Object* child_obj) {
-  DCHECK(parent_entry == GetEntry(parent_obj)->index());
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry != NULL) {
-    filler_->SetIndexedReference(HeapGraphEdge::kElement,
-                                 parent_entry,
-                                 index,
-                                 child_entry);
+  DCHECK(IsWorker() || parent_entry == GetEntry(parent_obj)->index());
+  if (child_obj->IsHeapObject()) {
+    SetIndexedEdge(HeapGraphEdge::kElement, parent_obj, parent_entry, index,
+                   HeapObject::cast(child_obj), true);
   }
 }
 
@@ -1938,15 +2285,11 @@ void V8HeapExplorer::SetInternalReference(HeapObject* parent_obj,
                                           const char* reference_name,
                                           Object* child_obj,
                                           int field_offset) {
-  DCHECK(parent_entry == GetEntry(parent_obj)->index());
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry == NULL) return;
-  if (IsEssentialObject(child_obj)) {
-    filler_->SetNamedReference(HeapGraphEdge::kInternal,
-                               parent_entry,
-                               reference_name,
-                               child_entry);
-  }
+  DCHECK(IsWorker() || parent_entry == GetEntry(parent_obj)->index());
+  if (!child_obj->IsHeapObject()) return;
+  SetNamedEdge(HeapGraphEdge::kInternal, parent_obj, parent_entry,
+               reference_name, HeapObject::cast(child_obj),
+               IsEssentialObject(child_obj));
   MarkVisitedField(parent_obj, field_offset);
 }
 
@@ -1956,15 +2299,12 @@ void V8HeapExplorer::SetInternalReference(HeapObject* parent_obj,
                                           int index,
                                           Object* child_obj,
                                           int field_offset) {
-  DCHECK(parent_entry == GetEntry(parent_obj)->index());
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry == NULL) return;
-  if (IsEssentialObject(child_obj)) {
-    filler_->SetNamedReference(HeapGraphEdge::kInternal,
-                               parent_entry,
-                               names_->GetName(index),
-                               child_entry);
-  }
+  DCHECK(IsWorker() || parent_entry == GetEntry(parent_obj)->index());
+  if (!child_obj->IsHeapObject()) return;
+  bool is_essential = IsEssentialObject(child_obj);
+  SetNamedEdge(HeapGraphEdge::kInternal, parent_obj, parent_entry,
+               is_essential ? GetName(index) : nullptr,
+               HeapObject::cast(child_obj), is_essential);
   MarkVisitedField(parent_obj, field_offset);
 }
 
@@ -1973,13 +2313,10 @@ void V8HeapExplorer::SetHiddenReference(HeapObject* parent_obj,
                                         int parent_entry,
                                         int index,
                                         Object* child_obj) {
-  DCHECK(parent_entry == GetEntry(parent_obj)->index());
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry != NULL && IsEssentialObject(child_obj)) {
-    filler_->SetIndexedReference(HeapGraphEdge::kHidden,
-                                 parent_entry,
-                                 index,
-                                 child_entry);
+  DCHECK(IsWorker() || parent_entry == GetEntry(parent_obj)->index());
+  if (child_obj->IsHeapObject()) {
+    SetIndexedEdge(HeapGraphEdge::kHidden, parent_obj, parent_entry, index,
+                   HeapObject::cast(child_obj), IsEssentialObject(child_obj));
   }
 }
 
@@ -1989,15 +2326,10 @@ void V8HeapExplorer::SetWeakReference(HeapObject* parent_obj,
                                       const char* reference_name,
                                       Object* child_obj,
                                       int field_offset) {
-  DCHECK(parent_entry == GetEntry(parent_obj)->index());
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry == NULL) return;
-  if (IsEssentialObject(child_obj)) {
-    filler_->SetNamedReference(HeapGraphEdge::kWeak,
-                               parent_entry,
-                               reference_name,
-                               child_entry);
-  }
+  DCHECK(IsWorker() || parent_entry == GetEntry(parent_obj)->index());
+  if (!child_obj->IsHeapObject()) return;
+  SetNamedEdge(HeapGraphEdge::kWeak, parent_obj, parent_entry, reference_name,
+               HeapObject::cast(child_obj), IsEssentialObject(child_obj));
   MarkVisitedField(parent_obj, field_offset);
 }
 
@@ -2007,15 +2339,12 @@ void V8HeapExplorer::SetWeakReference(HeapObject* parent_obj,
                                       int index,
                                       Object* child_obj,
                                       int field_offset) {
-  DCHECK(parent_entry == GetEntry(parent_obj)->index());
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry == NULL) return;
-  if (IsEssentialObject(child_obj)) {
-    filler_->SetNamedReference(HeapGraphEdge::kWeak,
-                               parent_entry,
-                               names_->GetFormatted("%d", index),
-                               child_entry);
-  }
+  DCHECK(IsWorker() || parent_entry == GetEntry(parent_obj)->index());
+  if (!child_obj->IsHeapObject()) return;
+  bool is_essential = IsEssentialObject(child_obj);
+  SetNamedEdge(HeapGraphEdge::kWeak, parent_obj, parent_entry,
+               is_essential ? GetFormatted("%d", index) : nullptr,
+               HeapObject::cast(child_obj), is_essential);
   MarkVisitedField(parent_obj, field_offset);
 }
 
@@ -2040,28 +2369,84 @@ void V8HeapExplorer::SetPropertyReference(HeapObject* parent_obj,
                                           Object* child_obj,
                                           const char* name_format_string,
                                           int field_offset) {
-  DCHECK(parent_entry == GetEntry(parent_obj)->index());
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry != NULL) {
+  DCHECK(IsWorker() || parent_entry == GetEntry(parent_obj)->index());
+  if (child_obj->IsHeapObject()) {
     HeapGraphEdge::Type type =
         reference_name->IsSymbol() || String::cast(reference_name)->length() > 0
             ? HeapGraphEdge::kProperty : HeapGraphEdge::kInternal;
     const char* name = name_format_string != NULL && reference_name->IsString()
-        ? names_->GetFormatted(
+        ? GetFormatted(
               name_format_string,
               String::cast(reference_name)->ToCString(
                   DISALLOW_NULLS, ROBUST_STRING_TRAVERSAL).get()) :
-        names_->GetName(reference_name);
+        GetName(reference_name);
 
-    filler_->SetNamedReference(type,
-                               parent_entry,
-                               name,
-                               child_entry);
+    SetNamedEdge(type, parent_obj, parent_entry, name,
+                 HeapObject::cast(child_obj), true);
     MarkVisitedField(parent_obj, field_offset);
   }
 }
 
 
+void V8HeapExplorer::SetNamedEdge(HeapGraphEdge::Type type,
+                                  HeapObject* parent_obj, int parent_entry,
+                                  const char* name, HeapObject* child_obj,
+                                  bool add_edge) {
+  if (IsWorker()) {
+    pending_references_->Add(PendingReference(PendingReference::kNamedEdge,
+                                              type, parent_obj, name, 0,
+                                              child_obj, add_edge));
+    return;
+  }
+  HeapEntry* child_entry = GetEntry(child_obj);
+  if (add_edge) {
+    filler_->SetNamedReference(type, parent_entry, name, child_entry);
+  }
+}
+
+
+void V8HeapExplorer::SetIndexedEdge(HeapGraphEdge::Type type,
+                                    HeapObject* parent_obj, int parent_entry,
+                                    int index, HeapObject* child_obj,
+                                    bool add_edge) {
+  if (IsWorker()) {
+    pending_references_->Add(PendingReference(PendingReference::kIndexedEdge,
+                                              type, parent_obj, nullptr, index,
+                                              child_obj, add_edge));
+    return;
+  }
+  HeapEntry* child_entry = GetEntry(child_obj);
+  if (add_edge) {
+    filler_->SetIndexedReference(type, parent_entry, index, child_entry);
+  }
+}
+
+
+const char* V8HeapExplorer::GetName(Name* name) {
+  base::LockGuard<base::Mutex> guard(&main_explorer_->names_mutex_);
+  return names_->GetName(name);
+}
+
+
+const char* V8HeapExplorer::GetName(int index) {
+  base::LockGuard<base::Mutex> guard(&main_explorer_->names_mutex_);
+  return names_->GetName(index);
+}
+
+
+const char* V8HeapExplorer::GetFormatted(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  const char* result;
+  {
+    base::LockGuard<base::Mutex> guard(&main_explorer_->names_mutex_);
+    result = names_->GetVFormatted(format, args);
+  }
+  va_end(args);
+  return result;
+}
+
+
 void V8HeapExplorer::SetRootGcRootsReference() {
   filler_->SetIndexedAutoIndexReference(
       HeapGraphEdge::kElement,
@@ -2158,6 +2543,11 @@ const char* V8HeapExplorer::GetStrongGcSubrootName(Object* object) {
 
 void V8HeapExplorer::TagObject(Object* obj, const char* tag) {
   if (IsEssentialObject(obj)) {
+    if (IsWorker()) {
+      pending_references_->Add(PendingReference(
+          PendingReference::kTag, HeapObject::cast(obj), tag));
+      return;
+    }
     HeapEntry* entry = GetEntry(obj);
     if (entry->name()[0] == '\0') {
       entry->set_name(tag);
@@ -2168,6 +2558,11 @@ void V8HeapExplorer::TagObject(Object* obj, const char* tag) {
 
 void V8HeapExplorer::MarkAsWeakContainer(Object* object) {
   if (IsEssentialObject(object) && object->IsFixedArray()) {
+    if (IsWorker()) {
+      pending_references_->Add(PendingReference(
+          PendingReference::kWeakContainer, HeapObject::cast(object)));
+      return;
+    }
     weak_containers_.Insert(object);
   }
 }
@@ -2616,6 +3011,16 @@ template<> struct MaxDecimalDigitsIn<8> {
 };
 
 
+// The buffer needs space for 3 unsigned ints, 3 commas, \n and \0
+const int HeapSnapshotJSONSerializer::kEdgeBufferSize =
+    MaxDecimalDigitsIn<sizeof(unsigned)>::kUnsigned * 3 + 3 + 2;  // NOLINT
+// The buffer needs space for 5 unsigned ints, 1 size_t, 6 commas, \n and \0
+const int HeapSnapshotJSONSerializer::kNodeBufferSize =
+    5 * MaxDecimalDigitsIn<sizeof(unsigned)>::kUnsigned  // NOLINT
+    + MaxDecimalDigitsIn<sizeof(size_t)>::kUnsigned  // NOLINT
+    + 6 + 1 + 1;
+
+
 class OutputStreamWriter {
  public:
   explicit OutputStreamWriter(v8::OutputStream* stream)
@@ -2701,6 +3106,107 @@ class OutputStreamWriter {
 };
 
 
+// Formats the nodes or edges of a snapshot in batches on background threads
+// and the main thread. The main thread streams the batches to the output in
+// order as soon as they are ready, so at most kMaxBufferedBatches formatted
+// batches are held in memory.
+class HeapSnapshotJSONSerializer::ParallelSerializationJob
+    : public OrderedBatchJob {
+ public:
+  enum Kind { kNodes, kEdges };
+
+  static const int kBatchSize = 4 * KB;
+  static const int kMaxBufferedBatches = 64;
+  static const int kMaxTasks = 4;
+
+  ParallelSerializationJob(HeapSnapshotJSONSerializer* serializer, Kind kind,
+                           int items)
+      : OrderedBatchJob(serializer->snapshot_->profiler()
+                            ->heap_object_map()
+                            ->heap()
+                            ->isolate(),
+                        (items + kBatchSize - 1) / kBatchSize,
+                        kMaxBufferedBatches),
+        serializer_(serializer),
+        writer_(nullptr),
+        kind_(kind),
+        items_(items),
+        buffers_(new List<char>[batches()]) {}
+
+  ~ParallelSerializationJob() { delete[] buffers_; }
+
+  void Run(OutputStreamWriter* writer);
+
+ private:
+  void ProduceBatch(int task_index, int batch) override;
+  bool ConsumeBatch(int batch) override;
+
+  HeapSnapshotJSONSerializer* const serializer_;
+  OutputStreamWriter* writer_;
+  const Kind kind_;
+  const int items_;
+  List<char>* const buffers_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelSerializationJob);
+};
+
+
+void HeapSnapshotJSONSerializer::ParallelSerializationJob::ProduceBatch(
+    int task_index, int batch) {
+  int start = batch * kBatchSize;
+  int end = Min(start + kBatchSize, items_);
+  List<char>* buffer = &buffers_[batch];
+  if (kind_ == kNodes) {
+    List<HeapEntry>& entries = serializer_->snapshot_->entries();
+    EmbeddedVector<char, kNodeBufferSize> node;
+    buffer->Allocate((end - start) * kNodeBufferSize / 2);
+    buffer->Rewind(0);
+    for (int i = start; i < end; i++) {
+      HeapEntry* entry = &entries[i];
+      int length = serializer_->FormatNode(
+          entry, serializer_->FindStringId(entry->name()), node);
+      buffer->AddAll(node.SubVector(0, length));
+    }
+  } else {
+    List<HeapGraphEdge*>& edges = serializer_->snapshot_->children();
+    EmbeddedVector<char, kEdgeBufferSize> edge;
+    buffer->Allocate((end - start) * kEdgeBufferSize / 2);
+    buffer->Rewind(0);
+    for (int i = start; i < end; i++) {
+      int length = serializer_->FormatEdge(
+          edges[i], serializer_->EdgeNameOrIndex(edges[i], true), i == 0,
+          edge);
+      buffer->AddAll(edge.SubVector(0, length));
+    }
+  }
+  // OutputStreamWriter::AddSubstring expects a terminated string.
+  buffer->Add('\0');
+}
+
+
+bool HeapSnapshotJSONSerializer::ParallelSerializationJob::ConsumeBatch(
+    int batch) {
+  List<char>* buffer = &buffers_[batch];
+  writer_->AddSubstring(buffer->ToVector().start(), buffer->length() - 1);
+  buffer->Free();
+  return !writer_->aborted();
+}
+
+
+void HeapSnapshotJSONSerializer::ParallelSerializationJob::Run(
+    OutputStreamWriter* writer) {
+  writer_ = writer;
+  OrderedBatchJob::Run(ParallelJob::NumberOfTasks(kMaxTasks));
+  writer_ = nullptr;
+}
+
+
+bool HeapSnapshotJSONSerializer::UseParallelSerialization(int items) {
+  return FLAG_parallel_heap_snapshot_serialization &&
+         items > ParallelSerializationJob::kBatchSize;
+}
+
+
 // type, name|index, to_node.
 const int HeapSnapshotJSONSerializer::kEdgeFieldsCount = 3;
 // type, name, id, self_size, edge_count, trace_node_id.
@@ -2753,6 +3259,11 @@ void HeapSnapshotJSONSerializer::SerializeImpl() {
   SerializeStrings();
   if (writer_->aborted()) return;
   writer_->AddCharacter(']');
+  if (FLAG_heap_snapshot_counts_trailer) {
+    writer_->AddString(",\n\"snapshot_counts\":{");
+    SerializeCounts();
+    writer_->AddCharacter('}');
+  }
   writer_->AddCharacter('}');
   writer_->Finalize();
 }
@@ -2811,32 +3322,62 @@ static int utoa(T value, const Vector<char>& buffer, int buffer_pos) {
 }
 
 
-void HeapSnapshotJSONSerializer::SerializeEdge(HeapGraphEdge* edge,
-                                               bool first_edge) {
-  // The buffer needs space for 3 unsigned ints, 3 commas, \n and \0
-  static const int kBufferSize =
-      MaxDecimalDigitsIn<sizeof(unsigned)>::kUnsigned * 3 + 3 + 2;  // NOLINT
-  EmbeddedVector<char, kBufferSize> buffer;
-  int edge_name_or_index = edge->type() == HeapGraphEdge::kElement
-      || edge->type() == HeapGraphEdge::kHidden
-      ? edge->index() : GetStringId(edge->name());
+int HeapSnapshotJSONSerializer::FindStringId(const char* s) const {
+  HashMap::Entry* cache_entry =
+      strings_.Lookup(const_cast<char*>(s), StringHash(s));
+  DCHECK(cache_entry != NULL);
+  return static_cast<int>(reinterpret_cast<intptr_t>(cache_entry->value));
+}
+
+
+int HeapSnapshotJSONSerializer::EdgeNameOrIndex(HeapGraphEdge* edge,
+                                                bool find_only) {
+  if (edge->type() == HeapGraphEdge::kElement ||
+      edge->type() == HeapGraphEdge::kHidden) {
+    return edge->index();
+  }
+  return find_only ? FindStringId(edge->name()) : GetStringId(edge->name());
+}
+
+
+int HeapSnapshotJSONSerializer::FormatEdge(HeapGraphEdge* edge,
+                                           int name_or_index, bool first_edge,
+                                           const Vector<char>& buffer) {
+  DCHECK(buffer.length() >= kEdgeBufferSize);
   int buffer_pos = 0;
   if (!first_edge) {
     buffer[buffer_pos++] = ',';
   }
   buffer_pos = utoa(edge->type(), buffer, buffer_pos);
   buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(edge_name_or_index, buffer, buffer_pos);
+  buffer_pos = utoa(name_or_index, buffer, buffer_pos);
   buffer[buffer_pos++] = ',';
   buffer_pos = utoa(entry_index(edge->to()), buffer, buffer_pos);
   buffer[buffer_pos++] = '\n';
-  buffer[buffer_pos++] = '\0';
-  writer_->AddString(buffer.start());
+  buffer[buffer_pos] = '\0';
+  return buffer_pos;
+}
+
+
+void HeapSnapshotJSONSerializer::SerializeEdge(HeapGraphEdge* edge,
+                                               bool first_edge) {
+  EmbeddedVector<char, kEdgeBufferSize> buffer;
+  int length =
+      FormatEdge(edge, EdgeNameOrIndex(edge, false), first_edge, buffer);
+  writer_->AddSubstring(buffer.start(), length);
 }
 
 
 void HeapSnapshotJSONSerializer::SerializeEdges() {
   List<HeapGraphEdge*>& edges = snapshot_->children();
+  if (UseParallelSerialization(edges.length())) {
+    // Assign the string ids up front, in the order the serial path would.
+    for (int i = 0; i < edges.length(); ++i) EdgeNameOrIndex(edges[i], false);
+    ParallelSerializationJob job(this, ParallelSerializationJob::kEdges,
+                                 edges.length());
+    job.Run(writer_);
+    return;
+  }
   for (int i = 0; i < edges.length(); ++i) {
     DCHECK(i == 0 ||
            edges[i - 1]->from()->index() <= edges[i]->from()->index());
@@ -2846,20 +3387,16 @@ void HeapSnapshotJSONSerializer::SerializeEdges() {
 }
 
 
-void HeapSnapshotJSONSerializer::SerializeNode(HeapEntry* entry) {
-  // The buffer needs space for 4 unsigned ints, 1 size_t, 5 commas, \n and \0
-  static const int kBufferSize =
-      5 * MaxDecimalDigitsIn<sizeof(unsigned)>::kUnsigned  // NOLINT
-      + MaxDecimalDigitsIn<sizeof(size_t)>::kUnsigned  // NOLINT
-      + 6 + 1 + 1;
-  EmbeddedVector<char, kBufferSize> buffer;
+int HeapSnapshotJSONSerializer::FormatNode(HeapEntry* entry, int name_id,
+                                           const Vector<char>& buffer) {
+  DCHECK(buffer.length() >= kNodeBufferSize);
   int buffer_pos = 0;
   if (entry_index(entry) != 0) {
     buffer[buffer_pos++] = ',';
   }
   buffer_pos = utoa(entry->type(), buffer, buffer_pos);
   buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(GetStringId(entry->name()), buffer, buffer_pos);
+  buffer_pos = utoa(name_id, buffer, buffer_pos);
   buffer[buffer_pos++] = ',';
   buffer_pos = utoa(entry->id(), buffer, buffer_pos);
   buffer[buffer_pos++] = ',';
@@ -2869,13 +3406,28 @@ void HeapSnapshotJSONSerializer::SerializeNode(HeapEntry* entry) {
   buffer[buffer_pos++] = ',';
   buffer_pos = utoa(entry->trace_node_id(), buffer, buffer_pos);
   buffer[buffer_pos++] = '\n';
-  buffer[buffer_pos++] = '\0';
-  writer_->AddString(buffer.start());
+  buffer[buffer_pos] = '\0';
+  return buffer_pos;
+}
+
+
+void HeapSnapshotJSONSerializer::SerializeNode(HeapEntry* entry) {
+  EmbeddedVector<char, kNodeBufferSize> buffer;
+  int length = FormatNode(entry, GetStringId(entry->name()), buffer);
+  writer_->AddSubstring(buffer.start(), length);
 }
 
 
 void HeapSnapshotJSONSerializer::SerializeNodes() {
   List<HeapEntry>& entries = snapshot_->entries();
+  if (UseParallelSerialization(entries.length())) {
+    // Assign the string ids up front, in the order the serial path would.
+    for (int i = 0; i < entries.length(); ++i) GetStringId(entries[i].name());
+    ParallelSerializationJob job(this, ParallelSerializationJob::kNodes,
+                                 entries.length());
+    job.Run(writer_);
+    return;
+  }
   for (int i = 0; i < entries.length(); ++i) {
     SerializeNode(&entries[i]);
     if (writer_->aborted()) return;
@@ -2883,6 +3435,16 @@ void HeapSnapshotJSONSerializer::SerializeNodes() {
 }
 
 
+// With FLAG_heap_snapshot_counts_trailer the counts follow the strings, so
+// consumers do not need them before the nodes and edges are streamed.
+void HeapSnapshotJSONSerializer::SerializeCounts() {
+  writer_->AddString("\"node_count\":");
+  writer_->AddNumber(snapshot_->entries().length());
+  writer_->AddString(",\"edge_count\":");
+  writer_->AddNumber(snapshot_->edges().length());
+}
+
+
 void HeapSnapshotJSONSerializer::SerializeSnapshot() {
   writer_->AddString("\"meta\":");
   // The object describing node serialization layout.
@@ -2952,10 +3514,10 @@ void HeapSnapshotJSONSerializer::SerializeSnapshot() {
 #undef JSON_S
 #undef JSON_O
 #undef JSON_A
-  writer_->AddString(",\"node_count\":");
-  writer_->AddNumber(snapshot_->entries().length());
-  writer_->AddString(",\"edge_count\":");
-  writer_->AddNumber(snapshot_->edges().length());
+  if (!FLAG_heap_snapshot_counts_trailer) {
+    writer_->AddCharacter(',');
+    SerializeCounts();
+  }
   writer_->AddString(",\"trace_function_count\":");
   uint32_t count = 0;
   AllocationTracker* tracker = snapshot_->profiler()->allocation_tracker();
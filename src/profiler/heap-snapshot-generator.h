@@ -6,6 +6,7 @@
 #define V8_PROFILER_HEAP_SNAPSHOT_GENERATOR_H_
 
 #include "include/v8-profiler.h"
+#include "src/base/platform/mutex.h"
 #include "src/base/platform/time.h"
 #include "src/objects.h"
 #include "src/profiler/strings-storage.h"
@@ -351,9 +352,19 @@ class V8HeapExplorer : public HeapEntriesAllocator {
   static String* GetConstructorName(JSObject* object);
 
  private:
+  class ParallelExtractionJob;
+  struct PendingReference;
+
   typedef bool (V8HeapExplorer::*ExtractReferencesMethod)(int entry,
                                                           HeapObject* object);
 
+  // Creates an explorer that extracts references on a background task. It
+  // records them as pending references, which the main explorer adds to the
+  // snapshot on the main thread.
+  explicit V8HeapExplorer(V8HeapExplorer* main_explorer);
+
+  bool IsWorker() const { return main_explorer_ != this; }
+
   void MarkVisitedField(HeapObject* obj, int offset);
 
   HeapEntry* AddEntry(HeapObject* object);
@@ -363,8 +374,13 @@ class V8HeapExplorer : public HeapEntriesAllocator {
 
   const char* GetSystemEntryName(HeapObject* object);
 
-  template<V8HeapExplorer::ExtractReferencesMethod extractor>
-  bool IterateAndExtractSinglePass();
+  bool IterateAndExtractSinglePass(ExtractReferencesMethod extractor);
+  bool IterateAndExtractInParallel();
+  void ExtractObjectReferences(ExtractReferencesMethod extractor, int entry,
+                               HeapObject* obj);
+  bool AddPendingReferences(ExtractReferencesMethod extractor,
+                            List<PendingReference>* references);
+  static bool CanExtractInParallel(HeapObject* obj);
 
   bool ExtractReferencesPass1(int entry, HeapObject* obj);
   bool ExtractReferencesPass2(int entry, HeapObject* obj);
@@ -455,7 +471,24 @@ class V8HeapExplorer : public HeapEntriesAllocator {
   void TagObject(Object* obj, const char* tag);
   void MarkAsWeakContainer(Object* object);
 
+  // Add an edge to the snapshot, or record it on a worker. The entry of the
+  // child is created even if |add_edge| is false.
+  void SetNamedEdge(HeapGraphEdge::Type type, HeapObject* parent_obj,
+                    int parent_entry, const char* name, HeapObject* child_obj,
+                    bool add_edge);
+  void SetIndexedEdge(HeapGraphEdge::Type type, HeapObject* parent_obj,
+                      int parent_entry, int index, HeapObject* child_obj,
+                      bool add_edge);
+
+  // The strings storage is shared with the workers.
+  const char* GetName(Name* name);
+  const char* GetName(int index);
+  const char* GetFormatted(const char* format, ...);
+
   HeapEntry* GetEntry(Object* obj);
+  // Like GetEntry(obj)->index(), but workers only record that the entry is
+  // needed and return HeapEntry::kNoEntry.
+  int GetEntryIndex(HeapObject* obj);
 
   Heap* heap_;
   HeapSnapshot* snapshot_;
@@ -471,6 +504,13 @@ class V8HeapExplorer : public HeapEntriesAllocator {
 
   std::vector<bool> marks_;
 
+  // Points to this explorer unless it is a worker.
+  V8HeapExplorer* main_explorer_;
+  // References recorded by a worker for the page it is extracting.
+  List<PendingReference>* pending_references_;
+  // Protects names_ while workers are running.
+  base::Mutex names_mutex_;
+
   friend class IndexedReferencesExtractor;
   friend class RootsReferencesExtractor;
 
@@ -591,13 +631,26 @@ class HeapSnapshotJSONSerializer {
         s, len, v8::internal::kZeroHashSeed);
   }
 
+  class ParallelSerializationJob;
+
   int GetStringId(const char* s);
+  // Like GetStringId, but the string must already have an id. Does not modify
+  // the string table and may be called from background threads.
+  int FindStringId(const char* s) const;
+  int EdgeNameOrIndex(HeapGraphEdge* edge, bool find_only);
   int entry_index(HeapEntry* e) { return e->index() * kNodeFieldsCount; }
+  // Format a node or an edge into |buffer| and return the number of
+  // characters written, not counting the terminating \0.
+  int FormatEdge(HeapGraphEdge* edge, int name_or_index, bool first_edge,
+                 const Vector<char>& buffer);
+  int FormatNode(HeapEntry* entry, int name_id, const Vector<char>& buffer);
+  bool UseParallelSerialization(int items);
   void SerializeEdge(HeapGraphEdge* edge, bool first_edge);
   void SerializeEdges();
   void SerializeImpl();
   void SerializeNode(HeapEntry* entry);
   void SerializeNodes();
+  void SerializeCounts();
   void SerializeSnapshot();
   void SerializeTraceTree();
   void SerializeTraceNode(AllocationTraceNode* node);
@@ -609,6 +662,9 @@ class HeapSnapshotJSONSerializer {
   static const int kEdgeFieldsCount;
   static const int kNodeFieldsCount;
 
+  static const int kEdgeBufferSize;
+  static const int kNodeBufferSize;
+
   HeapSnapshot* snapshot_;
   HashMap strings_;
   int next_node_id_;
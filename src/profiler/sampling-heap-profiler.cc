@@ -11,6 +11,7 @@
 #include "src/frames-inl.h"
 #include "src/heap/heap.h"
 #include "src/isolate.h"
+#include "src/profiler/heap-profiler.h"
 #include "src/profiler/strings-storage.h"
 
 namespace v8 {
@@ -33,8 +34,9 @@ intptr_t SamplingAllocationObserver::GetNextSampleInterval(uint64_t rate) {
              : (next > INT_MAX ? INT_MAX : static_cast<intptr_t>(next));
 }
 
-SamplingHeapProfiler::SamplingHeapProfiler(Heap* heap, StringsStorage* names,
-                                           uint64_t rate, int stack_depth)
+SamplingHeapProfiler::SamplingHeapProfiler(
+    Heap* heap, StringsStorage* names, uint64_t rate, int stack_depth,
+    v8::HeapProfiler::SamplingFlags flags)
     : isolate_(heap->isolate()),
       heap_(heap),
       new_space_observer_(new SamplingAllocationObserver(
@@ -46,7 +48,8 @@ SamplingHeapProfiler::SamplingHeapProfiler(Heap* heap, StringsStorage* names,
       names_(names),
       profile_root_("(root)", v8::UnboundScript::kNoScriptId, 0),
       samples_(),
-      stack_depth_(stack_depth) {
+      stack_depth_(stack_depth),
+      flags_(flags) {
   heap->new_space()->AddAllocationObserver(new_space_observer_.get());
   AllSpaces spaces(heap);
   for (Space* space = spaces.next(); space != NULL; space = spaces.next()) {
@@ -54,6 +57,11 @@ SamplingHeapProfiler::SamplingHeapProfiler(Heap* heap, StringsStorage* names,
       space->AddAllocationObserver(other_spaces_observer_.get());
     }
   }
+  if (track_lifetimes()) {
+    heap->AddGCEpilogueCallback(
+        OnGCEpilogue,
+        static_cast<v8::GCType>(kGCTypeScavenge | kGCTypeMarkSweepCompact));
+  }
 }
 
 
@@ -65,6 +73,7 @@ SamplingHeapProfiler::~SamplingHeapProfiler() {
       space->RemoveAllocationObserver(other_spaces_observer_.get());
     }
   }
+  if (track_lifetimes()) heap_->RemoveGCEpilogueCallback(OnGCEpilogue);
 
   for (auto sample : samples_) {
     delete sample;
@@ -92,6 +101,23 @@ void SamplingHeapProfiler::SampleObject(Address soon_object, size_t size) {
   Sample* sample = new Sample(size, node, loc, this);
   samples_.insert(sample);
   sample->global.SetWeak(sample, OnWeakCallback, WeakCallbackType::kParameter);
+
+  if (track_lifetimes()) {
+    // Scavenges must not keep the sampled object alive, or it would never
+    // die young.
+    sample->global.MarkIndependent();
+    v8::AllocationProfile::LifetimeHistogram& lifetimes = node->lifetimes_;
+    if (lifetimes.died_after_scavenges.empty()) {
+      lifetimes.died_after_scavenges.resize(kMaxTrackedScavenges);
+    }
+    lifetimes.allocated_bytes += size;
+    if (heap()->InNewSpace(heap_object)) {
+      lifetimes.young++;
+    } else {
+      sample->promoted = true;
+      lifetimes.promoted++;
+    }
+  }
 }
 
 void SamplingHeapProfiler::OnWeakCallback(
@@ -100,10 +126,55 @@ void SamplingHeapProfiler::OnWeakCallback(
   AllocationNode* node = sample->owner;
   DCHECK(node->allocations_[sample->size] > 0);
   node->allocations_[sample->size]--;
+  if (sample->profiler->track_lifetimes()) {
+    sample->profiler->RecordDeath(sample);
+  }
   sample->profiler->samples_.erase(sample);
   delete sample;
 }
 
+void SamplingHeapProfiler::OnGCEpilogue(v8::Isolate* isolate,
+                                        v8::GCType type,
+                                        v8::GCCallbackFlags flags) {
+  SamplingHeapProfiler* profiler = reinterpret_cast<Isolate*>(isolate)
+                                       ->heap_profiler()
+                                       ->sampling_heap_profiler();
+  if (profiler != nullptr) profiler->UpdateLifetimes(type);
+}
+
+void SamplingHeapProfiler::UpdateLifetimes(v8::GCType type) {
+  v8::Isolate* isolate = reinterpret_cast<v8::Isolate*>(isolate_);
+  for (Sample* sample : samples_) {
+    if (sample->promoted) continue;
+    HandleScope scope(isolate_);
+    Local<Value> local = Local<Value>::New(isolate, sample->global);
+    if (heap()->InNewSpace(*Utils::OpenHandle(*local))) {
+      if (type == kGCTypeScavenge) sample->scavenges_survived++;
+    } else {
+      v8::AllocationProfile::LifetimeHistogram& lifetimes =
+          sample->owner->lifetimes_;
+      sample->promoted = true;
+      DCHECK(lifetimes.young > 0);
+      lifetimes.young--;
+      lifetimes.promoted++;
+    }
+  }
+}
+
+void SamplingHeapProfiler::RecordDeath(Sample* sample) {
+  if (sample->promoted) return;
+  v8::AllocationProfile::LifetimeHistogram& lifetimes =
+      sample->owner->lifetimes_;
+  DCHECK(lifetimes.young > 0);
+  lifetimes.young--;
+  if (sample->scavenges_survived == 0) {
+    lifetimes.died_young++;
+  } else {
+    int index = Min(sample->scavenges_survived, kMaxTrackedScavenges) - 1;
+    lifetimes.died_after_scavenges[index]++;
+  }
+}
+
 SamplingHeapProfiler::AllocationNode* SamplingHeapProfiler::FindOrAddChildNode(
     AllocationNode* parent, const char* name, int script_id,
     int start_position) {
@@ -205,7 +276,8 @@ v8::AllocationProfile::Node* SamplingHeapProfiler::TranslateAllocationNode(
       {ToApiHandle<v8::String>(
            isolate_->factory()->InternalizeUtf8String(node->name_)),
        script_name, node->script_id_, node->script_position_, line, column,
-       std::vector<v8::AllocationProfile::Node*>(), allocations}));
+       std::vector<v8::AllocationProfile::Node*>(), allocations,
+       node->lifetimes_}));
   v8::AllocationProfile::Node* current = &profile->nodes().back();
   for (auto child : node->children_) {
     current->children.push_back(
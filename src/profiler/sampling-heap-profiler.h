@@ -41,7 +41,7 @@ class AllocationProfile : public v8::AllocationProfile {
 class SamplingHeapProfiler {
  public:
   SamplingHeapProfiler(Heap* heap, StringsStorage* names, uint64_t rate,
-                       int stack_depth);
+                       int stack_depth, v8::HeapProfiler::SamplingFlags flags);
   ~SamplingHeapProfiler();
 
   v8::AllocationProfile* GetAllocationProfile();
@@ -58,12 +58,17 @@ class SamplingHeapProfiler {
           owner(owner_),
           global(Global<Value>(
               reinterpret_cast<v8::Isolate*>(profiler_->isolate_), local_)),
-          profiler(profiler_) {}
+          profiler(profiler_),
+          scavenges_survived(0),
+          promoted(false) {}
     ~Sample() { global.Reset(); }
     const size_t size;
     AllocationNode* const owner;
     Global<Value> global;
     SamplingHeapProfiler* const profiler;
+    // Only maintained when tracking lifetimes.
+    int scavenges_survived;
+    bool promoted;
 
    private:
     DISALLOW_COPY_AND_ASSIGN(Sample);
@@ -73,7 +78,8 @@ class SamplingHeapProfiler {
    public:
     AllocationNode(const char* const name, int script_id,
                    const int start_position)
-        : script_id_(script_id),
+        : lifetimes_(),
+          script_id_(script_id),
           script_position_(start_position),
           name_(name) {}
     ~AllocationNode() {
@@ -84,6 +90,7 @@ class SamplingHeapProfiler {
 
    private:
     std::map<size_t, unsigned int> allocations_;
+    v8::AllocationProfile::LifetimeHistogram lifetimes_;
     std::vector<AllocationNode*> children_;
     const int script_id_;
     const int script_position_;
@@ -101,6 +108,17 @@ class SamplingHeapProfiler {
 
   static void OnWeakCallback(const WeakCallbackInfo<Sample>& data);
 
+  // Lifetime tracking. Sampled objects are counted as young until a GC
+  // epilogue finds them outside of new space; objects that die while young
+  // are binned by the number of scavenges they survived.
+  bool track_lifetimes() const {
+    return (flags_ & v8::HeapProfiler::kSamplingTrackLifetimes) != 0;
+  }
+  static void OnGCEpilogue(v8::Isolate* isolate, v8::GCType type,
+                           v8::GCCallbackFlags flags);
+  void UpdateLifetimes(v8::GCType type);
+  void RecordDeath(Sample* sample);
+
   // Methods that construct v8::AllocationProfile.
 
   // Translates the provided AllocationNode *node* returning an equivalent
@@ -123,6 +141,10 @@ class SamplingHeapProfiler {
   AllocationNode profile_root_;
   std::set<Sample*> samples_;
   const int stack_depth_;
+  const v8::HeapProfiler::SamplingFlags flags_;
+
+  // Number of entries in LifetimeHistogram::died_after_scavenges.
+  static const int kMaxTrackedScavenges = 4;
 
   friend class SamplingAllocationObserver;
 };
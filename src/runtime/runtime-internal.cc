@@ -261,6 +261,10 @@ RUNTIME_FUNCTION(Runtime_AllocateInTargetSpace) {
   RUNTIME_ASSERT(size <= Page::kMaxRegularHeapObjectSize);
   bool double_align = AllocateDoubleAlignFlag::decode(flags);
   AllocationSpace space = AllocateTargetSpace::decode(flags);
+  if (space == OLD_SPACE) {
+    isolate->counters()->pretenured_allocations_runtime()->Increment();
+    if (FLAG_pretenuring_lab) isolate->heap()->RefillPretenuringLab();
+  }
   return *isolate->factory()->NewFillerObject(size, double_align, space);
 }
 
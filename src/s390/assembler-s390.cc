@@ -57,10 +57,9 @@ static unsigned CpuFeaturesImpliedByCompiler() {
   return answer;
 }
 
-// Check whether Store Facility STFLE instruction is available on the platform.
-// Instruction returns a bit vector of the enabled hardware facilities.
-static bool supportsSTFLE() {
 #if V8_HOST_ARCH_S390
+// Read the hardware capabilities the kernel reports in the auxiliary vector.
+static uint32_t getHWCAP() {
   static bool read_tried = false;
   static uint32_t auxv_hwcap = 0;
 
@@ -98,6 +97,15 @@ static bool supportsSTFLE() {
       close(fd);
     }
   }
+  return auxv_hwcap;
+}
+#endif
+
+// Check whether Store Facility STFLE instruction is available on the platform.
+// Instruction returns a bit vector of the enabled hardware facilities.
+static bool supportsSTFLE() {
+#if V8_HOST_ARCH_S390
+  uint32_t auxv_hwcap = getHWCAP();
 
   // Did not find result
   if (0 == auxv_hwcap) {
@@ -114,6 +122,16 @@ static bool supportsSTFLE() {
 #endif
 }
 
+#if V8_HOST_ARCH_S390
+// Check whether the kernel preserves the vector registers, which is required
+// in addition to the Vector Facility itself.
+static bool supportsVectorRegisters() {
+  // HWCAP_S390_VXRS is defined to be 2048 in include/asm/elf.h.
+  const uint32_t HWCAP_S390_VXRS = 2048;
+  return (getHWCAP() & HWCAP_S390_VXRS);
+}
+#endif
+
 void CpuFeatures::ProbeImpl(bool cross_compile) {
   supported_ |= CpuFeaturesImpliedByCompiler();
   icache_line_size_ = 256;
@@ -137,14 +155,14 @@ void CpuFeatures::ProbeImpl(bool cross_compile) {
     //    D(B) to specify to memory location to store the facilities bits
     // The facilities we are checking for are:
     //   Bit 45 - Distinct Operands for instructions like ARK, SRK, etc.
-    // As such, we require only 1 double word
-    int64_t facilities[1];
-    facilities[0] = 0;
+    //   Bit 129 - Vector Facility for z/Architecture
+    // As such, we require 3 double words
+    int64_t facilities[3] = {0, 0, 0};
     // LHI sets up GPR0
     // STFLE is specified as .insn, as opcode is not recognized.
     // We register the instructions kill r0 (LHI) and the CC (STFLE).
     asm volatile(
-        "lhi   0,0\n"
+        "lhi   0,2\n"
         ".insn s,0xb2b00000,%0\n"
         : "=Q"(facilities)
         :
@@ -162,6 +180,12 @@ void CpuFeatures::ProbeImpl(bool cross_compile) {
     if (facilities[0] & (1lu << (63 - 37))) {
       supported_ |= (1u << FLOATING_POINT_EXT);
     }
+    // Test for Vector Facility - Bit 129. The kernel must also save the
+    // vector registers across context switches.
+    if ((facilities[2] & (1lu << (63 - (129 - 128)))) &&
+        supportsVectorRegisters()) {
+      supported_ |= (1u << VECTOR_FACILITY);
+    }
   }
 #else
   // All distinct ops instructions can be simulated
@@ -170,6 +194,8 @@ void CpuFeatures::ProbeImpl(bool cross_compile) {
   supported_ |= (1u << GENERAL_INSTR_EXT);
 
   supported_ |= (1u << FLOATING_POINT_EXT);
+  // The vector instructions used by the stubs can be simulated
+  supported_ |= (1u << VECTOR_FACILITY);
   USE(performSTFLE);  // To avoid assert
 #endif
   supported_ |= (1u << FPU);
@@ -192,6 +218,7 @@ void CpuFeatures::PrintFeatures() {
   printf("FPU_EXT=%d\n", CpuFeatures::IsSupported(FLOATING_POINT_EXT));
   printf("GENERAL_INSTR=%d\n", CpuFeatures::IsSupported(GENERAL_INSTR_EXT));
   printf("DISTINCT_OPS=%d\n", CpuFeatures::IsSupported(DISTINCT_OPS));
+  printf("VECTOR_FACILITY=%d\n", CpuFeatures::IsSupported(VECTOR_FACILITY));
 }
 
 Register ToRegister(int num) {
@@ -1373,6 +1400,89 @@ void Assembler::rrfe_form(Opcode op, Condition m3, Condition m4, Register r1,
   emit4bytes(code);
 }
 
+// The vector formats below only address V0-V15, so the RXB field that holds
+// the high bit of each vector register number is always zero.
+
+// VRR format: <insn> V1,V2,V3,M4,M5,M6
+//    +--------+----+----+----+----+----+----+----+----+--------+
+//    | OpCode | V1 | V2 | V3 |////| M6 | M5 | M4 |RXB | OpCode |
+//    +--------+----+----+----+----+----+----+----+----+--------+
+//    0        8    12   16   20   24   28   32   36   40      47
+// The mask fields are named for VRR-c; VRR-a uses M5/M4/M3 and VRR-b M5/-/M4.
+void Assembler::vrr_form(Opcode op, DoubleRegister v1, DoubleRegister v2,
+                         DoubleRegister v3, int m24, int m28, int m32) {
+  DCHECK(is_uint16(op));
+  DCHECK(is_uint4(m24) && is_uint4(m28) && is_uint4(m32));
+  uint64_t code = (static_cast<uint64_t>(op & 0xFF00)) * B32 |
+                  (static_cast<uint64_t>(v1.code())) * B36 |
+                  (static_cast<uint64_t>(v2.code())) * B32 |
+                  (static_cast<uint64_t>(v3.code())) * B28 |
+                  (static_cast<uint64_t>(m24)) * B20 |
+                  (static_cast<uint64_t>(m28)) * B16 |
+                  (static_cast<uint64_t>(m32)) * B12 |
+                  (static_cast<uint64_t>(op & 0x00FF));
+  emit6bytes(code);
+}
+
+// VRX format: <insn> V1,D2(X2,B2),M3
+//    +--------+----+----+----+-------------+----+----+--------+
+//    | OpCode | V1 | X2 | B2 |     D2      | M3 |RXB | OpCode |
+//    +--------+----+----+----+-------------+----+----+--------+
+//    0        8    12   16   20            32   36   40      47
+void Assembler::vrx_form(Opcode op, DoubleRegister v1, Register x2,
+                         Register b2, Disp d2, int m3) {
+  DCHECK(is_uint12(d2));
+  DCHECK(is_uint16(op));
+  DCHECK(is_uint4(m3));
+  uint64_t code = (static_cast<uint64_t>(op & 0xFF00)) * B32 |
+                  (static_cast<uint64_t>(v1.code())) * B36 |
+                  (static_cast<uint64_t>(x2.code())) * B32 |
+                  (static_cast<uint64_t>(b2.code())) * B28 |
+                  (static_cast<uint64_t>(d2 & 0x0FFF)) * B16 |
+                  (static_cast<uint64_t>(m3)) * B12 |
+                  (static_cast<uint64_t>(op & 0x00FF));
+  emit6bytes(code);
+}
+
+// VRS format: <insn> R1/V1,R3/V3,D2(B2),M4
+//    +--------+----+----+----+-------------+----+----+--------+
+//    | OpCode | R1 | R3 | B2 |     D2      | M4 |RXB | OpCode |
+//    +--------+----+----+----+-------------+----+----+--------+
+//    0        8    12   16   20            32   36   40      47
+void Assembler::vrs_form(Opcode op, int r1, int r3, Register b2, Disp d2,
+                         int m4) {
+  DCHECK(is_uint12(d2));
+  DCHECK(is_uint16(op));
+  DCHECK(is_uint4(r1) && is_uint4(r3) && is_uint4(m4));
+  uint64_t code = (static_cast<uint64_t>(op & 0xFF00)) * B32 |
+                  (static_cast<uint64_t>(r1)) * B36 |
+                  (static_cast<uint64_t>(r3)) * B32 |
+                  (static_cast<uint64_t>(b2.code())) * B28 |
+                  (static_cast<uint64_t>(d2 & 0x0FFF)) * B16 |
+                  (static_cast<uint64_t>(m4)) * B12 |
+                  (static_cast<uint64_t>(op & 0x00FF));
+  emit6bytes(code);
+}
+
+// VRI format: <insn> V1,V3,I2,M3
+//    +--------+----+----+------------------+----+----+--------+
+//    | OpCode | V1 | V3 |        I2        | M3 |RXB | OpCode |
+//    +--------+----+----+------------------+----+----+--------+
+//    0        8    12   16                 32   36   40      47
+void Assembler::vri_form(Opcode op, DoubleRegister v1, DoubleRegister v3,
+                         const Operand& i2, int m3) {
+  DCHECK(is_uint16(op));
+  DCHECK(is_uint16(i2.imm_));
+  DCHECK(is_uint4(m3));
+  uint64_t code = (static_cast<uint64_t>(op & 0xFF00)) * B32 |
+                  (static_cast<uint64_t>(v1.code())) * B36 |
+                  (static_cast<uint64_t>(v3.code())) * B32 |
+                  (static_cast<uint64_t>(i2.imm_ & 0xFFFF)) * B16 |
+                  (static_cast<uint64_t>(m3)) * B12 |
+                  (static_cast<uint64_t>(op & 0x00FF));
+  emit6bytes(code);
+}
+
 // end of S390 Instruction generation
 
 // start of S390 instruction
@@ -1394,6 +1504,8 @@ RR_FORM_EMIT(lnr, LNR)
 RSY1_FORM_EMIT(loc, LOC)
 RXY_FORM_EMIT(lrv, LRV)
 RXY_FORM_EMIT(lrvh, LRVH)
+RRE_FORM_EMIT(lrvgr, LRVGR)
+RRE_FORM_EMIT(lrvr, LRVR)
 SS1_FORM_EMIT(mvn, MVN)
 SS1_FORM_EMIT(nc, NC)
 SI_FORM_EMIT(ni, NI)
@@ -2897,6 +3009,103 @@ void Assembler::msdbr(DoubleRegister d1, DoubleRegister d3, DoubleRegister d2) {
            Register::from_code(d3.code()), Register::from_code(d2.code()));
 }
 
+// Vector Load
+void Assembler::vl(DoubleRegister v1, const MemOperand& opnd) {
+  vrx_form(VL, v1, opnd.rx(), opnd.rb(), opnd.offset(), 0);
+}
+
+// Vector Store
+void Assembler::vst(DoubleRegister v1, const MemOperand& opnd) {
+  vrx_form(VST, v1, opnd.rx(), opnd.rb(), opnd.offset(), 0);
+}
+
+// Vector Load With Length - loads bytes 0 to min(R3, 15) of V1
+void Assembler::vll(DoubleRegister v1, Register r3, const MemOperand& opnd) {
+  DCHECK(opnd.rx().is(r0));
+  vrs_form(VLL, v1.code(), r3.code(), opnd.rb(), opnd.offset(), 0);
+}
+
+// Vector Store With Length - stores bytes 0 to min(R3, 15) of V1
+void Assembler::vstl(DoubleRegister v1, Register r3, const MemOperand& opnd) {
+  DCHECK(opnd.rx().is(r0));
+  vrs_form(VSTL, v1.code(), r3.code(), opnd.rb(), opnd.offset(), 0);
+}
+
+// Vector Load (Register)
+void Assembler::vlr(DoubleRegister v1, DoubleRegister v2) {
+  vrr_form(VLR, v1, v2, d0, 0, 0, 0);
+}
+
+// Vector Load GR from VR Element - the element index is D2(B2)
+void Assembler::vlgv(Register r1, DoubleRegister v3, const MemOperand& opnd,
+                     VectorElementSize m4) {
+  DCHECK(opnd.rx().is(r0));
+  vrs_form(VLGV, r1.code(), v3.code(), opnd.rb(), opnd.offset(), m4);
+}
+
+// Vector Load VR Element from GR - the element index is D2(B2)
+void Assembler::vlvg(DoubleRegister v1, Register r3, const MemOperand& opnd,
+                     VectorElementSize m4) {
+  DCHECK(opnd.rx().is(r0));
+  vrs_form(VLVG, v1.code(), r3.code(), opnd.rb(), opnd.offset(), m4);
+}
+
+// Vector Generate Byte Mask
+void Assembler::vgbm(DoubleRegister v1, const Operand& i2) {
+  vri_form(VGBM, v1, d0, i2, 0);
+}
+
+// Vector Replicate - copies element I2 of V3 into every element of V1
+void Assembler::vrep(DoubleRegister v1, DoubleRegister v3, const Operand& i2,
+                     VectorElementSize m4) {
+  vri_form(VREP, v1, v3, i2, m4);
+}
+
+// Vector And
+void Assembler::vn(DoubleRegister v1, DoubleRegister v2, DoubleRegister v3) {
+  vrr_form(VN, v1, v2, v3, 0, 0, 0);
+}
+
+// Vector Or
+void Assembler::vo(DoubleRegister v1, DoubleRegister v2, DoubleRegister v3) {
+  vrr_form(VO, v1, v2, v3, 0, 0, 0);
+}
+
+// Vector Exclusive Or
+void Assembler::vx(DoubleRegister v1, DoubleRegister v2, DoubleRegister v3) {
+  vrr_form(VX, v1, v2, v3, 0, 0, 0);
+}
+
+// Vector Compare Equal
+void Assembler::vceq(DoubleRegister v1, DoubleRegister v2, DoubleRegister v3,
+                     VectorElementSize m4, int m5) {
+  vrr_form(VCEQ, v1, v2, v3, m5, 0, m4);
+}
+
+// Vector Find Any Element Equal
+void Assembler::vfae(DoubleRegister v1, DoubleRegister v2, DoubleRegister v3,
+                     VectorElementSize m4, int m5) {
+  vrr_form(VFAE, v1, v2, v3, m5, 0, m4);
+}
+
+// Vector Find Element Equal
+void Assembler::vfee(DoubleRegister v1, DoubleRegister v2, DoubleRegister v3,
+                     VectorElementSize m4, int m5) {
+  vrr_form(VFEE, v1, v2, v3, m5, 0, m4);
+}
+
+// Vector Find Element Not Equal
+void Assembler::vfene(DoubleRegister v1, DoubleRegister v2, DoubleRegister v3,
+                      VectorElementSize m4, int m5) {
+  vrr_form(VFENE, v1, v2, v3, m5, 0, m4);
+}
+
+// Vector FP Add
+void Assembler::vfa(DoubleRegister v1, DoubleRegister v2, DoubleRegister v3,
+                    VectorElementSize m4, int m5) {
+  vrr_form(VFA, v1, v2, v3, 0, m5, m4);
+}
+
 // end of S390instructions
 
 bool Assembler::IsNop(SixByteInstr instr, int type) {
@@ -800,6 +800,8 @@ class Assembler : public AssemblerBase {
   RSY1_FORM(loc);
   RXY_FORM(lrv);
   RXY_FORM(lrvh);
+  RRE_FORM(lrvgr);
+  RRE_FORM(lrvr);
   RXE_FORM(mdb);
   RRE_FORM(mdbr);
   SS4_FORM(mvck);
@@ -1179,7 +1181,7 @@ class Assembler : public AssemblerBase {
   enum FIDBRA_MASK3 {
     FIDBRA_CURRENT_ROUNDING_MODE = 0,
     FIDBRA_ROUND_TO_NEAREST_AWAY_FROM_0 = 1,
-    // ...
+    FIDBRA_ROUND_TO_NEAREST_TO_EVEN = 4,
     FIDBRA_ROUND_TOWARD_0 = 5,
     FIDBRA_ROUND_TOWARD_POS_INF = 6,
     FIDBRA_ROUND_TOWARD_NEG_INF = 7
@@ -1187,6 +1189,36 @@ class Assembler : public AssemblerBase {
   void fiebra(DoubleRegister d1, DoubleRegister d2, FIDBRA_MASK3 m3);
   void fidbra(DoubleRegister d1, DoubleRegister d2, FIDBRA_MASK3 m3);
 
+  // Vector Facility Instructions (z13)
+  // Vector registers V0-V15 contain the floating point registers in their
+  // leftmost doubleword and are named by the DoubleRegister of the same code.
+  void vl(DoubleRegister v1, const MemOperand& opnd);
+  void vst(DoubleRegister v1, const MemOperand& opnd);
+  void vll(DoubleRegister v1, Register r3, const MemOperand& opnd);
+  void vstl(DoubleRegister v1, Register r3, const MemOperand& opnd);
+  void vlr(DoubleRegister v1, DoubleRegister v2);
+  void vlgv(Register r1, DoubleRegister v3, const MemOperand& opnd,
+            VectorElementSize m4);
+  void vlvg(DoubleRegister v1, Register r3, const MemOperand& opnd,
+            VectorElementSize m4);
+  void vgbm(DoubleRegister v1, const Operand& i2);
+  void vrep(DoubleRegister v1, DoubleRegister v3, const Operand& i2,
+            VectorElementSize m4);
+  void vn(DoubleRegister v1, DoubleRegister v2, DoubleRegister v3);
+  void vo(DoubleRegister v1, DoubleRegister v2, DoubleRegister v3);
+  void vx(DoubleRegister v1, DoubleRegister v2, DoubleRegister v3);
+  void vceq(DoubleRegister v1, DoubleRegister v2, DoubleRegister v3,
+            VectorElementSize m4, int m5 = kVectorNoFlags);
+  void vfae(DoubleRegister v1, DoubleRegister v2, DoubleRegister v3,
+            VectorElementSize m4, int m5 = kVectorNoFlags);
+  void vfee(DoubleRegister v1, DoubleRegister v2, DoubleRegister v3,
+            VectorElementSize m4, int m5 = kVectorNoFlags);
+  void vfene(DoubleRegister v1, DoubleRegister v2, DoubleRegister v3,
+             VectorElementSize m4, int m5 = kVectorNoFlags);
+  // Only long BFP elements (m4 == kVectorDoubleword) exist on z13.
+  void vfa(DoubleRegister v1, DoubleRegister v2, DoubleRegister v3,
+           VectorElementSize m4 = kVectorDoubleword, int m5 = 0);
+
   // Move integer
   void mvhi(const MemOperand& opnd1, const Operand& i2);
   void mvghi(const MemOperand& opnd1, const Operand& i2);
@@ -1439,6 +1471,15 @@ class Assembler : public AssemblerBase {
   inline void ssf_form(Opcode op, Register r3, Register b1, Disp d1,
                        Register b2, Disp d2);
 
+  inline void vrr_form(Opcode op, DoubleRegister v1, DoubleRegister v2,
+                       DoubleRegister v3, int m24, int m28, int m32);
+  inline void vrx_form(Opcode op, DoubleRegister v1, Register x2, Register b2,
+                       Disp d2, int m3);
+  inline void vrs_form(Opcode op, int r1, int r3, Register b2, Disp d2,
+                       int m4);
+  inline void vri_form(Opcode op, DoubleRegister v1, DoubleRegister v3,
+                       const Operand& i2, int m3);
+
   // Labels
   void print(Label* L);
   int max_reach_from(int pos);
@@ -2443,15 +2443,38 @@ void StringHelper::GenerateCopyCharacters(MacroAssembler* masm, Register dest,
     __ beq(&done, Label::kNear);
   }
 
-  // Copy count bytes from src to dst.
-  Label byte_loop;
-  // TODO(joransiu): Convert into MVC loop
-  __ bind(&byte_loop);
-  __ LoadlB(scratch, MemOperand(src));
-  __ la(src, MemOperand(src, 1));
-  __ stc(scratch, MemOperand(dest));
-  __ la(dest, MemOperand(dest, 1));
-  __ BranchOnCount(count, &byte_loop);
+  if (CpuFeatures::IsSupported(VECTOR_FACILITY)) {
+    // Copy 16 bytes at a time, then the remaining bytes with a single
+    // length-limited load and store.
+    Label vector_loop, tail;
+    __ bind(&vector_loop);
+    __ CmpP(count, Operand(kVectorRegisterSize));
+    __ blt(&tail, Label::kNear);
+    __ vl(kScratchDoubleReg, MemOperand(src));
+    __ vst(kScratchDoubleReg, MemOperand(dest));
+    __ la(src, MemOperand(src, kVectorRegisterSize));
+    __ la(dest, MemOperand(dest, kVectorRegisterSize));
+    __ SubP(count, Operand(kVectorRegisterSize));
+    __ b(&vector_loop, Label::kNear);
+
+    __ bind(&tail);
+    __ CmpP(count, Operand::Zero());
+    __ beq(&done, Label::kNear);
+    // VLL and VSTL take the index of the last byte to access.
+    __ SubP(count, Operand(1));
+    __ vll(kScratchDoubleReg, count, MemOperand(src));
+    __ vstl(kScratchDoubleReg, count, MemOperand(dest));
+  } else {
+    // Copy count bytes from src to dst.
+    Label byte_loop;
+    // TODO(joransiu): Convert into MVC loop
+    __ bind(&byte_loop);
+    __ LoadlB(scratch, MemOperand(src));
+    __ la(src, MemOperand(src, 1));
+    __ stc(scratch, MemOperand(dest));
+    __ la(dest, MemOperand(dest, 1));
+    __ BranchOnCount(count, &byte_loop);
+  }
 
   __ bind(&done);
 }
@@ -2898,7 +2921,29 @@ void StringHelper::GenerateOneByteCharsCompareLoop(
   Register index = length;  // index = -length;
 
   // Compare loop.
-  Label loop;
+  Label loop, done;
+  if (CpuFeatures::IsSupported(VECTOR_FACILITY)) {
+    // Compare 16 characters at a time while that many remain.  On a
+    // mismatch, advance index to the differing character and let the byte
+    // loop below redo that comparison to set the condition code.
+    Label vector_loop;
+    __ bind(&vector_loop);
+    __ AddP(scratch1, index, Operand(kVectorRegisterSize));
+    __ CmpP(scratch1, Operand::Zero());
+    __ bgt(&loop);
+    __ vl(kScratchDoubleReg, MemOperand(left, index));
+    __ vl(kDoubleRegZero, MemOperand(right, index));
+    __ vfene(kScratchDoubleReg, kScratchDoubleReg, kDoubleRegZero,
+             kVectorByte);
+    // Byte 7 of the result holds the index of the first mismatch, or 16.
+    __ vlgv(scratch1, kScratchDoubleReg, MemOperand(r0, 7), kVectorByte);
+    __ AddP(index, scratch1);
+    __ CmpP(scratch1, Operand(kVectorRegisterSize));
+    __ bne(&loop);
+    __ CmpP(index, Operand::Zero());
+    __ bne(&vector_loop);
+    __ b(&done);
+  }
   __ bind(&loop);
   __ LoadlB(scratch1, MemOperand(left, index));
   __ LoadlB(r0, MemOperand(right, index));
@@ -2907,6 +2952,7 @@ void StringHelper::GenerateOneByteCharsCompareLoop(
   __ AddP(index, Operand(1));
   __ CmpP(index, Operand::Zero());
   __ bne(&loop);
+  __ bind(&done);
 }
 
 void StringCompareStub::Generate(MacroAssembler* masm) {
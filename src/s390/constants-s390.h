@@ -901,6 +901,23 @@ enum Opcode {
   UNPKA = 0xEA,       // Unpack Ascii
   UNPKU = 0xE2,       // Unpack Unicode
   UPT = 0x0102,       // Update Tree
+  VCEQ = 0xE7F8,      // Vector Compare Equal
+  VFA = 0xE7E3,       // Vector FP Add
+  VFAE = 0xE782,      // Vector Find Any Element Equal
+  VFEE = 0xE780,      // Vector Find Element Equal
+  VFENE = 0xE781,     // Vector Find Element Not Equal
+  VGBM = 0xE744,      // Vector Generate Byte Mask
+  VL = 0xE706,        // Vector Load
+  VLGV = 0xE721,      // Vector Load GR from VR Element
+  VLL = 0xE737,       // Vector Load With Length
+  VLR = 0xE756,       // Vector Load (Register)
+  VLVG = 0xE722,      // Vector Load VR Element from GR
+  VN = 0xE768,        // Vector And
+  VO = 0xE76A,        // Vector Or
+  VREP = 0xE74D,      // Vector Replicate
+  VST = 0xE70E,       // Vector Store
+  VSTL = 0xE73F,      // Vector Store With Length
+  VX = 0xE76D,        // Vector Exclusive Or
   X = 0x57,           // Exclusive Or (32)
   XC = 0xD7,          // Exclusive Or (character)
   XG = 0xE382,        // Exclusive Or (64)
@@ -1057,6 +1074,25 @@ enum CheckForInexactConversion {
   kDontCheckForInexactConversion
 };
 
+// Element size control (M4 field) of the vector facility instructions.
+enum VectorElementSize {
+  kVectorByte = 0,
+  kVectorHalfword = 1,
+  kVectorWord = 2,
+  kVectorDoubleword = 3
+};
+
+const int kVectorRegisterSize = 16;
+
+// Flags (M5 field) of the vector string instructions.
+enum VectorStringFlags {
+  kVectorNoFlags = 0,
+  kVectorSetCC = 1,        // CS: set the condition code.
+  kVectorZeroSearch = 2,   // ZS: also search for a zero element.
+  kVectorResultMask = 4,   // RT: return an element mask instead of an index.
+  kVectorInvertResult = 8  // IN: invert the sense of the comparison.
+};
+
 // -----------------------------------------------------------------------------
 // Specific instructions, constants, and masks.
 
@@ -1535,6 +1571,86 @@ class RIEInstruction : Instruction {
   inline int size() const { return 6; }
 };
 
+// Vector instruction formats. Vector register numbers are 5 bits wide; the
+// high bit of each register field is kept in the RXB field (bits 36-39).
+
+// VRR Instruction
+class VRRInstruction : Instruction {
+ public:
+  inline int V1Value() const {
+    int rxb = Bits<SixByteInstr, int>(11, 8);
+    return Bits<SixByteInstr, int>(39, 36) | (rxb & 8) << 1;
+  }
+  inline int V2Value() const {
+    int rxb = Bits<SixByteInstr, int>(11, 8);
+    return Bits<SixByteInstr, int>(35, 32) | (rxb & 4) << 2;
+  }
+  inline int V3Value() const {
+    int rxb = Bits<SixByteInstr, int>(11, 8);
+    return Bits<SixByteInstr, int>(31, 28) | (rxb & 2) << 3;
+  }
+  // Mask fields in bits 32-35, 28-31 and 24-27. Their names depend on the
+  // format: M3, M4 and M5 for VRR-a, M4, - and M5 for VRR-b and M4, M5 and
+  // M6 for VRR-c.
+  inline int M32Value() const { return Bits<SixByteInstr, int>(15, 12); }
+  inline int M28Value() const { return Bits<SixByteInstr, int>(19, 16); }
+  inline int M24Value() const { return Bits<SixByteInstr, int>(23, 20); }
+  inline int size() const { return 6; }
+};
+
+// VRX Instruction
+class VRXInstruction : Instruction {
+ public:
+  inline int V1Value() const {
+    int rxb = Bits<SixByteInstr, int>(11, 8);
+    return Bits<SixByteInstr, int>(39, 36) | (rxb & 8) << 1;
+  }
+  inline int X2Value() const { return Bits<SixByteInstr, int>(35, 32); }
+  inline int B2Value() const { return Bits<SixByteInstr, int>(31, 28); }
+  inline int D2Value() const { return Bits<SixByteInstr, int>(27, 16); }
+  inline int M3Value() const { return Bits<SixByteInstr, int>(15, 12); }
+  inline int size() const { return 6; }
+};
+
+// VRS Instruction
+class VRSInstruction : Instruction {
+ public:
+  // The first operand is a vector register for VRS-a/b and a general
+  // register for VRS-c; the second is a general register for VRS-b.
+  inline int R1Value() const { return Bits<SixByteInstr, int>(39, 36); }
+  inline int V1Value() const {
+    int rxb = Bits<SixByteInstr, int>(11, 8);
+    return Bits<SixByteInstr, int>(39, 36) | (rxb & 8) << 1;
+  }
+  inline int R3Value() const { return Bits<SixByteInstr, int>(35, 32); }
+  inline int V3Value() const {
+    int rxb = Bits<SixByteInstr, int>(11, 8);
+    return Bits<SixByteInstr, int>(35, 32) | (rxb & 4) << 2;
+  }
+  inline int B2Value() const { return Bits<SixByteInstr, int>(31, 28); }
+  inline int D2Value() const { return Bits<SixByteInstr, int>(27, 16); }
+  inline int M4Value() const { return Bits<SixByteInstr, int>(15, 12); }
+  inline int size() const { return 6; }
+};
+
+// VRI Instruction
+class VRIInstruction : Instruction {
+ public:
+  inline int V1Value() const {
+    int rxb = Bits<SixByteInstr, int>(11, 8);
+    return Bits<SixByteInstr, int>(39, 36) | (rxb & 8) << 1;
+  }
+  inline int V3Value() const {
+    int rxb = Bits<SixByteInstr, int>(11, 8);
+    return Bits<SixByteInstr, int>(35, 32) | (rxb & 4) << 2;
+  }
+  inline uint16_t I2Value() const {
+    return Bits<SixByteInstr, uint16_t>(31, 16);
+  }
+  inline int M3Value() const { return Bits<SixByteInstr, int>(15, 12); }
+  inline int size() const { return 6; }
+};
+
 // Helper functions for converting between register numbers and names.
 class Registers {
  public:
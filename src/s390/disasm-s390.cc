@@ -68,6 +68,7 @@ class Decoder {
   // Handle formatting of instructions and their options.
   int FormatRegister(Instruction* instr, const char* option);
   int FormatFloatingRegister(Instruction* instr, const char* option);
+  int FormatVectorRegister(Instruction* instr, const char* option);
   int FormatMask(Instruction* instr, const char* option);
   int FormatDisplacement(Instruction* instr, const char* option);
   int FormatImmediate(Instruction* instr, const char* option);
@@ -223,6 +224,26 @@ int Decoder::FormatFloatingRegister(Instruction* instr, const char* format) {
   return -1;
 }
 
+int Decoder::FormatVectorRegister(Instruction* instr, const char* format) {
+  DCHECK(format[0] == 'v');
+
+  // The high bit of each register number comes from the RXB field.
+  VRRInstruction* vrrinstr = reinterpret_cast<VRRInstruction*>(instr);
+  int reg;
+  if (format[1] == '1') {  // 'v1: register resides in bit 8-11
+    reg = vrrinstr->V1Value();
+  } else if (format[1] == '2') {  // 'v2: register resides in bit 12-15
+    reg = vrrinstr->V2Value();
+  } else if (format[1] == '3') {  // 'v3: register resides in bit 16-19
+    reg = vrrinstr->V3Value();
+  } else {
+    UNREACHABLE();
+    return -1;
+  }
+  out_buffer_pos_ += SNPrintF(out_buffer_ + out_buffer_pos_, "v%d", reg);
+  return 2;
+}
+
 // FormatOption takes a formatting string and interprets it based on
 // the current instructions. The format string points to the first
 // character of the option string (the option escape has already been
@@ -250,6 +271,9 @@ int Decoder::FormatOption(Instruction* instr, const char* format) {
     case 'f': {
       return FormatFloatingRegister(instr, format);
     }
+    case 'v': {
+      return FormatVectorRegister(instr, format);
+    }
     case 'i': {  // int16
       return FormatImmediate(instr, format);
     }
@@ -316,6 +340,12 @@ int Decoder::FormatMask(Instruction* instr, const char* format) {
     value = reinterpret_cast<RXInstruction*>(instr)->B2Value();
     out_buffer_pos_ += SNPrintF(out_buffer_ + out_buffer_pos_, "0x%x", value);
     return 2;
+  } else if (format[1] == '3') {  // vector mask in bit 32 - 35
+    value = reinterpret_cast<VRRInstruction*>(instr)->M32Value();
+  } else if (format[1] == '4') {  // vector mask in bit 28 - 31
+    value = reinterpret_cast<VRRInstruction*>(instr)->M28Value();
+  } else if (format[1] == '5') {  // vector mask in bit 24 - 27
+    value = reinterpret_cast<VRRInstruction*>(instr)->M24Value();
   }
 
   out_buffer_pos_ += SNPrintF(out_buffer_ + out_buffer_pos_, "%d", value);
@@ -435,6 +465,11 @@ int Decoder::FormatImmediate(Instruction* instr, const char* format) {
     int16_t value = silinstr->I2Value();
     out_buffer_pos_ += SNPrintF(out_buffer_ + out_buffer_pos_, "%d", value);
     return 2;
+  } else if (format[1] == 'f') {  // unsigned immediate in 16-31 of VRI
+    VRIInstruction* vriinstr = reinterpret_cast<VRIInstruction*>(instr);
+    uint16_t value = vriinstr->I2Value();
+    out_buffer_pos_ += SNPrintF(out_buffer_ + out_buffer_pos_, "%d", value);
+    return 2;
   } else if (format[1] == 'e') {  // immediate in 16-47, but outputs as offset
     RILInstruction* rilinstr = reinterpret_cast<RILInstruction*>(instr);
     int32_t value = rilinstr->I2Value() * 2;
@@ -976,6 +1011,12 @@ bool Decoder::DecodeFourByte(Instruction* instr) {
     case FLOGR:
       Format(instr, "flogr\t'r5,'r6");
       break;
+    case LRVR:
+      Format(instr, "lrvr\t'r5,'r6");
+      break;
+    case LRVGR:
+      Format(instr, "lrvgr\t'r5,'r6");
+      break;
     // TRAP4 is used in calling to native function. it will not be generated
     // in native code.
     case TRAP4: {
@@ -998,6 +1039,57 @@ bool Decoder::DecodeSixByte(Instruction* instr) {
 
   Opcode opcode = instr->S390OpcodeValue();
   switch (opcode) {
+    case VL:
+      Format(instr, "vl\t'v1,'d1('r2d,'r3)");
+      break;
+    case VST:
+      Format(instr, "vst\t'v1,'d1('r2d,'r3)");
+      break;
+    case VLL:
+      Format(instr, "vll\t'v1,'r2,'d1('r3)");
+      break;
+    case VSTL:
+      Format(instr, "vstl\t'v1,'r2,'d1('r3)");
+      break;
+    case VLR:
+      Format(instr, "vlr\t'v1,'v2");
+      break;
+    case VLGV:
+      Format(instr, "vlgv\t'r1,'v2,'d1('r3),'m3");
+      break;
+    case VLVG:
+      Format(instr, "vlvg\t'v1,'r2,'d1('r3),'m3");
+      break;
+    case VGBM:
+      Format(instr, "vgbm\t'v1,'if");
+      break;
+    case VREP:
+      Format(instr, "vrep\t'v1,'v2,'if,'m3");
+      break;
+    case VN:
+      Format(instr, "vn\t'v1,'v2,'v3");
+      break;
+    case VO:
+      Format(instr, "vo\t'v1,'v2,'v3");
+      break;
+    case VX:
+      Format(instr, "vx\t'v1,'v2,'v3");
+      break;
+    case VCEQ:
+      Format(instr, "vceq\t'v1,'v2,'v3,'m3,'m5");
+      break;
+    case VFAE:
+      Format(instr, "vfae\t'v1,'v2,'v3,'m3,'m5");
+      break;
+    case VFEE:
+      Format(instr, "vfee\t'v1,'v2,'v3,'m3,'m5");
+      break;
+    case VFENE:
+      Format(instr, "vfene\t'v1,'v2,'v3,'m3,'m5");
+      break;
+    case VFA:
+      Format(instr, "vfa\t'v1,'v2,'v3,'m3,'m4");
+      break;
     case LLILF:
       Format(instr, "llilf\t'r1,'i7");
       break;
@@ -5209,6 +5209,73 @@ void MacroAssembler::Popcnt64(Register dst, Register src) {
 }
 #endif
 
+// Computes the number of trailing zeros of r1 into dst, clobbering r0 and
+// r1.  (x ^ (x - 1)) & (x - 1) has exactly ctz(x) low bits set, so FLOGR
+// finds 64 - ctz(x) leading zeros in it; x == 0 yields 64.
+static void CountTrailingZerosOfR1(MacroAssembler* masm, Register dst) {
+  masm->lgr(r0, r1);
+  masm->aghi(r1, Operand(-1));
+  masm->xgr(r0, r1);
+  masm->ngr(r0, r1);
+  masm->flogr(r0, r0);
+  masm->lghi(dst, Operand(64));
+  masm->sgr(dst, r0);
+}
+
+void MacroAssembler::CountTrailingZeros32(Register dst, Register src) {
+  DCHECK(!src.is(r0) && !src.is(r1));
+  DCHECK(!dst.is(r0) && !dst.is(r1));
+
+  // Setting bit 32 makes a zero input count 32 trailing zeros.
+  llgfr(r1, src);
+  oihf(r1, Operand(1));
+  CountTrailingZerosOfR1(this, dst);
+}
+
+// Masks for swapping nibbles, bit pairs and single bits within each byte.
+static const uint32_t kReverseBitsMasks[] = {0x0F0F0F0F, 0x33333333,
+                                             0x55555555};
+
+void MacroAssembler::ReverseBits32(Register dst, Register src) {
+  DCHECK(!src.is(r0));
+  DCHECK(!dst.is(r0));
+
+  lrvr(dst, src);
+  for (int i = 0, shift = 4; i < 3; i++, shift >>= 1) {
+    ShiftRight(r0, dst, Operand(shift));
+    nilf(r0, Operand(kReverseBitsMasks[i]));
+    nilf(dst, Operand(kReverseBitsMasks[i]));
+    ShiftLeft(dst, dst, Operand(shift));
+    Or(dst, r0);
+  }
+}
+
+#ifdef V8_TARGET_ARCH_S390X
+void MacroAssembler::CountTrailingZeros64(Register dst, Register src) {
+  DCHECK(!src.is(r0) && !src.is(r1));
+  DCHECK(!dst.is(r0) && !dst.is(r1));
+
+  lgr(r1, src);
+  CountTrailingZerosOfR1(this, dst);
+}
+
+void MacroAssembler::ReverseBits64(Register dst, Register src) {
+  DCHECK(!src.is(r0));
+  DCHECK(!dst.is(r0));
+
+  lrvgr(dst, src);
+  for (int i = 0, shift = 4; i < 3; i++, shift >>= 1) {
+    ShiftRightP(r0, dst, Operand(shift));
+    nihf(r0, Operand(kReverseBitsMasks[i]));
+    nilf(r0, Operand(kReverseBitsMasks[i]));
+    nihf(dst, Operand(kReverseBitsMasks[i]));
+    nilf(dst, Operand(kReverseBitsMasks[i]));
+    ShiftLeftP(dst, dst, Operand(shift));
+    OrP(dst, r0);
+  }
+}
+#endif
+
 #ifdef DEBUG
 bool AreAliased(Register reg1, Register reg2, Register reg3, Register reg4,
                 Register reg5, Register reg6, Register reg7, Register reg8,
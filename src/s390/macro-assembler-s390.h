@@ -399,9 +399,15 @@ class MacroAssembler : public Assembler {
   void Xor(Register dst, Register src, const Operand& opnd);
   void XorP(Register dst, Register src, const Operand& opnd);
   void Popcnt32(Register dst, Register src);
+  // Clobbers r0 and r1.
+  void CountTrailingZeros32(Register dst, Register src);
+  void ReverseBits32(Register dst, Register src);
 
 #ifdef V8_TARGET_ARCH_S390X
   void Popcnt64(Register dst, Register src);
+  // Clobbers r0 and r1.
+  void CountTrailingZeros64(Register dst, Register src);
+  void ReverseBits64(Register dst, Register src);
 #endif
 
   void NotP(Register dst);
@@ -788,6 +788,7 @@ Simulator::Simulator(Isolate* isolate) : isolate_(isolate) {
   // Initializing FP registers.
   for (int i = 0; i < kNumFPRs; i++) {
     fp_registers_[i] = 0.0;
+    vr_low_registers_[i] = 0;
   }
 
   // The sp is initialized to point to the bottom (high address) of the
@@ -991,6 +992,28 @@ double Simulator::get_double_from_register_pair(int reg) {
   return (dm_val);
 }
 
+void Simulator::get_vector_register(int vreg, uint8_t* bytes) const {
+  DCHECK(vreg >= 0 && vreg < kNumFPRs);
+  uint64_t high = static_cast<uint64_t>(fp_registers_[vreg]);
+  uint64_t low = static_cast<uint64_t>(vr_low_registers_[vreg]);
+  for (int i = 0; i < 8; i++) {
+    bytes[i] = static_cast<uint8_t>(high >> (56 - 8 * i));
+    bytes[i + 8] = static_cast<uint8_t>(low >> (56 - 8 * i));
+  }
+}
+
+void Simulator::set_vector_register(int vreg, const uint8_t* bytes) {
+  DCHECK(vreg >= 0 && vreg < kNumFPRs);
+  uint64_t high = 0;
+  uint64_t low = 0;
+  for (int i = 0; i < 8; i++) {
+    high = (high << 8) | bytes[i];
+    low = (low << 8) | bytes[i + 8];
+  }
+  fp_registers_[vreg] = static_cast<int64_t>(high);
+  vr_low_registers_[vreg] = static_cast<int64_t>(low);
+}
+
 // Raw access to the PC register.
 void Simulator::set_pc(intptr_t value) {
   pc_modified_ = true;
@@ -2888,12 +2911,35 @@ bool Simulator::DecodeFourByteArithmetic(Instruction* instr) {
 
       r2_val = get_register(r2);
 
-      int64_t mask = ~(1 << (63 - i));
+      // The leftmost one bit found is cleared in the odd register.
+      uint64_t mask =
+          (i < 64) ? ~(static_cast<uint64_t>(1) << (63 - i)) : ~0ULL;
       set_register(r1, i);
       set_register(r1 + 1, r2_val & mask);
+      condition_reg_ = (i < 64) ? 0x2 : CC_EQ;
 
       break;
     }
+    case LRVR: {
+      RREInstruction* rreInst = reinterpret_cast<RREInstruction*>(instr);
+      int r1 = rreInst->R1Value();
+      int r2 = rreInst->R2Value();
+      int32_t r2_val = get_low_register<int32_t>(r2);
+      set_low_register(r1, ByteReverse(r2_val));
+      break;
+    }
+    case LRVGR: {
+      RREInstruction* rreInst = reinterpret_cast<RREInstruction*>(instr);
+      int r1 = rreInst->R1Value();
+      int r2 = rreInst->R2Value();
+      uint64_t r2_val = get_register(r2);
+      uint64_t high = static_cast<uint32_t>(
+          ByteReverse(static_cast<int32_t>(r2_val >> 32)));
+      uint64_t low = static_cast<uint32_t>(
+          ByteReverse(static_cast<int32_t>(r2_val)));
+      set_register(r1, (low << 32) | high);
+      break;
+    }
     case MSR:
     case MSGR: {  // they do not set overflow code
       RREInstruction* rreInst = reinterpret_cast<RREInstruction*>(instr);
@@ -3567,6 +3613,9 @@ bool Simulator::DecodeFourByteFloatingPoint(Instruction* instr) {
         case Assembler::FIDBRA_ROUND_TO_NEAREST_AWAY_FROM_0:
           set_d_register_from_double(r1, round(r2_val));
           break;
+        case Assembler::FIDBRA_ROUND_TO_NEAREST_TO_EVEN:
+          set_d_register_from_double(r1, std::nearbyint(r2_val));
+          break;
         case Assembler::FIDBRA_ROUND_TOWARD_0:
           set_d_register_from_double(r1, trunc(r2_val));
           break;
@@ -3593,6 +3642,9 @@ bool Simulator::DecodeFourByteFloatingPoint(Instruction* instr) {
         case Assembler::FIDBRA_ROUND_TO_NEAREST_AWAY_FROM_0:
           set_d_register_from_float32(r1, round(r2_val));
           break;
+        case Assembler::FIDBRA_ROUND_TO_NEAREST_TO_EVEN:
+          set_d_register_from_float32(r1, std::nearbyint(r2_val));
+          break;
         case Assembler::FIDBRA_ROUND_TOWARD_0:
           set_d_register_from_float32(r1, trunc(r2_val));
           break;
@@ -4211,6 +4263,24 @@ bool Simulator::DecodeSixByte(Instruction* instr) {
       set_register(r1, selected_val);
       break;
     }
+    case VCEQ:
+    case VFA:
+    case VFAE:
+    case VFEE:
+    case VFENE:
+    case VGBM:
+    case VL:
+    case VLGV:
+    case VLL:
+    case VLR:
+    case VLVG:
+    case VN:
+    case VO:
+    case VREP:
+    case VST:
+    case VSTL:
+    case VX:
+      return DecodeSixByteVector(instr);
     default:
       return DecodeSixByteArithmetic(instr);
   }
@@ -4674,6 +4744,252 @@ bool Simulator::DecodeSixByteArithmetic(Instruction* instr) {
   return true;
 }
 
+// Returns the zero-extended element at |index| of a vector register image,
+// where |size| is a VectorElementSize.
+static uint64_t GetVectorElement(const uint8_t* bytes, int size, int index) {
+  int element_bytes = 1 << size;
+  uint64_t value = 0;
+  for (int i = 0; i < element_bytes; i++) {
+    value = (value << 8) | bytes[index * element_bytes + i];
+  }
+  return value;
+}
+
+static void SetVectorElement(uint8_t* bytes, int size, int index,
+                             uint64_t value) {
+  int element_bytes = 1 << size;
+  for (int i = element_bytes - 1; i >= 0; i--) {
+    bytes[index * element_bytes + i] = static_cast<uint8_t>(value);
+    value >>= 8;
+  }
+}
+
+/**
+ * Decodes and simulates six byte vector facility instructions
+ */
+bool Simulator::DecodeSixByteVector(Instruction* instr) {
+  Opcode op = instr->S390OpcodeValue();
+
+  // Pre-cast instruction to various types
+  VRRInstruction* vrrInstr = reinterpret_cast<VRRInstruction*>(instr);
+  VRXInstruction* vrxInstr = reinterpret_cast<VRXInstruction*>(instr);
+  VRSInstruction* vrsInstr = reinterpret_cast<VRSInstruction*>(instr);
+  VRIInstruction* vriInstr = reinterpret_cast<VRIInstruction*>(instr);
+
+  uint8_t v1[kVectorRegisterSize];
+  uint8_t v2[kVectorRegisterSize];
+  uint8_t v3[kVectorRegisterSize];
+
+  switch (op) {
+    case VL:
+    case VST: {
+      int x2 = vrxInstr->X2Value();
+      int b2 = vrxInstr->B2Value();
+      int64_t x2_val = (x2 == 0) ? 0 : get_register(x2);
+      int64_t b2_val = (b2 == 0) ? 0 : get_register(b2);
+      intptr_t addr = x2_val + b2_val + vrxInstr->D2Value();
+      if (op == VL) {
+        for (int i = 0; i < kVectorRegisterSize; i++) {
+          v1[i] = ReadBU(addr + i);
+        }
+        set_vector_register(vrxInstr->V1Value(), v1);
+      } else {
+        get_vector_register(vrxInstr->V1Value(), v1);
+        for (int i = 0; i < kVectorRegisterSize; i++) {
+          WriteB(addr + i, v1[i]);
+        }
+      }
+      break;
+    }
+    case VLL:
+    case VSTL: {
+      // R3 holds the highest byte index to access, capped at 15.
+      int b2 = vrsInstr->B2Value();
+      int64_t b2_val = (b2 == 0) ? 0 : get_register(b2);
+      intptr_t addr = b2_val + vrsInstr->D2Value();
+      uint32_t last = get_low_register<uint32_t>(vrsInstr->R3Value());
+      int length = (last >= kVectorRegisterSize - 1) ? kVectorRegisterSize
+                                                     : last + 1;
+      if (op == VLL) {
+        memset(v1, 0, kVectorRegisterSize);
+        for (int i = 0; i < length; i++) {
+          v1[i] = ReadBU(addr + i);
+        }
+        set_vector_register(vrsInstr->V1Value(), v1);
+      } else {
+        get_vector_register(vrsInstr->V1Value(), v1);
+        for (int i = 0; i < length; i++) {
+          WriteB(addr + i, v1[i]);
+        }
+      }
+      break;
+    }
+    case VLR: {
+      get_vector_register(vrrInstr->V2Value(), v2);
+      set_vector_register(vrrInstr->V1Value(), v2);
+      break;
+    }
+    case VLGV: {
+      int size = vrsInstr->M4Value();
+      int b2 = vrsInstr->B2Value();
+      int64_t b2_val = (b2 == 0) ? 0 : get_register(b2);
+      int index = (b2_val + vrsInstr->D2Value()) &
+                  ((kVectorRegisterSize >> size) - 1);
+      get_vector_register(vrsInstr->V3Value(), v3);
+      set_register(vrsInstr->R1Value(), GetVectorElement(v3, size, index));
+      break;
+    }
+    case VLVG: {
+      int size = vrsInstr->M4Value();
+      int b2 = vrsInstr->B2Value();
+      int64_t b2_val = (b2 == 0) ? 0 : get_register(b2);
+      int index = (b2_val + vrsInstr->D2Value()) &
+                  ((kVectorRegisterSize >> size) - 1);
+      get_vector_register(vrsInstr->V1Value(), v1);
+      SetVectorElement(v1, size, index, get_register(vrsInstr->R3Value()));
+      set_vector_register(vrsInstr->V1Value(), v1);
+      break;
+    }
+    case VGBM: {
+      // Each bit of I2, leftmost first, selects an all-ones or zero byte.
+      uint16_t mask = vriInstr->I2Value();
+      for (int i = 0; i < kVectorRegisterSize; i++) {
+        v1[i] = (mask & (0x8000 >> i)) ? 0xFF : 0;
+      }
+      set_vector_register(vriInstr->V1Value(), v1);
+      break;
+    }
+    case VREP: {
+      int size = vriInstr->M3Value();
+      int index = vriInstr->I2Value() & ((kVectorRegisterSize >> size) - 1);
+      get_vector_register(vriInstr->V3Value(), v3);
+      uint64_t element = GetVectorElement(v3, size, index);
+      for (int i = 0; i < (kVectorRegisterSize >> size); i++) {
+        SetVectorElement(v1, size, i, element);
+      }
+      set_vector_register(vriInstr->V1Value(), v1);
+      break;
+    }
+    case VN:
+    case VO:
+    case VX: {
+      get_vector_register(vrrInstr->V2Value(), v2);
+      get_vector_register(vrrInstr->V3Value(), v3);
+      for (int i = 0; i < kVectorRegisterSize; i++) {
+        if (op == VN) {
+          v1[i] = v2[i] & v3[i];
+        } else if (op == VO) {
+          v1[i] = v2[i] | v3[i];
+        } else {
+          v1[i] = v2[i] ^ v3[i];
+        }
+      }
+      set_vector_register(vrrInstr->V1Value(), v1);
+      break;
+    }
+    case VCEQ: {
+      int size = vrrInstr->M32Value();
+      int flags = vrrInstr->M24Value();
+      int count = kVectorRegisterSize >> size;
+      int equal = 0;
+      get_vector_register(vrrInstr->V2Value(), v2);
+      get_vector_register(vrrInstr->V3Value(), v3);
+      for (int i = 0; i < count; i++) {
+        bool match =
+            GetVectorElement(v2, size, i) == GetVectorElement(v3, size, i);
+        SetVectorElement(v1, size, i, match ? ~static_cast<uint64_t>(0) : 0);
+        if (match) equal++;
+      }
+      set_vector_register(vrrInstr->V1Value(), v1);
+      if (flags & kVectorSetCC) {
+        if (equal == count) {
+          condition_reg_ = CC_EQ;
+        } else if (equal > 0) {
+          condition_reg_ = 0x4;
+        } else {
+          condition_reg_ = 0x1;
+        }
+      }
+      break;
+    }
+    case VFEE:
+    case VFENE:
+    case VFAE: {
+      // String searches produce the byte index of the first element found
+      // (or 16) in byte 7 of V1, unless VFAE is asked for a result mask.
+      int size = vrrInstr->M32Value();
+      int flags = vrrInstr->M24Value();
+      int count = kVectorRegisterSize >> size;
+      get_vector_register(vrrInstr->V2Value(), v2);
+      get_vector_register(vrrInstr->V3Value(), v3);
+      int found = count;
+      int zero = count;
+      memset(v1, 0, kVectorRegisterSize);
+      for (int i = 0; i < count; i++) {
+        uint64_t element = GetVectorElement(v2, size, i);
+        if ((flags & kVectorZeroSearch) && zero == count && element == 0) {
+          zero = i;
+        }
+        bool match;
+        if (op == VFEE) {
+          match = element == GetVectorElement(v3, size, i);
+        } else if (op == VFENE) {
+          match = element != GetVectorElement(v3, size, i);
+        } else {
+          match = false;
+          for (int j = 0; j < count; j++) {
+            if (element == GetVectorElement(v3, size, j)) match = true;
+          }
+          if (flags & kVectorInvertResult) match = !match;
+          if (match && (flags & kVectorResultMask) && i < zero) {
+            SetVectorElement(v1, size, i, ~static_cast<uint64_t>(0));
+          }
+        }
+        if (match && found == count) found = i;
+      }
+      int first = (zero < found) ? zero : found;
+      if (op != VFAE || !(flags & kVectorResultMask)) {
+        v1[7] = static_cast<uint8_t>(first << size);
+      }
+      set_vector_register(vrrInstr->V1Value(), v1);
+      if (flags & kVectorSetCC) {
+        if (zero <= found && zero < count) {
+          condition_reg_ = CC_EQ;
+        } else if (found == count) {
+          condition_reg_ = 0x1;
+        } else if (op == VFENE && GetVectorElement(v2, size, found) >
+                                      GetVectorElement(v3, size, found)) {
+          condition_reg_ = 0x2;
+        } else {
+          condition_reg_ = 0x4;
+        }
+      }
+      break;
+    }
+    case VFA: {
+      // Only long BFP elements are supported; M5 bit 8 limits the
+      // operation to the leftmost element.
+      DCHECK_EQ(kVectorDoubleword, vrrInstr->M32Value());
+      bool single = (vrrInstr->M28Value() & 0x8) != 0;
+      get_vector_register(vrrInstr->V2Value(), v2);
+      get_vector_register(vrrInstr->V3Value(), v3);
+      memset(v1, 0, kVectorRegisterSize);
+      for (int i = 0; i < (single ? 1 : 2); i++) {
+        uint64_t lhs = GetVectorElement(v2, kVectorDoubleword, i);
+        uint64_t rhs = GetVectorElement(v3, kVectorDoubleword, i);
+        double sum = bit_cast<double>(lhs) + bit_cast<double>(rhs);
+        SetVectorElement(v1, kVectorDoubleword, i, bit_cast<uint64_t>(sum));
+      }
+      set_vector_register(vrrInstr->V1Value(), v1);
+      break;
+    }
+    default:
+      UNREACHABLE();
+      return false;
+  }
+  return true;
+}
+
 int16_t Simulator::ByteReverse(int16_t hword) {
   return (hword << 8) | ((hword >> 8) & 0x00ff);
 }
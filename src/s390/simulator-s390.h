@@ -194,6 +194,11 @@ class Simulator {
     return *bit_cast<float*>(&regval32);
   }
 
+  // Vector registers V0-V15 overlay the FP registers in their leftmost
+  // doubleword.  Bytes are numbered from the left, as in the architecture.
+  void get_vector_register(int vreg, uint8_t* bytes) const;
+  void set_vector_register(int vreg, const uint8_t* bytes);
+
   // Special case of set_register and get_register to access the raw PC value.
   void set_pc(intptr_t value);
   intptr_t get_pc() const;
@@ -315,6 +320,7 @@ class Simulator {
 
   bool DecodeSixByte(Instruction* instr);
   bool DecodeSixByteArithmetic(Instruction* instr);
+  bool DecodeSixByteVector(Instruction* instr);
   bool S390InstructionDecode(Instruction* instr);
 
   template <typename T>
@@ -387,6 +393,8 @@ class Simulator {
   // are 64-bit, even in 31-bit mode.
   uint64_t registers_[kNumGPRs];
   int64_t fp_registers_[kNumFPRs];
+  // Rightmost doubleword of the vector registers overlaying the FPRs.
+  int64_t vr_low_registers_[kNumFPRs];
 
   // Condition Code register. In S390, the last 4 bits are used.
   int32_t condition_reg_;
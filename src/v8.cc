@@ -21,6 +21,7 @@
 #include "src/snapshot/natives.h"
 #include "src/snapshot/serialize.h"
 #include "src/snapshot/snapshot.h"
+#include "src/zone.h"
 
 
 namespace v8 {
@@ -50,6 +51,7 @@ void V8::TearDown() {
   RegisteredExtension::UnregisterAll();
   Isolate::GlobalTearDown();
   Sampler::TearDown();
+  ZoneSegmentPool::Purge();
   FlagList::ResetAllFlags();  // Frees memory held by string arguments.
 }
 
@@ -68,6 +70,11 @@ void V8::InitializeOncePerProcessImpl() {
     FLAG_max_semi_space_size = 1;
   }
 
+#if !V8_TARGET_ARCH_X64
+  // Only the x64 write barrier orders the store before the color check.
+  FLAG_concurrent_marking = false;
+#endif
+
   if (FLAG_turbo && strcmp(FLAG_turbo_filter, "~~") == 0) {
     const char* filter_flag = "--turbo-filter=*";
     FlagList::SetFlagsFromString(filter_flag, StrLength(filter_flag));
@@ -978,6 +978,14 @@ void Assembler::cpuid() {
 }
 
 
+void Assembler::mfence() {
+  EnsureSpace ensure_space(this);
+  emit(0x0F);
+  emit(0xAE);
+  emit(0xF0);
+}
+
+
 void Assembler::cqo() {
   EnsureSpace ensure_space(this);
   emit_rex_64();
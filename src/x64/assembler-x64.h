@@ -864,6 +864,7 @@ class Assembler : public AssemblerBase {
   void cpuid();
   void hlt();
   void int3();
+  void mfence();
   void nop();
   void ret(int imm16);
   void ud2();
@@ -3580,6 +3580,12 @@ void RecordWriteStub::CheckNeedsToInformIncrementalMarker(
 
   // Let's look at the color of the object:  If it is not black we don't have
   // to inform the incremental marker.
+  if (concurrent_marking()) {
+    // The concurrent marker blackens an object before reading its fields.
+    // Order the store before the color check, so that either the marker sees
+    // the new value or the object is seen black here.
+    __ mfence();
+  }
   __ JumpIfBlack(regs_.object(),
                  regs_.scratch0(),
                  regs_.scratch1(),
@@ -122,7 +122,8 @@ class RecordWriteStub: public PlatformCodeStub {
                  ValueBits::encode(value.code()) |
                  AddressBits::encode(address.code()) |
                  RememberedSetActionBits::encode(remembered_set_action) |
-                 SaveFPRegsModeBits::encode(fp_mode);
+                 SaveFPRegsModeBits::encode(fp_mode) |
+                 ConcurrentMarkingBits::encode(FLAG_concurrent_marking);
   }
 
   RecordWriteStub(uint32_t key, Isolate* isolate)
@@ -349,11 +350,18 @@ class RecordWriteStub: public PlatformCodeStub {
     return SaveFPRegsModeBits::decode(minor_key_);
   }
 
+  // Stubs in the snapshot are generated without --concurrent_marking, so the
+  // flag is part of the key to get a stub with a fenced color check.
+  bool concurrent_marking() const {
+    return ConcurrentMarkingBits::decode(minor_key_);
+  }
+
   class ObjectBits: public BitField<int, 0, 4> {};
   class ValueBits: public BitField<int, 4, 4> {};
   class AddressBits: public BitField<int, 8, 4> {};
   class RememberedSetActionBits: public BitField<RememberedSetAction, 12, 1> {};
   class SaveFPRegsModeBits: public BitField<SaveFPRegsMode, 13, 1> {};
+  class ConcurrentMarkingBits: public BitField<bool, 14, 1> {};
 
   Label slow_;
   RegisterAllocation regs_;
@@ -1804,6 +1804,11 @@ int DisassemblerX64::TwoByteOpcodeInstruction(byte* data) {
     // CPUID
     AppendToBuffer("%s", mnemonic);
 
+  } else if (opcode == 0xAE && *current == 0xF0) {
+    // MFENCE
+    AppendToBuffer("mfence");
+    current++;
+
   } else if ((opcode & 0xF0) == 0x40) {
     // CMOVcc: conditional move.
     int condition = opcode & 0x0F;
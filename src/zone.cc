@@ -6,6 +6,7 @@
 
 #include <cstring>
 
+#include "src/flags.h"
 #include "src/v8.h"
 
 #ifdef V8_USE_ADDRESS_SANITIZER
@@ -46,7 +47,7 @@ const size_t kASanRedzoneBytes = 0;
 // (encoded in the this pointer) and a size in bytes. Segments are
 // chained together forming a LIFO structure with the newest segment
 // available as segment_head_. Segments are allocated using malloc()
-// and de-allocated using free().
+// and de-allocated using free(), unless the ZoneSegmentPool recycles them.
 
 class Segment {
  public:
@@ -73,6 +74,88 @@ class Segment {
 };
 
 
+base::LazyMutex ZoneSegmentPool::mutex_ = LAZY_MUTEX_INITIALIZER;
+Segment* ZoneSegmentPool::segments_[kNumberOfSizeClasses];
+size_t ZoneSegmentPool::retained_bytes_ = 0;
+size_t ZoneSegmentPool::requested_segments_ = 0;
+size_t ZoneSegmentPool::reused_segments_ = 0;
+
+
+Segment* ZoneSegmentPool::Get(size_t size) {
+  base::LockGuard<base::Mutex> guard(mutex_.Pointer());
+  requested_segments_++;
+  if (size > (static_cast<size_t>(1) << kMaximumSizeClassBits)) return nullptr;
+  int bits = kMinimumSizeClassBits;
+  while ((static_cast<size_t>(1) << bits) < size) bits++;
+  // Look one size class up as well, but not further, so that small zones do
+  // not use up the large segments.
+  int limit = Min(bits + 1, kMaximumSizeClassBits);
+  for (; bits <= limit; bits++) {
+    Segment** head = &segments_[bits - kMinimumSizeClassBits];
+    Segment* result = *head;
+    if (result == nullptr) continue;
+    *head = result->next();
+    retained_bytes_ -= result->size();
+    reused_segments_++;
+    ASAN_UNPOISON_MEMORY_REGION(result->start(), result->capacity());
+    return result;
+  }
+  return nullptr;
+}
+
+
+bool ZoneSegmentPool::Put(Segment* segment, size_t size) {
+  if (size < (static_cast<size_t>(1) << kMinimumSizeClassBits) ||
+      size > (static_cast<size_t>(1) << kMaximumSizeClassBits)) {
+    return false;
+  }
+  int bits = kMaximumSizeClassBits;
+  while ((static_cast<size_t>(1) << bits) > size) bits--;
+  size_t limit =
+      static_cast<size_t>(Max(0, FLAG_zone_segment_pool_size)) * MB;
+  base::LockGuard<base::Mutex> guard(mutex_.Pointer());
+  if (retained_bytes_ + size > limit) return false;
+  Segment** head = &segments_[bits - kMinimumSizeClassBits];
+  segment->Initialize(*head, size);
+  *head = segment;
+  retained_bytes_ += size;
+  ASAN_POISON_MEMORY_REGION(segment->start(), segment->capacity());
+  return true;
+}
+
+
+void ZoneSegmentPool::Purge() {
+  base::LockGuard<base::Mutex> guard(mutex_.Pointer());
+  for (int i = 0; i < kNumberOfSizeClasses; i++) {
+    for (Segment* current = segments_[i]; current != nullptr;) {
+      Segment* next = current->next();
+      Malloced::Delete(current);
+      current = next;
+    }
+    segments_[i] = nullptr;
+  }
+  retained_bytes_ = 0;
+}
+
+
+size_t ZoneSegmentPool::retained_bytes() {
+  base::LockGuard<base::Mutex> guard(mutex_.Pointer());
+  return retained_bytes_;
+}
+
+
+size_t ZoneSegmentPool::requested_segments() {
+  base::LockGuard<base::Mutex> guard(mutex_.Pointer());
+  return requested_segments_;
+}
+
+
+size_t ZoneSegmentPool::reused_segments() {
+  base::LockGuard<base::Mutex> guard(mutex_.Pointer());
+  return reused_segments_;
+}
+
+
 Zone::Zone()
     : allocation_size_(0),
       segment_bytes_allocated_(0),
@@ -201,7 +284,12 @@ void Zone::DeleteKeptSegment() {
 // Creates a new segment, sets it size, and pushes it to the front
 // of the segment chain. Returns the new segment.
 Segment* Zone::NewSegment(size_t size) {
-  Segment* result = reinterpret_cast<Segment*>(Malloced::New(size));
+  Segment* result = ZoneSegmentPool::Get(size);
+  if (result != nullptr) {
+    size = result->size();
+  } else {
+    result = reinterpret_cast<Segment*>(Malloced::New(size));
+  }
   segment_bytes_allocated_ += size;
   if (result != nullptr) {
     result->Initialize(segment_head_, size);
@@ -211,10 +299,12 @@ Segment* Zone::NewSegment(size_t size) {
 }
 
 
-// Deletes the given segment. Does not touch the segment chain.
+// Deletes the given segment, or hands it to the segment pool for reuse.
+// Does not touch the segment chain.
 void Zone::DeleteSegment(Segment* segment, size_t size) {
   segment_bytes_allocated_ -= size;
-  Malloced::Delete(segment);
+  // The header may have been zapped already, so pass the size explicitly.
+  if (!ZoneSegmentPool::Put(segment, size)) Malloced::Delete(segment);
 }
 
 
@@ -9,6 +9,7 @@
 
 #include "src/allocation.h"
 #include "src/base/logging.h"
+#include "src/base/platform/mutex.h"
 #include "src/globals.h"
 #include "src/hashmap.h"
 #include "src/list.h"
@@ -118,6 +119,46 @@ class Zone final {
 };
 
 
+// The ZoneSegmentPool caches segments released by zones so that later zones,
+// on any thread, can reuse them instead of going back to malloc(). Segments
+// are kept in power-of-two size classes between the minimum and maximum
+// segment size, and the total number of bytes retained is capped by
+// --zone-segment-pool-size.
+class ZoneSegmentPool final : public AllStatic {
+ public:
+  // Returns a pooled segment of at least 'size' bytes, or nullptr if there
+  // is none.
+  static Segment* Get(size_t size);
+
+  // Takes ownership of 'segment', which is 'size' bytes large, if it fits
+  // into the pool. The segment header is not read, as it may have been
+  // zapped. Returns false if the caller still has to free the segment.
+  static bool Put(Segment* segment, size_t size);
+
+  // Frees all pooled segments.
+  static void Purge();
+
+  // Statistics.
+  static size_t retained_bytes();
+  static size_t requested_segments();
+  static size_t reused_segments();
+
+ private:
+  // Segments between 8 KB and 1 MB, the minimum and maximum size of segments
+  // allocated by zones, are pooled.
+  static const int kMinimumSizeClassBits = 13;
+  static const int kMaximumSizeClassBits = 20;
+  static const int kNumberOfSizeClasses =
+      kMaximumSizeClassBits - kMinimumSizeClassBits + 1;
+
+  static base::LazyMutex mutex_;
+  static Segment* segments_[kNumberOfSizeClasses];
+  static size_t retained_bytes_;
+  static size_t requested_segments_;
+  static size_t reused_segments_;
+};
+
+
 // ZoneObject is an abstraction that helps define classes of objects
 // allocated in the Zone. Use it as a base class; see ast.h.
 class ZoneObject {
@@ -91,6 +91,22 @@ TEST(RunWord32Ctz) {
   CHECK_EQ(0, m.Call(uint32_t(0x9afdbc81)));
 }
 
+
+TEST(RunWord32CtzOfReverseBits) {
+  BufferedRawMachineAssemblerTester<int32_t> m(MachineType::Uint32());
+  if (!m.machine()->Word32Ctz().IsSupported() ||
+      !m.machine()->Word32ReverseBits().IsSupported()) {
+    return;
+  }
+  Node* reversed =
+      m.AddNode(m.machine()->Word32ReverseBits().op(), m.Parameter(0));
+  m.Return(m.Int32Sub(m.AddNode(m.machine()->Word32Ctz().op(), reversed),
+                      m.Word32Clz(m.Parameter(0))));
+
+  // Trailing zeros of the reversed value are the original's leading zeros.
+  FOR_UINT32_INPUTS(i) { CHECK_EQ(0, m.Call(*i)); }
+}
+
 TEST(RunWord32Clz) {
   BufferedRawMachineAssemblerTester<int32_t> m(MachineType::Uint32());
   m.Return(m.Word32Clz(m.Parameter(0)));
@@ -318,6 +334,22 @@ TEST(RunWord64Ctz) {
 }
 
 
+TEST(RunWord64CtzOfReverseBits) {
+  RawMachineAssemblerTester<int32_t> m(MachineType::Uint64());
+  if (!m.machine()->Word64Ctz().IsSupported() ||
+      !m.machine()->Word64ReverseBits().IsSupported()) {
+    return;
+  }
+  Node* reversed =
+      m.AddNode(m.machine()->Word64ReverseBits().op(), m.Parameter(0));
+  m.Return(m.Int32Sub(m.AddNode(m.machine()->Word64Ctz().op(), reversed),
+                      m.Word64Clz(m.Parameter(0))));
+
+  // Trailing zeros of the reversed value are the original's leading zeros.
+  FOR_UINT64_INPUTS(i) { CHECK_EQ(0, m.Call(*i)); }
+}
+
+
 TEST(RunWord64Popcnt) {
   BufferedRawMachineAssemblerTester<int32_t> m(MachineType::Uint64());
   if (!m.machine()->Word64Popcnt().IsSupported()) {
@@ -1230,6 +1262,47 @@ TEST(RunLoadStoreFloat64Offset) {
 }
 
 
+TEST(RunLoadStoreWithLongDisplacement) {
+  // Displacements beyond 16 bits, with the load folded into an ALU operation
+  // where the target supports memory operands, e.g. s390 RXY instructions.
+  const int32_t kDisplacements[] = {-0x12344, -0x8004, 0x8000, 0x12344,
+                                    0x7fff0};
+  int32_t buffer[3];
+  for (size_t k = 0; k < arraysize(kDisplacements); k++) {
+    int32_t displacement = kDisplacements[k];
+    byte* base = reinterpret_cast<byte*>(buffer) - displacement;
+    RawMachineAssemblerTester<int32_t> m(MachineType::Int32());
+    // generate load [#base + #displacement]
+    Node* load0 = m.Load(MachineType::Int32(), m.PointerConstant(base),
+                         m.IntPtrConstant(displacement));
+    // generate load [#base + (#4 + #displacement)]
+    Node* load1 = m.Load(
+        MachineType::Int32(), m.PointerConstant(base),
+        m.IntPtrAdd(m.IntPtrConstant(sizeof(int32_t)),
+                    m.IntPtrConstant(displacement)));
+    Node* result = m.Int32Add(m.Int32Sub(m.Parameter(0), load0), load1);
+    // generate store [#base + #8 + #displacement]
+    m.Store(MachineRepresentation::kWord32, m.PointerConstant(base),
+            m.IntPtrConstant(2 * sizeof(int32_t) + displacement), result,
+            kNoWriteBarrier);
+    m.Return(result);
+
+    FOR_INT32_INPUTS(i) {
+      buffer[0] = *i;
+      buffer[1] = *i ^ 0x5a5a5a5a;
+      FOR_INT32_INPUTS(j) {
+        int32_t expected = bit_cast<int32_t>(
+            static_cast<uint32_t>(*j) - static_cast<uint32_t>(buffer[0]) +
+            static_cast<uint32_t>(buffer[1]));
+        buffer[2] = 0;
+        CHECK_EQ(expected, m.Call(*j));
+        CHECK_EQ(expected, buffer[2]);
+      }
+    }
+  }
+}
+
+
 TEST(RunInt32AddP) {
   RawMachineAssemblerTester<int32_t> m;
   Int32BinopTester bt(&m);
@@ -5542,6 +5615,20 @@ TEST(RunFloat64RoundTiesEven) {
 }
 
 
+TEST(RunFloat64RoundTiesEvenHalfway) {
+  BufferedRawMachineAssemblerTester<double> m(MachineType::Float64());
+  if (!m.machine()->Float64RoundTiesEven().IsSupported()) return;
+  m.Return(m.Float64RoundTiesEven(m.Parameter(0)));
+
+  CheckDoubleEq(0.0, m.Call(0.5));
+  CheckDoubleEq(2.0, m.Call(1.5));
+  CheckDoubleEq(2.0, m.Call(2.5));
+  CheckDoubleEq(-0.0, m.Call(-0.5));
+  CheckDoubleEq(-2.0, m.Call(-2.5));
+  CheckDoubleEq(4503599627370496.0, m.Call(4503599627370496.0));
+}
+
+
 TEST(RunFloat32RoundTruncate) {
   BufferedRawMachineAssemblerTester<float> m(MachineType::Float32());
   if (!m.machine()->Float32RoundTruncate().IsSupported()) return;
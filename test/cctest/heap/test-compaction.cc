@@ -336,5 +336,67 @@ HEAP_TEST(CompactionPartiallyAbortedPageWithStoreBufferEntries) {
   }
 }
 
+TEST(CompactionHotCodeLayout) {
+  // Test that hot code on evacuated code pages is moved to pages that only
+  // contain hot code.
+  FLAG_hot_code_layout = true;
+  FLAG_always_compact = true;
+  FLAG_concurrent_sweeping = false;
+  FLAG_opt = false;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  const int kFunctions = 64;
+  {
+    HandleScope scope(isolate);
+    // Code allocated during bootstrapping lives on pages that are never
+    // evacuated, so make sure that the functions get code pages of their own.
+    SimulateFullSpace(heap->code_space());
+    CompileRun(
+        "var functions = [];"
+        "for (var i = 0; i < 64; i++) {"
+        "  functions.push(new Function('return ' + i + ';'));"
+        "  functions[i]();"
+        "}");
+    List<Handle<JSFunction> > functions;
+    List<Address> addresses;
+    for (int i = 0; i < kFunctions; i++) {
+      EmbeddedVector<char, 32> source;
+      SNPrintF(source, "functions[%d]", i);
+      Handle<JSFunction> function = Handle<JSFunction>::cast(
+          v8::Utils::OpenHandle(*v8::Local<v8::Function>::Cast(
+              CompileRun(source.start()))));
+      CHECK_EQ(Code::FUNCTION, function->code()->kind());
+      CHECK(!Page::FromAddress(function->code()->address())->NeverEvacuate());
+      // A third of the code is hot, so that the pages qualify for evacuation.
+      function->code()->set_profiler_ticks(i % 3 == 0 ? 1 : 0);
+      functions.Add(function);
+      addresses.Add(function->code()->address());
+    }
+
+    heap->CollectAllGarbage();
+    if (heap->mark_compact_collector()->sweeping_in_progress()) {
+      heap->mark_compact_collector()->EnsureSweepingCompleted();
+    }
+
+    int evacuated_hot_code = 0;
+    for (int i = 0; i < kFunctions; i += 3) {
+      Code* code = functions[i]->code();
+      CHECK(MarkCompactCollector::IsHotCode(code));
+      if (code->address() == addresses[i]) continue;
+      evacuated_hot_code++;
+      Page* page = Page::FromAddress(code->address());
+      HeapObjectIterator it(page);
+      for (HeapObject* object = it.Next(); object != nullptr;
+           object = it.Next()) {
+        if (object->IsCode() && Code::cast(object)->kind() == Code::FUNCTION) {
+          CHECK(MarkCompactCollector::IsHotCode(Code::cast(object)));
+        }
+      }
+    }
+    CHECK_GT(evacuated_hot_code, 0);
+  }
+}
+
 }  // namespace internal
 }  // namespace v8
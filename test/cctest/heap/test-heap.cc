@@ -4665,6 +4665,51 @@ TEST(LargeObjectSlotRecording) {
 }
 
 
+TEST(YoungLargeObjects) {
+  FLAG_young_large_objects = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  Factory* factory = isolate->factory();
+  HandleScope scope(isolate);
+
+  int length = Page::kMaxRegularHeapObjectSize / kPointerSize + KB;
+  int old_pages = heap->lo_space()->PageCount();
+  {
+    HandleScope temporary_scope(isolate);
+    Handle<FixedArray> temporary = factory->NewFixedArray(length, NOT_TENURED);
+    CHECK(heap->new_lo_space()->Contains(*temporary));
+  }
+  Handle<FixedArray> array = factory->NewFixedArray(length, NOT_TENURED);
+  CHECK(heap->new_lo_space()->Contains(*array));
+  CHECK(heap->InNewSpace(*array));
+  Handle<HeapNumber> number = factory->NewHeapNumber(1.5);
+  CHECK(heap->InNewSpace(*number));
+  array->set(length - 1, *number);
+
+  // A scavenge promotes the reachable large object without moving it and
+  // frees the unreachable one.
+  FixedArray* old_location = *array;
+  heap->CollectGarbage(NEW_SPACE);
+  CHECK(heap->new_lo_space()->IsEmpty());
+  CHECK(heap->lo_space()->Contains(*array));
+  CHECK(!heap->InNewSpace(*array));
+  CHECK_EQ(old_location, *array);
+  CHECK_EQ(old_pages + 1, heap->lo_space()->PageCount());
+
+  // Its pointers into new space have been recorded.
+  heap->CollectGarbage(NEW_SPACE);
+  heap->CollectGarbage(NEW_SPACE);
+  CHECK_EQ(*number, array->get(length - 1));
+
+  // A full GC promotes young large objects up front.
+  Handle<FixedArray> young = factory->NewFixedArray(length, NOT_TENURED);
+  CHECK(heap->new_lo_space()->Contains(*young));
+  heap->CollectAllGarbage();
+  CHECK(heap->new_lo_space()->IsEmpty());
+  CHECK(heap->lo_space()->Contains(*young));
+}
+
 class DummyVisitor : public ObjectVisitor {
  public:
   void VisitPointers(Object** start, Object** end) override {}
@@ -5572,6 +5617,110 @@ UNINITIALIZED_TEST(Regress538257) {
 }
 
 
+UNINITIALIZED_TEST(MemoryBudget) {
+  const int kMemoryBudget = 64;
+  v8::Isolate::CreateParams create_params;
+  create_params.constraints.set_memory_budget(kMemoryBudget);
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  isolate->Enter();
+  {
+    i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+    Heap* heap = i_isolate->heap();
+    intptr_t heap_budget =
+        kMemoryBudget * MB / 100 * Heap::kMemoryBudgetHeapPercent;
+    CHECK_EQ(static_cast<intptr_t>(kMemoryBudget * MB), heap->memory_budget());
+    CHECK_LE(2 * heap->MaxSemiSpaceSize(),
+             Max(heap_budget / 8, static_cast<intptr_t>(Page::kPageSize)));
+    CHECK_LE(heap->MaxOldGenerationSize(), heap_budget);
+
+    HandleScope handle_scope(i_isolate);
+    Handle<FixedArray> array =
+        i_isolate->factory()->NewFixedArray(100 * KB, TENURED);
+    heap->CollectAllGarbage();
+    CHECK(heap->old_space()->Contains(*array) ||
+          heap->lo_space()->Contains(*array));
+    CHECK_LE(heap->old_generation_allocation_limit(), heap_budget);
+  }
+  isolate->Exit();
+  isolate->Dispose();
+}
+
+
+TEST(ArrayBufferTrackedPerPage) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  Factory* factory = isolate->factory();
+  const int64_t external_memory = heap->amount_of_external_allocated_memory();
+
+  {
+    HandleScope scope(isolate);
+    Handle<JSArrayBuffer> buffer = factory->NewJSArrayBuffer();
+    CHECK(JSArrayBuffer::SetupAllocatingData(buffer, isolate, 100));
+    CHECK(heap->InNewSpace(*buffer));
+    CHECK_NOT_NULL(Page::FromAddress(buffer->address())->local_tracker());
+    CHECK_EQ(external_memory + 100,
+             heap->amount_of_external_allocated_memory());
+
+    // The backing store moves along when the buffer is copied and promoted.
+    heap->CollectGarbage(NEW_SPACE);  // in survivor space now
+    heap->CollectGarbage(NEW_SPACE);  // in old gen now
+    CHECK(!heap->InNewSpace(*buffer));
+    CHECK_NOT_NULL(Page::FromAddress(buffer->address())->local_tracker());
+    CHECK_EQ(external_memory + 100,
+             heap->amount_of_external_allocated_memory());
+
+    // Dead buffers in new space are found by the scavenger.
+    {
+      HandleScope inner_scope(isolate);
+      Handle<JSArrayBuffer> dead = factory->NewJSArrayBuffer();
+      CHECK(JSArrayBuffer::SetupAllocatingData(dead, isolate, 200));
+      CHECK_EQ(external_memory + 300,
+               heap->amount_of_external_allocated_memory());
+    }
+    heap->CollectGarbage(NEW_SPACE);
+    CHECK_EQ(external_memory + 100,
+             heap->amount_of_external_allocated_memory());
+  }
+
+  // Dead buffers in old space are found by mark-compact.
+  heap->CollectAllGarbage();
+  CHECK_EQ(external_memory, heap->amount_of_external_allocated_memory());
+}
+
+
+TEST(HeapObjectStatisticsSnapshot) {
+  i::FLAG_gc_object_stats_sampling_rate = 1;
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  Heap* heap = CcTest::heap();
+  v8::HandleScope scope(isolate);
+  CompileRun("var a = []; for (var i = 0; i < 100; i++) a.push({x: i});");
+
+  v8::HeapObjectStatisticsSnapshot snapshot;
+  heap->CollectAllGarbage();
+  CHECK(isolate->GetHeapObjectStatisticsSnapshot(&snapshot));
+  CHECK_EQ(heap->ms_count(), snapshot.gc_count());
+  CHECK_EQ(1, snapshot.sampling_rate());
+  size_t js_objects = 0;
+  bool found_code_kind = false;
+  for (size_t i = 0; i < snapshot.length(); i++) {
+    v8::HeapObjectStatistics* statistics = snapshot.Get(i);
+    CHECK_GT(statistics->object_count(), 0u);
+    CHECK_GT(statistics->object_size(), 0u);
+    if (strcmp(statistics->object_type(), "JS_OBJECT_TYPE") == 0) {
+      js_objects = statistics->object_count();
+    }
+    if (strcmp(statistics->object_type(), "CODE_TYPE") == 0) {
+      found_code_kind = true;
+    }
+  }
+  CHECK_GE(js_objects, 100u);
+  CHECK(found_code_kind);
+}
+
+
 TEST(Regress357137) {
   CcTest::InitializeVM();
   v8::Isolate* isolate = CcTest::isolate();
@@ -6531,5 +6680,72 @@ HEAP_TEST(Regress587004) {
   heap->CollectGarbage(NEW_SPACE);
 }
 
+
+TEST(ParallelScavenge) {
+  FLAG_parallel_scavenge = true;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  Heap* heap = CcTest::heap();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+
+  // Young objects are reachable from the roots, from an old-space array and
+  // from each other, so that all tasks find work and shared objects are
+  // reached through several paths.
+  const int N = 1024;
+  Handle<FixedArray> old_array = factory->NewFixedArray(N, TENURED);
+  Handle<FixedArray> young_array = factory->NewFixedArray(N);
+  CHECK(heap->old_space()->Contains(*old_array));
+  CHECK(heap->InNewSpace(*young_array));
+  for (int i = 0; i < N; i++) {
+    Handle<FixedArray> young = factory->NewFixedArray(2);
+    young->set(0, Smi::FromInt(i));
+    young->set(1, *young_array);
+    old_array->set(i, *young);
+    young_array->set(i, *young);
+  }
+
+  heap->CollectGarbage(NEW_SPACE);
+  heap->CollectGarbage(NEW_SPACE);
+
+  CHECK(!heap->InNewSpace(*young_array));
+  for (int i = 0; i < N; i++) {
+    FixedArray* young = FixedArray::cast(old_array->get(i));
+    CHECK_EQ(young, young_array->get(i));
+    CHECK_EQ(Smi::FromInt(i), young->get(0));
+    CHECK_EQ(*young_array, young->get(1));
+  }
+}
+
+
+TEST(PretenuringLab) {
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  Heap* heap = CcTest::heap();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  if (heap->inline_allocation_disabled()) return;
+
+  // Make the linear allocation area of old space empty.
+  heap->old_space()->EmptyAllocationInfo();
+  heap->RefillPretenuringLab();
+  Address top = heap->old_space()->top();
+  CHECK_EQ(static_cast<intptr_t>(Heap::kPretenuringLabSize),
+           heap->old_space()->limit() - top);
+
+  // Tenured allocations bump through the buffer and do not refill it again.
+  Handle<FixedArray> first = factory->NewFixedArray(16, TENURED);
+  CHECK_EQ(top, first->address());
+  heap->RefillPretenuringLab();
+  Handle<FixedArray> second = factory->NewFixedArray(16, TENURED);
+  CHECK_EQ(top + first->Size(), second->address());
+
+  // The heap stays iterable and verifiable across a full GC.
+  heap->CollectAllGarbage();
+  CHECK(heap->old_space()->Contains(*first));
+  CHECK(heap->old_space()->Contains(*second));
+}
+
+
 }  // namespace internal
 }  // namespace v8
@@ -18,6 +18,7 @@
 
 #include "src/full-codegen/full-codegen.h"
 #include "src/global-handles.h"
+#include "src/heap/concurrent-marking.h"
 #include "test/cctest/cctest.h"
 #include "test/cctest/heap/utils-inl.h"
 
@@ -194,5 +195,66 @@ TEST(IncrementalMarkingUsingDelayedTasks) {
   i::V8::SetPlatformForTesting(old_platform);
 }
 
+
+TEST(ConcurrentMarking) {
+  if (!i::FLAG_incremental_marking) return;
+  i::FLAG_concurrent_marking = true;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  Heap* heap = CcTest::heap();
+  Factory* factory = CcTest::i_isolate()->factory();
+  heap->CollectAllGarbage();
+
+  // Build a graph of old-space arrays, plain objects and heap numbers that is
+  // only reachable from a single handle, so that most of it is marked by the
+  // background task.
+  const int kLength = 1024;
+  Handle<FixedArray> root = factory->NewFixedArray(kLength, TENURED);
+  for (int i = 0; i < kLength; i++) {
+    Handle<FixedArray> inner = factory->NewFixedArray(2, TENURED);
+    Handle<JSObject> object =
+        factory->NewJSObject(CcTest::i_isolate()->object_function(), TENURED);
+    inner->set(0, *object);
+    inner->set(1, *factory->NewHeapNumber(i, IMMUTABLE, TENURED));
+    root->set(i, *inner);
+  }
+
+  SimulateIncrementalMarking(heap);
+  heap->CollectAllGarbage();
+
+  for (int i = 0; i < kLength; i++) {
+    FixedArray* inner = FixedArray::cast(root->get(i));
+    CHECK(inner->get(0)->IsJSObject());
+    CHECK_EQ(static_cast<double>(i),
+             HeapNumber::cast(inner->get(1))->value());
+  }
+  CHECK(heap->concurrent_marking()->IsIdle());
+}
+
+
+TEST(ConcurrentMarkingDisablesLeftTrimming) {
+  if (!i::FLAG_incremental_marking || !i::FLAG_move_object_start) return;
+  i::FLAG_concurrent_marking = true;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  Heap* heap = CcTest::heap();
+  heap->CollectAllGarbage();
+
+  Handle<FixedArray> array = CcTest::i_isolate()->factory()->NewFixedArray(16);
+  CHECK(heap->CanMoveObjectStart(*array));
+
+  // The background task may visit the array and update its mark bits at any
+  // time, so the start of the array must not move.
+  SimulateIncrementalMarking(heap, false);
+  CHECK(!heap->CanMoveObjectStart(*array));
+
+  heap->CollectAllGarbage();
+  MarkCompactCollector* collector = heap->mark_compact_collector();
+  if (collector->sweeping_in_progress()) {
+    collector->EnsureSweepingCompleted();
+  }
+  CHECK(heap->CanMoveObjectStart(*array));
+}
+
 }  // namespace internal
 }  // namespace v8
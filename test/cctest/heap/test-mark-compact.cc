@@ -80,7 +80,7 @@ TEST(MarkingDeque) {
 HEAP_TEST(Promotion) {
   CcTest::InitializeVM();
   Heap* heap = CcTest::heap();
-  heap->ConfigureHeap(1, 1, 1, 0);
+  heap->ConfigureHeap(1, 1, 1, 0, 0);
 
   v8::HandleScope sc(CcTest::isolate());
 
@@ -106,7 +106,7 @@ HEAP_TEST(Promotion) {
 HEAP_TEST(NoPromotion) {
   CcTest::InitializeVM();
   Heap* heap = CcTest::heap();
-  heap->ConfigureHeap(1, 1, 1, 0);
+  heap->ConfigureHeap(1, 1, 1, 0, 0);
 
   v8::HandleScope sc(CcTest::isolate());
 
@@ -391,6 +391,88 @@ TEST(EmptyObjectGroups) {
 }
 
 
+TEST(ParallelMarking) {
+  FLAG_parallel_marking = true;
+  FLAG_stress_compaction = true;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  Heap* heap = CcTest::heap();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+
+  // Objects that are visited in parallel (arrays, plain objects, strings and
+  // heap numbers) are mixed with maps, which are handed back to the main
+  // thread. Compaction makes sure that slots recorded by the marking tasks
+  // are updated.
+  const int N = 1024;
+  Handle<FixedArray> root = factory->NewFixedArray(N, TENURED);
+  Handle<JSFunction> function = factory->NewFunction(factory->empty_string());
+  Handle<String> name = factory->InternalizeUtf8String("x");
+  for (int i = 0; i < N; i++) {
+    Handle<JSObject> object = factory->NewJSObject(function, TENURED);
+    JSObject::AddProperty(object, name, factory->NewHeapNumber(i), NONE);
+    Handle<FixedArray> inner = factory->NewFixedArray(2, TENURED);
+    inner->set(0, *object);
+    inner->set(1, *factory->NewStringFromAsciiChecked("parallel", TENURED));
+    root->set(i, *inner);
+  }
+
+  heap->CollectAllGarbage();
+  heap->CollectAllGarbage();
+
+  for (int i = 0; i < N; i++) {
+    FixedArray* inner = FixedArray::cast(root->get(i));
+    Handle<JSObject> object(JSObject::cast(inner->get(0)), isolate);
+    Handle<Object> value =
+        JSReceiver::GetProperty(object, name).ToHandleChecked();
+    CHECK_EQ(i, static_cast<int>(value->Number()));
+    CHECK(String::cast(inner->get(1))->IsUtf8EqualTo(CStrVector("parallel")));
+  }
+}
+
+
+TEST(ParallelPointerUpdate) {
+  FLAG_parallel_pointer_update = true;
+  FLAG_stress_compaction = true;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  Heap* heap = CcTest::heap();
+  Factory* factory = CcTest::i_isolate()->factory();
+
+  // Old-space arrays point to each other and to young arrays, so that slots
+  // recorded in slots buffers, old-to-new slots and to-space objects all need
+  // to be updated after compaction.
+  const int N = 256;
+  Handle<FixedArray> old_arrays = factory->NewFixedArray(N, TENURED);
+  Handle<FixedArray> young_arrays = factory->NewFixedArray(N);
+  for (int i = 0; i < N; i++) {
+    Handle<FixedArray> old_array = factory->NewFixedArray(3, TENURED);
+    Handle<FixedArray> young_array = factory->NewFixedArray(2);
+    old_array->set(0, Smi::FromInt(i));
+    old_array->set(1, *young_array);
+    young_array->set(0, Smi::FromInt(i));
+    young_array->set(1, *old_array);
+    old_arrays->set(i, *old_array);
+    young_arrays->set(i, *young_array);
+  }
+  for (int i = 0; i < N; i++) {
+    FixedArray::cast(old_arrays->get(i))->set(2, old_arrays->get(N - 1 - i));
+  }
+
+  heap->CollectAllGarbage();
+
+  for (int i = 0; i < N; i++) {
+    FixedArray* old_array = FixedArray::cast(old_arrays->get(i));
+    FixedArray* young_array = FixedArray::cast(young_arrays->get(i));
+    CHECK_EQ(Smi::FromInt(i), old_array->get(0));
+    CHECK_EQ(young_array, old_array->get(1));
+    CHECK_EQ(old_arrays->get(N - 1 - i), old_array->get(2));
+    CHECK_EQ(Smi::FromInt(i), young_array->get(0));
+    CHECK_EQ(old_array, young_array->get(1));
+  }
+}
+
+
 #if defined(__has_feature)
 #if __has_feature(address_sanitizer)
 #define V8_WITH_ASAN 1
@@ -352,6 +352,86 @@ TEST(MemoryAllocator) {
 }
 
 
+TEST(MemoryAllocatorPool) {
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+
+  MemoryAllocator* memory_allocator = new MemoryAllocator(isolate);
+  CHECK(memory_allocator->SetUp(heap->MaxReserved(),
+                                heap->MaxExecutableSize()));
+  TestMemoryAllocatorScope test_scope(isolate, memory_allocator);
+
+  {
+    OldSpace faked_space(heap, OLD_SPACE, NOT_EXECUTABLE);
+    Page* page = memory_allocator->AllocatePage(faked_space.AreaSize(),
+                                                &faked_space, NOT_EXECUTABLE);
+    Address address = page->address();
+    intptr_t size = memory_allocator->Size();
+
+    // A freed regular page stays mapped and is reused by the next allocation.
+    memory_allocator->PreFreeMemory(page);
+    memory_allocator->PerformFreeMemoryOrPool(page);
+    CHECK_EQ(1, memory_allocator->NumberOfPooledChunks());
+    CHECK_EQ(size - Page::kPageSize, memory_allocator->Size());
+
+    page = memory_allocator->AllocatePage(faked_space.AreaSize(), &faked_space,
+                                          NOT_EXECUTABLE);
+    CHECK_EQ(address, page->address());
+    CHECK_EQ(0, memory_allocator->NumberOfPooledChunks());
+    CHECK_EQ(size, memory_allocator->Size());
+    CHECK(page->owner() == &faked_space);
+    CHECK_EQ(0, page->LiveBytes());
+
+    // Pooled pages are unmapped when the pool is released.
+    memory_allocator->PreFreeMemory(page);
+    memory_allocator->PerformFreeMemoryOrPool(page);
+    CHECK_EQ(1, memory_allocator->NumberOfPooledChunks());
+    memory_allocator->ReleasePooledChunks();
+    CHECK_EQ(0, memory_allocator->NumberOfPooledChunks());
+  }
+  memory_allocator->TearDown();
+  delete memory_allocator;
+}
+
+
+TEST(MemoryAllocatorHugePages) {
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  FLAG_huge_pages = true;
+
+  MemoryAllocator* memory_allocator = new MemoryAllocator(isolate);
+  CHECK(memory_allocator->SetUp(heap->MaxReserved(),
+                                heap->MaxExecutableSize()));
+  TestMemoryAllocatorScope test_scope(isolate, memory_allocator);
+
+  {
+    OldSpace faked_space(heap, OLD_SPACE, NOT_EXECUTABLE);
+    Page* first = memory_allocator->AllocatePage(faked_space.AreaSize(),
+                                                 &faked_space, NOT_EXECUTABLE);
+    Page* second = memory_allocator->AllocatePage(faked_space.AreaSize(),
+                                                  &faked_space, NOT_EXECUTABLE);
+    Address address = second->address();
+
+    // Pages are placed next to each other in a huge page aligned region.
+    CHECK(IsAddressAligned(first->address(), MemoryAllocator::kHugePageSize));
+    CHECK_EQ(first->address() + Page::kPageSize, address);
+
+    // A freed page goes back to its region instead of the page pool.
+    memory_allocator->PreFreeMemory(second);
+    memory_allocator->PerformFreeMemoryOrPool(second);
+    CHECK_EQ(0, memory_allocator->NumberOfPooledChunks());
+    second = memory_allocator->AllocatePage(faked_space.AreaSize(),
+                                            &faked_space, NOT_EXECUTABLE);
+    CHECK_EQ(address, second->address());
+
+    memory_allocator->Free(first);
+    memory_allocator->Free(second);
+  }
+  memory_allocator->TearDown();
+  delete memory_allocator;
+  FLAG_huge_pages = false;
+}
+
 TEST(NewSpace) {
   Isolate* isolate = CcTest::i_isolate();
   Heap* heap = isolate->heap();
@@ -448,6 +528,72 @@ TEST(CompactionSpace) {
 }
 
 
+TEST(FreeListSizeClasses) {
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  MemoryAllocator* memory_allocator = new MemoryAllocator(isolate);
+  CHECK(memory_allocator != nullptr);
+  CHECK(
+      memory_allocator->SetUp(heap->MaxReserved(), heap->MaxExecutableSize()));
+  TestMemoryAllocatorScope test_scope(isolate, memory_allocator);
+
+  CompactionSpace* compaction_space =
+      new CompactionSpace(heap, OLD_SPACE, NOT_EXECUTABLE);
+  CHECK(compaction_space->SetUp());
+
+  // Carve free blocks of 40, 100 and 300 words, i.e., from the first three
+  // size classes, out of a single object.
+  const int kSize = Page::kMaxRegularHeapObjectSize;
+  Address start = HeapObject::cast(compaction_space->AllocateRawUnaligned(kSize)
+                                       .ToObjectChecked())
+                      ->address();
+  heap->CreateFillerObjectAt(start, kSize);
+  Address small_block = start;
+  Address medium_block = start + 64 * kPointerSize;
+  Address large_block = start + 256 * kPointerSize;
+
+  FreeList free_list(compaction_space);
+  CHECK(free_list.IsEmpty());
+  CHECK_EQ(0, free_list.Free(small_block, 40 * kPointerSize));
+  CHECK_EQ(0, free_list.Free(medium_block, 100 * kPointerSize));
+  CHECK_EQ(0, free_list.Free(large_block, 300 * kPointerSize));
+  CHECK(!free_list.IsEmpty());
+  CHECK_EQ(static_cast<intptr_t>(440 * kPointerSize), free_list.Available());
+  CHECK_EQ(300 * kPointerSize, free_list.LargestBlockSize());
+
+  // All blocks of the third size class fit 100 words.
+  FreeSpace* node = free_list.TryRemoveMemory(100 * kPointerSize);
+  CHECK_EQ(large_block, node->address());
+  CHECK_EQ(100 * kPointerSize, node->size());
+  CHECK_EQ(200 * kPointerSize, free_list.LargestBlockSize());
+
+  // Blocks smaller than the first size class are not added.
+  CHECK_EQ(24 * kPointerSize,
+           free_list.Free(small_block + 40 * kPointerSize, 24 * kPointerSize));
+
+  // Without a block of the third size class, the size class of the requested
+  // size is searched.
+  free_list.Reset();
+  CHECK(free_list.IsEmpty());
+  CHECK_EQ(0, free_list.Free(small_block, 40 * kPointerSize));
+  CHECK_EQ(0, free_list.Free(medium_block, 100 * kPointerSize));
+  node = free_list.TryRemoveMemory(90 * kPointerSize);
+  CHECK_EQ(medium_block, node->address());
+  CHECK_EQ(100 * kPointerSize, node->size());
+
+  // Without a block that fits, the largest block is returned.
+  node = free_list.TryRemoveMemory(50 * kPointerSize);
+  CHECK_EQ(small_block, node->address());
+  CHECK(free_list.IsEmpty());
+  CHECK_EQ(static_cast<intptr_t>(0), free_list.Available());
+  CHECK(free_list.TryRemoveMemory(50 * kPointerSize) == nullptr);
+
+  delete compaction_space;
+  memory_allocator->TearDown();
+  delete memory_allocator;
+}
+
+
 TEST(LargeObjectSpace) {
   v8::V8::Initialize();
 
@@ -420,4 +420,40 @@ TEST(9) {
 #endif
 
 
+// Test vector find element equal
+TEST(10) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  HandleScope scope(isolate);
+
+  Assembler assm(isolate, NULL, 0);
+  if (!CpuFeatures::IsSupported(VECTOR_FACILITY)) return;
+
+  // Search the 16 bytes at r2 for the character in r3.
+  __ vl(d1, MemOperand(r2, 0));
+  __ vlvg(d2, r3, MemOperand(r0, 0), kVectorByte);
+  __ vrep(d2, d2, Operand::Zero(), kVectorByte);
+  __ vfee(d3, d1, d2, kVectorByte, kVectorSetCC);
+  __ vlgv(r2, d3, MemOperand(r0, 7), kVectorByte);
+  __ b(r14);
+
+  CodeDesc desc;
+  assm.GetCode(&desc);
+  Handle<Code> code = isolate->factory()->NewCode(
+      desc, Code::ComputeFlags(Code::STUB), Handle<Code>());
+#ifdef DEBUG
+  code->Print();
+#endif
+  F3 f = FUNCTION_CAST<F3>(code->entry());
+  char buffer[] = "abcdefghijklmnop";
+  intptr_t res = reinterpret_cast<intptr_t>(
+      CALL_GENERATED_CODE(isolate, f, buffer, 'g', 0, 0, 0));
+  ::printf("f() = %" V8PRIdPTR "\n", res);
+  CHECK_EQ(6, static_cast<int>(res));
+  res = reinterpret_cast<intptr_t>(
+      CALL_GENERATED_CODE(isolate, f, buffer, 'z', 0, 0, 0));
+  CHECK_EQ(16, static_cast<int>(res));
+}
+
+
 #undef __
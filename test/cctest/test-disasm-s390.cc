@@ -208,6 +208,10 @@ TEST(FourBytes) {
           "4b812006       sh\tr8,6(r1,r2)");
   COMPARE(mh(r5, MemOperand(r9, r8, 7)),
           "4c598007       mh\tr5,7(r9,r8)");
+  COMPARE(lrvr(r3, r4),
+          "b91f0034       lrvr\tr3,r4");
+  COMPARE(lrvgr(r7, r8),
+          "b90f0078       lrvgr\tr7,r8");
 
   VERIFY_RUN();
 }
@@ -409,6 +413,40 @@ TEST(SixBytes) {
           "c00b00001f40   nilf\tr0,8000");
   COMPARE(oilf(r9, Operand(1000)),
           "c09d000003e8   oilf\tr9,1000");
+  COMPARE(vl(d1, MemOperand(r2, 16)),
+          "e71020100006   vl\tv1,16(r2)");
+  COMPARE(vst(d2, MemOperand(r3, r4, 32)),
+          "e7234020000e   vst\tv2,32(r3,r4)");
+  COMPARE(vll(d3, r5, MemOperand(r6, 0)),
+          "e73560000037   vll\tv3,r5,0(r6)");
+  COMPARE(vstl(d3, r5, MemOperand(r6, 0)),
+          "e7356000003f   vstl\tv3,r5,0(r6)");
+  COMPARE(vlr(d4, d5),
+          "e74500000056   vlr\tv4,v5");
+  COMPARE(vlgv(r2, d1, MemOperand(r0, 7), kVectorByte),
+          "e72100070021   vlgv\tr2,v1,7(r0),0");
+  COMPARE(vlvg(d1, r2, MemOperand(r0, 1), kVectorDoubleword),
+          "e71200013022   vlvg\tv1,r2,1(r0),3");
+  COMPARE(vgbm(d0, Operand(0xFFFF)),
+          "e700ffff0044   vgbm\tv0,65535");
+  COMPARE(vrep(d1, d2, Operand(3), kVectorWord),
+          "e7120003204d   vrep\tv1,v2,3,2");
+  COMPARE(vn(d1, d2, d3),
+          "e71230000068   vn\tv1,v2,v3");
+  COMPARE(vo(d1, d2, d3),
+          "e7123000006a   vo\tv1,v2,v3");
+  COMPARE(vx(d1, d2, d3),
+          "e7123000006d   vx\tv1,v2,v3");
+  COMPARE(vceq(d1, d2, d3, kVectorByte, kVectorSetCC),
+          "e712301000f8   vceq\tv1,v2,v3,0,1");
+  COMPARE(vfee(d4, d5, d6, kVectorHalfword, kVectorZeroSearch | kVectorSetCC),
+          "e74560301080   vfee\tv4,v5,v6,1,3");
+  COMPARE(vfene(d4, d5, d6, kVectorByte),
+          "e74560000081   vfene\tv4,v5,v6,0,0");
+  COMPARE(vfae(d1, d2, d3, kVectorByte, kVectorResultMask),
+          "e71230400082   vfae\tv1,v2,v3,0,4");
+  COMPARE(vfa(d1, d2, d3),
+          "e712300030e3   vfa\tv1,v2,v3,3,0");
 
   VERIFY_RUN();
 }
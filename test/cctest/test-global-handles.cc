@@ -27,6 +27,8 @@
 
 #include "src/global-handles.h"
 
+#include "src/heap/gc-tracer.h"
+#include "src/v8.h"
 #include "test/cctest/cctest.h"
 
 using namespace v8::internal;
@@ -417,3 +419,193 @@ TEST(WeakPersistentSmi) {
   // Should not crash.
   g.SetWeak<void>(nullptr, &WeakCallback, v8::WeakCallbackType::kParameter);
 }
+
+
+static int collected_handles = 0;
+static int second_pass_callbacks = 0;
+
+
+static void SecondPassCallback(const v8::WeakCallbackInfo<void>& data) {
+  second_pass_callbacks++;
+}
+
+
+static void ResetingWeakCallback(const v8::WeakCallbackInfo<void>& data) {
+  collected_handles++;
+  static_cast<v8::Global<v8::Object>*>(data.GetParameter())->Reset();
+  data.SetSecondPassCallback(&SecondPassCallback);
+}
+
+
+// Keeps idle tasks until the test runs them and drops delayed tasks.
+class IdleTaskPlatform : public v8::Platform {
+ public:
+  explicit IdleTaskPlatform(v8::Platform* platform) : platform_(platform) {}
+  virtual ~IdleTaskPlatform() {
+    for (int i = 0; i < idle_tasks_.length(); i++) delete idle_tasks_[i];
+  }
+
+  void CallOnBackgroundThread(v8::Task* task,
+                              ExpectedRuntime expected_runtime) override {
+    platform_->CallOnBackgroundThread(task, expected_runtime);
+  }
+
+  void CallOnForegroundThread(v8::Isolate* isolate, v8::Task* task) override {
+    platform_->CallOnForegroundThread(isolate, task);
+  }
+
+  void CallDelayedOnForegroundThread(v8::Isolate* isolate, v8::Task* task,
+                                     double delay_in_seconds) override {
+    delete task;
+  }
+
+  void CallIdleOnForegroundThread(v8::Isolate* isolate,
+                                  v8::IdleTask* task) override {
+    idle_tasks_.Add(task);
+  }
+
+  bool IdleTasksEnabled(v8::Isolate* isolate) override { return true; }
+
+  double MonotonicallyIncreasingTime() override {
+    return platform_->MonotonicallyIncreasingTime();
+  }
+
+  uint64_t AddTraceEvent(char phase, const uint8_t* category_enabled_flag,
+                         const char* name, uint64_t id, uint64_t bind_id,
+                         int num_args, const char** arg_names,
+                         const uint8_t* arg_types, const uint64_t* arg_values,
+                         unsigned int flags) override {
+    return 0;
+  }
+
+  void UpdateTraceEventDuration(const uint8_t* category_enabled_flag,
+                                const char* name, uint64_t handle) override {}
+
+  const uint8_t* GetCategoryGroupEnabled(const char* name) override {
+    static uint8_t no = 0;
+    return &no;
+  }
+
+  const char* GetCategoryGroupName(
+      const uint8_t* category_enabled_flag) override {
+    static const char* dummy = "dummy";
+    return dummy;
+  }
+
+  bool PendingIdleTask() { return !idle_tasks_.is_empty(); }
+
+  // Runs the idle tasks posted so far with the given idle time.
+  void PerformIdleTasks(double idle_time_in_seconds) {
+    List<v8::IdleTask*> tasks;
+    tasks.AddAll(idle_tasks_);
+    idle_tasks_.Clear();
+    for (int i = 0; i < tasks.length(); i++) {
+      tasks[i]->Run(MonotonicallyIncreasingTime() + idle_time_in_seconds);
+      delete tasks[i];
+    }
+  }
+
+ private:
+  v8::Platform* platform_;
+  List<v8::IdleTask*> idle_tasks_;
+};
+
+
+TEST(ManyWeakHandlesIdentifiedInParallel) {
+  // Second pass callbacks are invoked synchronously in these modes.
+  if (FLAG_optimize_for_size || FLAG_predictable) return;
+  // Enough handles to span many node blocks, so that weak handles are
+  // identified in parallel if --parallel-global-handles is on.
+  const int kHandles = 4096;
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  Heap* heap = CcTest::heap();
+  GlobalHandles* global_handles = CcTest::i_isolate()->global_handles();
+  int initial_handles = global_handles->global_handles_count();
+  v8::Platform* old_platform = V8::GetCurrentPlatform();
+  IdleTaskPlatform platform(old_platform);
+  V8::SetPlatformForTesting(&platform);
+
+  v8::Global<v8::Object>* handles = new v8::Global<v8::Object>[kHandles];
+  {
+    v8::HandleScope scope(isolate);
+    v8::Local<v8::Object> survivor = v8::Object::New(isolate);
+    for (int i = 0; i < kHandles; i++) {
+      if (i % 2 == 0) {
+        handles[i].Reset(isolate, survivor);
+      } else {
+        handles[i].Reset(isolate, v8::Object::New(isolate));
+      }
+      handles[i].SetWeak<void>(&handles[i], &ResetingWeakCallback,
+                               v8::WeakCallbackType::kParameter);
+    }
+    collected_handles = 0;
+    second_pass_callbacks = 0;
+    heap->CollectAllGarbage();
+    CHECK_EQ(kHandles / 2, collected_handles);
+    CHECK_EQ(initial_handles + kHandles / 2,
+             global_handles->global_handles_count());
+  }
+
+  // Second pass callbacks are left to an idle task. If its deadline has
+  // passed, the task invokes a single batch of callbacks, accounts for them in
+  // the GC tracer and posts another task for the rest.
+  CHECK_EQ(0, second_pass_callbacks);
+  CHECK(platform.PendingIdleTask());
+  GCTracer* tracer = heap->tracer();
+  CHECK_EQ(0, tracer->second_pass_callbacks_since_gc());
+  platform.PerformIdleTasks(0);
+  CHECK_LT(0, second_pass_callbacks);
+  CHECK_GT(kHandles / 2, second_pass_callbacks);
+  CHECK_EQ(second_pass_callbacks, tracer->second_pass_callbacks_since_gc());
+  CHECK(platform.PendingIdleTask());
+
+  const double kLongIdleTimeInSeconds = 1;
+  while (platform.PendingIdleTask()) {
+    platform.PerformIdleTasks(kLongIdleTimeInSeconds);
+  }
+  CHECK_EQ(kHandles / 2, second_pass_callbacks);
+
+  // The next GC reports the batches and starts counting from zero.
+  heap->CollectGarbage(NEW_SPACE);
+  CHECK_EQ(0, tracer->second_pass_callbacks_since_gc());
+
+  V8::SetPlatformForTesting(old_platform);
+  for (int i = 0; i < kHandles; i++) handles[i].Reset();
+  delete[] handles;
+}
+
+
+TEST(SecondPassCallbacksRunWhenTheQueueIsFull) {
+  // Second pass callbacks are invoked synchronously in these modes.
+  if (FLAG_optimize_for_size || FLAG_predictable) return;
+  const int kHandles = GlobalHandles::kMaxQueuedSecondPassCallbacks + 1;
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  Heap* heap = CcTest::heap();
+  v8::Platform* old_platform = V8::GetCurrentPlatform();
+  IdleTaskPlatform platform(old_platform);
+  V8::SetPlatformForTesting(&platform);
+
+  v8::Global<v8::Object>* handles = new v8::Global<v8::Object>[kHandles];
+  {
+    v8::HandleScope scope(isolate);
+    for (int i = 0; i < kHandles; i++) {
+      handles[i].Reset(isolate, v8::Object::New(isolate));
+      handles[i].SetWeak<void>(&handles[i], &ResetingWeakCallback,
+                               v8::WeakCallbackType::kParameter);
+    }
+  }
+  collected_handles = 0;
+  second_pass_callbacks = 0;
+  heap->CollectAllGarbage();
+  CHECK_EQ(kHandles, collected_handles);
+
+  // The embedder never runs idle tasks, so the callbacks do not wait for one
+  // once there are too many of them.
+  CHECK_EQ(kHandles, second_pass_callbacks);
+  CHECK(!platform.PendingIdleTask());
+
+  V8::SetPlatformForTesting(old_platform);
+  delete[] handles;
+}
@@ -1028,6 +1028,122 @@ TEST(HeapSnapshotJSONSerializationAborting) {
   CHECK_EQ(0, stream.eos_signaled());
 }
 
+
+TEST(HeapSnapshotJSONSerializationParallel) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+  CompileRun(
+      "var a = [];\n"
+      "for (var i = 0; i < 10000; i++) a.push({ x: i, y: 'y' + i });");
+  const v8::HeapSnapshot* snapshot = heap_profiler->TakeHeapSnapshot();
+  CHECK(ValidateSnapshot(snapshot));
+  CHECK_GT(snapshot->GetNodesCount(), 20000);
+
+  // Formatting nodes and edges in parallel produces the same output.
+  i::FLAG_parallel_heap_snapshot_serialization = false;
+  TestJSONStream serial_stream;
+  snapshot->Serialize(&serial_stream, v8::HeapSnapshot::kJSON);
+  i::FLAG_parallel_heap_snapshot_serialization = true;
+  TestJSONStream parallel_stream;
+  snapshot->Serialize(&parallel_stream, v8::HeapSnapshot::kJSON);
+  CHECK_EQ(1, parallel_stream.eos_signaled());
+  CHECK_EQ(serial_stream.size(), parallel_stream.size());
+  i::ScopedVector<char> serial_json(serial_stream.size());
+  serial_stream.WriteTo(serial_json);
+  i::ScopedVector<char> parallel_json(parallel_stream.size());
+  parallel_stream.WriteTo(parallel_json);
+  CHECK_EQ(0, memcmp(serial_json.start(), parallel_json.start(),
+                     serial_json.length()));
+}
+
+
+static int GetEdgesCount(const v8::HeapSnapshot* snapshot) {
+  i::HeapSnapshot* heap_snapshot = const_cast<i::HeapSnapshot*>(
+      reinterpret_cast<const i::HeapSnapshot*>(snapshot));
+  return heap_snapshot->edges().length();
+}
+
+
+TEST(HeapSnapshotParallelExtraction) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+  CompileRun(
+      "function A(x) { this.x = x; this.s = 's' + x; }\n"
+      "var a = [];\n"
+      "for (var i = 0; i < 10000; i++) a.push(new A(i));\n"
+      "var m = new Map([[a[0], a[1]]]);\n"
+      "var buffer = new ArrayBuffer(16);");
+
+  // Extracting references page by page produces the same graph.
+  i::FLAG_parallel_heap_snapshot_extraction = false;
+  const v8::HeapSnapshot* serial = heap_profiler->TakeHeapSnapshot();
+  CHECK(ValidateSnapshot(serial));
+  i::FLAG_parallel_heap_snapshot_extraction = true;
+  const v8::HeapSnapshot* parallel = heap_profiler->TakeHeapSnapshot();
+  CHECK(ValidateSnapshot(parallel));
+  CHECK_GT(parallel->GetNodesCount(), 20000);
+  CHECK_EQ(serial->GetNodesCount(), parallel->GetNodesCount());
+  CHECK_EQ(GetEdgesCount(serial), GetEdgesCount(parallel));
+
+  const v8::HeapGraphNode* global = GetGlobalObject(parallel);
+  const v8::HeapGraphNode* a =
+      GetProperty(global, v8::HeapGraphEdge::kProperty, "a");
+  CHECK(a);
+  CHECK_GE(a->GetChildrenCount(), 10000);
+  // Array buffers are extracted on the main thread.
+  const v8::HeapGraphNode* buffer =
+      GetProperty(global, v8::HeapGraphEdge::kProperty, "buffer");
+  CHECK(buffer);
+  CHECK(GetProperty(buffer, v8::HeapGraphEdge::kInternal, "backing_store"));
+}
+
+
+TEST(HeapSnapshotJSONCountsTrailer) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+  CompileRun("var a = { x: 1 };");
+  const v8::HeapSnapshot* snapshot = heap_profiler->TakeHeapSnapshot();
+  CHECK(ValidateSnapshot(snapshot));
+
+  i::FLAG_heap_snapshot_counts_trailer = true;
+  TestJSONStream stream;
+  snapshot->Serialize(&stream, v8::HeapSnapshot::kJSON);
+  i::FLAG_heap_snapshot_counts_trailer = false;
+  CHECK_EQ(1, stream.eos_signaled());
+  i::ScopedVector<char> json(stream.size());
+  stream.WriteTo(json);
+
+  OneByteResource* json_res = new OneByteResource(json);
+  v8::Local<v8::String> json_string =
+      v8::String::NewExternalOneByte(env->GetIsolate(), json_res)
+          .ToLocalChecked();
+  env->Global()
+      ->Set(env.local(), v8_str("json_snapshot"), json_string)
+      .FromJust();
+  CompileRun("var parsed = JSON.parse(json_snapshot);");
+
+  // The counts are only written after the strings.
+  CHECK(CompileRun("'node_count' in parsed.snapshot")->IsFalse());
+  CHECK(CompileRun("'edge_count' in parsed.snapshot")->IsFalse());
+  int node_count =
+      CompileRun("parsed.snapshot_counts.node_count")
+          ->Int32Value(env.local())
+          .FromJust();
+  int edge_count =
+      CompileRun("parsed.snapshot_counts.edge_count")
+          ->Int32Value(env.local())
+          .FromJust();
+  CHECK_EQ(snapshot->GetNodesCount(), node_count);
+  CHECK_EQ(GetEdgesCount(snapshot), edge_count);
+  CHECK_EQ(node_count, CompileRun("parsed.nodes.length / "
+                                  "parsed.snapshot.meta.node_fields.length")
+                           ->Int32Value(env.local())
+                           .FromJust());
+}
+
 namespace {
 
 class TestStatsStream : public v8::OutputStream {
@@ -2982,6 +3098,63 @@ TEST(SamplingHeapProfiler) {
 }
 
 
+TEST(SamplingHeapProfilerLifetimes) {
+  v8::HandleScope scope(v8::Isolate::GetCurrent());
+  LocalContext env;
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+
+  // Turn off always_opt. Inlining can cause stack traces to be shorter than
+  // what we expect in this test.
+  v8::internal::FLAG_always_opt = false;
+
+  // Suppress randomness to avoid flakiness in tests.
+  v8::internal::FLAG_sampling_heap_profiler_suppress_randomness = true;
+
+  heap_profiler->StartSamplingHeapProfiler(
+      1024, 16, v8::HeapProfiler::kSamplingTrackLifetimes);
+  CompileRun(
+      "var retained = [];\n"
+      "function garbage() { return new Array(64); }\n"
+      "function keep() { retained.push(new Array(64)); }\n"
+      "for (var i = 0; i < 1024; ++i) {\n"
+      "  garbage();\n"
+      "  keep();\n"
+      "}");
+  CcTest::heap()->CollectGarbage(i::NEW_SPACE);
+  CcTest::heap()->CollectAllGarbage();
+
+  v8::base::SmartPointer<v8::AllocationProfile> profile(
+      heap_profiler->GetAllocationProfile());
+  CHECK(!profile.is_empty());
+
+  // Objects that are dropped right away die young, and none are left.
+  const char* garbage_names[] = {"", "garbage"};
+  auto node_garbage = FindAllocationProfileNode(
+      *profile, Vector<const char*>(garbage_names, arraysize(garbage_names)));
+  CHECK(node_garbage);
+  const v8::AllocationProfile::LifetimeHistogram& garbage =
+      node_garbage->lifetimes;
+  CHECK_GT(garbage.allocated_bytes, 0u);
+  CHECK_GT(garbage.died_young, 0u);
+  CHECK_EQ(0u, garbage.young);
+
+  // Retained objects never die; they are either promoted or still young.
+  const char* keep_names[] = {"", "keep"};
+  auto node_keep = FindAllocationProfileNode(
+      *profile, Vector<const char*>(keep_names, arraysize(keep_names)));
+  CHECK(node_keep);
+  const v8::AllocationProfile::LifetimeHistogram& keep = node_keep->lifetimes;
+  unsigned int count = 0;
+  for (auto allocation : node_keep->allocations) count += allocation.count;
+  CHECK_GT(count, 0u);
+  CHECK_EQ(0u, keep.died_young);
+  for (unsigned int died : keep.died_after_scavenges) CHECK_EQ(0u, died);
+  CHECK_EQ(count, keep.promoted + keep.young);
+
+  heap_profiler->StopSamplingHeapProfiler();
+}
+
+
 TEST(SamplingHeapProfilerApiAllocation) {
   v8::HandleScope scope(v8::Isolate::GetCurrent());
   LocalContext env;
@@ -0,0 +1,108 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the string compare and character copy loops of the code stubs,
+// i.e. one-byte equality and relational compare of flat strings, and the
+// copy of short substrings, which are not created as sliced strings. The
+// indexOf cases cover single-character and short-pattern searches.
+new BenchmarkSuite('StringCompare', [1000], [
+  new Benchmark('StringEquals', false, false, 0,
+                Equals, CompareSetup, CompareTearDown),
+  new Benchmark('StringLessThan', false, false, 0,
+                LessThan, CompareSetup, CompareTearDown),
+  new Benchmark('StringShortSubstring', false, false, 0,
+                ShortSubstring, SubstringSetup, SubstringTearDown),
+  new Benchmark('StringShortSubstringTwoByte', false, false, 0,
+                ShortSubstringTwoByte, SubstringSetup, SubstringTearDown),
+  new Benchmark('StringIndexOfChar', false, false, 0,
+                IndexOfChar, IndexOfSetup, IndexOfTearDown),
+  new Benchmark('StringIndexOfShort', false, false, 0,
+                IndexOfShort, IndexOfSetup, IndexOfTearDown),
+]);
+
+
+var result;
+var left;
+var right;
+
+// The strings share a long common prefix so that the comparison is
+// dominated by the character loop rather than the length checks. They are
+// distinct, flat and not internalized, so equality has to compare the
+// characters as well.
+function CompareSetup() {
+  var prefix = "abcdefghijklmnopqrstuvwxyz".repeat(40);
+  left = (prefix + "x").split("").join("");
+  right = (prefix + "x").split("").join("");
+  result = undefined;
+}
+
+function Equals() {
+  result = 0;
+  for (var i = 0; i < 100; i++) {
+    if (left == right) result++;
+  }
+}
+
+function LessThan() {
+  result = 0;
+  for (var i = 0; i < 100; i++) {
+    if (left <= right) result++;
+  }
+}
+
+function CompareTearDown() {
+  return result === 100;
+}
+
+
+// Substrings shorter than SlicedString::kMinLength are copied.
+var kShortLength = 12;
+var oneByteSource;
+var twoByteSource;
+
+function SubstringSetup() {
+  oneByteSource = "0123456789abcdef".repeat(64);
+  twoByteSource = "0123456789abcde\u1234".repeat(64);
+  result = undefined;
+}
+
+function ShortSubstring() {
+  for (var i = 0; i < 500; i++) {
+    result = oneByteSource.substring(i, i + kShortLength);
+  }
+}
+
+function ShortSubstringTwoByte() {
+  for (var i = 0; i < 500; i++) {
+    result = twoByteSource.substring(i, i + kShortLength);
+  }
+}
+
+function SubstringTearDown() {
+  return result.length === kShortLength;
+}
+
+
+var haystack;
+
+function IndexOfSetup() {
+  haystack = "abcdefghijklmnopqrstuvwxy".repeat(40) + "z!";
+  result = undefined;
+}
+
+function IndexOfChar() {
+  for (var i = 0; i < 100; i++) {
+    result = haystack.indexOf("z");
+  }
+}
+
+function IndexOfShort() {
+  for (var i = 0; i < 100; i++) {
+    result = haystack.indexOf("yz!");
+  }
+}
+
+function IndexOfTearDown() {
+  return result >= 998;
+}
@@ -85,6 +85,29 @@ TEST(Bits, CountTrailingZeros64) {
 }
 
 
+TEST(Bits, ClearLowestSetBit32) {
+  EXPECT_EQ(0u, ClearLowestSetBit32(0));
+  EXPECT_EQ(0u, ClearLowestSetBit32(0x80000000));
+  TRACED_FORRANGE(uint32_t, shift, 0, 30) {
+    EXPECT_EQ(0x80000000u, ClearLowestSetBit32(0x80000000u | (1u << shift)));
+  }
+  EXPECT_EQ(0xf0f0f0e0u, ClearLowestSetBit32(0xf0f0f0f0));
+}
+
+
+TEST(Bits, ClearLowestSetBit64) {
+  EXPECT_EQ(0u, ClearLowestSetBit64(0));
+  EXPECT_EQ(0u, ClearLowestSetBit64(0x8000000000000000));
+  TRACED_FORRANGE(uint32_t, shift, 0, 62) {
+    EXPECT_EQ(V8_UINT64_C(0x8000000000000000),
+              ClearLowestSetBit64(V8_UINT64_C(0x8000000000000000) |
+                                  (V8_UINT64_C(1) << shift)));
+  }
+  EXPECT_EQ(V8_UINT64_C(0xf0f0f0e000000000),
+            ClearLowestSetBit64(0xf0f0f0f000000000));
+}
+
+
 TEST(Bits, IsPowerOfTwo32) {
   EXPECT_FALSE(IsPowerOfTwo32(0U));
   TRACED_FORRANGE(uint32_t, shift, 0, 31) {
@@ -28,5 +28,10 @@ TEST(SysInfoTest, AmountOfVirtualMemory) {
   EXPECT_LE(0, SysInfo::AmountOfVirtualMemory());
 }
 
+
+TEST(SysInfoTest, AmountOfContainerMemory) {
+  EXPECT_LE(0, SysInfo::AmountOfContainerMemory());
+}
+
 }  // namespace base
 }  // namespace v8
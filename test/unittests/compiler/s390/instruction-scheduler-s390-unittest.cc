@@ -0,0 +1,78 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "test/unittests/compiler/instruction-selector-unittest.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+namespace {
+
+// Returns the position of the first instruction of {s} with the given
+// opcode, or s.size() if there is none.
+size_t IndexOf(const InstructionSelectorTest::Stream& s, ArchOpcode opcode) {
+  for (size_t i = 0; i < s.size(); i++) {
+    if (s[i]->arch_opcode() == opcode) return i;
+  }
+  return s.size();
+}
+
+}  // namespace
+
+
+class InstructionSchedulerTest : public InstructionSelectorTest {
+ public:
+  InstructionSchedulerTest()
+      : saved_flag_(FLAG_turbo_instruction_scheduling) {
+    FLAG_turbo_instruction_scheduling = true;
+  }
+  ~InstructionSchedulerTest() override {
+    FLAG_turbo_instruction_scheduling = saved_flag_;
+  }
+
+ private:
+  bool saved_flag_;
+};
+
+
+TEST_F(InstructionSchedulerTest, DivideIsHoistedAheadOfIndependentWork) {
+  StreamBuilder m(this, MachineType::Int32(), MachineType::Int32(),
+                  MachineType::Int32(), MachineType::Int32());
+  // Single cycle work that does not depend on the divide comes first in the
+  // graph.
+  Node* work = m.Word32Xor(m.Parameter(2), m.Parameter(0));
+  work = m.Word32Or(work, m.Parameter(1));
+  work = m.Word32Xor(work, m.Parameter(2));
+  Node* const div = m.Int32Div(m.Parameter(0), m.Parameter(1));
+  m.Return(m.Int32Add(div, work));
+  Stream s = m.Build();
+  size_t const div_index = IndexOf(s, kS390_Div32);
+  ASSERT_LT(div_index, s.size());
+  // The divide is on the critical path, so it is issued before the other
+  // operations, whose latency it then hides.
+  EXPECT_LT(div_index, IndexOf(s, kS390_Xor));
+  EXPECT_LT(div_index, IndexOf(s, kS390_Or));
+  EXPECT_LT(IndexOf(s, kS390_Or), IndexOf(s, kS390_Add));
+}
+
+
+TEST_F(InstructionSchedulerTest, LoadIsHoistedAheadOfIndependentWork) {
+  StreamBuilder m(this, MachineType::Int32(), MachineType::Pointer(),
+                  MachineType::Int32(), MachineType::Int32());
+  Node* work = m.Word32Xor(m.Parameter(1), m.Parameter(2));
+  work = m.Word32Or(work, m.Parameter(1));
+  Node* const load =
+      m.Load(MachineType::Int32(), m.Parameter(0), m.IntPtrConstant(8));
+  m.Return(m.Int32Mul(load, work));
+  Stream s = m.Build();
+  size_t const load_index = IndexOf(s, kS390_LoadWordS32);
+  ASSERT_LT(load_index, s.size());
+  EXPECT_LT(load_index, IndexOf(s, kS390_Xor));
+  EXPECT_LT(load_index, IndexOf(s, kS390_Or));
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
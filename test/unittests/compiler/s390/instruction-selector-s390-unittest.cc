@@ -9,6 +9,452 @@
 
 namespace v8 {
 namespace internal {
-namespace compiler {}  // namespace compiler
+namespace compiler {
+
+namespace {
+
+// A displacement that does not fit the 12-bit RX form, but the 20-bit RXY
+// form, and is beyond the 16-bit range of the PPC port as well.
+const int32_t kLongDisplacement = 0x12344;
+
+
+template <typename T>
+struct MachInst {
+  T constructor;
+  const char* constructor_name;
+  ArchOpcode arch_opcode;
+  MachineType machine_type;
+  bool commutative;
+};
+
+typedef MachInst<Node* (RawMachineAssembler::*)(Node*, Node*)> MachInst2;
+
+
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const MachInst<T>& mi) {
+  return os << mi.constructor_name;
+}
+
+
+// ALU operations that take a memory operand of their own width.
+const MachInst2 kMemoryOperandBinops[] = {
+    {&RawMachineAssembler::Int32Add, "Int32Add", kS390_Add,
+     MachineType::Int32(), true},
+    {&RawMachineAssembler::Int32Sub, "Int32Sub", kS390_Sub,
+     MachineType::Int32(), false},
+    {&RawMachineAssembler::Word32And, "Word32And", kS390_And,
+     MachineType::Int32(), true},
+    {&RawMachineAssembler::Word32Or, "Word32Or", kS390_Or,
+     MachineType::Int32(), true},
+    {&RawMachineAssembler::Word32Xor, "Word32Xor", kS390_Xor,
+     MachineType::Int32(), true},
+#if V8_TARGET_ARCH_S390X
+    {&RawMachineAssembler::Int64Add, "Int64Add", kS390_Add,
+     MachineType::Int64(), true},
+    {&RawMachineAssembler::Int64Sub, "Int64Sub", kS390_Sub,
+     MachineType::Int64(), false},
+    {&RawMachineAssembler::Word64And, "Word64And", kS390_And,
+     MachineType::Int64(), true},
+    {&RawMachineAssembler::Word64Or, "Word64Or", kS390_Or,
+     MachineType::Int64(), true},
+    {&RawMachineAssembler::Word64Xor, "Word64Xor", kS390_Xor,
+     MachineType::Int64(), true},
+#endif
+};
+
+
+int MemoryOperandWidth(const MachInst2& binop) {
+  return binop.machine_type.representation() == MachineRepresentation::kWord64
+             ? kS390_MemoryOperand64
+             : kS390_MemoryOperand32;
+}
+
+
+// Returns the first instruction of {s} with the given opcode, or nullptr.
+const Instruction* FindInstruction(const InstructionSelectorTest::Stream& s,
+                                   ArchOpcode opcode) {
+  for (size_t i = 0; i < s.size(); i++) {
+    if (s[i]->arch_opcode() == opcode) return s[i];
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+
+// -----------------------------------------------------------------------------
+// ALU operations with a memory operand.
+
+
+typedef InstructionSelectorTestWithParam<MachInst2>
+    InstructionSelectorMemoryOperandBinopTest;
+
+
+TEST_P(InstructionSelectorMemoryOperandBinopTest, LoadOnRight) {
+  const MachInst2 binop = GetParam();
+  StreamBuilder m(this, binop.machine_type, binop.machine_type,
+                  MachineType::Pointer());
+  Node* const p0 = m.Parameter(0);
+  Node* const p1 = m.Parameter(1);
+  Node* const load = m.Load(binop.machine_type, p1,
+                            m.IntPtrConstant(kLongDisplacement));
+  Node* const n = (m.*binop.constructor)(p0, load);
+  m.Return(n);
+  Stream s = m.Build();
+  ASSERT_EQ(1U, s.size());
+  EXPECT_EQ(binop.arch_opcode, s[0]->arch_opcode());
+  EXPECT_EQ(kMode_MRI, s[0]->addressing_mode());
+  EXPECT_EQ(MemoryOperandWidth(binop),
+            static_cast<int>(MiscField::decode(s[0]->opcode())));
+  ASSERT_EQ(3U, s[0]->InputCount());
+  EXPECT_EQ(s.ToVreg(p0), s.ToVreg(s[0]->InputAt(0)));
+  EXPECT_EQ(s.ToVreg(p1), s.ToVreg(s[0]->InputAt(1)));
+  EXPECT_EQ(kLongDisplacement, s.ToInt32(s[0]->InputAt(2)));
+  ASSERT_EQ(1U, s[0]->OutputCount());
+  EXPECT_TRUE(s.IsSameAsFirst(s[0]->Output()));
+  EXPECT_EQ(s.ToVreg(n), s.ToVreg(s[0]->Output()));
+}
+
+
+TEST_P(InstructionSelectorMemoryOperandBinopTest, LoadOnLeft) {
+  const MachInst2 binop = GetParam();
+  StreamBuilder m(this, binop.machine_type, binop.machine_type,
+                  MachineType::Pointer());
+  Node* const p0 = m.Parameter(0);
+  Node* const p1 = m.Parameter(1);
+  Node* const load = m.Load(binop.machine_type, p1, m.IntPtrConstant(8));
+  m.Return((m.*binop.constructor)(load, p0));
+  Stream s = m.Build();
+  if (binop.commutative) {
+    // The operands are commuted and the load is folded.
+    ASSERT_EQ(1U, s.size());
+    EXPECT_EQ(binop.arch_opcode, s[0]->arch_opcode());
+    EXPECT_EQ(kMode_MRI, s[0]->addressing_mode());
+    ASSERT_EQ(3U, s[0]->InputCount());
+    EXPECT_EQ(s.ToVreg(p0), s.ToVreg(s[0]->InputAt(0)));
+    EXPECT_EQ(s.ToVreg(p1), s.ToVreg(s[0]->InputAt(1)));
+    EXPECT_EQ(8, s.ToInt32(s[0]->InputAt(2)));
+  } else {
+    ASSERT_EQ(2U, s.size());
+    EXPECT_EQ(binop.arch_opcode, s[1]->arch_opcode());
+    EXPECT_EQ(kMode_None, s[1]->addressing_mode());
+  }
+}
+
+
+TEST_P(InstructionSelectorMemoryOperandBinopTest, LoadWithMRRI) {
+  const MachInst2 binop = GetParam();
+  StreamBuilder m(this, binop.machine_type, binop.machine_type,
+                  MachineType::Pointer(), MachineType::Pointer());
+  Node* const p0 = m.Parameter(0);
+  Node* const p1 = m.Parameter(1);
+  Node* const p2 = m.Parameter(2);
+  Node* const load =
+      m.Load(binop.machine_type, p1,
+             m.IntPtrAdd(p2, m.IntPtrConstant(kLongDisplacement)));
+  m.Return((m.*binop.constructor)(p0, load));
+  Stream s = m.Build();
+  ASSERT_EQ(1U, s.size());
+  EXPECT_EQ(binop.arch_opcode, s[0]->arch_opcode());
+  EXPECT_EQ(kMode_MRRI, s[0]->addressing_mode());
+  ASSERT_EQ(4U, s[0]->InputCount());
+  EXPECT_EQ(s.ToVreg(p0), s.ToVreg(s[0]->InputAt(0)));
+  EXPECT_EQ(s.ToVreg(p1), s.ToVreg(s[0]->InputAt(1)));
+  EXPECT_EQ(s.ToVreg(p2), s.ToVreg(s[0]->InputAt(2)));
+  EXPECT_EQ(kLongDisplacement, s.ToInt32(s[0]->InputAt(3)));
+}
+
+
+TEST_P(InstructionSelectorMemoryOperandBinopTest, LoadWithOtherUses) {
+  const MachInst2 binop = GetParam();
+  StreamBuilder m(this, binop.machine_type, binop.machine_type,
+                  MachineType::Pointer());
+  Node* const p0 = m.Parameter(0);
+  Node* const load =
+      m.Load(binop.machine_type, m.Parameter(1), m.IntPtrConstant(8));
+  // The load is not covered by the operation, so it is not folded.
+  m.Return((m.*binop.constructor)((m.*binop.constructor)(p0, load), load));
+  Stream s = m.Build();
+  ASSERT_EQ(3U, s.size());
+  EXPECT_EQ(kMode_MRI, s[0]->addressing_mode());
+  EXPECT_EQ(binop.arch_opcode, s[1]->arch_opcode());
+  EXPECT_EQ(kMode_None, s[1]->addressing_mode());
+  EXPECT_EQ(binop.arch_opcode, s[2]->arch_opcode());
+  EXPECT_EQ(kMode_None, s[2]->addressing_mode());
+}
+
+
+INSTANTIATE_TEST_CASE_P(InstructionSelectorTest,
+                        InstructionSelectorMemoryOperandBinopTest,
+                        ::testing::ValuesIn(kMemoryOperandBinops));
+
+
+TEST_F(InstructionSelectorTest, Int32AddWithNarrowLoadIsNotFolded) {
+  const MachineType kNarrowTypes[] = {
+      MachineType::Int8(), MachineType::Uint8(), MachineType::Int16(),
+      MachineType::Uint16()};
+  TRACED_FOREACH(MachineType, type, kNarrowTypes) {
+    StreamBuilder m(this, MachineType::Int32(), MachineType::Int32(),
+                    MachineType::Pointer());
+    m.Return(m.Int32Add(m.Parameter(0),
+                        m.Load(type, m.Parameter(1), m.IntPtrConstant(8))));
+    Stream s = m.Build();
+    ASSERT_EQ(2U, s.size());
+    EXPECT_EQ(kS390_Add, s[1]->arch_opcode());
+    EXPECT_EQ(kMode_None, s[1]->addressing_mode());
+  }
+}
+
+
+#if V8_TARGET_ARCH_S390X
+TEST_F(InstructionSelectorTest, Int64AddWithWord32LoadIsNotFolded) {
+  StreamBuilder m(this, MachineType::Int64(), MachineType::Int64(),
+                  MachineType::Pointer());
+  m.Return(m.Int64Add(
+      m.Parameter(0), m.ChangeInt32ToInt64(m.Load(
+                          MachineType::Int32(), m.Parameter(1),
+                          m.IntPtrConstant(8)))));
+  Stream s = m.Build();
+  const Instruction* add = FindInstruction(s, kS390_Add);
+  ASSERT_TRUE(add != nullptr);
+  EXPECT_EQ(kMode_None, add->addressing_mode());
+}
+
+
+TEST_F(InstructionSelectorTest, Int32AddWithWord64LoadIsNotFolded) {
+  StreamBuilder m(this, MachineType::Int32(), MachineType::Int32(),
+                  MachineType::Pointer());
+  m.Return(m.Int32Add(
+      m.Parameter(0), m.TruncateInt64ToInt32(m.Load(
+                          MachineType::Int64(), m.Parameter(1),
+                          m.IntPtrConstant(8)))));
+  Stream s = m.Build();
+  const Instruction* add = FindInstruction(s, kS390_Add);
+  ASSERT_TRUE(add != nullptr);
+  EXPECT_EQ(kMode_None, add->addressing_mode());
+}
+#endif
+
+
+TEST_F(InstructionSelectorTest, Int32AddWithLoadInOtherBlockIsNotFolded) {
+  StreamBuilder m(this, MachineType::Int32(), MachineType::Int32(),
+                  MachineType::Pointer());
+  Node* const load =
+      m.Load(MachineType::Int32(), m.Parameter(1), m.IntPtrConstant(8));
+  RawMachineLabel next;
+  m.Goto(&next);
+  m.Bind(&next);
+  m.Return(m.Int32Add(m.Parameter(0), load));
+  Stream s = m.Build();
+  const Instruction* add = FindInstruction(s, kS390_Add);
+  ASSERT_TRUE(add != nullptr);
+  EXPECT_EQ(kMode_None, add->addressing_mode());
+}
+
+
+// -----------------------------------------------------------------------------
+// Compares with a memory operand.
+
+
+TEST_F(InstructionSelectorTest, Word32EqualWithLoad) {
+  StreamBuilder m(this, MachineType::Int32(), MachineType::Int32(),
+                  MachineType::Pointer());
+  Node* const p0 = m.Parameter(0);
+  Node* const p1 = m.Parameter(1);
+  Node* const n = m.Word32Equal(
+      p0, m.Load(MachineType::Int32(), p1, m.IntPtrConstant(16)));
+  m.Return(n);
+  Stream s = m.Build();
+  ASSERT_EQ(1U, s.size());
+  EXPECT_EQ(kS390_Cmp32, s[0]->arch_opcode());
+  EXPECT_EQ(kMode_MRI, s[0]->addressing_mode());
+  ASSERT_EQ(3U, s[0]->InputCount());
+  EXPECT_EQ(s.ToVreg(p0), s.ToVreg(s[0]->InputAt(0)));
+  EXPECT_EQ(s.ToVreg(p1), s.ToVreg(s[0]->InputAt(1)));
+  EXPECT_EQ(16, s.ToInt32(s[0]->InputAt(2)));
+  EXPECT_EQ(kFlags_set, s[0]->flags_mode());
+  EXPECT_EQ(kEqual, s[0]->flags_condition());
+  ASSERT_EQ(1U, s[0]->OutputCount());
+  EXPECT_EQ(s.ToVreg(n), s.ToVreg(s[0]->Output()));
+}
+
+
+TEST_F(InstructionSelectorTest, Int32LessThanWithLoadOnLeftIsCommuted) {
+  StreamBuilder m(this, MachineType::Int32(), MachineType::Int32(),
+                  MachineType::Pointer());
+  Node* const p0 = m.Parameter(0);
+  m.Return(m.Int32LessThan(
+      m.Load(MachineType::Int32(), m.Parameter(1), m.IntPtrConstant(16)),
+      p0));
+  Stream s = m.Build();
+  ASSERT_EQ(1U, s.size());
+  EXPECT_EQ(kS390_Cmp32, s[0]->arch_opcode());
+  EXPECT_EQ(kMode_MRI, s[0]->addressing_mode());
+  EXPECT_EQ(s.ToVreg(p0), s.ToVreg(s[0]->InputAt(0)));
+  EXPECT_EQ(kFlags_set, s[0]->flags_mode());
+  EXPECT_EQ(kSignedGreaterThan, s[0]->flags_condition());
+}
+
+
+TEST_F(InstructionSelectorTest, Uint32LessThanBranchWithLoadOnLeft) {
+  StreamBuilder m(this, MachineType::Int32(), MachineType::Int32(),
+                  MachineType::Pointer());
+  Node* const p0 = m.Parameter(0);
+  RawMachineLabel a, b;
+  m.Branch(m.Uint32LessThan(m.Load(MachineType::Uint32(), m.Parameter(1),
+                                   m.IntPtrConstant(kLongDisplacement)),
+                            p0),
+           &a, &b);
+  m.Bind(&a);
+  m.Return(m.Int32Constant(1));
+  m.Bind(&b);
+  m.Return(m.Int32Constant(0));
+  Stream s = m.Build();
+  ASSERT_EQ(1U, s.size());
+  EXPECT_EQ(kS390_Cmp32, s[0]->arch_opcode());
+  EXPECT_EQ(kMode_MRI, s[0]->addressing_mode());
+  EXPECT_EQ(s.ToVreg(p0), s.ToVreg(s[0]->InputAt(0)));
+  EXPECT_EQ(kLongDisplacement, s.ToInt32(s[0]->InputAt(2)));
+  EXPECT_EQ(kFlags_branch, s[0]->flags_mode());
+  EXPECT_EQ(kUnsignedGreaterThan, s[0]->flags_condition());
+}
+
+
+#if V8_TARGET_ARCH_S390X
+TEST_F(InstructionSelectorTest, Word64EqualWithLoadWithMRRI) {
+  StreamBuilder m(this, MachineType::Int32(), MachineType::Int64(),
+                  MachineType::Pointer(), MachineType::Pointer());
+  Node* const p0 = m.Parameter(0);
+  Node* const p1 = m.Parameter(1);
+  Node* const p2 = m.Parameter(2);
+  m.Return(m.Word64Equal(
+      m.Load(MachineType::Int64(), p1, m.IntPtrAdd(p2, m.IntPtrConstant(24))),
+      p0));
+  Stream s = m.Build();
+  ASSERT_EQ(1U, s.size());
+  EXPECT_EQ(kS390_Cmp64, s[0]->arch_opcode());
+  EXPECT_EQ(kMode_MRRI, s[0]->addressing_mode());
+  ASSERT_EQ(4U, s[0]->InputCount());
+  EXPECT_EQ(s.ToVreg(p0), s.ToVreg(s[0]->InputAt(0)));
+  EXPECT_EQ(s.ToVreg(p1), s.ToVreg(s[0]->InputAt(1)));
+  EXPECT_EQ(s.ToVreg(p2), s.ToVreg(s[0]->InputAt(2)));
+  EXPECT_EQ(24, s.ToInt32(s[0]->InputAt(3)));
+  EXPECT_EQ(kEqual, s[0]->flags_condition());
+}
+
+
+TEST_F(InstructionSelectorTest, Word64CompareWithWord32LoadIsNotFolded) {
+  StreamBuilder m(this, MachineType::Int32(), MachineType::Int64(),
+                  MachineType::Pointer());
+  m.Return(m.Word64Equal(
+      m.Parameter(0), m.ChangeInt32ToInt64(m.Load(
+                          MachineType::Int32(), m.Parameter(1),
+                          m.IntPtrConstant(8)))));
+  Stream s = m.Build();
+  const Instruction* cmp = FindInstruction(s, kS390_Cmp64);
+  ASSERT_TRUE(cmp != nullptr);
+  EXPECT_EQ(kMode_None, cmp->addressing_mode());
+}
+#endif
+
+
+// -----------------------------------------------------------------------------
+// Loads and stores with [base + index + displacement].
+
+
+TEST_F(InstructionSelectorTest, LoadWithMRRI) {
+  StreamBuilder m(this, MachineType::Int32(), MachineType::Pointer(),
+                  MachineType::Pointer());
+  Node* const p0 = m.Parameter(0);
+  Node* const p1 = m.Parameter(1);
+  m.Return(m.Load(MachineType::Int32(), p0,
+                  m.IntPtrAdd(p1, m.IntPtrConstant(kLongDisplacement))));
+  Stream s = m.Build();
+  ASSERT_EQ(1U, s.size());
+  EXPECT_EQ(kS390_LoadWordS32, s[0]->arch_opcode());
+  EXPECT_EQ(kMode_MRRI, s[0]->addressing_mode());
+  ASSERT_EQ(3U, s[0]->InputCount());
+  EXPECT_EQ(s.ToVreg(p0), s.ToVreg(s[0]->InputAt(0)));
+  EXPECT_EQ(s.ToVreg(p1), s.ToVreg(s[0]->InputAt(1)));
+  EXPECT_EQ(kLongDisplacement, s.ToInt32(s[0]->InputAt(2)));
+}
+
+
+TEST_F(InstructionSelectorTest, LoadWithAddOnBaseUsesMRRI) {
+  StreamBuilder m(this, MachineType::Int32(), MachineType::Pointer(),
+                  MachineType::Pointer());
+  Node* const p0 = m.Parameter(0);
+  Node* const p1 = m.Parameter(1);
+  m.Return(m.Load(MachineType::Int32(),
+                  m.IntPtrAdd(p0, m.IntPtrConstant(-kLongDisplacement)), p1));
+  Stream s = m.Build();
+  ASSERT_EQ(1U, s.size());
+  EXPECT_EQ(kMode_MRRI, s[0]->addressing_mode());
+  ASSERT_EQ(3U, s[0]->InputCount());
+  EXPECT_EQ(s.ToVreg(p1), s.ToVreg(s[0]->InputAt(0)));
+  EXPECT_EQ(s.ToVreg(p0), s.ToVreg(s[0]->InputAt(1)));
+  EXPECT_EQ(-kLongDisplacement, s.ToInt32(s[0]->InputAt(2)));
+}
+
+
+TEST_F(InstructionSelectorTest, LoadWithSharedAddUsesMRR) {
+  StreamBuilder m(this, MachineType::Int32(), MachineType::Pointer(),
+                  MachineType::Pointer());
+  Node* const index = m.IntPtrAdd(m.Parameter(1), m.IntPtrConstant(8));
+  // The add has another use, so it is not folded into the load.
+  Node* const load = m.Load(MachineType::Int32(), m.Parameter(0), index);
+  m.Return(m.Int32Add(load, m.Load(MachineType::Int32(), index,
+                                   m.IntPtrConstant(0))));
+  Stream s = m.Build();
+  const Instruction* load_instr = FindInstruction(s, kS390_LoadWordS32);
+  ASSERT_TRUE(load_instr != nullptr);
+  EXPECT_EQ(kMode_MRR, load_instr->addressing_mode());
+}
+
+
+TEST_F(InstructionSelectorTest, LoadWithTwentyBitDisplacement) {
+  const int32_t kDisplacements[] = {-524288, 524287, kLongDisplacement};
+  TRACED_FOREACH(int32_t, displacement, kDisplacements) {
+    StreamBuilder m(this, MachineType::Int32(), MachineType::Pointer());
+    m.Return(m.Load(MachineType::Int32(), m.Parameter(0),
+                    m.IntPtrConstant(displacement)));
+    Stream s = m.Build();
+    ASSERT_EQ(1U, s.size());
+    EXPECT_EQ(kMode_MRI, s[0]->addressing_mode());
+    EXPECT_EQ(displacement, s.ToInt32(s[0]->InputAt(1)));
+  }
+  // Displacements beyond 20 bits have to be materialized in a register.
+  StreamBuilder m(this, MachineType::Int32(), MachineType::Pointer());
+  m.Return(m.Load(MachineType::Int32(), m.Parameter(0),
+                  m.IntPtrConstant(524288)));
+  Stream s = m.Build();
+  ASSERT_EQ(1U, s.size());
+  EXPECT_EQ(kMode_MRR, s[0]->addressing_mode());
+}
+
+
+TEST_F(InstructionSelectorTest, StoreWithMRRI) {
+  StreamBuilder m(this, MachineType::Int32(), MachineType::Pointer(),
+                  MachineType::Pointer(), MachineType::Int32());
+  Node* const p0 = m.Parameter(0);
+  Node* const p1 = m.Parameter(1);
+  Node* const p2 = m.Parameter(2);
+  m.Store(MachineRepresentation::kWord32, p0,
+          m.IntPtrAdd(p1, m.IntPtrConstant(kLongDisplacement)), p2,
+          kNoWriteBarrier);
+  m.Return(m.Int32Constant(0));
+  Stream s = m.Build();
+  ASSERT_EQ(1U, s.size());
+  EXPECT_EQ(kS390_StoreWord32, s[0]->arch_opcode());
+  EXPECT_EQ(kMode_MRRI, s[0]->addressing_mode());
+  ASSERT_EQ(4U, s[0]->InputCount());
+  EXPECT_EQ(s.ToVreg(p0), s.ToVreg(s[0]->InputAt(0)));
+  EXPECT_EQ(s.ToVreg(p1), s.ToVreg(s[0]->InputAt(1)));
+  EXPECT_EQ(kLongDisplacement, s.ToInt32(s[0]->InputAt(2)));
+  EXPECT_EQ(s.ToVreg(p2), s.ToVreg(s[0]->InputAt(3)));
+  EXPECT_EQ(0U, s[0]->OutputCount());
+}
+
+}  // namespace compiler
 }  // namespace internal
 }  // namespace v8
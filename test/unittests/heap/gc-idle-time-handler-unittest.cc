@@ -24,12 +24,18 @@ class GCIdleTimeHandlerTest : public ::testing::Test {
     result.contexts_disposed = 0;
     result.contexts_disposal_rate = GCIdleTimeHandler::kHighContextDisposalRate;
     result.incremental_marking_stopped = false;
+    result.used_new_space_size = 0;
+    result.new_space_capacity = kNewSpaceCapacity;
+    result.scavenge_speed_in_bytes_per_ms = kScavengeSpeed;
+    result.old_generation_near_limit = false;
     return result;
   }
 
   static const size_t kSizeOfObjects = 100 * MB;
   static const size_t kMarkCompactSpeed = 200 * KB;
   static const size_t kMarkingSpeed = 200 * KB;
+  static const size_t kNewSpaceCapacity = 1 * MB;
+  static const size_t kScavengeSpeed = 100 * KB;
   static const int kMaxNotifications = 100;
 
  private:
@@ -252,5 +258,107 @@ TEST_F(GCIdleTimeHandlerTest, DoneIfNotMakingProgressOnIncrementalMarking) {
   EXPECT_EQ(DONE, action.type);
 }
 
+TEST(GCIdleGapHistory, NoPredictionWithFewGaps) {
+  GCIdleGapHistory history;
+  for (int i = 0; i < GCIdleGapHistory::kMinGapsForPrediction - 1; i++) {
+    history.AddGap(10);
+  }
+  EXPECT_EQ(0, history.PredictGap());
+  history.AddGap(10);
+  EXPECT_EQ(10, history.PredictGap());
+}
+
+
+TEST(GCIdleGapHistory, PredictsShortGap) {
+  GCIdleGapHistory history;
+  for (int i = 20; i > 0; i--) {
+    history.AddGap(i);
+  }
+  EXPECT_EQ(3, history.PredictGap());
+}
+
+
+TEST(GCIdleGapHistory, ForgetsOldGaps) {
+  GCIdleGapHistory history;
+  for (int i = 0; i < GCIdleGapHistory::kMaxGaps; i++) {
+    history.AddGap(1);
+  }
+  for (int i = 0; i < GCIdleGapHistory::kMaxGaps; i++) {
+    history.AddGap(5);
+  }
+  EXPECT_EQ(GCIdleGapHistory::kMaxGaps, history.gaps_count());
+  EXPECT_EQ(5, history.PredictGap());
+}
+
+
+TEST(GCIdleGapHistory, HitsAndMisses) {
+  GCIdleGapHistory history;
+  history.RecordHit();
+  history.RecordHit();
+  history.RecordMiss(1.5);
+  EXPECT_EQ(2u, history.hits());
+  EXPECT_EQ(1u, history.misses());
+  EXPECT_EQ(1.5, history.total_delay_in_ms());
+}
+
+
+TEST_F(GCIdleTimeHandlerTest, ServerNoIdleTime) {
+  GCIdleTimeHeapState heap_state = DefaultHeapState();
+  heap_state.used_new_space_size = kNewSpaceCapacity;
+  GCIdleTimeAction action = handler()->ComputeForServer(0, heap_state);
+  EXPECT_EQ(DO_NOTHING, action.type);
+}
+
+
+TEST_F(GCIdleTimeHandlerTest, ServerScavenge) {
+  GCIdleTimeHeapState heap_state = DefaultHeapState();
+  heap_state.used_new_space_size = kNewSpaceCapacity / 2;
+  double idle_time_ms = 10.0;
+  GCIdleTimeAction action =
+      handler()->ComputeForServer(idle_time_ms, heap_state);
+  EXPECT_EQ(DO_SCAVENGE, action.type);
+}
+
+
+TEST_F(GCIdleTimeHandlerTest, ServerScavengeDoesNotFit) {
+  GCIdleTimeHeapState heap_state = DefaultHeapState();
+  heap_state.used_new_space_size = kNewSpaceCapacity / 2;
+  heap_state.incremental_marking_stopped = true;
+  double idle_time_ms = 2.0;
+  GCIdleTimeAction action =
+      handler()->ComputeForServer(idle_time_ms, heap_state);
+  EXPECT_EQ(DONE, action.type);
+}
+
+
+TEST_F(GCIdleTimeHandlerTest, ServerIncrementalMarking) {
+  GCIdleTimeHeapState heap_state = DefaultHeapState();
+  double idle_time_ms = 2.0;
+  GCIdleTimeAction action =
+      handler()->ComputeForServer(idle_time_ms, heap_state);
+  EXPECT_EQ(DO_INCREMENTAL_STEP, action.type);
+}
+
+
+TEST_F(GCIdleTimeHandlerTest, ServerStartIncrementalMarking) {
+  GCIdleTimeHeapState heap_state = DefaultHeapState();
+  heap_state.incremental_marking_stopped = true;
+  heap_state.old_generation_near_limit = true;
+  double idle_time_ms = 2.0;
+  GCIdleTimeAction action =
+      handler()->ComputeForServer(idle_time_ms, heap_state);
+  EXPECT_EQ(DO_INCREMENTAL_STEP, action.type);
+}
+
+
+TEST_F(GCIdleTimeHandlerTest, ServerNothingToDo) {
+  GCIdleTimeHeapState heap_state = DefaultHeapState();
+  heap_state.incremental_marking_stopped = true;
+  double idle_time_ms = 10.0;
+  GCIdleTimeAction action =
+      handler()->ComputeForServer(idle_time_ms, heap_state);
+  EXPECT_EQ(DONE, action.type);
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -0,0 +1,257 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <vector>
+
+#include "src/base/platform/elapsed-timer.h"
+#include "src/base/utils/random-number-generator.h"
+#include "src/heap/mark-compact.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// Number of cells covering the object area of a regular page.
+const uint32_t kCellCount =
+    static_cast<uint32_t>(Bitmap::kLength / Bitmap::kBitsPerCell);
+
+// Scans the cells one bit at a time and returns the index of the first mark
+// bit of every object with the given color.
+std::vector<int> ScanBitwise(MarkBit::CellType* cells, uint32_t cell_count,
+                             LiveObjectIterationMode mode) {
+  std::vector<int> result;
+  int length = static_cast<int>(cell_count * Bitmap::kBitsPerCell);
+  for (int i = 0; i < length; i++) {
+    if (!(cells[i / Bitmap::kBitsPerCell] & (1u << (i % 32)))) continue;
+    int j = i + 1;
+    bool second = (cells[j / Bitmap::kBitsPerCell] & (1u << (j % 32))) != 0;
+    if (mode == kAllLiveObjects || second == (mode == kBlackObjects)) {
+      result.push_back(i);
+    }
+    i = j;
+  }
+  return result;
+}
+
+
+// Iterates over the cells 32 mark bits at a time the way LiveObjectIterator
+// did before it switched to 64-bit words.
+template <LiveObjectIterationMode T>
+class CellIterator {
+ public:
+  CellIterator(MarkBit::CellType* cells, uint32_t cell_count)
+      : cells_(cells),
+        cell_count_(cell_count),
+        cell_index_(0),
+        current_cell_(cells[0]) {}
+
+  int Next() {
+    while (cell_index_ < cell_count_) {
+      int index = -1;
+      while (current_cell_ != 0) {
+        uint32_t trailing_zeros =
+            base::bits::CountTrailingZeros32(current_cell_);
+        int first = static_cast<int>(cell_index_ * Bitmap::kBitsPerCell +
+                                     trailing_zeros);
+        current_cell_ &= ~(1u << trailing_zeros);
+        uint32_t second_bit_index = 0;
+        if (trailing_zeros < Bitmap::kBitIndexMask) {
+          second_bit_index = 1u << (trailing_zeros + 1);
+        } else {
+          second_bit_index = 0x1;
+          current_cell_ = cells_[++cell_index_];
+        }
+        bool second = (current_cell_ & second_bit_index) != 0;
+        if (T == kAllLiveObjects || second == (T == kBlackObjects)) {
+          index = first;
+        }
+        current_cell_ &= ~second_bit_index;
+        if (index >= 0) break;
+      }
+      if (current_cell_ == 0 && ++cell_index_ < cell_count_) {
+        current_cell_ = cells_[cell_index_];
+      }
+      if (index >= 0) return index;
+    }
+    return -1;
+  }
+
+ private:
+  MarkBit::CellType* cells_;
+  uint32_t cell_count_;
+  uint32_t cell_index_;
+  MarkBit::CellType current_cell_;
+};
+
+
+template <LiveObjectIterationMode T>
+std::vector<int> ScanWordwise(MarkBit::CellType* cells, uint32_t cell_count) {
+  std::vector<int> result;
+  MarkBitWordIterator<T> it(cells, cell_count);
+  int index;
+  while ((index = it.Next()) != MarkBitWordIterator<T>::kDone) {
+    result.push_back(index);
+  }
+  return result;
+}
+
+}  // namespace
+
+
+class LiveObjectIteratorTest : public ::testing::Test {
+ public:
+  LiveObjectIteratorTest() : cells_(kCellCount + 1, 0) {}
+
+  MarkBit::CellType* cells() { return &cells_[0]; }
+
+  void Clear() { std::fill(cells_.begin(), cells_.end(), 0); }
+
+  void SetBit(int index) {
+    cells_[index / Bitmap::kBitsPerCell] |= 1u << (index % 32);
+  }
+
+  void MarkBlack(int index) {
+    SetBit(index);
+    SetBit(index + 1);
+  }
+
+  void MarkGrey(int index) { SetBit(index); }
+
+  // Marks objects of two to {max_size} words with gaps of up to {max_gap}
+  // words between them. About half of the objects are grey if {with_grey} is
+  // set, otherwise all objects are black.
+  void MarkRandomObjects(base::RandomNumberGenerator* rng, int max_size,
+                         int max_gap, bool with_grey) {
+    Clear();
+    int length = static_cast<int>(kCellCount * Bitmap::kBitsPerCell) - 2;
+    int index = rng->NextInt(max_gap + 1);
+    while (index < length) {
+      if (!with_grey || rng->NextBool()) {
+        MarkBlack(index);
+      } else {
+        MarkGrey(index);
+      }
+      index += 2 + rng->NextInt(max_size - 1) + rng->NextInt(max_gap + 1);
+    }
+  }
+
+  template <LiveObjectIterationMode T>
+  void CheckAgainstBitwiseScan() {
+    EXPECT_EQ(ScanBitwise(cells(), kCellCount, T),
+              ScanWordwise<T>(cells(), kCellCount));
+  }
+
+  void CheckAllModes() {
+    CheckAgainstBitwiseScan<kBlackObjects>();
+    CheckAgainstBitwiseScan<kGreyObjects>();
+    CheckAgainstBitwiseScan<kAllLiveObjects>();
+  }
+
+ private:
+  // One cell of padding allows the bitwise scan to look at the second mark
+  // bit of the last possible object without bounds checks.
+  std::vector<MarkBit::CellType> cells_;
+};
+
+
+TEST_F(LiveObjectIteratorTest, Empty) {
+  EXPECT_TRUE(ScanWordwise<kAllLiveObjects>(cells(), kCellCount).empty());
+  EXPECT_TRUE(ScanWordwise<kAllLiveObjects>(cells(), 0).empty());
+}
+
+
+TEST_F(LiveObjectIteratorTest, SingleObject) {
+  // Covers all positions within the first and last words of the range.
+  int length = static_cast<int>(kCellCount * Bitmap::kBitsPerCell) - 1;
+  for (int i = 0; i < length; i = (i == 127) ? length - 128 : i + 1) {
+    Clear();
+    MarkBlack(i);
+    std::vector<int> black = ScanWordwise<kBlackObjects>(cells(), kCellCount);
+    ASSERT_EQ(1u, black.size());
+    EXPECT_EQ(i, black[0]);
+    EXPECT_TRUE(ScanWordwise<kGreyObjects>(cells(), kCellCount).empty());
+
+    Clear();
+    MarkGrey(i);
+    std::vector<int> grey = ScanWordwise<kGreyObjects>(cells(), kCellCount);
+    ASSERT_EQ(1u, grey.size());
+    EXPECT_EQ(i, grey[0]);
+    EXPECT_TRUE(ScanWordwise<kBlackObjects>(cells(), kCellCount).empty());
+  }
+}
+
+
+TEST_F(LiveObjectIteratorTest, MarkBitsSpanningWords) {
+  // The second mark bit of these objects is in the next cell or word.
+  MarkBlack(31);
+  MarkGrey(95);
+  MarkBlack(127);
+  MarkBlack(129);
+  CheckAllModes();
+  std::vector<int> all = ScanWordwise<kAllLiveObjects>(cells(), kCellCount);
+  ASSERT_EQ(4u, all.size());
+  EXPECT_EQ(31, all[0]);
+  EXPECT_EQ(95, all[1]);
+  EXPECT_EQ(127, all[2]);
+  EXPECT_EQ(129, all[3]);
+}
+
+
+TEST_F(LiveObjectIteratorTest, OddCellCount) {
+  // The last word of the range only has a low cell.
+  MarkBlack(64);
+  MarkBlack(96);
+  std::vector<int> black = ScanWordwise<kBlackObjects>(cells(), 3);
+  ASSERT_EQ(1u, black.size());
+  EXPECT_EQ(64, black[0]);
+}
+
+
+TEST_F(LiveObjectIteratorTest, RandomBitmaps) {
+  base::RandomNumberGenerator rng(42);
+  for (int max_gap = 0; max_gap <= 512; max_gap = 2 * max_gap + 1) {
+    for (int i = 0; i < 8; i++) {
+      MarkRandomObjects(&rng, 8, max_gap, true);
+      CheckAllModes();
+    }
+  }
+}
+
+
+// Microbenchmark comparing the 64-bit word iteration with the previous
+// cell-at-a-time iteration on dense and sparse pages. Run it with
+// --gtest_also_run_disabled_tests.
+TEST_F(LiveObjectIteratorTest, DISABLED_Benchmark) {
+  const int kIterations = 2000;
+  base::RandomNumberGenerator rng(42);
+  for (int max_gap = 0; max_gap <= 4096; max_gap = 4 * max_gap + 1) {
+    MarkRandomObjects(&rng, 8, max_gap, false);
+    int cellwise_found = 0;
+    int wordwise_found = 0;
+    base::ElapsedTimer timer;
+    timer.Start();
+    for (int i = 0; i < kIterations; i++) {
+      CellIterator<kBlackObjects> it(cells(), kCellCount);
+      while (it.Next() >= 0) cellwise_found++;
+    }
+    double cellwise_ms = timer.Elapsed().InMillisecondsF();
+    timer.Restart();
+    for (int i = 0; i < kIterations; i++) {
+      MarkBitWordIterator<kBlackObjects> it(cells(), kCellCount);
+      while (it.Next() != MarkBitWordIterator<kBlackObjects>::kDone) {
+        wordwise_found++;
+      }
+    }
+    double wordwise_ms = timer.Elapsed().InMillisecondsF();
+    EXPECT_EQ(cellwise_found, wordwise_found);
+    PrintF("max gap %4d, %5d black objects: cells %.2f ms, words %.2f ms\n",
+           max_gap, wordwise_found / kIterations, cellwise_ms, wordwise_ms);
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
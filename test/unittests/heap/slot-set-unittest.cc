@@ -139,5 +139,53 @@ TEST(SlotSet, RemoveRange) {
   }
 }
 
+void CheckInsertRangeOn(uint32_t start, uint32_t end) {
+  SlotSet set;
+  set.SetPageStart(0);
+  set.InsertRange(start, end);
+  for (uint32_t i = 0; i < Page::kPageSize; i += kPointerSize) {
+    EXPECT_EQ(start <= i && i < end, set.Lookup(i));
+  }
+}
+
+TEST(SlotSet, InsertRange) {
+  CheckInsertRangeOn(0, Page::kPageSize);
+  CheckInsertRangeOn(1 * kPointerSize, 1023 * kPointerSize);
+  for (uint32_t start = 0; start <= 32; start++) {
+    CheckInsertRangeOn(start * kPointerSize, (start + 1) * kPointerSize);
+    CheckInsertRangeOn(start * kPointerSize, (start + 2) * kPointerSize);
+    const uint32_t kEnds[] = {32, 64, 100, 128, 1024, 1500, 2048};
+    for (size_t i = 0; i < arraysize(kEnds); i++) {
+      for (int k = -3; k <= 3; k++) {
+        uint32_t end = (kEnds[i] + k);
+        if (start < end) {
+          CheckInsertRangeOn(start * kPointerSize, end * kPointerSize);
+        }
+      }
+    }
+  }
+  uint32_t last = Page::kPageSize - kPointerSize;
+  CheckInsertRangeOn(last, Page::kPageSize);
+}
+
+TEST(SlotSet, InsertRangeAndIterate) {
+  SlotSet set;
+  set.SetPageStart(0);
+  set.Insert(0);
+  set.InsertRange(40 * kPointerSize, 2000 * kPointerSize);
+  set.Insert(2000 * kPointerSize);
+  int count = set.Iterate([](Address slot_address) {
+    uintptr_t intaddr = reinterpret_cast<uintptr_t>(slot_address);
+    return (intaddr % 2 == 0) ? SlotSet::KEEP_SLOT : SlotSet::REMOVE_SLOT;
+  });
+  EXPECT_EQ(1962, count);
+  EXPECT_TRUE(set.Lookup(0));
+  EXPECT_FALSE(set.Lookup(39 * kPointerSize));
+  EXPECT_TRUE(set.Lookup(40 * kPointerSize));
+  EXPECT_TRUE(set.Lookup(1999 * kPointerSize));
+  EXPECT_TRUE(set.Lookup(2000 * kPointerSize));
+  EXPECT_FALSE(set.Lookup(2001 * kPointerSize));
+}
+
 }  // namespace internal
 }  // namespace v8
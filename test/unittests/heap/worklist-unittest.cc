@@ -0,0 +1,78 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/worklist.h"
+#include "src/list-inl.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+typedef Worklist<int> TestWorklist;
+
+TEST(Worklist, LocalPushPop) {
+  TestWorklist worklist;
+  TestWorklist::Local local(&worklist);
+  int entry;
+  EXPECT_FALSE(local.Pop(&entry));
+  local.Push(1);
+  local.Push(2);
+  EXPECT_EQ(2, local.length());
+  EXPECT_TRUE(local.Pop(&entry));
+  EXPECT_EQ(2, entry);
+  EXPECT_TRUE(local.Pop(&entry));
+  EXPECT_EQ(1, entry);
+  EXPECT_TRUE(local.IsEmpty());
+  EXPECT_TRUE(worklist.IsGlobalPoolEmpty());
+}
+
+TEST(Worklist, FlushToGlobalPublishesSegments) {
+  TestWorklist worklist;
+  TestWorklist::Local producer(&worklist);
+  const int kEntries = 2 * TestWorklist::kSegmentSize + 1;
+  for (int i = 0; i < kEntries; i++) producer.Push(i);
+  producer.FlushToGlobal();
+  EXPECT_TRUE(producer.IsEmpty());
+  EXPECT_EQ(kEntries, worklist.GlobalPoolSize());
+
+  TestWorklist::Local consumer(&worklist);
+  int taken = 0;
+  int entry;
+  while (consumer.TryTake()) {
+    EXPECT_GE(TestWorklist::kSegmentSize, consumer.length());
+    while (consumer.Pop(&entry)) taken++;
+  }
+  EXPECT_EQ(kEntries, taken);
+  EXPECT_TRUE(worklist.IsGlobalPoolEmpty());
+}
+
+TEST(Worklist, StealTerminatesWhenAllTasksAreIdle) {
+  TestWorklist worklist;
+  EXPECT_TRUE(worklist.Register());
+  TestWorklist::Local local(&worklist);
+  local.Push(1);
+  local.FlushToGlobal();
+  EXPECT_TRUE(local.Steal());
+  int entry;
+  EXPECT_TRUE(local.Pop(&entry));
+  EXPECT_EQ(1, entry);
+  // The only registered task is out of work, so the work is complete and
+  // late tasks must not join.
+  EXPECT_FALSE(local.Steal());
+  EXPECT_FALSE(worklist.Register());
+}
+
+TEST(Worklist, ClearDropsGlobalPool) {
+  TestWorklist worklist;
+  TestWorklist::Local local(&worklist);
+  for (int i = 0; i < 10; i++) local.Push(i);
+  local.FlushToGlobal();
+  EXPECT_FALSE(worklist.IsGlobalPoolEmpty());
+  worklist.Clear();
+  EXPECT_TRUE(worklist.IsGlobalPoolEmpty());
+  EXPECT_FALSE(local.TryTake());
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,90 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/base/platform/platform.h"
+#include "src/parallel-job.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+class CountingItemJob : public ItemParallelJob {
+ public:
+  static const int kItems = 1000;
+
+  explicit CountingItemJob(Isolate* isolate) : ItemParallelJob(isolate) {
+    for (int i = 0; i < kItems; i++) counts_[i].SetValue(0);
+  }
+
+  int NumberOfItems() override { return kItems; }
+
+  int count(int item) { return counts_[item].Value(); }
+
+ protected:
+  void ProcessItem(int item) override { counts_[item].Increment(1); }
+
+ private:
+  AtomicNumber<int> counts_[kItems];
+};
+
+
+class RecordingJob : public ParallelJob {
+ public:
+  static const int kTasks = 4;
+
+  explicit RecordingJob(Isolate* isolate) : ParallelJob(isolate) {
+    for (int i = 0; i < kTasks; i++) runs_[i].SetValue(0);
+  }
+
+  int runs(int task_index) { return runs_[task_index].Value(); }
+  int main_thread_id() { return main_thread_id_; }
+
+ private:
+  void RunTask(int task_index) override {
+    if (task_index == 0) main_thread_id_ = base::OS::GetCurrentThreadId();
+    runs_[task_index].Increment(1);
+  }
+
+  AtomicNumber<int> runs_[kTasks];
+  int main_thread_id_;
+};
+
+}  // namespace
+
+
+typedef TestWithIsolate ParallelJobTest;
+
+
+TEST_F(ParallelJobTest, ItemsAreProcessedOnce) {
+  CountingItemJob job(isolate());
+  job.Run(4);
+  for (int i = 0; i < CountingItemJob::kItems; i++) {
+    EXPECT_EQ(1, job.count(i));
+  }
+}
+
+
+TEST_F(ParallelJobTest, FirstTaskRunsOnCallingThread) {
+  RecordingJob job(isolate());
+  job.Run(RecordingJob::kTasks);
+  EXPECT_EQ(base::OS::GetCurrentThreadId(), job.main_thread_id());
+  EXPECT_EQ(1, job.runs(0));
+  // Background tasks that did not start in time are canceled.
+  for (int i = 1; i < RecordingJob::kTasks; i++) {
+    EXPECT_LE(job.runs(i), 1);
+  }
+}
+
+
+TEST_F(ParallelJobTest, NumberOfTasks) {
+  EXPECT_EQ(1, ParallelJob::NumberOfTasks(1));
+  EXPECT_LE(1, ParallelJob::NumberOfTasks(8));
+  EXPECT_GE(8, ParallelJob::NumberOfTasks(8));
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -108,9 +108,12 @@
         'heap/gc-idle-time-handler-unittest.cc',
         'heap/memory-reducer-unittest.cc',
         'heap/heap-unittest.cc',
+        'heap/live-object-iterator-unittest.cc',
         'heap/scavenge-job-unittest.cc',
         'heap/slot-set-unittest.cc',
+        'heap/worklist-unittest.cc',
         'locked-queue-unittest.cc',
+        'parallel-job-unittest.cc',
         'run-all-unittests.cc',
         'runtime/runtime-interpreter-unittest.cc',
         'test-utils.h',
@@ -120,6 +123,7 @@
         'wasm/loop-assignment-analysis-unittest.cc',
         'wasm/module-decoder-unittest.cc',
         'wasm/wasm-macro-gen-unittest.cc',
+        'zone-unittest.cc',
       ],
       'conditions': [
         ['v8_target_arch=="arm"', {
@@ -159,6 +163,7 @@
         }],
         ['v8_target_arch=="s390" or v8_target_arch=="s390x"', {
           'sources': [  ### gcmole(arch:s390) ###
+            'compiler/s390/instruction-scheduler-s390-unittest.cc',
             'compiler/s390/instruction-selector-s390-unittest.cc',
           ],
         }],
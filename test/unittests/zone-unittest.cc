@@ -0,0 +1,84 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/flags.h"
+#include "src/zone.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+class ZoneSegmentPoolTest : public ::testing::Test {
+ public:
+  ZoneSegmentPoolTest() : pool_size_(FLAG_zone_segment_pool_size) {
+    ZoneSegmentPool::Purge();
+  }
+  ~ZoneSegmentPoolTest() override {
+    FLAG_zone_segment_pool_size = pool_size_;
+    ZoneSegmentPool::Purge();
+  }
+
+ private:
+  int pool_size_;
+};
+
+}  // namespace
+
+
+TEST_F(ZoneSegmentPoolTest, ReusesSegments) {
+  FLAG_zone_segment_pool_size = 8;
+  {
+    Zone zone;
+    zone.New(100);
+  }
+  size_t retained = ZoneSegmentPool::retained_bytes();
+  EXPECT_LT(0u, retained);
+  size_t requested = ZoneSegmentPool::requested_segments();
+  size_t reused = ZoneSegmentPool::reused_segments();
+  {
+    Zone zone;
+    zone.New(100);
+    EXPECT_EQ(requested + 1, ZoneSegmentPool::requested_segments());
+    EXPECT_EQ(reused + 1, ZoneSegmentPool::reused_segments());
+    EXPECT_EQ(0u, ZoneSegmentPool::retained_bytes());
+  }
+  EXPECT_EQ(retained, ZoneSegmentPool::retained_bytes());
+}
+
+
+TEST_F(ZoneSegmentPoolTest, RespectsSizeLimit) {
+  FLAG_zone_segment_pool_size = 0;
+  {
+    Zone zone;
+    zone.New(100);
+  }
+  EXPECT_EQ(0u, ZoneSegmentPool::retained_bytes());
+}
+
+
+TEST_F(ZoneSegmentPoolTest, DoesNotPoolLargeSegments) {
+  FLAG_zone_segment_pool_size = 8;
+  {
+    Zone zone;
+    zone.New(2 * MB);
+  }
+  EXPECT_EQ(0u, ZoneSegmentPool::retained_bytes());
+}
+
+
+TEST_F(ZoneSegmentPoolTest, PurgeFreesSegments) {
+  FLAG_zone_segment_pool_size = 8;
+  {
+    Zone zone;
+    zone.New(100);
+  }
+  EXPECT_LT(0u, ZoneSegmentPool::retained_bytes());
+  ZoneSegmentPool::Purge();
+  EXPECT_EQ(0u, ZoneSegmentPool::retained_bytes());
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -46,6 +46,7 @@ INTERESTING_NEW_GEN_KEYS="\
   code \
   semispace \
   object_groups \
+  parallel \
 "
 
 INTERESTING_OLD_GEN_KEYS="\
@@ -69,11 +70,12 @@ INTERESTING_OLD_GEN_KEYS="\
   evacuate.new_space \
   evacuate.update_pointers \
   evacuate.update_pointers.between_evacuated \
-  evacuate.update_pointers.to_evacuated \
+  evacuate.update_pointers.parallel \
   evacuate.update_pointers.to_new \
   evacuate.update_pointers.weak \
   mark \
   mark.finish_incremental \
+  mark.parallel \
   mark.prepare_code_flush \
   mark.roots \
   mark.weak_closure \